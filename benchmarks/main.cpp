@@ -0,0 +1,889 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+/* giada-bench
+Headless benchmark of the whole audio pipeline. A synthetic Document is built
+from scratch, then a dummy audio backend (a plain thread, no audio device)
+drives Renderer::render() for a fixed number of blocks. Throughput, per-block
+latency and heap allocations are printed as JSON, so that results can be
+compared across releases. */
+
+#include "src/core/actions/ActionManager.h"
+#include "src/core/channels/channelManager.h"
+#include "src/core/const.h"
+#include "src/core/jackTransport.h"
+#include "src/core/kernelMidi.h"
+#include "src/core/midiMapper.h"
+#include "src/core/midiSynchronizer.h"
+#include "src/core/mixer.h"
+#include "src/core/model/model.h"
+#include "src/core/plugins/pluginHost.h"
+#include "src/core/resampler.h"
+#include "src/core/rendering/midiOutput.h"
+#include "src/core/rendering/reactor.h"
+#include "src/core/rendering/renderer.h"
+#include "src/core/sequencer.h"
+#include "src/core/simd.h"
+#include "src/core/wave.h"
+#include "src/core/waveFactory.h"
+#include "src/core/worker.h"
+#include "src/deps/concurrentqueue/concurrentqueue.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#ifdef WITH_AUDIO_JACK
+#include "src/core/jackSynchronizer.h"
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <nlohmann/json.hpp>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace giada::m
+{
+class Engine;
+}
+
+namespace giada::v
+{
+class Ui;
+}
+
+/* Glue and GUI code reference these globals. The benchmark never touches them. */
+
+giada::m::Engine* g_engine = nullptr;
+giada::v::Ui*     g_ui     = nullptr;
+
+/* -------------------------------------------------------------------------- */
+
+/* Global allocation counter. Every call to the (replaced) global operator new
+is counted, so that allocations performed while rendering can be reported. */
+
+namespace
+{
+std::atomic<std::size_t> allocations_ = 0;
+}
+
+void* operator new(std::size_t size)
+{
+	allocations_.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size == 0 ? 1 : size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+/* -------------------------------------------------------------------------- */
+
+namespace giada::m
+{
+namespace
+{
+struct Options
+{
+	int         sampleChannels = 16;
+	int         midiChannels   = 4;
+	std::string mode           = "tape"; // tape, elastic, mixed
+	float       pitch          = 1.0f;
+	std::string storage        = "float"; // float, int16, half
+	std::string resampler      = "linear";
+	bool        freeze         = true;
+	int         actionsPerBeat = 4;
+	int         blocks         = 10000;
+	int         warmupBlocks   = 100;
+	int         swaps          = 1000;
+	int         midiEvents     = 100;
+	int         bufferSize     = G_DEFAULT_BUFSIZE;
+	int         sampleRate     = G_DEFAULT_SAMPLERATE;
+	int         renderThreads  = G_DEFAULT_RENDER_THREADS;
+	std::string output; // Print to stdout if empty
+};
+
+struct Results
+{
+	double              seconds;
+	std::size_t         allocations;
+	std::size_t         maxAllocationsInBlock;
+	std::size_t         sampleMemory; // Bytes of audio data held by all Waves
+	double              aliasingDb;   // See measureAliasing_()
+	std::vector<double> latencies;    // Microseconds, one per block
+	std::size_t         swapAllocations;
+	std::vector<double> swapLatencies; // Microseconds, one per swap. See Bench::measureSwaps()
+	std::vector<double> midiPolling;  // Microseconds, one per event. See Bench::measureMidiLatency()
+	std::vector<double> midiNotified; // Same as above
+};
+
+/* -------------------------------------------------------------------------- */
+
+void printUsage_()
+{
+	std::cerr << "Usage: giada-bench [options]\n"
+	             "  --sample-channels=N  Number of Sample channels (default 16)\n"
+	             "  --midi-channels=N    Number of MIDI channels (default 4)\n"
+	             "  --mode=MODE          Sample playback mode: tape, elastic or mixed (default tape)\n"
+	             "  --pitch=P            Pitch of Sample channels (default 1.0)\n"
+	             "  --storage=S          Sample storage: float, int16 or half (default float)\n"
+	             "  --resampler=Q        Resampler quality: sinc-best, sinc-medium, sinc-fastest, zoh, linear,\n"
+	             "                       builtin-sinc, builtin-cubic or builtin-linear (default linear)\n"
+	             "  --freeze=B           Pre-render pitched Samples in background: on or off (default on).\n"
+	             "                       Turn it off to measure the resampler on the audio thread\n"
+	             "  --actions=N          MIDI actions per beat, per MIDI channel (default 4)\n"
+	             "  --blocks=N           Number of measured blocks (default 10000)\n"
+	             "  --warmup=N           Number of unmeasured blocks rendered first (default 100)\n"
+	             "  --swaps=N            Number of measured Document swaps (default 1000)\n"
+	             "  --midi-events=N      Number of measured MIDI in -> audio out events (default 100)\n"
+	             "  --buffer-size=N      Frames per block\n"
+	             "  --sample-rate=N      Sample rate\n"
+	             "  --render-threads=N   Size of the render worker pool\n"
+	             "  --output=FILE        Write JSON to FILE instead of stdout\n";
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* getResamplerQuality_
+Maps the --resampler option to a Resampler::Quality. Returns an empty optional
+if the name is unknown. */
+
+std::optional<Resampler::Quality> getResamplerQuality_(const std::string& name)
+{
+	if (name == "sinc-best")
+		return Resampler::Quality::SINC_BEST;
+	if (name == "sinc-medium")
+		return Resampler::Quality::SINC_MEDIUM;
+	if (name == "sinc-fastest")
+		return Resampler::Quality::SINC_FASTEST;
+	if (name == "zoh")
+		return Resampler::Quality::ZERO_ORDER_HOLD;
+	if (name == "linear")
+		return Resampler::Quality::LINEAR;
+	if (name == "builtin-sinc")
+		return Resampler::Quality::BUILTIN_SINC;
+	if (name == "builtin-cubic")
+		return Resampler::Quality::BUILTIN_CUBIC;
+	if (name == "builtin-linear")
+		return Resampler::Quality::BUILTIN_LINEAR;
+	return {};
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* parseOptions_
+Parses '--key=value' arguments. Returns false on unknown or malformed ones. */
+
+bool parseOptions_(int argc, char** argv, Options& o)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const std::size_t eq  = arg.find('=');
+		if (arg.rfind("--", 0) != 0 || eq == std::string::npos)
+			return false;
+
+		const std::string key   = arg.substr(2, eq - 2);
+		const std::string value = arg.substr(eq + 1);
+
+		try
+		{
+			if (key == "sample-channels")
+				o.sampleChannels = std::stoi(value);
+			else if (key == "midi-channels")
+				o.midiChannels = std::stoi(value);
+			else if (key == "mode" && (value == "tape" || value == "elastic" || value == "mixed"))
+				o.mode = value;
+			else if (key == "pitch")
+				o.pitch = std::clamp(std::stof(value), G_MIN_PITCH, G_MAX_PITCH);
+			else if (key == "storage" && (value == "float" || value == "int16" || value == "half"))
+				o.storage = value;
+			else if (key == "resampler" && getResamplerQuality_(value))
+				o.resampler = value;
+			else if (key == "freeze" && (value == "on" || value == "off"))
+				o.freeze = value == "on";
+			else if (key == "actions")
+				o.actionsPerBeat = std::max(std::stoi(value), 0);
+			else if (key == "blocks")
+				o.blocks = std::max(std::stoi(value), 1);
+			else if (key == "warmup")
+				o.warmupBlocks = std::max(std::stoi(value), 0);
+			else if (key == "swaps")
+				o.swaps = std::max(std::stoi(value), 1);
+			else if (key == "midi-events")
+				o.midiEvents = std::max(std::stoi(value), 1);
+			else if (key == "buffer-size")
+				o.bufferSize = std::max(std::stoi(value), 8);
+			else if (key == "sample-rate")
+				o.sampleRate = std::max(std::stoi(value), 1);
+			else if (key == "render-threads")
+				o.renderThreads = std::clamp(std::stoi(value), 1, G_MAX_RENDER_THREADS);
+			else if (key == "output")
+				o.output = value;
+			else
+				return false;
+		}
+		catch (const std::exception&)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* makeWave_
+Creates a one-bar stereo Wave filled with a sine tone, so that Sample channels
+always produce an audible signal. */
+
+std::unique_ptr<Wave> makeWave_(Frame frames, int sampleRate, float frequency)
+{
+	std::unique_ptr<Wave> wave = waveFactory::createEmpty(frames, G_MAX_IO_CHANS, sampleRate, "bench");
+
+	for (int ch = 0; ch < G_MAX_IO_CHANS; ch++)
+	{
+		float* data = wave->getBuffer().getChannelView(ch).data();
+		for (Frame i = 0; i < frames; i++)
+			data[i] = 0.5f * std::sin(2.0f * std::numbers::pi_v<float> * frequency * i / sampleRate);
+	}
+
+	return wave;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* measureAliasing_
+Resamples a tone at 0.45 of the sample rate with a pitch of 1.5: the result is
+above the Nyquist frequency, so whatever comes out is aliasing. Returns its
+level relative to the input, in dB. Lower is better. */
+
+double measureAliasing_(Resampler::Quality quality)
+{
+	constexpr Frame FRAMES = 65536;
+	constexpr Frame SKIP   = 1024; // Resampler warm-up
+	constexpr float PITCH  = 1.5f;
+
+	/* Computed in double precision: phase errors of a float sine would show up as
+	noise below the Nyquist frequency. */
+
+	mcl::AudioBuffer in(FRAMES, G_MAX_IO_CHANS);
+	mcl::AudioBuffer out(static_cast<int>(FRAMES / PITCH) - 1, G_MAX_IO_CHANS);
+	for (Frame i = 0; i < FRAMES; i++)
+		for (int ch = 0; ch < G_MAX_IO_CHANS; ch++)
+			in.at(i, ch) = static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * 0.45 * i));
+
+	const Resampler resampler(quality);
+	resampler.process(in, 0, FRAMES, out, 0, PITCH);
+
+	double inPower = 0.0, aliasing = 0.0;
+	for (Frame i = 0; i < FRAMES; i++)
+		inPower += in.at(i, 0) * in.at(i, 0);
+	for (Frame i = SKIP; i < out.countFrames() - SKIP; i++)
+		aliasing += out.at(i, 0) * out.at(i, 0);
+
+	inPower /= FRAMES;
+	aliasing /= out.countFrames() - SKIP * 2;
+
+	return 10.0 * std::log10(std::max(aliasing / inPower, 1e-20));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* isAudible_
+True if the buffer contains any signal, as in Renderer. */
+
+bool isAudible_(const mcl::AudioBuffer& b)
+{
+	for (int i = 0; i < b.countChannels(); i++)
+		if (simd::getPeak(b.getChannelView(i).data(), b.countFrames()) > G_SILENCE_THRESHOLD)
+			return true;
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* percentile_
+Returns the p-th percentile of an already sorted vector. */
+
+double percentile_(const std::vector<double>& sorted, double p)
+{
+	const std::size_t i = static_cast<std::size_t>(std::ceil(p * sorted.size())) - 1;
+	return sorted[std::min(i, sorted.size() - 1)];
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* toHistogramJson_
+Returns percentiles and a histogram of an already sorted vector of latencies in
+microseconds. Each bucket counts the values up to its upper bound, excluding the
+previous bucket. */
+
+nlohmann::json toHistogramJson_(const std::vector<double>& sorted)
+{
+	constexpr std::array<double, 8> BOUNDS = {50, 100, 250, 500, 1000, 2000, 5000, 10000};
+
+	nlohmann::json j;
+
+	j["p50"] = percentile_(sorted, 0.50);
+	j["p99"] = percentile_(sorted, 0.99);
+	j["max"] = sorted.back();
+
+	auto it = sorted.begin();
+	for (const double bound : BOUNDS)
+	{
+		const auto        next = std::upper_bound(it, sorted.end(), bound);
+		const std::string key  = "le_" + std::to_string(static_cast<int>(bound));
+
+		j["histogram"][key] = std::distance(it, next);
+		it                  = next;
+	}
+	j["histogram"]["more"] = std::distance(it, sorted.end());
+
+	return j;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+/* Bench
+The minimal set of engine components needed by the Renderer, wired together
+the same way the Engine does, minus KernelAudio. */
+
+class Bench
+{
+public:
+	Bench(const Options&);
+	~Bench();
+
+	/* setup
+	Fills the Document with Sample and MIDI channels according to Options, then
+	starts the sequencer. */
+
+	void setup();
+
+	/* run
+	Renders all blocks on a dedicated thread, acting as the audio callback. */
+
+	Results run();
+
+private:
+	/* measureSwaps
+	Times Document swaps, each one following a single change of a Channel
+	property (its height): a typical light edit coming from the UI. */
+
+	void measureSwaps(Results&);
+
+	/* measureMidiLatency
+	Times MIDI in -> audio out, end to end: from the moment a MIDI message
+	leaves the device callback to the end of the first rendered block that
+	contains the sound it triggers, i.e. when the block is handed over to the
+	audio device. Messages go through a MIDI input worker, as in KernelMidi,
+	which presses the 'probe' Sample channel through the Reactor, as a
+	MIDI-learned key would. Blocks are rendered in real time by a paced audio
+	thread, so the result includes the wait for the next audio callback. Other
+	channels must be silent. With 'notify' off the worker just polls its queue
+	every 3 ms, as it did before being woken up on enqueue: a baseline to
+	compare against. Returns microseconds, one per message. */
+
+	std::vector<double> measureMidiLatency(ID probeId, bool notify);
+
+	void addSampleChannel(std::size_t trackIndex, PlaybackMode, float frequency);
+	void addMidiChannel(std::size_t trackIndex);
+
+	/* addProbeChannel
+	Adds a silent-until-pressed Sample channel for measureMidiLatency(), playing
+	one block of constant signal in SINGLE_BASIC mode. Returns its ID. */
+
+	ID addProbeChannel(std::size_t trackIndex);
+
+	const Options& m_options;
+	std::size_t    m_sampleMemory;
+
+	model::Model           m_model;
+	KernelMidi             m_kernelMidi;
+	MidiMapper<KernelMidi> m_midiMapper;
+	PluginHost             m_pluginHost;
+	JackTransport          m_jackTransport;
+	MidiSynchronizer       m_midiSynchronizer;
+	Sequencer              m_sequencer;
+	Mixer                  m_mixer;
+	ActionManager          m_actionManager;
+	ChannelManager         m_channelManager;
+	rendering::Reactor     m_reactor;
+#ifdef WITH_AUDIO_JACK
+	JackSynchronizer m_jackSynchronizer;
+#endif
+	rendering::Renderer m_renderer;
+};
+
+/* -------------------------------------------------------------------------- */
+
+Bench::Bench(const Options& o)
+: m_options(o)
+, m_sampleMemory(0)
+, m_kernelMidi(m_model)
+, m_midiMapper(m_kernelMidi)
+, m_pluginHost(m_model)
+, m_midiSynchronizer(m_kernelMidi)
+, m_sequencer(m_model, m_midiSynchronizer, m_jackTransport)
+, m_mixer(m_model)
+, m_actionManager(m_model)
+, m_channelManager(m_model, m_midiMapper, m_kernelMidi)
+, m_reactor(m_model, m_midiMapper, m_actionManager, m_kernelMidi)
+#ifdef WITH_AUDIO_JACK
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_jackSynchronizer, m_jackTransport, m_kernelMidi)
+#else
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_kernelMidi)
+#endif
+{
+	/* No UI, no event dispatcher: all callbacks are no-ops. */
+
+	m_kernelMidi.onMidiSent                     = []() {};
+	m_sequencer.onAboutStart                    = [](SeqStatus) {};
+	m_sequencer.onAboutStop                     = []() {};
+	m_sequencer.onSceneChanged                  = []() {};
+	m_mixer.onSignalTresholdReached             = []() {};
+	m_mixer.onEndOfRecording                    = []() {};
+	m_channelManager.onChannelsAltered          = []() {};
+	m_channelManager.onChannelPlayStatusChanged = [](ID, ChannelStatus) {};
+	m_channelManager.onChannelRecorded          = [](Frame) { return std::unique_ptr<Wave>(); };
+	m_renderer.onResamplerFallback              = [](bool, float) {};
+	rendering::registerOnSendMidiCb([](ID) {});
+}
+
+/* -------------------------------------------------------------------------- */
+
+Bench::~Bench()
+{
+	m_mixer.disable();
+	m_renderer.stopWorkers();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench::setup()
+{
+	const int sampleRate = m_options.sampleRate;
+	const int bufferSize = m_options.bufferSize;
+
+	m_model.registerThread(Thread::MAIN, /*realtime=*/false);
+	m_model.init();
+
+	model::KernelAudio& kernelAudio = m_model.get().kernelAudio;
+	kernelAudio.samplerate          = sampleRate;
+	kernelAudio.buffersize          = bufferSize;
+	kernelAudio.renderThreads       = m_options.renderThreads;
+	kernelAudio.rsmpQuality         = getResamplerQuality_(m_options.resampler).value();
+	kernelAudio.loadGovernor        = 0; // Blocks are rendered back to back: keep the quality fixed
+	m_model.swap(model::SwapType::NONE);
+
+	m_model.resetStretcherPool(m_options.sampleChannels, sampleRate); // Enough for all ELASTIC channels
+	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
+	m_channelManager.reset(sampleRate, bufferSize);
+	m_sequencer.reset(sampleRate);
+	m_pluginHost.reset(bufferSize);
+	m_renderer.startWorkers(m_options.renderThreads);
+
+	/* Spread channels across all visible tracks, round-robin. */
+
+	std::vector<std::size_t> trackIndexes;
+	for (const model::Track& track : m_model.get().tracks.getAll())
+		if (!track.isInternal())
+			trackIndexes.push_back(track.getIndex());
+
+	for (int i = 0; i < m_options.sampleChannels; i++)
+	{
+		const bool         elastic = m_options.mode == "elastic" || (m_options.mode == "mixed" && i % 2 == 1);
+		const PlaybackMode mode    = elastic ? PlaybackMode::ELASTIC : PlaybackMode::TAPE;
+		addSampleChannel(trackIndexes[i % trackIndexes.size()], mode, 110.0f * (i + 1));
+	}
+
+	for (int i = 0; i < m_options.midiChannels; i++)
+		addMidiChannel(trackIndexes[(m_options.sampleChannels + i) % trackIndexes.size()]);
+
+	/* Start the sequencer directly in the model, bypassing Sequencer::start()
+	and its MIDI/JACK side effects. */
+
+	m_model.get().sequencer.status = SeqStatus::RUNNING;
+	m_model.swap(model::SwapType::NONE);
+
+	m_mixer.enable();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench::addSampleChannel(std::size_t trackIndex, PlaybackMode playbackMode, float frequency)
+{
+	const int   sampleRate = m_options.sampleRate;
+	const Frame frames     = m_sequencer.getFramesInLoop();
+	const ID    channelId  = m_channelManager.addChannel(ChannelType::SAMPLE, trackIndex, sampleRate, m_options.bufferSize).id;
+
+	const SampleStorage storage = m_options.storage == "int16" ? SampleStorage::INT16
+	                              : m_options.storage == "half"  ? SampleStorage::HALF
+	                                                             : SampleStorage::FLOAT;
+
+	std::unique_ptr<Wave> w = makeWave_(frames, sampleRate, frequency);
+	waveFactory::setStorage(*w, storage);
+	m_sampleMemory += w->getDataSize();
+
+	Wave& wave = m_model.addWave(std::move(w));
+	m_channelManager.loadSampleChannel(channelId, wave, Scene{0});
+
+	Channel& ch            = m_model.get().tracks.getChannel(channelId);
+	ch.sampleChannel->mode = SamplePlayerMode::LOOP_REPEAT;
+	ch.sampleChannel->setPlaybackMode(playbackMode, Scene{0});
+	ch.sampleChannel->setPitch(m_options.pitch, Scene{0});
+	ch.shared->playStatus.store(ChannelStatus::PLAY);
+	if (!m_options.freeze)
+		ch.shared->freezer.reset();
+
+	m_model.swap(model::SwapType::NONE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench::addMidiChannel(std::size_t trackIndex)
+{
+	const ID channelId = m_channelManager.addChannel(ChannelType::MIDI, trackIndex, m_options.sampleRate, m_options.bufferSize).id;
+
+	/* Evenly spaced notes, each one lasting half of the step. */
+
+	const Tick ticksInLoop = m_sequencer.getTicksInLoop();
+	const int  numActions  = m_sequencer.getTimeSignature().beats * m_options.actionsPerBeat;
+
+	for (int i = 0; i < numActions; i++)
+	{
+		const Tick a = Tick(ticksInLoop.value() * i / numActions);
+		const Tick b = Tick(ticksInLoop.value() * (2 * i + 1) / (2 * numActions));
+		m_actionManager.recordMidiAction(channelId, Scene{0}, /*note=*/36 + i % 48, G_MAX_VELOCITY_FLOAT, {a, b}, ticksInLoop);
+	}
+
+	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	ch.shared->playStatus.store(ChannelStatus::PLAY);
+
+	m_model.swap(model::SwapType::NONE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+ID Bench::addProbeChannel(std::size_t trackIndex)
+{
+	const int sampleRate = m_options.sampleRate;
+	const ID  channelId  = m_channelManager.addChannel(ChannelType::SAMPLE, trackIndex, sampleRate, m_options.bufferSize).id;
+
+	std::unique_ptr<Wave> w = waveFactory::createEmpty(m_options.bufferSize, G_MAX_IO_CHANS, sampleRate, "probe");
+	for (int ch = 0; ch < G_MAX_IO_CHANS; ch++)
+		std::ranges::fill(w->getBuffer().getChannelView(ch), 0.5f);
+
+	Wave& wave = m_model.addWave(std::move(w));
+	m_channelManager.loadSampleChannel(channelId, wave, Scene{0});
+
+	m_model.get().tracks.getChannel(channelId).sampleChannel->mode = SamplePlayerMode::SINGLE_BASIC;
+	m_model.swap(model::SwapType::NONE);
+
+	return channelId;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Results Bench::run()
+{
+	Results results{};
+	results.latencies.reserve(m_options.blocks);
+	results.sampleMemory = m_sampleMemory;
+	results.aliasingDb   = measureAliasing_(getResamplerQuality_(m_options.resampler).value());
+
+	measureSwaps(results);
+
+	std::thread audioThread([this, &results]()
+	{
+		using Clock = std::chrono::steady_clock;
+
+		m_model.registerThread(Thread::AUDIO, /*realtime=*/true);
+
+		mcl::AudioBuffer       out(m_options.bufferSize, G_MAX_IO_CHANS);
+		const mcl::AudioBuffer in; // No audio input
+
+		for (int i = 0; i < m_options.warmupBlocks; i++)
+			m_renderer.render(out, in, m_model);
+
+		const Clock::time_point start = Clock::now();
+
+		for (int i = 0; i < m_options.blocks; i++)
+		{
+			const std::size_t       allocs = allocations_.load(std::memory_order_relaxed);
+			const Clock::time_point t0     = Clock::now();
+
+			m_renderer.render(out, in, m_model);
+
+			const Clock::time_point t1          = Clock::now();
+			const std::size_t       blockAllocs = allocations_.load(std::memory_order_relaxed) - allocs;
+
+			results.allocations += blockAllocs;
+			results.maxAllocationsInBlock = std::max(results.maxAllocationsInBlock, blockAllocs);
+			results.latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+		}
+
+		results.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	});
+
+	audioThread.join();
+
+	/* Silence everything but the probe channel, then measure MIDI latency. */
+
+	const ID probeId = addProbeChannel(std::as_const(m_model).get().tracks.getAll().back().getIndex());
+
+	for (const Channel* ch : std::as_const(m_model).get().tracks.getChannels())
+		if ((ch->type == ChannelType::SAMPLE || ch->type == ChannelType::MIDI) && ch->id != probeId)
+			ch->shared->playStatus.store(ChannelStatus::OFF);
+
+	results.midiPolling  = measureMidiLatency(probeId, /*notify=*/false);
+	results.midiNotified = measureMidiLatency(probeId, /*notify=*/true);
+
+	return results;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench::measureSwaps(Results& results)
+{
+	using Clock = std::chrono::steady_clock;
+
+	/* The group Channel of the last Track: its neighbours are regular Sample and
+	MIDI Channels, which the swap should leave untouched. */
+
+	const ID channelId = m_model.get().tracks.getAll().back().getGroupChannel().id;
+
+	results.swapLatencies.reserve(m_options.swaps);
+
+	for (int i = 0; i < m_options.swaps; i++)
+	{
+		const std::size_t       allocs = allocations_.load(std::memory_order_relaxed);
+		const Clock::time_point t0     = Clock::now();
+
+		m_channelManager.setHeight(channelId, i % 2 == 0 ? G_GUI_UNIT : G_GUI_UNIT * 2);
+
+		const Clock::time_point t1 = Clock::now();
+
+		results.swapAllocations += allocations_.load(std::memory_order_relaxed) - allocs;
+		results.swapLatencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<double> Bench::measureMidiLatency(ID probeId, bool notify)
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int POLLING_RATE_MS = 3;
+
+	const Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+	    std::chrono::duration<double>(static_cast<double>(m_options.bufferSize) / m_options.sampleRate));
+	const ChannelShared& probe = *std::as_const(m_model).get().tracks.getChannel(probeId).shared;
+
+	moodycamel::ConcurrentQueue<Clock::time_point> queue;
+	std::vector<double>                            latencies;
+	std::atomic<bool>                              running = true;
+	std::atomic<bool>                              armed   = false; // Waiting for the probe to be heard
+	std::atomic<bool>                              audible = false; // Last block had some signal
+	std::atomic<Clock::rep>                        heard   = 0;     // When the probe was heard first
+	std::mt19937                                   random(/*seed=*/0);
+	std::uniform_int_distribution<Clock::rep>      interval(period.count(), period.count() * 3);
+
+	latencies.reserve(m_options.midiEvents);
+
+	/* The audio callback, rendering one block per period like a real device. */
+
+	std::thread audioThread([this, period, &running, &armed, &audible, &heard]()
+	{
+		m_model.registerThread(Thread::AUDIO, /*realtime=*/true);
+
+		mcl::AudioBuffer       out(m_options.bufferSize, G_MAX_IO_CHANS);
+		const mcl::AudioBuffer in; // No audio input
+		Clock::time_point      next = Clock::now();
+
+		while (running.load())
+		{
+			std::this_thread::sleep_until(next += period);
+			m_renderer.render(out, in, m_model);
+
+			audible.store(isAudible_(out));
+			if (audible.load() && armed.exchange(false))
+				heard.store(Clock::now().time_since_epoch().count());
+		}
+	});
+
+	/* The MIDI input worker, pressing the probe channel as MidiDispatcher
+	would do for a MIDI-learned key. */
+
+	Worker worker(notify ? G_KERNEL_MIDI_INPUT_RATE_MS : POLLING_RATE_MS);
+	worker.start([this, probeId, &queue]()
+	{
+		m_model.registerThread(Thread::MIDI, /*realtime=*/false);
+
+		Clock::time_point sent;
+		while (queue.try_dequeue(sent))
+			m_reactor.keyPress(probeId, Scene{0}, G_MAX_VELOCITY_FLOAT, /*canRecordActions=*/false,
+			    /*canQuantize=*/false, Tick{});
+	});
+
+	for (int i = 0; i < m_options.midiEvents; i++)
+	{
+		/* Wait for the previous press to be over, then some more: events come at
+		random times with respect to the audio callback. */
+
+		while (probe.playStatus.load() != ChannelStatus::OFF || audible.load())
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		std::this_thread::sleep_for(Clock::duration(interval(random)));
+
+		const Clock::time_point sent = Clock::now();
+
+		heard.store(0);
+		armed.store(true);
+		queue.enqueue(sent);
+		if (notify)
+			worker.notify();
+
+		while (heard.load() == 0)
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+		const Clock::time_point received{Clock::duration(heard.load())};
+		latencies.push_back(std::chrono::duration<double, std::micro>(received - sent).count());
+	}
+
+	worker.stop();
+	running.store(false);
+	audioThread.join();
+
+	return latencies;
+}
+
+/* -------------------------------------------------------------------------- */
+
+nlohmann::json toJson_(const Options& o, Results r)
+{
+	std::sort(r.latencies.begin(), r.latencies.end());
+	std::sort(r.swapLatencies.begin(), r.swapLatencies.end());
+	std::sort(r.midiPolling.begin(), r.midiPolling.end());
+	std::sort(r.midiNotified.begin(), r.midiNotified.end());
+
+	const double blocks     = static_cast<double>(o.blocks);
+	const double deadlineUs = 1000000.0 * o.bufferSize / o.sampleRate;
+
+	nlohmann::json j;
+
+	j["config"]["sample_channels"]  = o.sampleChannels;
+	j["config"]["midi_channels"]    = o.midiChannels;
+	j["config"]["mode"]             = o.mode;
+	j["config"]["pitch"]            = o.pitch;
+	j["config"]["storage"]          = o.storage;
+	j["config"]["resampler"]        = o.resampler;
+	j["config"]["freeze"]           = o.freeze;
+	j["config"]["actions_per_beat"] = o.actionsPerBeat;
+	j["config"]["blocks"]           = o.blocks;
+	j["config"]["swaps"]            = o.swaps;
+	j["config"]["midi_events"]      = o.midiEvents;
+	j["config"]["buffer_size"]      = o.bufferSize;
+	j["config"]["sample_rate"]      = o.sampleRate;
+	j["config"]["render_threads"]   = o.renderThreads;
+
+	j["results"]["blocks_per_second"]        = blocks / r.seconds;
+	j["results"]["realtime_factor"]          = (blocks * deadlineUs / 1000000.0) / r.seconds;
+	j["results"]["deadline_us"]              = deadlineUs;
+	j["results"]["latency_us"]["p50"]        = percentile_(r.latencies, 0.50);
+	j["results"]["latency_us"]["p99"]        = percentile_(r.latencies, 0.99);
+	j["results"]["latency_us"]["max"]        = r.latencies.back();
+	j["results"]["allocations_per_block"]    = r.allocations / blocks;
+	j["results"]["max_allocations_in_block"] = r.maxAllocationsInBlock;
+	j["results"]["sample_memory_bytes"]      = r.sampleMemory;
+	j["results"]["resampler_aliasing_db"]    = r.aliasingDb;
+	j["results"]["swap_us"]["p50"]           = percentile_(r.swapLatencies, 0.50);
+	j["results"]["swap_us"]["p99"]           = percentile_(r.swapLatencies, 0.99);
+	j["results"]["swap_us"]["max"]           = r.swapLatencies.back();
+	j["results"]["allocations_per_swap"]     = r.swapAllocations / static_cast<double>(o.swaps);
+
+	j["results"]["midi_in_to_audio_out_us"]["polling"]  = toHistogramJson_(r.midiPolling);
+	j["results"]["midi_in_to_audio_out_us"]["notified"] = toHistogramJson_(r.midiNotified);
+
+	return j;
+}
+} // namespace
+} // namespace giada::m
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char** argv)
+{
+	using namespace giada;
+
+	m::Options options;
+	if (!m::parseOptions_(argc, argv, options))
+	{
+		m::printUsage_();
+		return EXIT_FAILURE;
+	}
+
+	m::Bench bench(options);
+	bench.setup();
+
+	const nlohmann::json json = m::toJson_(options, bench.run());
+
+	if (options.output.empty())
+	{
+		std::cout << json.dump(4) << "\n";
+		return EXIT_SUCCESS;
+	}
+
+	std::ofstream file(options.output);
+	if (!file.is_open())
+	{
+		std::cerr << "Unable to open " << options.output << " for writing\n";
+		return EXIT_FAILURE;
+	}
+	file << json.dump(4) << "\n";
+
+	return EXIT_SUCCESS;
+}
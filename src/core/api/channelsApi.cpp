@@ -31,6 +31,7 @@
 #include "src/core/midiSynchronizer.h"
 #include "src/core/mixer.h"
 #include "src/utils/fs.h"
+#include <utility>
 
 namespace giada::m
 {
@@ -73,16 +74,16 @@ bool ChannelsApi::hasActions(ID channelId) const
 
 /* -------------------------------------------------------------------------- */
 
-Channel& ChannelsApi::get(ID channelId)
+const Channel& ChannelsApi::get(ID channelId) const
 {
-	return m_channelManager.getChannel(channelId);
+	return std::as_const(m_channelManager).getChannel(channelId);
 }
 
 /* -------------------------------------------------------------------------- */
 
-model::Tracks& ChannelsApi::getTracks()
+const model::Tracks& ChannelsApi::getTracks() const
 {
-	return m_model.get().tracks;
+	return std::as_const(m_model).get().tracks;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -128,10 +129,12 @@ void ChannelsApi::move(ID channelId, std::size_t newTrackIndex, std::size_t newP
 
 int ChannelsApi::loadSampleChannel(ID channelId, const std::string& filePath)
 {
-	const Scene              scene       = m_sequencer.getCurrentScene();
-	const int                sampleRate  = m_kernelAudio.getSampleRate();
-	const Resampler::Quality rsmpQuality = m_model.get().kernelAudio.rsmpQuality;
-	return m_channelManager.loadSampleChannel(channelId, filePath, sampleRate, rsmpQuality, scene);
+	const Scene              scene           = m_sequencer.getCurrentScene();
+	const int                sampleRate      = m_kernelAudio.getSampleRate();
+	const Resampler::Quality rsmpQuality     = m_model.get().kernelAudio.rsmpQuality;
+	const Frame              streamThreshold = m_model.get().kernelAudio.streamThreshold * sampleRate;
+	const SampleStorage      storage         = m_model.get().kernelAudio.sampleStorage;
+	return m_channelManager.loadSampleChannel(channelId, filePath, sampleRate, rsmpQuality, streamThreshold, storage, scene);
 }
 
 void ChannelsApi::loadSampleChannel(ID channelId, Wave& wave)
@@ -141,9 +144,16 @@ void ChannelsApi::loadSampleChannel(ID channelId, Wave& wave)
 
 /* -------------------------------------------------------------------------- */
 
+int ChannelsApi::setSampleStorage(ID channelId, SampleStorage storage)
+{
+	return m_channelManager.setSampleStorage(channelId, storage, m_sequencer.getCurrentScene());
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelsApi::remove(ID channelId)
 {
-	const std::vector<Plugin*> plugins  = m_channelManager.getChannel(channelId).plugins;
+	const std::vector<Plugin*> plugins  = get(channelId).plugins;
 	const bool                 hasSolos = m_channelManager.hasSolos();
 	std::vector<ID>            pluginIds;
 	for (const Plugin* p : plugins)
@@ -154,7 +164,7 @@ void ChannelsApi::remove(ID channelId)
 	m_mixer.updateSoloCount(hasSolos);
 
 	/* Plug-in destruction must be done in the main thread, due to JUCE and
-	VST3 internal workings. */
+	VST3 internal workings: they are freed later on by Model::collectPlugins(). */
 
 	m_pluginHost.freePlugins(pluginIds);
 }
@@ -174,7 +184,7 @@ void ChannelsApi::clone(ID channelId)
 	/* Plug-in cloning must be done in the main thread, due to JUCE and VST3
 	internal workings. */
 
-	const Channel&             ch            = m_channelManager.getChannel(channelId);
+	const Channel&             ch            = get(channelId);
 	const Scene                scene         = m_sequencer.getCurrentScene();
 	const int                  bufferSize    = m_kernelAudio.getBufferSize();
 	const int                  sampleRate    = m_kernelAudio.getSampleRate();
@@ -189,7 +199,7 @@ void ChannelsApi::clone(ID channelId)
 
 void ChannelsApi::copyToScene(ID channelId, Scene dstScene)
 {
-	const Channel& ch       = m_channelManager.getChannel(channelId);
+	const Channel& ch       = get(channelId);
 	const Scene    srcScene = m_sequencer.getCurrentScene();
 
 	if (ch.type == ChannelType::GROUP)
@@ -72,8 +72,8 @@ public:
 	bool canRemoveTrack(std::size_t trackIndex) const;
 	bool hasActions(ID channelId) const;
 
-	Channel&       get(ID);
-	model::Tracks& getTracks();
+	const Channel&       get(ID) const;
+	const model::Tracks& getTracks() const;
 
 	void     addTrack();
 	void     removeTrack(std::size_t trackIndex);
@@ -82,6 +82,7 @@ public:
 	void     move(ID, std::size_t newTrackIndex, std::size_t newPosition);
 	int      loadSampleChannel(ID channelId, const std::string& filePath);
 	void     loadSampleChannel(ID channelId, Wave&);
+	int      setSampleStorage(ID channelId, SampleStorage);
 	void     remove(ID);
 	void     freeSampleChannel(ID, bool allScenes);
 	void     clone(ID);
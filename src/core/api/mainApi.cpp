@@ -26,16 +26,20 @@
 
 #include "src/core/api/mainApi.h"
 #include "src/core/channels/channelManager.h"
+#include "src/core/diskStream.h"
 #include "src/core/engine.h"
 #include "src/core/kernelAudio.h"
 #include "src/core/midiSynchronizer.h"
 #include "src/core/mixer.h"
+#include "src/core/model/model.h"
+#include "src/core/stretchStream.h"
 
 namespace giada::m
 {
-MainApi::MainApi(KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms,
+MainApi::MainApi(model::Model& model, KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms,
     ChannelManager& cm, Recorder& r, ActionManager& am, rendering::Reactor& re)
-: m_kernelAudio(ka)
+: m_model(model)
+, m_kernelAudio(ka)
 , m_mixer(m)
 , m_sequencer(s)
 , m_midiSynchronizer(ms)
@@ -128,6 +132,26 @@ double MainApi::getCpuLoad() const { return m_kernelAudio.getCpuLoad(); }
 
 /* -------------------------------------------------------------------------- */
 
+DspLoad::Value MainApi::getDspLoad(const DspLoad& d) const
+{
+	return d.get(m_kernelAudio.getBufferSize(), m_kernelAudio.getSampleRate());
+}
+
+DspLoad::Value MainApi::getMixerDspLoad() const { return getDspLoad(m_mixer.getDspLoad()); }
+
+/* -------------------------------------------------------------------------- */
+
+int MainApi::getStreamUnderruns() const
+{
+	return DiskStream::getTotalUnderruns() + StretchStream::getTotalUnderruns();
+}
+
+/* -------------------------------------------------------------------------- */
+
+model::Reclaimer::Stats MainApi::getPendingDeletions() const { return m_model.getReclaimerStats(); }
+
+/* -------------------------------------------------------------------------- */
+
 Mixer::RecordInfo MainApi::getRecordInfo() const
 {
 	return m_mixer.getRecordInfo();
@@ -384,4 +408,11 @@ void MainApi::copyCurrentScene(Scene dstScene)
 	m_channelManager.copyAllChannelsToScene(srcScene, dstScene);
 	m_actionManager.copyAllActionsToScene(srcScene, dstScene);
 }
+
+/* -------------------------------------------------------------------------- */
+
+void MainApi::collectPlugins()
+{
+	m_model.collectPlugins();
+}
 } // namespace giada::m
@@ -28,12 +28,18 @@
 #define G_MAIN_API_H
 
 #include "src/core/mixer.h"
+#include "src/core/model/reclaimer.h"
 
 namespace giada::m::rendering
 {
 class Reactor;
 }
 
+namespace giada::m::model
+{
+class Model;
+}
+
 namespace giada::m
 {
 class Engine;
@@ -46,7 +52,7 @@ class ActionManager;
 class MainApi
 {
 public:
-	MainApi(KernelAudio&, Mixer&, Sequencer&, MidiSynchronizer&, ChannelManager&, Recorder&,
+	MainApi(model::Model&, KernelAudio&, Mixer&, Sequencer&, MidiSynchronizer&, ChannelManager&, Recorder&,
 	    ActionManager&, rendering::Reactor&);
 
 	bool              isRecordingInput() const;
@@ -62,6 +68,9 @@ public:
 	Peak              getPeakOut() const;
 	Peak              getPeakIn() const;
 	double            getCpuLoad() const;
+	DspLoad::Value    getDspLoad(const DspLoad&) const;
+	DspLoad::Value    getMixerDspLoad() const;
+	int               getStreamUnderruns() const;
 	Mixer::RecordInfo getRecordInfo() const;
 	TimeSignature     getTimeSignature() const;
 	float             getBpm() const;
@@ -83,6 +92,11 @@ public:
 	SceneStatus       getSceneStatus() const;
 	bool              isSceneActive(Scene) const; // If scene has actions or samples in it
 
+	/* getPendingDeletions
+	Returns how much removed data (Waves, Plugins, ...) is waiting to be freed. */
+
+	model::Reclaimer::Stats getPendingDeletions() const;
+
 	void toggleMetronome();
 	void setMasterInVolume(float);
 	void setMasterOutVolume(float);
@@ -107,7 +121,14 @@ public:
 	void setScene(Scene, bool forced);
 	void copyCurrentScene(Scene dst);
 
+	/* collectPlugins
+	Frees the Plugins removed in the meantime, once the audio thread is done
+	with them. Main thread only: call it periodically. */
+
+	void collectPlugins();
+
 private:
+	model::Model&       m_model;
 	KernelAudio&        m_kernelAudio;
 	Mixer&              m_mixer;
 	Sequencer&          m_sequencer;
@@ -32,6 +32,7 @@
 #include "src/core/waveFactory.h"
 #include "src/core/waveFx.h"
 #include "src/utils/log.h"
+#include <utility>
 
 namespace giada::m
 {
@@ -93,14 +94,14 @@ void SampleEditorApi::togglePreview()
 
 Frame SampleEditorApi::getPreviewTracker()
 {
-	return m_channelManager.getChannel(PREVIEW_CHANNEL_ID).shared->tracker.load();
+	return std::as_const(m_channelManager).getChannel(PREVIEW_CHANNEL_ID).shared->tracker.load();
 }
 
 /* -------------------------------------------------------------------------- */
 
 ChannelStatus SampleEditorApi::getPreviewStatus()
 {
-	return m_channelManager.getChannel(PREVIEW_CHANNEL_ID).shared->playStatus.load();
+	return std::as_const(m_channelManager).getChannel(PREVIEW_CHANNEL_ID).shared->playStatus.load();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -208,7 +209,7 @@ void SampleEditorApi::trim(ID channelId, Frame a, Frame b)
 
 void SampleEditorApi::shift(ID channelId, Frame offset)
 {
-	const Channel& ch       = m_channelManager.getChannel(channelId);
+	const Channel& ch       = std::as_const(m_channelManager).getChannel(channelId);
 	const Scene    scene    = m_sequencer.getCurrentScene();
 	const Frame    oldShift = ch.sampleChannel->getShift(scene);
 
@@ -251,15 +252,37 @@ void SampleEditorApi::reload(ID channelId)
 	const int                sampleRate  = m_kernelAudio.getSampleRate();
 	const Resampler::Quality rsmpQuality = m_model.get().kernelAudio.rsmpQuality;
 	// TODO - error checking
-	m_channelManager.loadSampleChannel(channelId, getWave(channelId).getPath(), sampleRate, rsmpQuality, Scene{0});
+	m_channelManager.loadSampleChannel(channelId, getWave(channelId).getPath(), sampleRate, rsmpQuality, /*streamThreshold=*/0, SampleStorage::FLOAT, Scene{0});
 	loadPreviewChannel(channelId); // Refresh preview channel properties
 }
 
 /* -------------------------------------------------------------------------- */
 
+int SampleEditorApi::makeResident(ID channelId)
+{
+	/* The Sample Editor reads and edits the whole Wave in memory: streamed Waves
+	must be fully loaded first. */
+
+	const int                sampleRate  = m_kernelAudio.getSampleRate();
+	const Resampler::Quality rsmpQuality = m_model.get().kernelAudio.rsmpQuality;
+	const int                res         = m_channelManager.makeSampleResident(channelId, sampleRate, rsmpQuality, m_sequencer.getCurrentScene());
+	if (res != G_RES_OK)
+		return res;
+
+	/* Peaks saved with the project are read only now, when actually needed by
+	the waveform display. */
+
+	Wave* wave = std::as_const(m_channelManager).getChannel(channelId).sampleChannel->getWave(m_sequencer.getCurrentScene());
+	if (wave != nullptr)
+		wave->loadPeaks();
+	return G_RES_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+
 Wave& SampleEditorApi::getWave(ID channelId) const
 {
 	const Scene currentScene = m_sequencer.getCurrentScene();
-	return *m_channelManager.getChannel(channelId).sampleChannel->getWave(currentScene);
+	return *std::as_const(m_channelManager).getChannel(channelId).sampleChannel->getWave(currentScene);
 }
 } // namespace giada::m
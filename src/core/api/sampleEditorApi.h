@@ -70,6 +70,7 @@ public:
 	void           setRange(ID channelId, FrameRange);
 	void           resetRange(ID channelId);
 	void           reload(ID channelId);
+	int            makeResident(ID channelId);
 
 private:
 	Wave& getWave(ID channelId) const;
@@ -41,7 +41,7 @@ namespace utils = mcl::utils;
 namespace giada::m
 {
 StorageApi::StorageApi(Engine& e, model::Model& m, PluginManager& pm, MidiSynchronizer& ms,
-    Mixer& mx, ChannelManager& cm, KernelAudio& ka, Sequencer& s)
+    Mixer& mx, ChannelManager& cm, KernelAudio& ka, Sequencer& s, Bouncer& b)
 : m_engine(e)
 , m_model(m)
 , m_pluginManager(pm)
@@ -50,6 +50,7 @@ StorageApi::StorageApi(Engine& e, model::Model& m, PluginManager& pm, MidiSynchr
 , m_channelManager(cm)
 , m_kernelAudio(ka)
 , m_sequencer(s)
+, m_bouncer(b)
 {
 }
 
@@ -119,15 +120,22 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, std::fu
 	m_mixer.disable();
 	m_engine.reset();
 
-	/* Load the patch into Model. */
+	/* Load the patch into Model. Wave decoding takes most of the time here:
+	map its progress to the [0.3, 0.6] range. */
 
-	const int                sampleRate  = m_kernelAudio.getSampleRate();
-	const int                bufferSize  = m_kernelAudio.getBufferSize();
-	const Resampler::Quality rsmpQuality = m_kernelAudio.getResamplerQuality();
-	const model::LoadState   state       = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality);
+	const int                sampleRate   = m_kernelAudio.getSampleRate();
+	const int                bufferSize   = m_kernelAudio.getBufferSize();
+	const Resampler::Quality rsmpQuality  = m_kernelAudio.getResamplerQuality();
+	const auto               loadProgress = [&progress](float v)
+	{ progress(0.3f + v * 0.3f); };
+	const model::LoadState   state        = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality, loadProgress);
 
 	progress(0.6f);
 
+	const pcmCache::Stats cacheStats = getPcmCacheStats();
+	u::log::print("[StorageApi::loadProject] PCM cache: {} hits, {} misses ({:.0f}%), {} bytes saved\n",
+	    cacheStats.hits, cacheStats.misses, cacheStats.getHitRate() * 100.0f, cacheStats.bytesSaved);
+
 	/* Prepare the engine. Recorder has to recompute the actions positions if
 	the current samplerate != patch samplerate. Clock needs to update frames
 	in sequencer. */
@@ -149,4 +157,27 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, std::fu
 
 	return state;
 }
+
+/* -------------------------------------------------------------------------- */
+
+int StorageApi::bounce(const Bouncer::Options& options, std::function<void(float)> progress)
+{
+	if (m_mixer.isRecordingInput() || m_mixer.isRecordingActions())
+	{
+		u::log::print("[StorageApi::bounce] Can't bounce while recording!\n");
+		return G_RES_ERR;
+	}
+
+	const int bufferSize = m_kernelAudio.getBufferSize();
+	const int sampleRate = m_kernelAudio.getSampleRate();
+
+	return m_bouncer.bounce(options, bufferSize, sampleRate, progress);
+}
+
+/* -------------------------------------------------------------------------- */
+
+pcmCache::Stats StorageApi::getPcmCacheStats() const
+{
+	return pcmCache::getStats();
+}
 } // namespace giada::m
@@ -27,7 +27,9 @@
 #ifndef G_STORAGE_API_H
 #define G_STORAGE_API_H
 
+#include "src/core/bouncer.h"
 #include "src/core/model/model.h"
+#include "src/core/pcmCache.h"
 #include "src/core/types.h"
 #include "src/gui/model.h"
 #include <functional>
@@ -47,7 +49,7 @@ class StorageApi
 {
 public:
 	StorageApi(Engine&, model::Model&, PluginManager&, MidiSynchronizer&,
-	    Mixer&, ChannelManager&, KernelAudio&, Sequencer&);
+	    Mixer&, ChannelManager&, KernelAudio&, Sequencer&, Bouncer&);
 
 	/* storeProject
 	Saves the current project. Returns true on success. */
@@ -61,6 +63,17 @@ public:
 
 	model::LoadState loadProject(const std::string& projectPath, std::function<void(float)> progress);
 
+	/* bounce
+	Renders the current project offline to a wave file (plus optional stems).
+	Not allowed while recording. Returns a G_RES_* code. */
+
+	int bounce(const Bouncer::Options&, std::function<void(float)> progress);
+
+	/* getPcmCacheStats
+	Returns hit rate and bytes saved by the decoded audio cache. */
+
+	pcmCache::Stats getPcmCacheStats() const;
+
 private:
 	Engine&           m_engine;
 	model::Model&     m_model;
@@ -70,6 +83,7 @@ private:
 	ChannelManager&   m_channelManager;
 	KernelAudio&      m_kernelAudio;
 	Sequencer&        m_sequencer;
+	Bouncer&          m_bouncer;
 };
 } // namespace giada::m
 
@@ -0,0 +1,277 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/bouncer.h"
+#include "src/core/channels/channel.h"
+#include "src/core/channels/channelManager.h"
+#include "src/core/const.h"
+#include "src/core/diskStream.h"
+#include "src/core/mixer.h"
+#include "src/core/model/model.h"
+#include "src/core/plugins/pluginHost.h"
+#include "src/core/rendering/renderer.h"
+#include "src/core/sequencer.h"
+#include "src/core/simd.h"
+#include "src/core/stretchStream.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/deps/mcl-utils/src/fs.hpp"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <fmt/core.h>
+#include <memory>
+#include <sndfile.h>
+#include <vector>
+
+namespace utils = mcl::utils;
+
+namespace giada::m
+{
+namespace
+{
+/* WaveWriter
+Streams planar audio blocks to a 32-bit float wave file. Libsndfile wants
+interleaved frames, so each block is interleaved into a scratch buffer first. */
+
+class WaveWriter
+{
+public:
+	WaveWriter(const std::string& path, int channels, int sampleRate)
+	: m_channels(channels)
+	{
+		SF_INFO header;
+		header.samplerate = sampleRate;
+		header.channels   = channels;
+		header.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+		m_file = sf_open(path.c_str(), SFM_WRITE, &header);
+		if (m_file == nullptr)
+			u::log::print("[Bouncer] unable to open {} for writing: {}\n", path, sf_strerror(m_file));
+	}
+
+	WaveWriter(const WaveWriter&)            = delete;
+	WaveWriter& operator=(const WaveWriter&) = delete;
+
+	~WaveWriter()
+	{
+		if (m_file != nullptr)
+			sf_close(m_file);
+	}
+
+	bool isOpen() const { return m_file != nullptr; }
+
+	/* write
+	Writes the first 'frames' frames of the given buffer. Returns false on I/O
+	errors. */
+
+	bool write(const mcl::AudioBuffer& buf, Frame frames)
+	{
+		m_interleaved.resize(frames * m_channels);
+		for (int ch = 0; ch < m_channels; ch++)
+		{
+			const float* src = buf.getChannelView(ch).data();
+			for (Frame i = 0; i < frames; i++)
+				m_interleaved[i * m_channels + ch] = src[i];
+		}
+		return sf_writef_float(m_file, m_interleaved.data(), frames) == frames;
+	}
+
+private:
+	SNDFILE*           m_file;
+	int                m_channels;
+	std::vector<float> m_interleaved;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* Stem
+A single Channel to be written to its own file, alongside the master output. */
+
+struct Stem
+{
+	ID                          channelId;
+	std::unique_ptr<WaveWriter> writer;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* makeStems_
+Returns the list of stems to write, according to the Stems option. Internal
+Tracks (master i/o, preview) are never part of it. */
+
+std::vector<Stem> makeStems_(const model::Tracks& tracks, const Bouncer::Options& options, int sampleRate)
+{
+	const std::string basePath = utils::fs::stripExt(options.path);
+	std::vector<Stem> stems;
+
+	for (const model::Track& track : tracks.getAll())
+	{
+		if (track.isInternal())
+			continue;
+
+		if (options.stems == Bouncer::Stems::TRACKS)
+		{
+			const std::string path = fmt::format("{}-track{}.wav", basePath, track.getIndex());
+			stems.push_back({track.getGroupChannel().id, std::make_unique<WaveWriter>(path, G_MAX_IO_CHANS, sampleRate)});
+		}
+		else if (options.stems == Bouncer::Stems::CHANNELS)
+		{
+			for (const Channel& c : track.getChannels().getAll())
+			{
+				if (c.type == ChannelType::GROUP)
+					continue;
+				const std::string path = fmt::format("{}-channel{}.wav", basePath, c.id.getValue());
+				stems.push_back({c.id, std::make_unique<WaveWriter>(path, G_MAX_IO_CHANS, sampleRate)});
+			}
+		}
+	}
+
+	return stems;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* mixStem_
+Fills 'out' with the post-fader signal of the given Channel, i.e. what the
+Channel sends to its Track or to the master output. */
+
+void mixStem_(const Channel& ch, bool hasSolos, mcl::AudioBuffer& out)
+{
+	out.clear();
+
+	if (ch.shared->silent || !ch.isAudible(hasSolos))
+		return;
+
+	const mcl::AudioBuffer& buf  = ch.shared->audioBuffer;
+	const Pan::Type         pan  = ch.pan.get();
+	const float             gain = ch.volume * ch.shared->volumeInternal.load();
+
+	for (int i = 0; i < buf.countChannels() && i < out.countChannels(); i++)
+		simd::sum(out.getChannelView(i).data(), buf.getChannelView(i).data(), buf.countFrames(), gain * pan[i]);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Bouncer::Bouncer(model::Model& m, rendering::Renderer& r, Mixer& mx, PluginHost& ph, Sequencer& s, ChannelManager& cm)
+: m_model(m)
+, m_renderer(r)
+, m_mixer(mx)
+, m_pluginHost(ph)
+, m_sequencer(s)
+, m_channelManager(cm)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+int Bouncer::bounce(const Options& options, int bufferSize, int sampleRate, std::function<void(float)> progress)
+{
+	progress(0.0f);
+
+	const Frame length = m_model.get().sequencer.getFramesInLoop(sampleRate) * std::max(options.loops, 1);
+
+	if (length <= 0)
+		return G_RES_ERR_NO_DATA;
+
+	WaveWriter        master(options.path, G_MAX_IO_CHANS, sampleRate);
+	std::vector<Stem> stems = makeStems_(m_model.get().tracks, options, sampleRate);
+
+	if (!master.isOpen() || std::any_of(stems.begin(), stems.end(), [](const Stem& s)
+	                            { return !s.writer->isOpen(); }))
+		return G_RES_ERR_IO;
+
+	u::log::print("[Bouncer::bounce] Bouncing {} frames to {}, {} stems\n", length, options.path, stems.size());
+
+	/* Take the audio thread out of the picture: from now on this thread is the
+	only one rendering. Save the sequencer and channels state, so that it can be
+	restored once done. Channels start from scratch: anything playing right now
+	is stopped and rewound. */
+
+	m_mixer.disable();
+	m_pluginHost.setNonRealtime(true);
+	DiskStream::setNonRealtime(true);
+	StretchStream::setNonRealtime(true);
+
+	const Sequencer::State                       seqState     = m_sequencer.getState();
+	const std::vector<ChannelManager::PlayState> channelState = m_channelManager.getPlayState();
+	const Scene                                  scene        = options.scene.value_or(seqState.currentScene);
+
+	m_channelManager.resetPlayState(scene);
+	m_sequencer.setState({.status = SeqStatus::RUNNING, .currentFrame = 0, .currentScene = scene, .nextScene = scene}, sampleRate);
+
+	/* Render block by block. The last block is rendered in full but only the
+	frames within 'length' are written to disk. */
+
+	mcl::AudioBuffer out(bufferSize, G_MAX_IO_CHANS);
+	mcl::AudioBuffer mix(bufferSize, G_MAX_IO_CHANS);
+	int              res = G_RES_OK;
+
+	for (Frame frame = 0, block = 0; frame < length && res == G_RES_OK; frame += bufferSize, block++)
+	{
+		const Frame frames = std::min<Frame>(bufferSize, length - frame);
+
+		m_renderer.renderOffline(out, m_model);
+
+		const model::Document& document  = m_model.get();
+		const Channel&         masterOut = document.tracks.getChannel(MASTER_OUT_CHANNEL_ID);
+
+		mixStem_(masterOut, document.mixer.hasSolos, mix);
+		m_mixer.finalizeOutput(document.mixer, mix, /*inToOut=*/false, document.kernelAudio.limitOutput, masterOut.volume, masterOut.volume);
+		if (!master.write(mix, frames))
+			res = G_RES_ERR_IO;
+
+		for (Stem& stem : stems)
+		{
+			mixStem_(document.tracks.getChannel(stem.channelId), document.mixer.hasSolos, mix);
+			if (!stem.writer->write(mix, frames))
+				res = G_RES_ERR_IO;
+		}
+
+		if (block % 64 == 0)
+			progress(static_cast<float>(frame) / length);
+	}
+
+	/* Bring everything back online. */
+
+	m_sequencer.setState(seqState, sampleRate);
+	m_channelManager.setPlayState(channelState);
+
+	DiskStream::setNonRealtime(false);
+	StretchStream::setNonRealtime(false);
+	m_pluginHost.setNonRealtime(false);
+	m_mixer.enable();
+
+	if (res != G_RES_OK)
+		u::log::print("[Bouncer::bounce] I/O error while writing to disk!\n");
+
+	progress(1.0f);
+
+	return res;
+}
+} // namespace giada::m
@@ -0,0 +1,93 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_BOUNCER_H
+#define G_BOUNCER_H
+
+#include "src/scene.h"
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace giada::m::model
+{
+class Model;
+}
+
+namespace giada::m::rendering
+{
+class Renderer;
+}
+
+namespace giada::m
+{
+class Mixer;
+class PluginHost;
+class Sequencer;
+class ChannelManager;
+class Bouncer
+{
+public:
+	enum class Stems
+	{
+		NONE,     // Master output only
+		TRACKS,   // Master output + one file per Track
+		CHANNELS, // Master output + one file per Channel
+	};
+
+	struct Options
+	{
+		std::string          path;
+		int                  loops = 1;
+		Stems                stems = Stems::NONE;
+		std::optional<Scene> scene;
+	};
+
+	Bouncer(model::Model&, rendering::Renderer&, Mixer&, PluginHost&, Sequencer&, ChannelManager&);
+
+	/* bounce
+	Renders 'loops' sequencer loops to disk, as fast as the CPU allows. The
+	realtime Mixer is disabled and plug-ins are switched to non-realtime mode for
+	the whole operation. The sequencer is rewound and run from the beginning,
+	with all channels stopped; both are brought back to their original state
+	once done. Stems, if requested, are written next to the master file. Driven
+	by the UI or, for batch exports, by `giada --bounce` (see init::bounce()).
+	Returns a G_RES_* code. */
+
+	int bounce(const Options&, int bufferSize, int sampleRate, std::function<void(float)> progress);
+
+private:
+	model::Model&        m_model;
+	rendering::Renderer& m_renderer;
+	Mixer&               m_mixer;
+	PluginHost&          m_pluginHost;
+	Sequencer&           m_sequencer;
+	ChannelManager&      m_channelManager;
+};
+} // namespace giada::m
+
+#endif
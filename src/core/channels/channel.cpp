@@ -142,9 +142,13 @@ bool Channel::canInputRec(Scene scene) const
 	if (type != ChannelType::SAMPLE)
 		return false;
 
+	/* Streamed Waves live mostly on disk, compact ones are stored in 16 bit:
+	only fully resident Waves can be overdubbed. */
+
 	bool hasWave     = sampleChannel->hasWave(scene);
 	bool isProtected = sampleChannel->overdubProtection;
-	bool canOverdub  = !hasWave || (hasWave && !isProtected);
+	bool isResident  = hasWave && sampleChannel->getWave(scene)->isResident();
+	bool canOverdub  = !hasWave || (hasWave && !isProtected && isResident);
 
 	return armed && canOverdub;
 }
@@ -27,6 +27,7 @@
 #include "src/core/channels/channelFactory.h"
 #include "src/core/channels/channel.h"
 #include "src/core/conf.h"
+#include "src/core/loadGovernor.h"
 #include "src/core/model/model.h"
 #include "src/core/patch.h"
 #include "src/core/plugins/plugin.h"
@@ -55,8 +56,10 @@ std::unique_ptr<ChannelShared> makeShared_(ChannelType type, ID channelId, int s
 	{
 		shared->quantizer.emplace();
 		shared->renderQueue.emplace(/*size=*/2, 0, /*num_threads=*/2);
-		shared->resampler.emplace(quality);
-		shared->stretcher.emplace(sampleRate);
+		shared->resampler.emplace(quality, LoadGovernor::getFallbackQuality(quality));
+		shared->compactWindow.emplace(G_COMPACT_WINDOW_FRAMES, G_MAX_IO_CHANS);
+		shared->freezer       = std::make_shared<Freezer>(quality, sampleRate);
+		shared->stretchStream = std::make_unique<StretchStream>();
 	}
 
 	return shared;
@@ -105,6 +108,8 @@ Data create(const Channel& o, int sampleRate, int bufferSize, Resampler::Quality
 	ch.id     = channelId_.generate();
 	ch.shared = shared.get();
 
+	shared->params.reset(ch.volume, ch.pan.asFloat());
+
 	return {ch, std::move(shared)};
 }
 
@@ -122,7 +127,9 @@ Channel deserializeChannel(const Patch::Channel& pch, ChannelShared& shared, flo
 std::unique_ptr<ChannelShared> deserializeShared(const Patch::Channel& pch, int sampleRate,
     int bufferSize, Resampler::Quality quality)
 {
-	return makeShared_(pch.type, pch.id, sampleRate, bufferSize, quality);
+	std::unique_ptr<ChannelShared> shared = makeShared_(pch.type, pch.id, sampleRate, bufferSize, quality);
+	shared->params.reset(pch.volume, pch.pan);
+	return shared;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -37,6 +37,8 @@
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/deps/mcl-utils/src/container.hpp"
 #include "src/utils/log.h"
+#include <algorithm>
+#include <utility>
 
 namespace utils = mcl::utils;
 
@@ -46,6 +48,20 @@ namespace
 {
 constexpr int Q_ACTION_PLAY   = 0;
 constexpr int Q_ACTION_REWIND = 10000; // Avoid clash with Q_ACTION_PLAY + channelId
+
+/* -------------------------------------------------------------------------- */
+
+/* dropRenderQueue_
+Discards render requests not yet consumed by the audio thread, if any. */
+
+void dropRenderQueue_(ChannelShared& shared)
+{
+	if (!shared.renderQueue)
+		return;
+	rendering::RenderInfo info;
+	while (shared.renderQueue->try_dequeue(info))
+		;
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -66,6 +82,11 @@ Channel& ChannelManager::getChannel(ID channelId)
 	return m_model.get().tracks.getChannel(channelId);
 }
 
+const Channel& ChannelManager::getChannel(ID channelId) const
+{
+	return std::as_const(m_model).get().tracks.getChannel(channelId);
+}
+
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::reset(int sampleRate, Frame framesInBuffer)
@@ -131,11 +152,17 @@ void ChannelManager::removeTrack(std::size_t trackIndex)
 {
 	assert(canRemoveTrack(trackIndex));
 
-	const Channel& ch = m_model.get().tracks.get(trackIndex).getGroupChannel();
+	const ChannelShared& shared = *std::as_const(m_model).get().tracks.get(trackIndex).getGroupChannel().shared;
+
+	/* Detach the channel from the Document first: shared data can be removed
+	only when nothing points to it anymore (see Model::removeChannelShared()).
+	Everything is published with a single swap. */
+
+	const model::Transaction transaction = m_model.beginTransaction();
 
-	m_model.removeChannelShared(*ch.shared);
 	m_model.get().tracks.remove(trackIndex);
 	m_model.swap(model::SwapType::HARD);
+	m_model.removeChannelShared(shared);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -171,12 +198,15 @@ Channel& ChannelManager::addChannel(ChannelType type, std::size_t trackIndex,
 /* -------------------------------------------------------------------------- */
 
 int ChannelManager::loadSampleChannel(ID channelId, const std::string& fname, int sampleRate,
-    Resampler::Quality quality, Scene scene)
+    Resampler::Quality quality, Frame streamThreshold, SampleStorage storage, Scene scene)
 {
-	waveFactory::Result res = waveFactory::createFromFile(fname, /*id=*/{}, sampleRate, quality);
+	waveFactory::Result res = waveFactory::createFromFile(fname, /*id=*/{}, sampleRate, quality, streamThreshold);
 	if (res.status != G_RES_OK)
 		return res.status;
 
+	if (!res.wave->isStreamed())
+		waveFactory::setStorage(*res.wave, storage);
+
 	loadSampleChannel(channelId, m_model.addWave(std::move(res.wave)), scene);
 
 	return G_RES_OK;
@@ -193,8 +223,8 @@ void ChannelManager::loadSampleChannel(ID channelId, Wave& wave, Scene scene)
 	loadSampleChannel(channel, &newWave, scene);
 	m_model.swap(model::SwapType::HARD);
 
-	/* Remove the old Wave, if any. It is safe to do it now: the audio thread is
-	already processing the new Document. */
+	/* Remove the old Wave, if any. The Document doesn't point to it anymore:
+	it will be freed as soon as the audio thread is done with it. */
 
 	if (oldWave != nullptr)
 		m_model.removeWave(*oldWave);
@@ -204,10 +234,64 @@ void ChannelManager::loadSampleChannel(ID channelId, Wave& wave, Scene scene)
 
 /* -------------------------------------------------------------------------- */
 
+int ChannelManager::makeSampleResident(ID channelId, int sampleRate, Resampler::Quality quality, Scene scene)
+{
+	Sample sample = std::as_const(m_model).get().tracks.getChannel(channelId).sampleChannel->getSample(scene);
+
+	if (sample.wave == nullptr || sample.wave->isResident())
+		return G_RES_OK;
+
+	/* Compact Waves are already in memory: just expand them to float, in
+	place. The audio thread might be reading the Wave in the meantime. */
+
+	if (sample.wave->isCompact())
+	{
+		model::SharedLock lock = m_model.lockShared();
+		return waveFactory::setStorage(*sample.wave, SampleStorage::FLOAT);
+	}
+
+	waveFactory::Result res = waveFactory::createFromFile(sample.wave->getPath(), /*id=*/{}, sampleRate, quality);
+	if (res.status != G_RES_OK)
+		return res.status;
+
+	const Wave* oldWave = sample.wave;
+
+	sample.wave = &m_model.addWave(std::move(res.wave));
+
+	/* Model has been swapped by addWave(), needs to get Channel again. */
+
+	m_model.get().tracks.getChannel(channelId).loadSample(sample, scene);
+	m_model.swap(model::SwapType::HARD);
+
+	/* Remove the streamed Wave, as in loadSampleChannel() above. */
+
+	m_model.removeWave(*oldWave);
+
+	return G_RES_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int ChannelManager::setSampleStorage(ID channelId, SampleStorage storage, Scene scene)
+{
+	Wave* wave = std::as_const(m_model).get().tracks.getChannel(channelId).sampleChannel->getWave(scene);
+
+	if (wave == nullptr)
+		return G_RES_OK;
+
+	/* The audio thread might be reading the Wave in the meantime. */
+
+	model::SharedLock lock = m_model.lockShared();
+
+	return waveFactory::setStorage(*wave, storage);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelManager::cloneChannel(ID channelId, Scene scene, int sampleRate, int bufferSize, const std::vector<Plugin*>& plugins)
 {
-	const Channel&           oldChannel     = m_model.get().tracks.getChannel(channelId);
-	const std::size_t        trackIndex     = m_model.get().tracks.getByChannel(channelId).getIndex();
+	const Channel&           oldChannel     = std::as_const(*this).getChannel(channelId);
+	const std::size_t        trackIndex     = std::as_const(m_model).get().tracks.getByChannel(channelId).getIndex();
 	const Resampler::Quality rsmpQuality    = m_model.get().kernelAudio.rsmpQuality;
 	channelFactory::Data     newChannelData = channelFactory::create(oldChannel, sampleRate, bufferSize, rsmpQuality);
 
@@ -239,7 +323,7 @@ void ChannelManager::cloneChannel(ID channelId, Scene scene, int sampleRate, int
 
 void ChannelManager::copyChannelToScene(ID channelId, Scene srcScene, Scene dstScene)
 {
-	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(*this).getChannel(channelId);
 	copyChannelToScene(ch, srcScene, dstScene);
 	m_model.swap(model::SwapType::HARD);
 }
@@ -248,11 +332,8 @@ void ChannelManager::copyChannelToScene(ID channelId, Scene srcScene, Scene dstS
 
 void ChannelManager::copyAllChannelsToScene(Scene srcScene, Scene dstScene)
 {
-	m_model.get().tracks.forEachChannel([this, srcScene, dstScene](Channel& ch)
-	{
-		copyChannelToScene(ch, srcScene, dstScene);
-		return true;
-	});
+	for (const Channel* ch : m_model.get().tracks.getChannels())
+		copyChannelToScene(*ch, srcScene, dstScene);
 	m_model.swap(model::SwapType::HARD);
 }
 
@@ -292,7 +373,10 @@ void ChannelManager::freeSampleChannel(ID channelId, Scene sceneToFree)
 
 void ChannelManager::freeAllSampleChannels(Scene scene)
 {
-	// TODO - not super optmized, will swap model for each sample channel
+	/* Group the swaps of each channel, Waves removal included, into one. */
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_model.get().tracks.forEachChannel([this, scene](Channel& ch)
 	{
 		if (ch.sampleChannel)
@@ -317,19 +401,29 @@ void ChannelManager::moveChannel(ID channelId, std::size_t newTrackIndex, std::s
 
 void ChannelManager::deleteChannel(ID channelId)
 {
-	const Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel&           ch     = std::as_const(*this).getChannel(channelId);
+	const ChannelShared&     shared = *ch.shared;
+	std::vector<const Wave*> waves;
 
 	if (ch.type == ChannelType::SAMPLE)
 	{
 		const SceneArray<Sample>& samples = ch.sampleChannel->getSamples();
 		for (const Sample& sample : samples)
 			if (sample.wave != nullptr)
-				m_model.removeWave(*sample.wave);
+				waves.push_back(sample.wave);
 	}
 
-	m_model.removeChannelShared(*ch.shared);
-	m_model.get().tracks.getByChannel(channelId).removeChannel(channelId);
-	m_model.swap(model::SwapType::HARD);
+	/* Detach the channel from the Document first, as in removeTrack() above. */
+
+	{
+		const model::Transaction transaction = m_model.beginTransaction();
+
+		m_model.get().tracks.getByChannel(channelId).removeChannel(channelId);
+		m_model.swap(model::SwapType::HARD);
+		for (const Wave* w : waves)
+			m_model.removeWave(*w);
+		m_model.removeChannelShared(shared);
+	}
 
 	triggerOnChannelsAltered();
 }
@@ -348,22 +442,27 @@ void ChannelManager::renameChannel(ID channelId, const std::string& name, Scene
 
 float ChannelManager::getMasterInVol() const
 {
-	return m_model.get().tracks.getChannel(MASTER_IN_CHANNEL_ID).volume;
+	return getChannel(MASTER_IN_CHANNEL_ID).volume;
 }
 
 float ChannelManager::getMasterOutVol() const
 {
-	return m_model.get().tracks.getChannel(MASTER_OUT_CHANNEL_ID).volume;
+	return getChannel(MASTER_OUT_CHANNEL_ID).volume;
 }
 
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::finalizeInputRec(const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame, Scene scene)
 {
-	for (Channel* ch : getRecordableChannels(scene))
-		recordChannel(*ch, buffer, recordedFrames, currentFrame, scene);
-	for (Channel* ch : getOverdubbableChannels(scene))
-		overdubChannel(*ch, buffer, currentFrame, scene);
+	/* Publish all recorded channels at once, instead of swapping for each of
+	them. */
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
+	for (const ID channelId : getRecordableChannels(scene))
+		recordChannel(channelId, buffer, recordedFrames, currentFrame, scene);
+	for (const ID channelId : getOverdubbableChannels(scene))
+		overdubChannel(channelId, buffer, currentFrame, scene);
 
 	triggerOnChannelsAltered();
 }
@@ -380,8 +479,12 @@ void ChannelManager::setInputMonitor(ID channelId, bool value)
 
 void ChannelManager::setVolume(ID channelId, float value)
 {
-	m_model.get().tracks.getChannel(channelId).volume = std::clamp(value, 0.0f, G_MAX_VOLUME);
-	m_model.swap(model::SwapType::SOFT);
+	/* No swap needed: the realtime thread reads the volume from the shared
+	ChannelParams. */
+
+	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	ch.volume   = std::clamp(value, 0.0f, G_MAX_VOLUME);
+	ch.shared->params.setVolume(ch.volume);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -434,8 +537,12 @@ void ChannelManager::setPlaybackMode(ID channelId, PlaybackMode playbackMode, Sc
 
 void ChannelManager::setPan(ID channelId, float value)
 {
-	m_model.get().tracks.getChannel(channelId).pan = std::clamp(value, 0.0f, G_MAX_PAN);
-	m_model.swap(model::SwapType::SOFT);
+	/* No swap needed, same as setVolume() above. */
+
+	Channel&    ch  = m_model.get().tracks.getChannel(channelId);
+	const float pan = std::clamp(value, 0.0f, G_MAX_PAN);
+	ch.pan          = pan;
+	ch.shared->params.setPan(pan);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -544,7 +651,7 @@ void ChannelManager::removeExtraOutput(ID channelId, std::size_t i)
 void ChannelManager::loadWaveInPreviewChannel(ID channelId, Scene scene)
 {
 	Channel&       previewCh = m_model.get().tracks.getChannel(PREVIEW_CHANNEL_ID);
-	const Channel& sourceCh  = m_model.get().tracks.getChannel(channelId);
+	const Channel& sourceCh  = std::as_const(*this).getChannel(channelId);
 
 	assert(previewCh.sampleChannel);
 	assert(sourceCh.sampleChannel);
@@ -576,6 +683,56 @@ void ChannelManager::setPreviewTracker(Frame f)
 
 /* -------------------------------------------------------------------------- */
 
+std::vector<ChannelManager::PlayState> ChannelManager::getPlayState() const
+{
+	std::vector<PlayState> out;
+	for (const Channel* ch : std::as_const(m_model.get().tracks).getChannels())
+		if (!ch->isInternal())
+			out.push_back({ch->id, ch->shared->tracker.load(), ch->shared->playStatus.load(), ch->shared->recStatus.load()});
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelManager::resetPlayState(Scene scene)
+{
+	for (const Channel* ch : std::as_const(m_model.get().tracks).getChannels())
+	{
+		if (ch->isInternal() || ch->type != ChannelType::SAMPLE)
+			continue;
+
+		ChannelShared&      shared = *ch->shared;
+		const ChannelStatus status = shared.playStatus.load();
+
+		dropRenderQueue_(shared);
+		shared.tracker.store(ch->sampleChannel->hasWave(scene) ? ch->sampleChannel->getRange(scene).getA() : 0);
+		if (status == ChannelStatus::PLAY || status == ChannelStatus::ENDING || status == ChannelStatus::WAIT)
+			shared.playStatus.store(ChannelStatus::OFF);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelManager::setPlayState(const std::vector<PlayState>& states)
+{
+	for (const Channel* ch : std::as_const(m_model.get().tracks).getChannels())
+	{
+		const auto state = std::find_if(states.begin(), states.end(), [id = ch->id](const PlayState& s)
+		{ return s.channelId == id; });
+		if (state == states.end())
+			continue;
+
+		ChannelShared& shared = *ch->shared;
+
+		dropRenderQueue_(shared);
+		shared.tracker.store(state->tracker);
+		shared.playStatus.store(state->playStatus);
+		shared.recStatus.store(state->recStatus);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelManager::finalizeActionRec(const std::unordered_set<ID>& ids)
 {
 	for (ID id : ids)
@@ -617,7 +774,7 @@ bool ChannelManager::hasSolos() const
 
 bool ChannelManager::canRemoveTrack(std::size_t trackIndex) const
 {
-	return m_model.get().tracks.get(trackIndex).getNumChannels() == 1;
+	return std::as_const(m_model).get().tracks.get(trackIndex).getNumChannels() == 1;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -658,16 +815,22 @@ void ChannelManager::setupChannelCallbacks(const Channel& ch, ChannelShared& sha
 
 /* -------------------------------------------------------------------------- */
 
-std::vector<Channel*> ChannelManager::getRecordableChannels(Scene scene)
+std::vector<ID> ChannelManager::getRecordableChannels(Scene scene) const
 {
-	return m_model.get().tracks.getChannelsIf([scene](const Channel& c)
-	{ return c.canInputRec(scene) && !c.hasWave(scene); });
+	std::vector<ID> out;
+	for (const Channel* c : m_model.get().tracks.getChannels())
+		if (c->canInputRec(scene) && !c->hasWave(scene))
+			out.push_back(c->id);
+	return out;
 }
 
-std::vector<Channel*> ChannelManager::getOverdubbableChannels(Scene scene)
+std::vector<ID> ChannelManager::getOverdubbableChannels(Scene scene) const
 {
-	return m_model.get().tracks.getChannelsIf([scene](const Channel& c)
-	{ return c.canInputRec(scene) && c.hasWave(scene); });
+	std::vector<ID> out;
+	for (const Channel* c : m_model.get().tracks.getChannels())
+		if (c->canInputRec(scene) && c->hasWave(scene))
+			out.push_back(c->id);
+	return out;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -684,7 +847,7 @@ void ChannelManager::setupChannelPostRecording(Channel& ch, Frame currentFrame)
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame, Scene scene)
+void ChannelManager::recordChannel(ID channelId, const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame, Scene scene)
 {
 	assert(onChannelRecorded != nullptr);
 
@@ -698,7 +861,12 @@ void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 	/* Update channel with the new Wave. */
 
-	loadSampleChannel(ch, &m_model.addWave(std::move(wave)), scene);
+	Wave& newWave = m_model.addWave(std::move(wave));
+
+	/* Get the Channel after addWave(), which swaps the model. */
+
+	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	loadSampleChannel(ch, &newWave, scene);
 	setupChannelPostRecording(ch, currentFrame);
 
 	m_model.swap(model::SwapType::HARD);
@@ -706,9 +874,9 @@ void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::overdubChannel(Channel& ch, const mcl::AudioBuffer& buffer, Frame currentFrame, Scene scene)
+void ChannelManager::overdubChannel(ID channelId, const mcl::AudioBuffer& buffer, Frame currentFrame, Scene scene)
 {
-	Wave* wave = ch.sampleChannel->getWave(scene);
+	Wave* wave = std::as_const(m_model).get().tracks.getChannel(channelId).sampleChannel->getWave(scene);
 
 	/* Need model::DataLock here, as data might be being read by the audio
 	thread at the same time. */
@@ -716,14 +884,18 @@ void ChannelManager::overdubChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 	model::SharedLock lock = m_model.lockShared();
 
 	wave->getBuffer().sumAll(buffer);
+	wave->updatePeaks(0, wave->getLength());
 	wave->setLogical(true);
 
-	setupChannelPostRecording(ch, currentFrame);
+	/* Model has been swapped by SharedLock constructor, needs to get Channel
+	again. */
+
+	setupChannelPostRecording(m_model.get().tracks.getChannel(channelId), currentFrame);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::copyChannelToScene(Channel& ch, Scene srcScene, Scene dstScene)
+void ChannelManager::copyChannelToScene(const Channel& ch, Scene srcScene, Scene dstScene)
 {
 	if (ch.type != ChannelType::SAMPLE) // Currently relevant for Sample Channels only.
 		return;
@@ -734,15 +906,20 @@ void ChannelManager::copyChannelToScene(Channel& ch, Scene srcScene, Scene dstSc
 	/* Ideally we could just copy the Sample structure to the new scene, so that
 	the Sample::wave pointer points to the original, and now shared, Wave object.
 	This would be very confusing for the user, though, especially when destructively
-	editing the Wave (e.g. cut/copy/paste). It's better to just create a new copy
-	of Wave and set it to the new scene. */
+	editing the Wave (e.g. cut/copy/paste). It's better to just create a new Wave
+	and set it to the new scene. The new Wave shares the audio data with the
+	original one until either of them gets edited (see Wave::shareData()). */
 
 	Sample sample = ch.sampleChannel->getSample(srcScene);
 	Wave&  wave   = m_model.addWave(waveFactory::createFromWave(*sample.wave));
 
 	sample.wave = &wave;
-	ch.loadSample(sample, dstScene);
-	ch.setName(ch.getName(srcScene), dstScene);
+
+	/* Model has been swapped by addWave(), needs to get Channel again. */
+
+	Channel& dst = m_model.get().tracks.getChannel(ch.id);
+	dst.loadSample(sample, dstScene);
+	dst.setName(ch.getName(srcScene), dstScene);
 }
 
 /* -------------------------------------------------------------------------- */
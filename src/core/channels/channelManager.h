@@ -37,6 +37,7 @@
 #include <map>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace mcl
 {
@@ -63,12 +64,25 @@ class ChannelManager final
 public:
 	friend Engine;
 
+	/* PlayState
+	Playback state of a Channel, i.e. what the audio thread changes in its
+	ChannelShared while playing. */
+
+	struct PlayState
+	{
+		ID            channelId;
+		Frame         tracker;
+		ChannelStatus playStatus;
+		ChannelStatus recStatus;
+	};
+
 	ChannelManager(model::Model&, MidiMapper<KernelMidi>&, KernelMidi&);
 
 	/* getChannel
 	Returns channel object by ID. */
 
-	Channel& getChannel(ID);
+	Channel&       getChannel(ID);
+	const Channel& getChannel(ID) const;
 
 	/* hasInputRecordableChannels
 	Tells whether Mixer has one or more input-recordable channels. */
@@ -125,15 +139,31 @@ public:
 	Channel& addChannel(ChannelType, std::size_t trackIndex, int sampleRate, int bufferSize);
 
 	/* loadSampleChannel (1)
-	Creates a new Wave from a file path and loads it inside a Sample Channel. */
+	Creates a new Wave from a file path and loads it inside a Sample Channel.
+	Files longer than 'streamThreshold' frames are streamed from disk (0 = never
+	stream). Non-streamed Waves are kept in the given SampleStorage format. */
 
-	int loadSampleChannel(ID channelId, const std::string&, int sampleRate, Resampler::Quality, Scene);
+	int loadSampleChannel(ID channelId, const std::string&, int sampleRate, Resampler::Quality,
+	    Frame streamThreshold, SampleStorage, Scene);
 
 	/* loadSampleChannel (2)
 	Loads an existing Wave inside a Sample Channel. */
 
 	void loadSampleChannel(ID channelId, Wave&, Scene);
 
+	/* makeSampleResident
+	Replaces the streamed Wave of a Sample Channel with a fully loaded one, read
+	again from file, or expands a compact Wave to float. Sample properties (range,
+	pitch, ...) are kept. Does nothing if the Wave is already resident. */
+
+	int makeSampleResident(ID channelId, int sampleRate, Resampler::Quality, Scene);
+
+	/* setSampleStorage
+	Changes the storage format of the Wave loaded in a Sample Channel. Streamed
+	Waves can't be changed. */
+
+	int setSampleStorage(ID channelId, SampleStorage, Scene);
+
 	/* freeChannel
 	Unloads existing Wave from a Sample Channel. Pass an invalid Scene object
 	to remove all Waves from all scenes. */
@@ -203,6 +233,26 @@ public:
 	void freeWaveInPreviewChannel();
 	void setPreviewTracker(Frame f);
 
+	/* getPlayState
+	Returns the playback state of all non-internal Channels. */
+
+	std::vector<PlayState> getPlayState() const;
+
+	/* resetPlayState
+	Stops all non-internal Sample Channels and rewinds them to the beginning of
+	their range in the given Scene, dropping any pending render request. Channels
+	reading actions keep doing so. Used before offline rendering. Must be called
+	only when mixer is disabled. */
+
+	void resetPlayState(Scene);
+
+	/* setPlayState
+	Restores the playback state previously returned by getPlayState(). Channels
+	removed in the meantime are skipped. Must be called only when mixer is
+	disabled. */
+
+	void setPlayState(const std::vector<PlayState>&);
+
 	/* onChannelsAltered
 	Fired when something is done on channels (added, removed, loaded, ...). */
 
@@ -229,8 +279,8 @@ private:
 
 	void setupChannelCallbacks(const Channel&, ChannelShared&) const;
 
-	std::vector<Channel*> getRecordableChannels(Scene);
-	std::vector<Channel*> getOverdubbableChannels(Scene);
+	std::vector<ID> getRecordableChannels(Scene) const;
+	std::vector<ID> getOverdubbableChannels(Scene) const;
 
 	/* setupChannelPostRecording
 	Fnialize the Sample channel after an audio recording session. */
@@ -240,18 +290,18 @@ private:
 	/* recordChannel
 	Records the current Mixer audio input data into an empty channel. */
 
-	void recordChannel(Channel&, const mcl::AudioBuffer&, Frame recordedFrames, Frame currentFrame, Scene);
+	void recordChannel(ID channelId, const mcl::AudioBuffer&, Frame recordedFrames, Frame currentFrame, Scene);
 
 	/* overdubChannel
 	Records the current Mixer audio input data into a channel with an existing
 	Wave, overdub mode. */
 
-	void overdubChannel(Channel&, const mcl::AudioBuffer&, Frame currentFrame, Scene);
+	void overdubChannel(ID channelId, const mcl::AudioBuffer&, Frame currentFrame, Scene);
 
 	/* copyChannelToScene
 	Internal method that does not swap model. */
 
-	void copyChannelToScene(Channel&, Scene srcScene, Scene dstScene);
+	void copyChannelToScene(const Channel&, Scene srcScene, Scene dstScene);
 
 	void triggerOnChannelsAltered();
 
@@ -0,0 +1,92 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "src/core/channels/channelParams.h"
+#include <cassert>
+
+namespace giada::m
+{
+float ChannelParams::Ramp::getGainStart(int channel) const
+{
+	return volumeStart * panStart[channel];
+}
+
+float ChannelParams::Ramp::getGainEnd(int channel) const
+{
+	return volumeEnd * panEnd[channel];
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void ChannelParams::reset(float volume, float pan)
+{
+	m_volume.store(volume);
+	m_pan.store(pan);
+	m_ramp = {volume, volume, Pan(pan).get(), Pan(pan).get()};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelParams::setVolume(float v)
+{
+	assert(v >= 0.0f && v <= G_MAX_VOLUME);
+	m_volume.store(v);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelParams::setPan(float v)
+{
+	assert(v >= 0.0f && v <= G_MAX_PAN);
+	m_pan.store(v);
+}
+
+/* -------------------------------------------------------------------------- */
+
+float ChannelParams::getVolume() const
+{
+	return m_volume.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelParams::advance()
+{
+	m_ramp.volumeStart = m_ramp.volumeEnd;
+	m_ramp.panStart    = m_ramp.panEnd;
+	m_ramp.volumeEnd   = m_volume.load();
+	m_ramp.panEnd      = Pan(m_pan.load()).get();
+}
+
+/* -------------------------------------------------------------------------- */
+
+const ChannelParams::Ramp& ChannelParams::getRamp() const
+{
+	return m_ramp;
+}
+} // namespace giada::m
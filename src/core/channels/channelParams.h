@@ -0,0 +1,96 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_CHANNELPARAMS_H
+#define G_CHANNELPARAMS_H
+
+#include "src/core/const.h"
+#include "src/core/pan.h"
+#include "src/core/weakAtomic.h"
+
+namespace giada::m
+{
+/* ChannelParams
+Continuous parameters of a Channel (volume and pan) as seen by the realtime
+thread. Other threads write them directly, without swapping the Document: the
+realtime thread picks the new values up at the beginning of the next block and
+ramps towards them across the block, to prevent zipper noise. Channel::volume
+and Channel::pan keep holding the values for the rest of the application. */
+
+class ChannelParams
+{
+public:
+	/* Ramp
+	Volume and pan to apply across the current block, going linearly from
+	'start' (first frame) to 'end' (last frame). */
+
+	struct Ramp
+	{
+		/* getGain[Start|End]
+		Returns volume * pan for the given audio channel. */
+
+		float getGainStart(int channel) const;
+		float getGainEnd(int channel) const;
+
+		float     volumeStart = G_DEFAULT_VOL;
+		float     volumeEnd   = G_DEFAULT_VOL;
+		Pan::Type panStart    = Pan(G_DEFAULT_PAN).get();
+		Pan::Type panEnd      = Pan(G_DEFAULT_PAN).get();
+	};
+
+	/* reset
+	Sets the values right away, with no ramp. Call it only when the channel is
+	not being rendered yet (e.g. on creation). */
+
+	void reset(float volume, float pan);
+
+	/* set[Volume|Pan]
+	Sets new values, to be picked up by the realtime thread. Thread-safe. */
+
+	void setVolume(float);
+	void setPan(float);
+
+	float getVolume() const;
+
+	/* advance
+	Moves the ramp to the latest values. Realtime thread only, once per block. */
+
+	void advance();
+
+	/* getRamp
+	Returns the ramp for the current block. Realtime thread only. */
+
+	const Ramp& getRamp() const;
+
+private:
+	WeakAtomic<float> m_volume = G_DEFAULT_VOL;
+	WeakAtomic<float> m_pan    = G_DEFAULT_PAN;
+
+	Ramp m_ramp;
+};
+} // namespace giada::m
+
+#endif
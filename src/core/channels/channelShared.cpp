@@ -48,5 +48,7 @@ bool ChannelShared::isReadingActions() const
 void ChannelShared::setBufferSize(int bufferSize)
 {
 	audioBuffer.alloc(bufferSize, audioBuffer.countChannels());
+	silent     = false;
+	idleFrames = 0;
 }
 } // namespace giada::m
\ No newline at end of file
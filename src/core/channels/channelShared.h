@@ -27,15 +27,21 @@
 #ifndef G_CHANNELSHARED_H
 #define G_CHANNELSHARED_H
 
+#include "src/core/channels/channelParams.h"
 #include "src/core/const.h"
+#include "src/core/dspLoad.h"
+#include "src/core/freezer.h"
 #include "src/core/midiEvent.h"
 #include "src/core/quantizer.h"
 #include "src/core/rendering/sampleRendering.h"
 #include "src/core/resampler.h"
+#include "src/core/stretchStream.h"
 #include "src/core/stretcher.h"
 #include "src/deps/concurrentqueue/concurrentqueue.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <atomic>
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <memory>
 #include <optional>
 
 namespace giada::m
@@ -66,6 +72,26 @@ struct ChannelShared final
 	WeakAtomic<bool>          readActions    = false;
 	WeakAtomic<float>         volumeInternal = G_DEFAULT_VOL; // Used for velocity-drives-volume mode on Sample Channels
 
+	/* params
+	Volume and pan for the realtime thread, updated without swapping the
+	Document. */
+
+	ChannelParams params;
+
+	/* Silence tracking, for the real-time thread only. 'silent' is true when
+	audioBuffer is known to contain only zeros, so that clearing, merging and
+	plug-in processing can be skipped. 'idleFrames' counts the frames rendered
+	without any input signal nor audible plug-in output, and lets plug-in tails
+	(reverbs, delays, ...) ring out before the channel goes idle. */
+
+	bool  silent     = false;
+	Frame idleFrames = 0;
+
+	/* dspLoad
+	Time spent rendering this channel, plug-ins included. */
+
+	DspLoad dspLoad;
+
 	std::optional<Quantizer> quantizer;
 
 	/* Optional render queue for sample-based channels. Used by callers on thread
@@ -81,7 +107,26 @@ struct ChannelShared final
 
 	std::optional<Resampler> resampler = {};
 
-	std::optional<Stretcher> stretcher = {};
+	/* Stretcher for sample-based channels, lent by the Model (see StretcherPool)
+	only while the channel has Samples in ELASTIC mode. Nullptr otherwise, or if
+	the pool is exhausted. */
+
+	std::atomic<Stretcher*> stretcher = nullptr;
+
+	/* Optional scratch buffer for sample-based channels, where compact Waves
+	(see CompactBuffer) are expanded to float before resampling or stretching. */
+
+	std::optional<mcl::AudioBuffer> compactWindow = {};
+
+	/* Optional Freezer for sample-based channels. Shared with the background
+	renderer thread, which might outlive the channel while freezing. */
+
+	std::shared_ptr<Freezer> freezer = nullptr;
+
+	/* Optional StretchStream for sample-based channels. Idle unless the channel
+	plays Samples in ELASTIC mode. */
+
+	std::unique_ptr<StretchStream> stretchStream = nullptr;
 };
 } // namespace giada::m
 
@@ -96,6 +96,14 @@ bool SampleChannel::hasWaves() const
 
 /* -------------------------------------------------------------------------- */
 
+bool SampleChannel::hasElasticSamples() const
+{
+	return utils::container::hasIf(m_samples, [](const Sample& s)
+	{ return s.playbackMode == PlaybackMode::ELASTIC; });
+}
+
+/* -------------------------------------------------------------------------- */
+
 Wave* SampleChannel::getWave(Scene scene) const
 {
 	return m_samples[scene.getIndex()].wave;
@@ -135,7 +143,7 @@ const Sample& SampleChannel::getSample(Scene scene) const
 
 Frame SampleChannel::getWaveSize(Scene scene) const
 {
-	return hasWave(scene) ? m_samples[scene.getIndex()].wave->getBuffer().countFrames() : 0;
+	return hasWave(scene) ? m_samples[scene.getIndex()].wave->getLength() : 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -147,7 +155,7 @@ void SampleChannel::loadSample(const Sample& s, Scene scene)
 	if (s.wave != nullptr)
 	{
 		m_samples[scene.getIndex()].shift = s.shift == -1 ? 0 : s.shift;
-		m_samples[scene.getIndex()].range = s.range.isValid() ? s.range : FrameRange(0, s.wave->getBuffer().countFrames());
+		m_samples[scene.getIndex()].range = s.range.isValid() ? s.range : FrameRange(0, s.wave->getLength());
 	}
 }
 
@@ -45,6 +45,7 @@ public:
 	bool       isAnyNonLoopingSingleMode() const;
 	bool       hasWave(Scene) const;
 	bool       hasWaves() const;
+	bool       hasElasticSamples() const;
 	ID         getWaveId(Scene) const;
 	Frame      getWaveSize(Scene) const;
 	Wave*      getWave(Scene) const;
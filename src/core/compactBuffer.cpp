@@ -0,0 +1,134 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/compactBuffer.h"
+#include "src/core/simd.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+namespace giada::m
+{
+namespace
+{
+std::uint16_t toInt16_(float f)
+{
+	const float v = std::clamp(std::round(f * 32768.0f), -32768.0f, 32767.0f);
+	return std::bit_cast<std::uint16_t>(static_cast<std::int16_t>(v));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* toHalf_
+Float to half conversion, the opposite of simd::halfToFloat(): the exponent is
+re-biased by a multiplication, then extra mantissa bits are rounded to nearest
+even. Values too large for a half are clamped to the largest finite one. */
+
+std::uint16_t toHalf_(float f)
+{
+	constexpr std::uint32_t MAX_HALF = 0x7BFF;
+
+	const std::uint32_t bits = std::bit_cast<std::uint32_t>(f);
+	const std::uint32_t sign = (bits >> 16) & 0x8000;
+	const float         abs  = std::min(std::bit_cast<float>(bits & 0x7FFFFFFF), 65504.0f);
+	const std::uint32_t body = std::bit_cast<std::uint32_t>(abs * 0x1p-112f);
+	const std::uint32_t half = (body + 0x0FFF + ((body >> 13) & 1)) >> 13;
+
+	return static_cast<std::uint16_t>(sign | std::min(half, MAX_HALF));
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+CompactBuffer::CompactBuffer(const mcl::AudioBuffer& b, SampleStorage storage)
+: m_storage(storage)
+, m_frames(b.countFrames())
+, m_channels(b.countChannels())
+, m_data(static_cast<std::size_t>(m_frames) * m_channels)
+{
+	assert(storage != SampleStorage::FLOAT);
+
+	for (int ch = 0; ch < m_channels; ch++)
+	{
+		const float*   src  = b.getChannelView(ch).data();
+		std::uint16_t* dest = m_data.data() + static_cast<std::size_t>(ch) * m_frames;
+
+		if (m_storage == SampleStorage::INT16)
+			std::transform(src, src + m_frames, dest, toInt16_);
+		else
+			std::transform(src, src + m_frames, dest, toHalf_);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+SampleStorage CompactBuffer::getStorage() const { return m_storage; }
+Frame         CompactBuffer::countFrames() const { return m_frames; }
+int           CompactBuffer::countChannels() const { return m_channels; }
+std::size_t   CompactBuffer::getSize() const { return m_data.size() * sizeof(std::uint16_t); }
+
+/* -------------------------------------------------------------------------- */
+
+const std::uint16_t* CompactBuffer::getChannel(int ch) const
+{
+	return m_data.data() + static_cast<std::size_t>(ch) * m_frames;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CompactBuffer::read(mcl::AudioBuffer& dest, Frame start, Frame count, Frame destOffset) const
+{
+	assert(start >= 0 && start + count <= m_frames);
+	assert(destOffset + count <= dest.countFrames());
+
+	const int channels = std::min(m_channels, dest.countChannels());
+
+	for (int ch = 0; ch < channels; ch++)
+	{
+		float*               out = dest.getChannelView(ch).data() + destOffset;
+		const std::uint16_t* in  = getChannel(ch) + start;
+
+		if (m_storage == SampleStorage::INT16)
+			simd::int16ToFloat(out, reinterpret_cast<const std::int16_t*>(in), count);
+		else
+			simd::halfToFloat(out, in, count);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+mcl::AudioBuffer CompactBuffer::toFloat() const
+{
+	mcl::AudioBuffer out(m_frames, m_channels);
+	read(out, 0, m_frames, 0);
+	return out;
+}
+} // namespace giada::m
@@ -0,0 +1,89 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_COMPACT_BUFFER_H
+#define G_COMPACT_BUFFER_H
+
+#include "src/core/types.h"
+#include "src/types.h"
+#include <cstdint>
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* CompactBuffer
+Immutable, planar audio data stored with 16 bits per sample, either as signed
+integers (SampleStorage::INT16) or as half-precision floats (SampleStorage::HALF).
+Halves the memory footprint of a float buffer; samples are expanded back to
+float only when read. */
+
+class CompactBuffer
+{
+public:
+	/* CompactBuffer
+	Converts float buffer 'b' to the given storage, which must be a compact one.
+	INT16 clips anything outside the [-1.0, 1.0] range; HALF keeps about 11 bits
+	of precision at any level. */
+
+	CompactBuffer(const mcl::AudioBuffer& b, SampleStorage);
+
+	SampleStorage getStorage() const;
+	Frame         countFrames() const;
+	int           countChannels() const;
+
+	/* getSize
+	Returns the amount of memory taken by audio data, in bytes. */
+
+	std::size_t getSize() const;
+
+	/* read
+	Expands 'count' frames starting at 'start' into float buffer 'dest', starting
+	at 'destOffset'. Realtime-safe. */
+
+	void read(mcl::AudioBuffer& dest, Frame start, Frame count, Frame destOffset) const;
+
+	/* toFloat
+	Returns the whole content as a float buffer. */
+
+	mcl::AudioBuffer toFloat() const;
+
+private:
+	const std::uint16_t* getChannel(int ch) const;
+
+	SampleStorage              m_storage;
+	Frame                      m_frames;
+	int                        m_channels;
+	std::vector<std::uint16_t> m_data; // Planar, one channel after another
+};
+} // namespace giada::m
+
+#endif
@@ -59,6 +59,14 @@ struct Conf final
 	int                buffersize       = G_DEFAULT_BUFSIZE;
 	bool               limitOutput      = false;
 	Resampler::Quality rsmpQuality      = Resampler::Quality::SINC_BEST;
+	int                renderThreads    = G_DEFAULT_RENDER_THREADS;
+	int                pluginTailTime   = G_DEFAULT_PLUGIN_TAIL_TIME; // milliseconds
+	int                streamThreshold  = G_DEFAULT_STREAM_THRESHOLD; // seconds
+	int                pcmCacheSize     = G_DEFAULT_PCM_CACHE_SIZE;   // MB
+	int                loadGovernor     = G_DEFAULT_LOAD_GOVERNOR;    // percent, 0 = disabled
+	int                stretcherPool    = G_DEFAULT_STRETCHER_POOL;
+	bool               asyncStretch     = true;
+	SampleStorage      sampleStorage    = SampleStorage::FLOAT;
 
 	RtMidi::Api           midiSystem = G_DEFAULT_MIDI_API;
 	std::set<std::size_t> midiDevicesOut;
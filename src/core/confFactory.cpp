@@ -49,6 +49,14 @@ constexpr auto CONF_KEY_SAMPLERATE                    = "samplerate";
 constexpr auto CONF_KEY_BUFFER_SIZE                   = "buffer_size";
 constexpr auto CONF_KEY_LIMIT_OUTPUT                  = "limit_output";
 constexpr auto CONF_KEY_RESAMPLE_QUALITY              = "resample_quality";
+constexpr auto CONF_KEY_RENDER_THREADS                = "render_threads";
+constexpr auto CONF_KEY_PLUGIN_TAIL_TIME              = "plugin_tail_time";
+constexpr auto CONF_KEY_STREAM_THRESHOLD              = "stream_threshold";
+constexpr auto CONF_KEY_PCM_CACHE_SIZE                = "pcm_cache_size";
+constexpr auto CONF_KEY_LOAD_GOVERNOR                 = "load_governor";
+constexpr auto CONF_KEY_STRETCHER_POOL                = "stretcher_pool";
+constexpr auto CONF_KEY_ASYNC_STRETCH                 = "async_stretch";
+constexpr auto CONF_KEY_SAMPLE_STORAGE                = "sample_storage";
 constexpr auto CONF_KEY_MIDI_SYSTEM                   = "midi_system";
 constexpr auto CONF_KEY_MIDI_PORT_OUT                 = "midi_port_out";
 constexpr auto CONF_KEY_MIDI_PORT_IN                  = "midi_port_in";
@@ -155,6 +163,14 @@ Conf parse_(std::ifstream& ifs)
 	conf.buffersize                 = j.value(CONF_KEY_BUFFER_SIZE, conf.buffersize);
 	conf.limitOutput                = j.value(CONF_KEY_LIMIT_OUTPUT, conf.limitOutput);
 	conf.rsmpQuality                = j.value(CONF_KEY_RESAMPLE_QUALITY, conf.rsmpQuality);
+	conf.renderThreads              = j.value(CONF_KEY_RENDER_THREADS, conf.renderThreads);
+	conf.pluginTailTime             = j.value(CONF_KEY_PLUGIN_TAIL_TIME, conf.pluginTailTime);
+	conf.streamThreshold            = j.value(CONF_KEY_STREAM_THRESHOLD, conf.streamThreshold);
+	conf.pcmCacheSize               = j.value(CONF_KEY_PCM_CACHE_SIZE, conf.pcmCacheSize);
+	conf.loadGovernor               = j.value(CONF_KEY_LOAD_GOVERNOR, conf.loadGovernor);
+	conf.stretcherPool              = j.value(CONF_KEY_STRETCHER_POOL, conf.stretcherPool);
+	conf.asyncStretch               = j.value(CONF_KEY_ASYNC_STRETCH, conf.asyncStretch);
+	conf.sampleStorage              = j.value(CONF_KEY_SAMPLE_STORAGE, conf.sampleStorage);
 	conf.midiSystem                 = j.value(CONF_KEY_MIDI_SYSTEM, conf.midiSystem);
 	conf.midiDevicesOut             = j.value(CONF_KEY_MIDI_PORT_OUT, conf.midiDevicesOut);
 	conf.midiDevicesIn              = j.value(CONF_KEY_MIDI_PORT_IN, conf.midiDevicesIn);
@@ -255,6 +271,13 @@ void sanitize_(Conf& conf)
 	conf.channelsOutStart = std::max(0, conf.channelsOutStart);
 	conf.channelsInCount  = std::max(1, conf.channelsInCount);
 	conf.channelsInStart  = std::max(0, conf.channelsInStart);
+	conf.renderThreads    = std::clamp(conf.renderThreads, 1, G_MAX_RENDER_THREADS);
+	conf.pluginTailTime   = std::clamp(conf.pluginTailTime, 0, G_MAX_PLUGIN_TAIL_TIME);
+	conf.streamThreshold  = std::clamp(conf.streamThreshold, 0, G_MAX_STREAM_THRESHOLD);
+	conf.pcmCacheSize     = std::clamp(conf.pcmCacheSize, 0, G_MAX_PCM_CACHE_SIZE);
+	conf.loadGovernor     = std::clamp(conf.loadGovernor, 0, G_MAX_LOAD_GOVERNOR);
+	conf.stretcherPool    = std::clamp(conf.stretcherPool, 0, G_MAX_STRETCHER_POOL);
+	conf.sampleStorage    = std::clamp(conf.sampleStorage, SampleStorage::FLOAT, SampleStorage::HALF);
 
 	conf.uiScaling = std::clamp(conf.uiScaling, G_MIN_UI_SCALING, G_MAX_UI_SCALING);
 }
@@ -286,6 +309,14 @@ bool serialize(const Conf& conf)
 	j[CONF_KEY_BUFFER_SIZE]                   = conf.buffersize;
 	j[CONF_KEY_LIMIT_OUTPUT]                  = conf.limitOutput;
 	j[CONF_KEY_RESAMPLE_QUALITY]              = conf.rsmpQuality;
+	j[CONF_KEY_RENDER_THREADS]                = conf.renderThreads;
+	j[CONF_KEY_PLUGIN_TAIL_TIME]              = conf.pluginTailTime;
+	j[CONF_KEY_STREAM_THRESHOLD]              = conf.streamThreshold;
+	j[CONF_KEY_PCM_CACHE_SIZE]                = conf.pcmCacheSize;
+	j[CONF_KEY_LOAD_GOVERNOR]                 = conf.loadGovernor;
+	j[CONF_KEY_STRETCHER_POOL]                = conf.stretcherPool;
+	j[CONF_KEY_ASYNC_STRETCH]                 = conf.asyncStretch;
+	j[CONF_KEY_SAMPLE_STORAGE]                = static_cast<int>(conf.sampleStorage);
 	j[CONF_KEY_MIDI_SYSTEM]                   = conf.midiSystem;
 	j[CONF_KEY_MIDI_PORT_OUT]                 = conf.midiDevicesOut;
 	j[CONF_KEY_MIDI_PORT_IN]                  = conf.midiDevicesIn;
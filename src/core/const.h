@@ -38,20 +38,73 @@ namespace giada
 {
 /* -- Engine ---------------------------------------------------------------- */
 /* G_EVENT_DISPATCHER_RATE_MS
-The amount of sleep between each Event Dispatcher cycle. It should be lower
-than the audio thread sleep time. Note: this value will obviously increase the
-live input latency, keep it small! */
-constexpr int G_EVENT_DISPATCHER_RATE_MS = 5;
+The maximum amount of sleep between each Event Dispatcher cycle. The Event
+Dispatcher runs as soon as it sees an event pumped in (see G_WORKER_RT_POLL_MS):
+this is just a safety net, and it doesn't affect latency. */
+constexpr int G_EVENT_DISPATCHER_RATE_MS = 50;
 
 /* G_KERNEL_MIDI_OUTPUT_RATE_MS
-The rate at which KernelMidi spits out MIDI events. Note: this value will
-obviously increase the MIDI output latency, keep it small!*/
-constexpr int G_KERNEL_MIDI_OUTPUT_RATE_MS = 3;
+The maximum amount of sleep between each KernelMidi output cycle. KernelMidi
+runs as soon as it sees a MIDI event sent (see G_WORKER_RT_POLL_MS): this is
+just a safety net. */
+constexpr int G_KERNEL_MIDI_OUTPUT_RATE_MS = 50;
 
 /* G_KERNEL_MIDI_INPUT_RATE_MS
-The rate at which KernelMidi checks for MIDI events received from the devices.
-Note: this value will obviously increase the MIDI latency, keep it small! */
-constexpr int G_KERNEL_MIDI_INPUT_RATE_MS = 3;
+The maximum amount of sleep between each KernelMidi input cycle. KernelMidi
+wakes up as soon as a MIDI event is received from the devices. Each cycle also
+flushes model swaps coalesced in the meantime, so keep it close to
+G_MODEL_COALESCE_MS. */
+constexpr int G_KERNEL_MIDI_INPUT_RATE_MS = 20;
+
+/* G_WORKER_RT_POLL_MS
+How often a sleeping worker fed by the realtime thread (Event Dispatcher,
+KernelMidi output) checks for new work. The realtime thread only raises a flag
+and never wakes threads up itself, so this bounds the latency of its events. */
+constexpr int G_WORKER_RT_POLL_MS = 1;
+
+/* G_DISK_READER_RATE_MS
+The amount of sleep between each disk reader cycle, i.e. how often streamed
+samples are refilled from disk. It must be way shorter than the time covered by
+a stream ring buffer (see G_STREAM_RING_SECONDS). */
+constexpr int G_DISK_READER_RATE_MS = 5;
+
+/* G_PEAKS_BUILDER_RATE_MS
+The amount of sleep between each cycle of the thread that computes waveform
+peaks in background. */
+constexpr int G_PEAKS_BUILDER_RATE_MS = 50;
+
+/* G_FREEZER_RATE_MS
+The amount of sleep between each cycle of the thread that pre-renders pitched
+or stretched samples in background (see Freezer). */
+constexpr int G_FREEZER_RATE_MS = 100;
+
+/* G_STRETCH_STREAM_RATE_MS
+The amount of sleep between each cycle of the thread that time-stretches ELASTIC
+samples ahead of the playhead (see StretchStream). It must be way shorter than
+the time covered by a stretch ring buffer (see G_STRETCH_RING_FRAMES). */
+constexpr int G_STRETCH_STREAM_RATE_MS = 5;
+
+/* G_RECLAIMER_RATE_MS
+The amount of sleep between each cycle of the thread that frees the objects
+removed from the model, once the audio thread is done with them (see
+model::Reclaimer). */
+constexpr int G_RECLAIMER_RATE_MS = 100;
+
+/* G_MODEL_COALESCE_MS
+Minimum time between two model swaps caused by continuous controls (e.g. a
+MIDI-learned knob), see model::Transaction. Edits made in between are published
+together with the next swap. */
+constexpr int G_MODEL_COALESCE_MS = 20;
+
+/* G_RT_EPOCH_POLL_US
+How often a thread waiting for the realtime thread to leave its read-side
+sections checks again (see RtEpoch). Sections last one audio block at most. */
+constexpr int G_RT_EPOCH_POLL_US = 50;
+
+/* G_RENDER_GRAPH_SORT_BLOCKS
+How often, in audio blocks, the root nodes of the render graph are sorted again
+by their measured rendering time (see rendering::RenderState). */
+constexpr int G_RENDER_GRAPH_SORT_BLOCKS = 64;
 
 /* -- MIN/MAX values -------------------------------------------------------- */
 constexpr float G_MIN_BPM               = 20.0f;
@@ -72,6 +125,13 @@ constexpr float G_MAX_VELOCITY_FLOAT    = 1.0f;
 constexpr int   G_MAX_MIDI_CHANS        = 16;
 constexpr int   G_MAX_DISPATCHER_EVENTS = 32;
 constexpr int   G_MAX_SEQUENCER_EVENTS  = 128; // Per block
+constexpr int   G_MAX_RENDER_THREADS    = 16;
+constexpr int   G_MAX_PLUGIN_TAIL_TIME  = 60000;    // milliseconds
+constexpr float G_SILENCE_THRESHOLD     = 0.00001f; // -100 dB
+constexpr int   G_MAX_STREAM_THRESHOLD  = 3600;     // seconds
+constexpr int   G_MAX_PCM_CACHE_SIZE    = 65536;    // MB
+constexpr int   G_MAX_LOAD_GOVERNOR     = 100;      // percent
+constexpr int   G_MAX_STRETCHER_POOL    = 256;
 
 /* -- default values -------------------------------------------------------- */
 constexpr RtAudio::Api G_DEFAULT_SOUNDSYS            = RtAudio::Api::UNSPECIFIED;
@@ -93,6 +153,39 @@ constexpr auto         G_DEFAULT_PATCH_NAME          = "(default patch)";
 constexpr int          G_DEFAULT_ACTION_SIZE_depr_   = 8192; // frames
 constexpr float        G_DEFAULT_REC_TRIGGER_LEVEL   = -10.0f;
 constexpr int          G_DEFAULT_VST_MIDIBUFFER_SIZE = 1024; // TODO - not 100% sure about this size
+constexpr int          G_DEFAULT_RENDER_THREADS      = 1;    // Serial rendering
+constexpr int          G_DEFAULT_PLUGIN_TAIL_TIME    = 2000; // milliseconds
+constexpr int          G_DEFAULT_STREAM_THRESHOLD    = 60;   // seconds, 0 = never stream from disk
+constexpr int          G_DEFAULT_PCM_CACHE_SIZE      = 2048; // MB, 0 = cache disabled
+constexpr int          G_DEFAULT_LOAD_GOVERNOR       = 80;   // percent of the block duration, 0 = disabled
+constexpr int          G_DEFAULT_STRETCHER_POOL      = 16;   // Max Sample channels in ELASTIC mode
+
+/* -- disk streaming -------------------------------------------------------- */
+constexpr int G_STREAM_HEAD_SECONDS  = 2;     // Preloaded in memory
+constexpr int G_STREAM_RING_SECONDS  = 4;     // Read ahead from disk
+constexpr int G_STREAM_CHUNK_FRAMES  = 8192;  // Frames read from disk at once
+constexpr int G_STREAM_WINDOW_FRAMES = 32768; // Max frames handed to a reader per call
+constexpr int G_STREAM_READ_MARGIN   = 4096;  // Extra frames for resampler/stretcher latency
+
+/* -- compact sample storage ------------------------------------------------ */
+constexpr int G_COMPACT_WINDOW_FRAMES = 8192; // Max frames expanded to float per call
+constexpr int G_COMPACT_READ_MARGIN   = 1024; // Extra frames for resampler/stretcher latency
+
+/* -- waveform peaks -------------------------------------------------------- */
+constexpr int G_PEAKS_BLOCK_FRAMES = 64; // Frames summarized by each Peak of the first level
+
+/* -- sample freezing ------------------------------------------------------- */
+constexpr int G_FREEZE_DELAY_MS      = 500;  // Time a Sample must stay untouched before being frozen
+constexpr int G_FREEZE_RENDER_MARGIN = 8192; // Extra frames for resampler/stretcher latency
+
+/* -- stretch streaming ----------------------------------------------------- */
+constexpr int G_STRETCH_RING_FRAMES  = 32768; // Rendered ahead of the playhead
+constexpr int G_STRETCH_CHUNK_FRAMES = 2048;  // Rendered at once
+
+/* -- load governor --------------------------------------------------------- */
+constexpr float G_LOAD_GOVERNOR_RESTORE     = 0.6f; // Restore quality when load drops below threshold * this
+constexpr int   G_LOAD_GOVERNOR_HOLD_MS     = 2000; // Min time spent in degraded mode
+constexpr int   G_LOAD_GOVERNOR_MAX_BACKOFF = 16;   // Max multiplier of the hold time on repeated overloads
 
 /* -- responses and return codes -------------------------------------------- */
 constexpr int G_RES_ERR_PROCESSING    = -6;
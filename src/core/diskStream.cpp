@@ -0,0 +1,335 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/diskStream.h"
+#include "src/core/const.h"
+#include "src/core/worker.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace giada::m
+{
+namespace
+{
+Worker                   reader_(G_DISK_READER_RATE_MS);
+std::mutex               streamsMutex_;
+std::condition_variable  streamsCv_;
+std::vector<DiskStream*> streams_;
+std::vector<DiskStream*> snapshot_;                // For the disk reader only
+const DiskStream*        filling_        = nullptr; // Guarded by streamsMutex_
+std::atomic<bool>        readerRunning_  = false;
+std::atomic<bool>        nonRealtime_    = false;
+std::atomic<int>         totalUnderruns_ = 0;
+
+/* -------------------------------------------------------------------------- */
+
+/* fillStream_
+Fills a single stream, unless it has been unregistered in the meantime. The
+lock is held only to mark the stream as being filled, not while reading from
+disk: the DiskStream destructor waits for that mark to go away. */
+
+bool fillStream_(DiskStream* stream)
+{
+	{
+		std::scoped_lock lock(streamsMutex_);
+		if (std::find(streams_.begin(), streams_.end(), stream) == streams_.end())
+			return false;
+		filling_ = stream;
+	}
+
+	const bool busy = stream->fill();
+
+	{
+		std::scoped_lock lock(streamsMutex_);
+		filling_ = nullptr;
+	}
+	streamsCv_.notify_all();
+
+	return busy;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* readStreams_
+Keeps filling all registered streams until there's nothing left to read. Works
+on a snapshot of the list, so that streams can be added and removed while
+reading. */
+
+void readStreams_()
+{
+	bool busy = true;
+	while (busy)
+	{
+		busy = false;
+		{
+			std::scoped_lock lock(streamsMutex_);
+			snapshot_.assign(streams_.begin(), streams_.end());
+		}
+		for (DiskStream* stream : snapshot_)
+			busy |= fillStream_(stream);
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::unique_ptr<DiskStream> DiskStream::open(const std::string& path, Frame start, Frame capacity)
+{
+	SF_INFO  header;
+	SNDFILE* file = sf_open(path.c_str(), SFM_READ, &header);
+
+	if (file == nullptr)
+	{
+		u::log::print("[DiskStream::open] unable to read {}. {}\n", path, sf_strerror(file));
+		return nullptr;
+	}
+
+	if (header.channels > G_MAX_IO_CHANS || header.seekable == 0)
+	{
+		u::log::print("[DiskStream::open] {} can't be streamed\n", path);
+		sf_close(file);
+		return nullptr;
+	}
+
+	return std::make_unique<DiskStream>(file, header.channels, header.frames, start, capacity);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DiskStream::startReader()
+{
+	readerRunning_.store(true);
+	reader_.start(readStreams_);
+}
+
+void DiskStream::stopReader()
+{
+	reader_.stop();
+	readerRunning_.store(false);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DiskStream::setNonRealtime(bool v) { nonRealtime_.store(v); }
+int  DiskStream::getTotalUnderruns() { return totalUnderruns_.load(); }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+DiskStream::DiskStream(SNDFILE* file, int channels, Frame length, Frame start, Frame capacity)
+: m_file(file)
+, m_fileChannels(channels)
+, m_length(length)
+, m_capacity(capacity)
+, m_ring(capacity, G_MAX_IO_CHANS)
+, m_window(G_STREAM_WINDOW_FRAMES, G_MAX_IO_CHANS)
+, m_fileBuffer(G_STREAM_CHUNK_FRAMES * channels)
+, m_base(start)
+, m_end(start)
+, m_wanted(start)
+, m_reading(false)
+, m_underruns(0)
+{
+	assert(m_file != nullptr);
+	assert(m_capacity >= G_STREAM_WINDOW_FRAMES);
+
+	sf_seek(m_file, start, SEEK_SET);
+
+	std::scoped_lock lock(streamsMutex_);
+	streams_.push_back(this);
+}
+
+/* -------------------------------------------------------------------------- */
+
+DiskStream::~DiskStream()
+{
+	/* Unregister first, then wait for the disk reader in case it is filling
+	this very stream: nobody touches it afterwards. */
+
+	{
+		std::unique_lock lock(streamsMutex_);
+		std::erase(streams_, this);
+		streamsCv_.wait(lock, [this]()
+		{ return filling_ != this; });
+	}
+
+	sf_close(m_file);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame             DiskStream::getLength() const { return m_length; }
+Frame             DiskStream::getCapacity() const { return m_capacity; }
+int               DiskStream::getUnderruns() const { return m_underruns.load(); }
+mcl::AudioBuffer& DiskStream::getWindow() { return m_window; }
+
+/* -------------------------------------------------------------------------- */
+
+Frame DiskStream::read(mcl::AudioBuffer& dest, Frame start, Frame count, Frame destOffset)
+{
+	assert(start >= 0);
+	assert(start + count <= m_length);
+
+	Frame frames = copy(dest, start, count, destOffset);
+
+	/* Offline rendering: no deadlines here, just wait for the disk reader to
+	catch up. */
+
+	while (frames < count && nonRealtime_.load() && readerRunning_.load())
+	{
+		prefetch(start + frames);
+		std::this_thread::yield();
+		frames += copy(dest, start + frames, count - frames, destOffset + frames);
+	}
+
+	if (frames < count)
+	{
+		prefetch(start + frames);
+		m_underruns.fetch_add(1, std::memory_order_relaxed);
+		totalUnderruns_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return frames;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DiskStream::prefetch(Frame f)
+{
+	m_wanted.store(std::clamp(f, 0, m_length), std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool DiskStream::fill()
+{
+	const Frame wanted = m_wanted.load(std::memory_order_relaxed);
+	Frame       base   = m_base.load(std::memory_order_relaxed);
+	Frame       end    = m_end.load(std::memory_order_relaxed);
+
+	/* The consumer has jumped outside the buffered region (e.g. a loop restart):
+	invalidate the ring buffer and read again from the new position. */
+
+	if (wanted < base || wanted > end)
+	{
+		/* Collapse the readable region first, so that the consumer finds it
+		empty with either the old or the new base. Then publish the new base and
+		wait for any copy still working on the old region. Only then the end can
+		move to the new position. */
+
+		m_end.store(std::min(base, wanted));
+		m_base.store(wanted);
+		waitForConsumer();
+		m_end.store(wanted);
+		if (sf_seek(m_file, wanted, SEEK_SET) == -1)
+		{
+			u::log::print("[DiskStream::fill] unable to seek to frame {}\n", wanted);
+			return false;
+		}
+		base = end = wanted;
+	}
+
+	const Frame limit = std::min(m_length, wanted + m_capacity);
+	if (end >= limit)
+		return false;
+
+	/* Frames about to be written overwrite the oldest ones in the ring buffer.
+	Move the base forward first, then make sure the consumer is not reading the
+	old frames in the meantime. */
+
+	const Frame frames  = std::min(G_STREAM_CHUNK_FRAMES, limit - end);
+	const Frame newBase = std::max(base, end + frames - m_capacity);
+	if (newBase != base)
+	{
+		m_base.store(newBase);
+		waitForConsumer();
+	}
+
+	const Frame read = static_cast<Frame>(sf_readf_float(m_file, m_fileBuffer.data(), frames));
+	if (read <= 0)
+		return false;
+
+	/* Libsndfile returns interleaved frames, while the ring buffer is planar and
+	always stereo: deinterleave and duplicate mono files on the fly. */
+
+	for (Frame i = 0; i < read; ++i)
+	{
+		const Frame pos = (end + i) % m_capacity;
+		for (int ch = 0; ch < G_MAX_IO_CHANS; ++ch)
+			m_ring.getChannelView(ch).data()[pos] = m_fileBuffer[i * m_fileChannels + std::min(ch, m_fileChannels - 1)];
+	}
+
+	m_end.store(end + read, std::memory_order_release);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame DiskStream::copy(mcl::AudioBuffer& dest, Frame start, Frame count, Frame destOffset)
+{
+	/* The 'reading' flag must be raised before looking at the buffered region:
+	see the counterpart in fill() and waitForConsumer(). */
+
+	m_reading.store(true);
+
+	const Frame base   = m_base.load();
+	const Frame end    = m_end.load(std::memory_order_acquire);
+	Frame       frames = 0;
+
+	if (start >= base && start < end)
+	{
+		frames            = std::min(count, end - start);
+		const Frame pos   = start % m_capacity;
+		const Frame first = std::min(frames, m_capacity - pos);
+
+		dest.setAll(m_ring, first, pos, destOffset);
+		if (first < frames) // Wrap around
+			dest.setAll(m_ring, frames - first, 0, destOffset + first);
+	}
+
+	m_reading.store(false, std::memory_order_release);
+
+	return frames;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DiskStream::waitForConsumer() const
+{
+	while (m_reading.load())
+		std::this_thread::yield();
+}
+} // namespace giada::m
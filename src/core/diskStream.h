@@ -0,0 +1,146 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_DISK_STREAM_H
+#define G_DISK_STREAM_H
+
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/types.h"
+#include <atomic>
+#include <memory>
+#include <sndfile.h>
+#include <string>
+#include <vector>
+
+namespace giada::m
+{
+/* DiskStream
+Feeds a long sample from disk, so that only a small head region must live in
+memory (see Wave). Frames are read ahead by a background disk reader thread into
+a lock-free ring buffer, starting from the position requested by the consumer
+with prefetch(). Single producer (the disk reader), single consumer (the thread
+that renders the channel owning the Wave): the consumer never blocks, unless
+setNonRealtime(true) is in effect. */
+
+class DiskStream final
+{
+public:
+	/* open
+	Opens file 'path' for streaming, starting at frame 'start'. The ring buffer
+	holds 'capacity' frames. Returns nullptr on failure. */
+
+	static std::unique_ptr<DiskStream> open(const std::string& path, Frame start, Frame capacity);
+
+	/* startReader, stopReader
+	Starts or stops the background disk reader thread, shared by all streams. */
+
+	static void startReader();
+	static void stopReader();
+
+	/* setNonRealtime
+	Makes read() wait for the disk reader instead of reporting an underrun. Use
+	it for offline rendering only. */
+
+	static void setNonRealtime(bool);
+
+	/* getTotalUnderruns
+	Returns the number of underruns occurred across all streams so far. */
+
+	static int getTotalUnderruns();
+
+	DiskStream(SNDFILE*, int channels, Frame length, Frame start, Frame capacity);
+	DiskStream(const DiskStream&)            = delete;
+	DiskStream(DiskStream&&)                 = delete;
+	DiskStream& operator=(const DiskStream&) = delete;
+	DiskStream& operator=(DiskStream&&)      = delete;
+	~DiskStream();
+
+	Frame getLength() const;
+	Frame getCapacity() const;
+	int   getUnderruns() const;
+
+	/* getWindow
+	Returns a scratch buffer the consumer can copy the streamed frames into
+	before handing them to a resampler or a stretcher. Consumer thread only. */
+
+	mcl::AudioBuffer& getWindow();
+
+	/* read
+	Copies 'count' frames starting at absolute frame 'start' into 'dest', at
+	'destOffset'. Returns the number of frames actually copied: less than
+	'count' means underrun, and the missing frames are requested to the disk
+	reader. Consumer thread only. */
+
+	Frame read(mcl::AudioBuffer& dest, Frame start, Frame count, Frame destOffset);
+
+	/* prefetch
+	Tells the disk reader where the consumer will read next. Consumer thread
+	only. */
+
+	void prefetch(Frame);
+
+	/* fill
+	Reads the next chunk of frames from disk, if needed. Returns true if some
+	work has been done. Disk reader thread only. */
+
+	bool fill();
+
+private:
+	/* copy
+	Copies as many frames as currently available in the ring buffer, starting
+	from 'start'. Consumer thread only. */
+
+	Frame copy(mcl::AudioBuffer& dest, Frame start, Frame count, Frame destOffset);
+
+	/* waitForConsumer
+	Spins until the consumer is done reading from the ring buffer. Disk reader
+	thread only. */
+
+	void waitForConsumer() const;
+
+	SNDFILE*           m_file;
+	int                m_fileChannels;
+	Frame              m_length;
+	Frame              m_capacity;
+	mcl::AudioBuffer   m_ring;
+	mcl::AudioBuffer   m_window;
+	std::vector<float> m_fileBuffer; // Interleaved frames read from disk
+
+	/* m_base, m_end
+	Absolute frames [m_base, m_end) currently available in the ring buffer.
+	Written by the disk reader only. */
+
+	std::atomic<Frame> m_base;
+	std::atomic<Frame> m_end;
+
+	std::atomic<Frame> m_wanted;  // Next frame the consumer needs
+	std::atomic<bool>  m_reading; // Consumer is copying from the ring buffer
+	std::atomic<int>   m_underruns;
+};
+} // namespace giada::m
+
+#endif
@@ -0,0 +1,81 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/dspLoad.h"
+#include <algorithm>
+
+namespace giada::m
+{
+DspLoad::Timer::Timer(DspLoad& d)
+: m_dspLoad(d)
+, m_start(Clock::now())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+DspLoad::Timer::~Timer()
+{
+	m_dspLoad.add(Clock::now() - m_start);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+DspLoad::Value DspLoad::get(int bufferSize, int sampleRate) const
+{
+	if (bufferSize <= 0 || sampleRate <= 0)
+		return {};
+
+	const float blockDuration = (static_cast<float>(bufferSize) / sampleRate) * 1e6f; // in microseconds
+
+	return {
+	    .average = (m_average.load(std::memory_order_relaxed) / blockDuration) * 100.0f,
+	    .max     = (m_max.load(std::memory_order_relaxed) / blockDuration) * 100.0f};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DspLoad::add(Clock::duration d)
+{
+	const float elapsed = std::chrono::duration<float, std::micro>(d).count();
+	const float average = m_average.load(std::memory_order_relaxed);
+
+	m_average.store(average + (elapsed - average) * ALPHA, std::memory_order_relaxed);
+
+	m_windowMax = std::max(m_windowMax, elapsed);
+	m_max.store(std::max(m_windowMax, m_prevWindowMax), std::memory_order_relaxed);
+
+	if (++m_blocks < WINDOW)
+		return;
+
+	m_prevWindowMax = m_windowMax;
+	m_windowMax     = 0.0f;
+	m_blocks        = 0;
+}
+} // namespace giada::m
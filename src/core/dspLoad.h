@@ -0,0 +1,111 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_DSP_LOAD_H
+#define G_DSP_LOAD_H
+
+#include <atomic>
+#include <chrono>
+
+namespace giada::m
+{
+/* DspLoad
+Lock-free accounting of the time spent processing audio by a single component
+(e.g. a channel or a plug-in), as rolling average and maximum over the last
+blocks. Written by one real-time thread at a time, read by any other thread. */
+
+class DspLoad final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/* Value
+	Time spent processing audio, as a percentage of the audio block duration. */
+
+	struct Value
+	{
+		float average = 0.0f;
+		float max     = 0.0f;
+	};
+
+	/* Timer
+	Measures the time elapsed between its construction and destruction, and adds
+	it to the given DspLoad object. */
+
+	class Timer
+	{
+	public:
+		Timer(DspLoad&);
+		~Timer();
+
+	private:
+		DspLoad&          m_dspLoad;
+		Clock::time_point m_start;
+	};
+
+	DspLoad() = default;
+
+	/* get
+	Returns the current load, given the audio block size and the sample rate. */
+
+	Value get(int bufferSize, int sampleRate) const;
+
+	/* add
+	Accounts the time spent processing a single audio block. Real-time thread
+	only. */
+
+	void add(Clock::duration);
+
+private:
+	/* ALPHA
+	Smoothing factor of the exponential moving average. */
+
+	static constexpr float ALPHA = 0.05f;
+
+	/* WINDOW
+	Number of blocks the maximum value is computed on. */
+
+	static constexpr int WINDOW = 256;
+
+	/* m_average, m_max
+	Shared values, in microseconds. */
+
+	std::atomic<float> m_average = 0.0f;
+	std::atomic<float> m_max     = 0.0f;
+
+	/* m_windowMax, m_prevWindowMax, m_blocks
+	Real-time thread only. The maximum is published as the largest value between
+	the current and the previous window, so that it never drops to zero at the
+	beginning of a new window. */
+
+	float m_windowMax     = 0.0f;
+	float m_prevWindowMax = 0.0f;
+	int   m_blocks        = 0;
+};
+} // namespace giada::m
+
+#endif
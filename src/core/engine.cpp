@@ -27,13 +27,19 @@
 #include "src/core/engine.h"
 #include "src/core/conf.h"
 #include "src/core/confFactory.h"
+#include "src/core/diskStream.h"
+#include "src/core/freezer.h"
 #include "src/core/model/model.h"
+#include "src/core/pcmCache.h"
+#include "src/core/peaks.h"
 #include "src/core/rendering/midiOutput.h"
+#include "src/core/stretchStream.h"
 #include "src/utils/fs.h"
 #include "src/utils/log.h"
 #include "src/utils/string.h"
 #include <fmt/core.h>
 #include <memory>
+#include <utility>
 
 namespace giada::m
 {
@@ -50,7 +56,7 @@ Engine::Engine()
 , m_mixer(m_model)
 , m_actionManager(m_model)
 , m_channelManager(m_model, m_midiMapper, m_kernelMidi)
-, m_recorder(m_sequencer, m_channelManager, m_mixer, m_actionManager)
+, m_recorder(m_model, m_sequencer, m_channelManager, m_mixer, m_actionManager)
 , m_midiDispatcher(m_model)
 #ifdef WITH_AUDIO_JACK
 , m_renderer(m_sequencer, m_mixer, m_pluginHost, m_jackSynchronizer, m_jackTransport, m_kernelMidi)
@@ -58,13 +64,14 @@ Engine::Engine()
 , m_renderer(m_sequencer, m_mixer, m_pluginHost, m_kernelMidi)
 #endif
 , m_reactor(m_model, m_midiMapper, m_actionManager, m_kernelMidi)
-, m_mainApi(m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder, m_actionManager, m_reactor)
+, m_bouncer(m_model, m_renderer, m_mixer, m_pluginHost, m_sequencer, m_channelManager)
+, m_mainApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder, m_actionManager, m_reactor)
 , m_channelsApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_channelManager, m_recorder, m_actionManager, m_pluginHost, m_pluginManager, m_reactor)
 , m_pluginsApi(m_kernelAudio, m_pluginManager, m_pluginHost, m_model)
 , m_sampleEditorApi(m_kernelAudio, m_model, m_channelManager, m_reactor, m_sequencer)
 , m_actionEditorApi(*this, m_sequencer, m_actionManager)
 , m_ioApi(m_model, m_midiDispatcher)
-, m_storageApi(*this, m_model, m_pluginManager, m_midiSynchronizer, m_mixer, m_channelManager, m_kernelAudio, m_sequencer)
+, m_storageApi(*this, m_model, m_pluginManager, m_midiSynchronizer, m_mixer, m_channelManager, m_kernelAudio, m_sequencer, m_bouncer)
 , m_configApi(m_model, m_kernelAudio, m_kernelMidi, m_midiMapper, m_midiSynchronizer)
 {
 	m_kernelAudio.onAudioCallback = [this](mcl::AudioBuffer& out, const mcl::AudioBuffer& in)
@@ -101,6 +108,14 @@ Engine::Engine()
 		m_midiSynchronizer.receive(e, m_sequencer.getTimeSignature().beats);
 		onMidiReceived();
 	};
+	m_kernelMidi.onInputCycle = [this]()
+	{
+		/* Swaps caused by MIDI-learned knobs are coalesced on the MIDI thread
+		(see MidiDispatcher): publish the last ones, once the rate limit allows
+		it. */
+
+		m_model.flushCoalesced();
+	};
 	m_kernelMidi.onMidiSent = [this]()
 	{
 		assert(onMidiSent != nullptr);
@@ -188,12 +203,24 @@ Engine::Engine()
 			});
 	};
 
+	m_renderer.onResamplerFallback = [this](bool fallback, float load)
+	{
+		m_eventDispatcher.pumpEvent([this, fallback, load]()
+		{
+			registerThread(Thread::EVENTS, /*realtime=*/false);
+			if (fallback)
+				u::log::print("[Engine] DSP load at {:.1f}%, pitched channels switched to fallback resampling\n", load);
+			else
+				u::log::print("[Engine] DSP load at {:.1f}%, pitched channels back to configured resampling\n", load);
+		});
+	};
+
 	m_channelManager.onChannelPlayStatusChanged = [this](ID channelId, ChannelStatus status)
 	{
 		m_eventDispatcher.pumpEvent([this, channelId, status]()
 		{
 			registerThread(Thread::EVENTS, /*realtime=*/false);
-			const Channel& ch = m_model.get().tracks.getChannel(channelId);
+			const Channel& ch = std::as_const(m_model).get().tracks.getChannel(channelId);
 			if (ch.midiLightning.enabled)
 				rendering::sendMidiLightningStatus(ch.id, ch.midiLightning, status, /*isAudible=*/true /* TODO!!! */, m_midiMapper);
 		});
@@ -242,6 +269,9 @@ Engine::Engine()
 
 			/* Also stop all those sample channels that don't have audio in it. */
 			m_reactor.killEmptySampleChannels(newScene);
+
+			/* Samples in the new scene might need to be pre-rendered. */
+			m_model.prerenderSamples();
 		});
 
 		/* Rebuild UI when the scene has changed to update channels. */
@@ -255,6 +285,11 @@ Engine::Engine()
 		onModelSwap(t);
 	};
 
+	m_model.onCompileRenderGraph = [this](const rendering::RenderGraph& graph)
+	{
+		m_renderer.reserveRenderState(graph.getNodes().size());
+	};
+
 	rendering::registerOnSendMidiCb([this](ID channelId)
 	{
 		onMidiSentFromChannel(channelId);
@@ -281,14 +316,7 @@ void Engine::init(const Conf& conf)
 
 	m_kernelAudio.init();
 
-	const int sampleRate = m_kernelAudio.getSampleRate();
-	const int bufferSize = m_kernelAudio.getBufferSize();
-
-	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
-	m_channelManager.reset(sampleRate, bufferSize);
-	m_sequencer.reset(sampleRate);
-	m_pluginHost.reset(bufferSize);
-	m_pluginManager.reset();
+	initRendering();
 
 	m_mixer.enable();
 	m_kernelAudio.startStream();
@@ -306,6 +334,45 @@ void Engine::init(const Conf& conf)
 
 /* -------------------------------------------------------------------------- */
 
+void Engine::initHeadless(const Conf& conf)
+{
+	registerThread(Thread::MAIN, /*realtime=*/false);
+
+	m_model.init();
+	m_model.load(conf);
+
+	initRendering();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Engine::initRendering()
+{
+	const model::Document& document = m_model.get();
+
+	const int sampleRate = m_kernelAudio.getSampleRate();
+	const int bufferSize = m_kernelAudio.getBufferSize();
+
+	m_model.resetStretcherPool(document.kernelAudio.stretcherPool, sampleRate);
+	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
+	m_channelManager.reset(sampleRate, bufferSize);
+	m_sequencer.reset(sampleRate);
+	m_pluginHost.reset(bufferSize);
+	m_pluginManager.reset();
+	m_renderer.startWorkers(document.kernelAudio.renderThreads);
+	if (document.renderGraph != nullptr)
+		m_renderer.reserveRenderState(document.renderGraph->getNodes().size());
+	DiskStream::startReader();
+	Peaks::startBuilder();
+	Freezer::startRenderer();
+	m_model.startReclaimer();
+	if (document.kernelAudio.asyncStretch)
+		StretchStream::startWorker();
+	pcmCache::init(u::fs::getPcmCachePath(), document.kernelAudio.pcmCacheSize * 1024ull * 1024ull);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Engine::reset()
 {
 	/* Managers first, due to the internal ID numbering. */
@@ -339,6 +406,14 @@ void Engine::shutdown(Conf& conf)
 		u::log::print("[Engine::shutdown] Mixer closed\n");
 	}
 
+	m_renderer.stopWorkers();
+
+	DiskStream::stopReader();
+	Peaks::stopBuilder();
+	Freezer::stopRenderer();
+	StretchStream::stopWorker();
+	m_model.stopReclaimer();
+
 	m_model.store(conf);
 
 	/* It's safer and cleaner to free all plug-ins before closing the app. Some
@@ -365,6 +440,8 @@ void Engine::resume()
 void Engine::debug()
 {
 	m_model.debug();
+	if (const rendering::RenderGraph* graph = m_model.get().renderGraph.get(); graph != nullptr)
+		m_renderer.debug(*graph);
 }
 #endif
 
@@ -36,6 +36,7 @@
 #include "src/core/api/pluginsApi.h"
 #include "src/core/api/sampleEditorApi.h"
 #include "src/core/api/storageApi.h"
+#include "src/core/bouncer.h"
 #include "src/core/channels/channelFactory.h"
 #include "src/core/channels/channelManager.h"
 #include "src/core/eventDispatcher.h"
@@ -79,6 +80,12 @@ public:
 
 	void init(const Conf&);
 
+	/* initHeadless
+	Initializes only what offline rendering needs (see Bouncer): no audio or
+	MIDI device is opened and the Mixer stays disabled. */
+
+	void initHeadless(const Conf&);
+
 	/* reset
 	Resets all sub-components to the initial state. Useful when Giada needs to
 	be brought back to the startup state. */
@@ -124,6 +131,12 @@ public:
 private:
 	void registerThread(Thread, bool isRealtime) const;
 
+	/* initRendering
+	Sets up the rendering components and their background threads, according
+	to the current sample rate and buffer size. */
+
+	void initRendering();
+
 	model::Model           m_model;
 	KernelAudio            m_kernelAudio;
 	KernelMidi             m_kernelMidi;
@@ -144,6 +157,7 @@ private:
 #endif
 	rendering::Renderer m_renderer;
 	rendering::Reactor  m_reactor;
+	Bouncer             m_bouncer;
 
 	MainApi         m_mainApi;
 	ChannelsApi     m_channelsApi;
@@ -31,7 +31,7 @@
 namespace giada::m
 {
 EventDispatcher::EventDispatcher()
-: m_worker(G_EVENT_DISPATCHER_RATE_MS)
+: m_worker(G_EVENT_DISPATCHER_RATE_MS, G_WORKER_RT_POLL_MS)
 , m_eventQueue(G_MAX_DISPATCHER_EVENTS)
 {
 }
@@ -48,7 +48,10 @@ void EventDispatcher::start()
 
 bool EventDispatcher::pumpEvent(const std::function<void()>& f)
 {
-	return m_eventQueue.try_enqueue(f);
+	if (!m_eventQueue.try_enqueue(f))
+		return false;
+	m_worker.notify_RT();
+	return true;
 }
 
 /* -------------------------------------------------------------------------- */
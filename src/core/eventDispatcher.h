@@ -54,7 +54,9 @@ public:
 	void start();
 
 	/* pumpEvent
-	Inserts a new event in the event queue. Returns false if the queue is full. */
+	Inserts a new event in the event queue and flags the worker, which runs it
+	within G_WORKER_RT_POLL_MS. Realtime-safe. Returns false if the queue is
+	full. */
 
 	bool pumpEvent(const Event&);
 
@@ -0,0 +1,285 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/freezer.h"
+#include "src/core/const.h"
+#include "src/core/stretcher.h"
+#include "src/core/wave.h"
+#include "src/core/worker.h"
+#include "src/deps/mcl-utils/src/time.hpp"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace utils = mcl::utils;
+
+namespace giada::m
+{
+namespace
+{
+Worker                              renderer_(G_FREEZER_RATE_MS);
+std::mutex                          queueMutex_;
+std::vector<std::weak_ptr<Freezer>> queue_;
+std::atomic<bool>                   rendererRunning_ = false;
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void Freezer::startRenderer()
+{
+	rendererRunning_.store(true);
+	renderer_.start([]()
+	{
+		std::vector<std::weak_ptr<Freezer>> pending;
+		{
+			std::scoped_lock lock(queueMutex_);
+			pending.swap(queue_);
+		}
+
+		/* Freezers whose channel is gone in the meantime are just skipped. Those
+		still waiting for their Sample to settle go back to the queue. */
+
+		std::vector<std::weak_ptr<Freezer>> later;
+		for (const std::weak_ptr<Freezer>& f : pending)
+			if (std::shared_ptr<Freezer> freezer = f.lock(); freezer != nullptr && !freezer->process(std::chrono::milliseconds(G_FREEZE_DELAY_MS)))
+				later.push_back(f);
+
+		std::scoped_lock lock(queueMutex_);
+		queue_.insert(queue_.end(), later.begin(), later.end());
+	});
+}
+
+void Freezer::stopRenderer()
+{
+	renderer_.stop();
+	rendererRunning_.store(false);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Freezer::Freezer(Resampler::Quality quality, int sampleRate)
+: m_quality(quality)
+, m_sampleRate(sampleRate)
+, m_state(State::EMPTY)
+, m_position(0)
+, m_expected(-1)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Freezer::isFrozen(const Sample& sample) const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_state.load() != State::EMPTY && m_key == makeKey(sample);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Freezer::request(const Sample& sample)
+{
+	const Key key = makeKey(sample);
+	{
+		std::scoped_lock lock(m_mutex);
+
+		if (m_pending ? m_pending->key == key : m_key == key)
+			return;
+
+		/* A Freezer with a pending Job is already in the renderer queue. */
+
+		const bool queued = m_pending.has_value();
+
+		m_pending     = Job{key, key.source != nullptr ? sample.wave->getSharedBuffer() : nullptr};
+		m_requestTime = std::chrono::steady_clock::now();
+
+		if (queued)
+			return;
+	}
+
+	if (!rendererRunning_.load())
+	{
+		process(std::chrono::milliseconds(0));
+		return;
+	}
+
+	std::scoped_lock lock(queueMutex_);
+	queue_.push_back(weak_from_this());
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::optional<rendering::ReadResult> Freezer::a_read(const Sample& sample, mcl::AudioBuffer& dest, Frame start, Frame offset)
+{
+	State state = State::READY;
+	if (!m_state.compare_exchange_strong(state, State::READING))
+		return {};
+
+	if (m_key != makeKey(sample))
+	{
+		m_state.store(State::READY);
+		return {};
+	}
+
+	/* Frozen frames map linearly to the Wave frames in the Sample range. The
+	position is recomputed from 'start' only after a jump (e.g. a rewind or the
+	first read), so that rounding never makes playback skip or repeat frames. */
+
+	const Frame  frames = m_buffer.countFrames();
+	const double ratio  = (m_key.b - m_key.a) / static_cast<double>(frames);
+
+	if (start != m_expected)
+		m_position = std::clamp(static_cast<Frame>(std::lround((start - m_key.a) / ratio)), 0, frames);
+
+	const Frame generated = std::min(dest.countFrames() - offset, frames - m_position);
+
+	dest.setAll(m_buffer, generated, m_position, offset);
+
+	m_position += generated;
+	m_expected = m_position == frames ? m_key.b : m_key.a + static_cast<Frame>(std::lround(m_position * ratio));
+
+	m_state.store(State::READY);
+
+	return rendering::ReadResult{m_expected - start, generated, true};
+}
+
+/* -------------------------------------------------------------------------- */
+
+Freezer::Key Freezer::makeKey(const Sample& sample)
+{
+	if (sample.wave == nullptr || !sample.wave->isResident() || sample.range.getLength() <= 0)
+		return {};
+	if (sample.playbackMode == PlaybackMode::TAPE && sample.pitch == 1.0f)
+		return {};
+
+	return {
+	    .source = &std::as_const(*sample.wave).getBuffer(),
+	    .a      = sample.range.getA(),
+	    .b      = sample.range.getB(),
+	    .pitch  = sample.pitch,
+	    .time   = sample.time,
+	    .mode   = sample.playbackMode};
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Freezer::process(std::chrono::milliseconds delay)
+{
+	Job job;
+	{
+		std::scoped_lock lock(m_mutex);
+		if (!m_pending)
+			return true;
+		if (std::chrono::steady_clock::now() - m_requestTime < delay)
+			return false;
+		job = *m_pending;
+	}
+
+	mcl::AudioBuffer frozen = job.source != nullptr ? render(job) : mcl::AudioBuffer();
+
+	std::scoped_lock lock(m_mutex);
+
+	/* Requested again while rendering: start over later. */
+
+	if (m_pending->key != job.key)
+		return false;
+
+	publish(job, std::move(frozen));
+	m_pending.reset();
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Freezer::publish(const Job& job, mcl::AudioBuffer&& frozen)
+{
+	/* Take the frozen audio away from the realtime thread first. It holds it for
+	one read at most. */
+
+	for (State state = m_state.load(); state != State::EMPTY; state = m_state.load())
+		if (state == State::READING || !m_state.compare_exchange_strong(state, State::EMPTY))
+			utils::time::sleep(1);
+
+	m_key      = job.key;
+	m_source   = job.source;
+	m_buffer   = std::move(frozen);
+	m_position = 0;
+	m_expected = -1;
+
+	if (m_key.source == nullptr || m_buffer.countFrames() == 0)
+		return;
+
+	m_state.store(State::READY);
+
+	u::log::print("[Freezer::publish] Sample frozen, {} frames\n", m_buffer.countFrames());
+}
+
+/* -------------------------------------------------------------------------- */
+
+mcl::AudioBuffer Freezer::render(const Job& job) const
+{
+	const Key&              key    = job.key;
+	const mcl::AudioBuffer& source = *job.source;
+	const float             ratio  = key.mode == PlaybackMode::ELASTIC ? 1.0f / key.time : key.pitch;
+	const Frame             length = static_cast<Frame>(std::ceil((key.b - key.a) / ratio)) + G_FREEZE_RENDER_MARGIN;
+
+	mcl::AudioBuffer out(length, G_MAX_IO_CHANS);
+	Frame            generated = 0;
+
+	/* The output buffer is larger than needed: both the resampler and the
+	stretcher stop once the input range has been fully consumed and drained. */
+
+	if (key.mode == PlaybackMode::TAPE)
+	{
+		const Resampler resampler(m_quality);
+		generated = static_cast<Frame>(resampler.process(source, key.a, key.b, out, 0, key.pitch).generated);
+	}
+	else // PlaybackMode::ELASTIC
+	{
+		Stretcher stretcher(m_sampleRate);
+		Frame     used = 0;
+		while (generated < length)
+		{
+			const Stretcher::Result res = stretcher.process(source, key.a + used, key.b, out, generated, key.time, key.pitch);
+			used += static_cast<Frame>(res.used);
+			generated += static_cast<Frame>(res.generated);
+			if (res.finished || (res.used == 0 && res.generated == 0))
+				break;
+		}
+	}
+
+	mcl::AudioBuffer frozen(generated, G_MAX_IO_CHANS);
+	frozen.setAll(out, generated, 0, 0);
+	return frozen;
+}
+} // namespace giada::m
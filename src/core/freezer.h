@@ -0,0 +1,167 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_FREEZER_H
+#define G_FREEZER_H
+
+#include "src/core/rendering/sampleRendering.h"
+#include "src/core/resampler.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/types.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace giada::m
+{
+/* Freezer
+Pre-renders the pitched or stretched version of a Sample, so that it can be
+played back with a plain copy instead of running the resampler or the stretcher
+in real time. Rendering happens in a background thread, once the Sample
+properties have been left untouched for G_FREEZE_DELAY_MS: the channel plays
+live in the meantime, e.g. while a knob is being dragged. One Freezer per
+sample channel, living in ChannelShared. */
+
+class Freezer final : public std::enable_shared_from_this<Freezer>
+{
+public:
+	/* startRenderer, stopRenderer
+	Starts or stops the background renderer thread, shared by all Freezers. */
+
+	static void startRenderer();
+	static void stopRenderer();
+
+	Freezer(Resampler::Quality, int sampleRate);
+	Freezer(const Freezer&)            = delete;
+	Freezer(Freezer&&)                 = delete;
+	Freezer& operator=(const Freezer&) = delete;
+	Freezer& operator=(Freezer&&)      = delete;
+
+	/* isFrozen
+	True if the frozen version of 'sample' is ready to be played. */
+
+	bool isFrozen(const Sample&) const;
+
+	/* request
+	Asks for 'sample' to be frozen. Does nothing if it's already frozen or
+	being frozen, or if it doesn't need it (no Wave, no pitch nor stretch, Wave
+	not fully in memory): any previously frozen audio is released then. If the
+	renderer thread is not running (e.g. no Engine around) the Sample is frozen
+	right away. */
+
+	void request(const Sample&);
+
+	/* a_read
+	Reads the frozen version of 'sample' into 'dest' from frame 'offset',
+	starting at frame 'start' of the Wave. Returns nothing if 'sample' is not
+	frozen: render it live then. Realtime thread only. */
+
+	std::optional<rendering::ReadResult> a_read(const Sample&, mcl::AudioBuffer& dest, Frame start, Frame offset);
+
+private:
+	/* Key
+	Everything a frozen buffer depends on. The audio data is identified by
+	address: the Freezer keeps it alive, so the address can't be reused by
+	another buffer, and any write to a shared Wave buffer makes a private copy
+	of it first (see Wave::getBuffer()). */
+
+	struct Key
+	{
+		bool operator==(const Key&) const = default;
+
+		const mcl::AudioBuffer* source = nullptr; // Nullptr = nothing to freeze
+		Frame                   a      = 0;
+		Frame                   b      = 0;
+		float                   pitch  = 1.0f;
+		float                   time   = 1.0f;
+		PlaybackMode            mode   = PlaybackMode::TAPE;
+	};
+
+	/* Job
+	A pending freeze request. */
+
+	struct Job
+	{
+		Key                                     key;
+		std::shared_ptr<const mcl::AudioBuffer> source;
+	};
+
+	enum class State
+	{
+		EMPTY,
+		READY,  // Frozen audio can be read
+		READING // Frozen audio is being read by the realtime thread
+	};
+
+	static Key makeKey(const Sample&);
+
+	/* process
+	Renders the pending Job, if any, once 'delay' has passed since it was
+	requested. Returns false if the Job must be processed again later. */
+
+	bool process(std::chrono::milliseconds delay);
+
+	/* render
+	Renders the Sample range described by a Job with the resampler or the
+	stretcher, in one go. */
+
+	mcl::AudioBuffer render(const Job&) const;
+
+	/* publish
+	Replaces the frozen audio with a new one, as soon as the realtime thread is
+	not reading it. Must be called with m_mutex locked. */
+
+	void publish(const Job&, mcl::AudioBuffer&&);
+
+	const Resampler::Quality m_quality;
+	const int                m_sampleRate;
+
+	/* Pending Job, shared with the thread that calls request(). */
+
+	mutable std::mutex                    m_mutex;
+	std::optional<Job>                    m_pending;
+	std::chrono::steady_clock::time_point m_requestTime;
+
+	/* Frozen audio. Written only in EMPTY state, read by the realtime thread
+	only in READING state. */
+
+	std::atomic<State>                      m_state;
+	Key                                     m_key;
+	std::shared_ptr<const mcl::AudioBuffer> m_source;
+	mcl::AudioBuffer                        m_buffer;
+
+	/* Playback position in m_buffer, and the Wave frame it maps to. Realtime
+	thread only. */
+
+	Frame m_position;
+	Frame m_expected;
+};
+} // namespace giada::m
+
+#endif
@@ -39,20 +39,40 @@
 #define CATCH_CONFIG_RUNNER
 #include "tests/ActionManager.cpp"
 #include "tests/channelFactory.cpp"
+#include "tests/channelParams.cpp"
+#include "tests/cow.cpp"
+#include "tests/diskStream.cpp"
+#include "tests/dspLoad.cpp"
+#include "tests/freezer.cpp"
+#include "tests/loadGovernor.cpp"
 #include "tests/midiEvent.cpp"
 #include "tests/midiLightning.cpp"
 #include "tests/patch.cpp"
+#include "tests/pcmCache.cpp"
+#include "tests/peaks.cpp"
+#include "tests/reclaimer.cpp"
+#include "tests/renderGraph.cpp"
+#include "tests/resampler.cpp"
+#include "tests/rtEpoch.cpp"
 #include "tests/sampleRendering.cpp"
+#include "tests/simd.cpp"
+#include "tests/stretchStream.cpp"
+#include "tests/stretcherPool.cpp"
+#include "tests/transaction.cpp"
 #include "tests/version.cpp"
 #include "tests/wave.cpp"
 #include "tests/waveFactory.cpp"
 #include "tests/waveFx.cpp"
 #include "tests/waveReading.cpp"
+#include "tests/worker.cpp"
+#include "tests/workerPool.cpp"
 #include <catch2/catch_session.hpp>
-#include <string>
-#include <vector>
 #endif
 #include <FL/Fl.H>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
 
 extern giada::m::Engine* g_engine;
 extern giada::v::Ui*     g_ui;
@@ -83,6 +103,59 @@ void printBuildInfo_()
 	KernelAudio::logCompiledAPIs();
 	KernelMidi::logCompiledAPIs();
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* BounceJob
+A project to render and the wave file to render it to, from the command line. */
+
+struct BounceJob
+{
+	std::string      projectPath;
+	Bouncer::Options options;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* parseBounceArgs_
+Parses the arguments following `--bounce`: options first, then pairs of project
+path and output file. Returns an empty vector on malformed arguments. */
+
+std::vector<BounceJob> parseBounceArgs_(const std::vector<std::string_view>& args)
+{
+	Bouncer::Options         defaults;
+	std::vector<std::string> paths;
+
+	for (const std::string_view arg : args)
+	{
+		if (arg.starts_with("--loops="))
+		{
+			const std::string_view value = arg.substr(8);
+			if (std::from_chars(value.data(), value.data() + value.size(), defaults.loops).ec != std::errc() || defaults.loops < 1)
+				return {};
+		}
+		else if (arg == "--stems=tracks")
+			defaults.stems = Bouncer::Stems::TRACKS;
+		else if (arg == "--stems=channels")
+			defaults.stems = Bouncer::Stems::CHANNELS;
+		else if (arg.starts_with("--"))
+			return {};
+		else
+			paths.emplace_back(arg);
+	}
+
+	if (paths.empty() || paths.size() % 2 != 0)
+		return {};
+
+	std::vector<BounceJob> jobs;
+	for (std::size_t i = 0; i < paths.size(); i += 2)
+	{
+		Bouncer::Options options = defaults;
+		options.path             = paths[i + 1];
+		jobs.push_back({paths[i], options});
+	}
+	return jobs;
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -106,6 +179,74 @@ int tests(int argc, char** argv)
 
 /* -------------------------------------------------------------------------- */
 
+int bounce(int argc, char** argv)
+{
+	const std::vector<std::string_view> args(argv, argv + argc);
+	if (args.size() < 2 || args[1] != "--bounce")
+		return -1;
+
+	const std::vector<BounceJob> jobs = parseBounceArgs_({args.begin() + 2, args.end()});
+	if (jobs.empty())
+	{
+		u::log::print("Usage: giada --bounce [--loops=N] [--stems=tracks|channels] <project> <file.wav> [<project> <file.wav> ...]\n");
+		return 1;
+	}
+
+	/* Settings (sample rate, buffer size, render threads, ...) come from the
+	configuration file, as in a regular session. No audio or MIDI device is
+	opened, and nothing is written back to the configuration file. */
+
+	Conf conf = confFactory::deserialize();
+
+	if (!conf.valid)
+		u::log::print("[init::bounce] Can't read configuration file! Using default values\n");
+
+	if (!u::log::init(conf.logMode))
+		u::log::print("[init::bounce] log init failed! Using default stdout\n");
+
+	juce::initialiseJuce_GUI();
+
+	auto engine = std::make_unique<Engine>();
+
+	engine->onMidiReceived        = []() {};
+	engine->onMidiSent            = []() {};
+	engine->onMidiSentFromChannel = [](ID) {};
+	engine->onModelSwap           = [](model::SwapType) {};
+
+	engine->initHeadless(conf);
+
+	int failures = 0;
+	for (const BounceJob& job : jobs)
+	{
+		const model::LoadState state = engine->getStorageApi().loadProject(job.projectPath, [](float) {});
+		if (state.patch.status != G_FILE_OK)
+		{
+			u::log::print("[init::bounce] Can't load project {}\n", job.projectPath);
+			failures++;
+			continue;
+		}
+		if (!state.isGood())
+			u::log::print("[init::bounce] Project {} has missing samples or plug-ins\n", job.projectPath);
+
+		if (engine->getStorageApi().bounce(job.options, [](float) {}) != G_RES_OK)
+		{
+			u::log::print("[init::bounce] Can't bounce project {} to {}\n", job.projectPath, job.options.path);
+			failures++;
+			continue;
+		}
+		u::log::print("[init::bounce] {} -> {}\n", job.projectPath, job.options.path);
+	}
+
+	engine->shutdown(conf);
+	engine.reset();
+	juce::shutdownJuce_GUI();
+	u::log::close();
+
+	return failures == 0 ? 0 : 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void startup()
 {
 	g_ui->dispatcher.onEventOccured = []()
@@ -35,6 +35,14 @@ Performs tests, if requested. Returns -1 if no tests are available or the
 
 int tests(int argc, char** argv);
 
+/* bounce
+Renders projects to wave files with no UI and no audio device, if requested
+with `--bounce [--loops=N] [--stems=tracks|channels] <project> <file.wav> ...`.
+Meant for batch exports. Returns -1 if `--bounce` has not been passed in, 0 on
+success, 1 otherwise. */
+
+int bounce(int argc, char** argv);
+
 void startup();
 void run();
 void shutdown();
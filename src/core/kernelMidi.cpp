@@ -177,7 +177,8 @@ void KernelMidi::Device<RtMidiType>::callback(double deltatime, const RtMidiMess
 	else
 		assert(false); // MIDI messages longer than 3 bytes are not supported
 
-	m_kernelMidi.m_inputQueue.try_enqueue(event);
+	if (m_kernelMidi.m_inputQueue.try_enqueue(event))
+		m_kernelMidi.m_inputWorker.notify();
 
 	G_DEBUG("Recv MIDI msg=0x{:0X}, timestamp={}", event.getRaw(), m_elapsedTime);
 }
@@ -205,8 +206,9 @@ template class KernelMidi::Device<RtMidiOut>;
 KernelMidi::KernelMidi(model::Model& m)
 : onMidiReceived(nullptr)
 , onMidiSent(nullptr)
+, onInputCycle(nullptr)
 , m_model(m)
-, m_outputWorker(G_KERNEL_MIDI_OUTPUT_RATE_MS)
+, m_outputWorker(G_KERNEL_MIDI_OUTPUT_RATE_MS, G_WORKER_RT_POLL_MS)
 , m_inputWorker(G_KERNEL_MIDI_INPUT_RATE_MS)
 , m_outputQueue(OUTPUT_QUEUE_MIN_CAPACITY, 0, MAX_NUM_PRODUCERS) // See https://github.com/cameron314/concurrentqueue#preallocation-correctly-using-try_enqueue
 , m_inputQueue(INPUT_QUEUE_MIN_CAPACITY, 0, MAX_NUM_PRODUCERS)
@@ -312,6 +314,8 @@ void KernelMidi::start()
 			MidiEvent event;
 			while (m_inputQueue.try_dequeue(event))
 				onMidiReceived(event);
+			if (onInputCycle != nullptr)
+				onInputCycle();
 		});
 	}
 }
@@ -409,7 +413,10 @@ bool KernelMidi::send(const MidiEvent& event) const
 
 	onMidiSent();
 
-	return m_outputQueue.try_enqueue(msg);
+	if (!m_outputQueue.try_enqueue(msg))
+		return false;
+	m_outputWorker.notify_RT();
+	return true;
 }
 
 /* -------------------------------------------------------------------------- */
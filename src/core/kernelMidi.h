@@ -113,7 +113,8 @@ public:
 	bool canSyncSlave() const;
 
 	/* send
-	Sends a MIDI message to the outside world. Returns false if MIDI out is not
+	Sends a MIDI message to the outside world. Realtime-safe: the output worker
+	picks it up within G_WORKER_RT_POLL_MS. Returns false if MIDI out is not
 	enabled or the internal queue is full. */
 
 	bool send(const MidiEvent&) const;
@@ -126,6 +127,12 @@ public:
 	std::function<void(const MidiEvent&)> onMidiReceived;
 	std::function<void()>                 onMidiSent;
 
+	/* onInputCycle
+	Fired by the input worker at the end of each cycle, after all the events
+	received so far have been passed to onMidiReceived. */
+
+	std::function<void()> onInputCycle;
+
 private:
 	using RtMidiMessage = std::vector<unsigned char>;
 
@@ -0,0 +1,100 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/loadGovernor.h"
+#include "src/core/const.h"
+#include <algorithm>
+
+namespace giada::m
+{
+std::optional<Resampler::Quality> LoadGovernor::getFallbackQuality(Resampler::Quality quality)
+{
+	switch (quality)
+	{
+	case Resampler::Quality::SINC_BEST:
+	case Resampler::Quality::SINC_MEDIUM:
+	case Resampler::Quality::SINC_FASTEST:
+	case Resampler::Quality::BUILTIN_SINC:
+		return Resampler::Quality::BUILTIN_CUBIC;
+	default:
+		return {};
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool LoadGovernor::update(DspLoad::Clock::duration d, int bufferSize, int sampleRate, int threshold)
+{
+	m_dspLoad.add(d);
+
+	const int   holdFrames = (G_LOAD_GOVERNOR_HOLD_MS * sampleRate / 1000) * m_backoff;
+	const float load       = getLoad(bufferSize, sampleRate);
+	const bool  degraded   = isDegraded();
+
+	m_elapsed = std::min(m_elapsed, holdFrames) + bufferSize;
+
+	if (!degraded && threshold > 0 && load > threshold)
+	{
+		/* Overloaded again right after the quality has been restored: the
+		configured quality is too expensive right now, wait longer next time. */
+
+		m_backoff = m_elapsed < holdFrames ? std::min(m_backoff * 2, G_LOAD_GOVERNOR_MAX_BACKOFF) : 1;
+		setDegraded(true);
+		return true;
+	}
+
+	if (degraded && (threshold == 0 || (m_elapsed >= holdFrames && load < threshold * G_LOAD_GOVERNOR_RESTORE)))
+	{
+		setDegraded(false);
+		return true;
+	}
+
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool LoadGovernor::isDegraded() const
+{
+	return m_degraded.load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+float LoadGovernor::getLoad(int bufferSize, int sampleRate) const
+{
+	return m_dspLoad.get(bufferSize, sampleRate).average;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LoadGovernor::setDegraded(bool degraded)
+{
+	m_degraded.store(degraded, std::memory_order_relaxed);
+	m_elapsed = 0;
+}
+} // namespace giada::m
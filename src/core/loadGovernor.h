@@ -0,0 +1,90 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_LOAD_GOVERNOR_H
+#define G_LOAD_GOVERNOR_H
+
+#include "src/core/dspLoad.h"
+#include "src/core/resampler.h"
+#include <atomic>
+#include <limits>
+#include <optional>
+
+namespace giada::m
+{
+/* LoadGovernor
+Watches the time spent rendering each audio block. When the load goes above a
+threshold, it asks pitched channels to switch to a cheaper resampling quality;
+the configured one is restored when the load drops well below the threshold
+and stays there for a while (hysteresis), so that it doesn't flip back and
+forth on every block. Updated by the real-time thread, read by any thread. */
+
+class LoadGovernor final
+{
+public:
+	/* getFallbackQuality
+	Returns the cheaper quality to switch to when the given one is too expensive,
+	or nothing if 'quality' is already cheap enough. */
+
+	static std::optional<Resampler::Quality> getFallbackQuality(Resampler::Quality);
+
+	LoadGovernor() = default;
+
+	/* update
+	Accounts the time spent rendering the last audio block. 'threshold' is the
+	max load allowed, in percent of the block duration: 0 disables the governor.
+	Returns true if the degraded state has changed. Real-time thread only. */
+
+	bool update(DspLoad::Clock::duration, int bufferSize, int sampleRate, int threshold);
+
+	/* isDegraded
+	True if pitched channels should use their fallback resampling quality. */
+
+	bool isDegraded() const;
+
+	/* getLoad
+	Returns the smoothed rendering load, in percent of the block duration. */
+
+	float getLoad(int bufferSize, int sampleRate) const;
+
+private:
+	void setDegraded(bool);
+
+	DspLoad           m_dspLoad;
+	std::atomic<bool> m_degraded = false;
+
+	/* m_elapsed, m_backoff
+	Real-time thread only. Frames rendered since the last transition, and the
+	current multiplier of the hold time, doubled every time the load goes over
+	the threshold shortly after the quality has been restored. */
+
+	int m_elapsed = std::numeric_limits<int>::max(); // Nothing happened yet
+	int m_backoff = 1;
+};
+} // namespace giada::m
+
+#endif
@@ -38,6 +38,7 @@
 #include "src/utils/log.h"
 #include <cassert>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 namespace giada::m
@@ -149,7 +150,7 @@ bool MidiDispatcher::isMasterMidiInAllowed(int c)
 
 bool MidiDispatcher::isChannelMidiInAllowed(ID channelId, int c)
 {
-	return m_model.get().tracks.getChannel(channelId).midiInput.isAllowed(c);
+	return std::as_const(m_model).get().tracks.getChannel(channelId).midiInput.isAllowed(c);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -239,6 +240,9 @@ void MidiDispatcher::processChannel(const Channel& c, const MidiEvent& midiEvent
 	else if (pure == c.midiInput.pitch.getValue())
 	{
 		G_DEBUG("   pitch ch={} (pure=0x{:0X}, value={})", c.id.getValue(), pure, midiEvent.getVelocityFloat());
+		/* Unlike volume, pitch changes need a swap. Knobs can fire hundreds
+		of events per second: coalesce them (see Model::beginTransaction). */
+		const model::Transaction transaction = m_model.beginTransaction(/*coalesce=*/true);
 		c::channel::setChannelPitch(c.id, midiEvent.getVelocityFloat(), Thread::MIDI);
 	}
 	else if (pure == c.midiInput.readActions.getValue())
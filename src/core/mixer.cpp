@@ -27,6 +27,7 @@
 #include "src/core/mixer.h"
 #include "src/core/const.h"
 #include "src/core/model/model.h"
+#include "src/core/simd.h"
 #include "src/deps/mcl-utils/src/math.hpp"
 #include "src/utils/log.h"
 
@@ -41,6 +42,13 @@ Channels identifiers. */
 
 constexpr int CH_LEFT  = 0;
 constexpr int CH_RIGHT = 1;
+
+/* -------------------------------------------------------------------------- */
+
+float getPeak_(const mcl::AudioBuffer& b, int channel)
+{
+	return simd::getPeak(b.getChannelView(channel).data(), b.countFrames());
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -81,8 +89,7 @@ void Mixer::enable()
 void Mixer::disable()
 {
 	m_model.get().mixer.a_setActive(false);
-	while (m_model.isRtLocked())
-		;
+	m_model.waitRtUnlocked();
 	u::log::print("[mixer::disable] disabled\n");
 }
 
@@ -142,6 +149,8 @@ void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_R
 	const model::Tracks&      tracks      = document_RT.tracks;
 	const model::KernelAudio& kernelAudio = document_RT.kernelAudio;
 
+	const DspLoad::Timer timer(m_dspLoad);
+
 	const Channel& masterInCh = tracks.getChannel(MASTER_IN_CHANNEL_ID);
 
 	const bool  hasInput        = in.isAllocd();
@@ -157,13 +166,15 @@ void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_R
 	mixer.a_setPeakOut({0.0f, 0.0f});
 	mixer.a_setPeakIn({0.0f, 0.0f});
 
+	const float inVol = masterInCh.shared->params.getVolume();
+
 	if (hasInput)
-		processLineIn(mixer, in, masterInCh.volume, recTriggerLevel, seqIsActive);
+		processLineIn(mixer, in, inVol, recTriggerLevel, seqIsActive);
 
 	if (shouldLineInRec)
 	{
 		const Frame newTrackerPos = lineInRec(in, mixer.getRecBuffer(),
-		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.volume,
+		    mixer.a_getInputTracker(), maxFramesToRec, inVol,
 		    allowsOverdub);
 		mixer.a_setInputTracker(newTrackerPos);
 	}
@@ -171,6 +182,13 @@ void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_R
 
 /* -------------------------------------------------------------------------- */
 
+const DspLoad& Mixer::getDspLoad() const
+{
+	return m_dspLoad;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Mixer::startInputRec(Frame from)
 {
 	m_model.get().mixer.a_setInputTracker(from);
@@ -259,7 +277,7 @@ Peak Mixer::makePeak(const mcl::AudioBuffer& b) const
 {
 	if (!b.isAllocd())
 		return {0.0f, 0.0f};
-	return {b.getPeak(CH_LEFT), b.getPeak(b.countChannels() == 1 ? CH_LEFT : CH_RIGHT)};
+	return {getPeak_(b, CH_LEFT), getPeak_(b, b.countChannels() == 1 ? CH_LEFT : CH_RIGHT)};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -314,20 +332,20 @@ void Mixer::processLineIn(const model::Mixer& mixer, const mcl::AudioBuffer& inB
 
 void Mixer::limit(mcl::AudioBuffer& outBuf) const
 {
-	for (int i = 0; i < outBuf.countFrames(); i++)
-		for (int j = 0; j < outBuf.countChannels(); j++)
-			outBuf.at(i, j) = std::max(-1.0f, std::min(outBuf.at(i, j), 1.0f));
+	for (int i = 0; i < outBuf.countChannels(); i++)
+		simd::clamp(outBuf.getChannelView(i).data(), outBuf.countFrames(), -1.0f, 1.0f);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Mixer::finalizeOutput(const model::Mixer& mixer, mcl::AudioBuffer& buf,
-    bool inToOut, bool shouldLimit, float vol) const
+    bool inToOut, bool shouldLimit, float volStart, float volEnd) const
 {
 	if (inToOut)
-		buf.sumAll(mixer.getInBuffer(), vol);
+		buf.sumAll(mixer.getInBuffer(), volEnd);
 	else
-		buf.applyGain(vol);
+		for (int i = 0; i < buf.countChannels(); i++)
+			simd::applyGainRamp(buf.getChannelView(i).data(), buf.countFrames(), volStart, volEnd);
 
 	if (shouldLimit)
 		limit(buf);
@@ -337,6 +355,6 @@ void Mixer::finalizeOutput(const model::Mixer& mixer, mcl::AudioBuffer& buf,
 
 void Mixer::updateOutputPeak(const model::Mixer& mixer, const mcl::AudioBuffer& buf) const
 {
-	mixer.a_setPeakOut({buf.getPeak(CH_LEFT), buf.getPeak(CH_RIGHT)});
+	mixer.a_setPeakOut({getPeak_(buf, CH_LEFT), getPeak_(buf, CH_RIGHT)});
 }
 } // namespace giada::m
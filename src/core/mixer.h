@@ -27,6 +27,7 @@
 #ifndef G_MIXER_H
 #define G_MIXER_H
 
+#include "src/core/dspLoad.h"
 #include "src/core/midiEvent.h"
 #include "src/core/ringBuffer.h"
 #include "src/core/sequencer.h"
@@ -85,6 +86,11 @@ public:
 
 	void render(const mcl::AudioBuffer& in, const model::Document&, int maxFramesToRec) const;
 
+	/* getDspLoad
+	Returns the time spent in render(). */
+
+	const DspLoad& getDspLoad() const;
+
 	/* reset
 	Brings everything back to the initial state. Must be called only when mixer
 	is disabled.*/
@@ -135,10 +141,10 @@ public:
 
 	/* finalizeOutput
 	Last touches after the output has been rendered: apply inToOut if any, apply
-	output volume. */
+	output volume, ramping from 'volStart' to 'volEnd' across the block. */
 
 	void finalizeOutput(const model::Mixer&, mcl::AudioBuffer&, bool inToOut,
-	    bool limit, float vol) const;
+	    bool limit, float volStart, float volEnd) const;
 
 	/* updateOutputPeak
 	Reads the maximum peak in the given buffer and updates the value in model::Mixer. */
@@ -200,6 +206,11 @@ private:
 
 	mutable bool m_signalCbFired;
 	mutable bool m_endOfRecCbFired;
+
+	/* m_dspLoad
+	Time spent in render(). Mutable: updated by the real-time thread. */
+
+	mutable DspLoad m_dspLoad;
 };
 } // namespace giada::m
 
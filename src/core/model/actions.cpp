@@ -41,20 +41,20 @@ namespace giada::m::model
 {
 void Actions::set(std::vector<Action>&& actions)
 {
-	m_actions = std::move(actions);
+	m_actions.edit() = std::move(actions);
 	sort(); // Always assume unsorted data coming in
 }
 
 void Actions::clearAll()
 {
-	m_actions.clear();
+	m_actions.edit().clear();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::clearChannel(ID channelId, Scene scene)
 {
-	utils::container::removeIf(m_actions, [=](const Action& a)
+	utils::container::removeIf(m_actions.edit(), [=](const Action& a)
 	{ return a.channelId == channelId && a.scene == scene; });
 }
 
@@ -62,7 +62,7 @@ void Actions::clearChannel(ID channelId, Scene scene)
 
 void Actions::clearActions(ID channelId, int type)
 {
-	utils::container::removeIf(m_actions, [=](const Action& a)
+	utils::container::removeIf(m_actions.edit(), [=](const Action& a)
 	{
 		return a.channelId == channelId && a.event.getStatus() == type;
 	});
@@ -70,7 +70,7 @@ void Actions::clearActions(ID channelId, int type)
 
 void Actions::clearActions(Scene scene)
 {
-	utils::container::removeIf(m_actions, [=](const Action& a)
+	utils::container::removeIf(m_actions.edit(), [=](const Action& a)
 	{ return a.scene == scene; });
 }
 
@@ -78,13 +78,13 @@ void Actions::clearActions(Scene scene)
 
 void Actions::deleteAction(ID id)
 {
-	utils::container::removeIf(m_actions, [=](const Action& a)
+	utils::container::removeIf(m_actions.edit(), [=](const Action& a)
 	{ return a.id == id; });
 }
 
 void Actions::deleteAction(ID currId, ID nextId)
 {
-	utils::container::removeIf(m_actions, [=](const Action& a)
+	utils::container::removeIf(m_actions.edit(), [=](const Action& a)
 	{ return a.id == currId || a.id == nextId; });
 }
 
@@ -101,7 +101,7 @@ void Actions::updateEvent(ID id, MidiEvent e)
 
 bool Actions::hasActions(ID channelId, int type) const
 {
-	for (const Action& a : m_actions)
+	for (const Action& a : m_actions.get())
 		if (a.channelId == channelId && (type == 0 || type == a.event.getStatus()))
 			return true;
 	return false;
@@ -109,7 +109,7 @@ bool Actions::hasActions(ID channelId, int type) const
 
 bool Actions::hasActions(Scene scene) const
 {
-	for (const Action& a : m_actions)
+	for (const Action& a : m_actions.get())
 		if (a.scene == scene)
 			return true;
 	return false;
@@ -117,7 +117,7 @@ bool Actions::hasActions(Scene scene) const
 
 /* -------------------------------------------------------------------------- */
 
-const std::vector<Action>& Actions::getAll() const { return m_actions; }
+const std::vector<Action>& Actions::getAll() const { return m_actions.get(); }
 
 /* -------------------------------------------------------------------------- */
 
@@ -125,7 +125,7 @@ const Action* Actions::findAction(ID id) const
 {
 	if (!id.isValid())
 		return nullptr;
-	for (const Action& a : m_actions)
+	for (const Action& a : m_actions.get())
 		if (a.id == id)
 			return &a;
 	return nullptr;
@@ -138,7 +138,7 @@ const Action* Actions::findAction(ID id) const
 void Actions::debug() const
 {
 	puts("model::actions");
-	for (const Action& a : m_actions)
+	for (const Action& a : m_actions.get())
 		fmt::print("\t\ttick={}, ID={}, scene={}, channel={}, value=0x{}, prevId={}, nextId={}\n",
 		    a.tick.value(), a.id.getValue(), a.scene.getIndex(), a.channelId.getValue(), a.event.getRaw(),
 		    a.prevId.getValue(), a.nextId.getValue());
@@ -157,7 +157,7 @@ Action Actions::rec(ID channelId, Scene scene, Tick tick, MidiEvent event)
 
 	Action a = actionFactory::makeAction({}, channelId, scene, tick, event);
 
-	m_actions.push_back(a);
+	m_actions.edit().push_back(a);
 	sort();
 
 	return a;
@@ -172,7 +172,7 @@ void Actions::rec(std::vector<Action>& actions, Scene scene)
 
 	for (const Action& a : actions)
 		if (!exists(a.channelId, scene, a.tick, a.event))
-			m_actions.push_back(a);
+			m_actions.edit().push_back(a);
 
 	sort();
 }
@@ -185,8 +185,9 @@ void Actions::rec(ID channelId, Scene scene, TickRange range, MidiEvent e1, Midi
 	Action a2 = actionFactory::makeAction({}, channelId, scene, range.getB(), e2);
 	a1.nextId = a2.id;
 	a2.prevId = a1.id;
-	m_actions.push_back(a1);
-	m_actions.push_back(a2);
+	std::vector<Action>& actions = m_actions.edit();
+	actions.push_back(a1);
+	actions.push_back(a2);
 	sort();
 }
 
@@ -197,10 +198,12 @@ const std::span<const Action> Actions::getActionsInTickRange(TickRange r) const
 	if (!r.isValid())
 		return {};
 
-	const auto first = std::lower_bound(m_actions.begin(), m_actions.end(), r.getA(), [](const Action& a, Tick value)
+	const std::vector<Action>& actions = m_actions.get();
+
+	const auto first = std::lower_bound(actions.begin(), actions.end(), r.getA(), [](const Action& a, Tick value)
 	{ return a.tick < value; });
 
-	const auto last = std::lower_bound(m_actions.begin(), m_actions.end(), r.getB(), [](const Action& a, Tick value)
+	const auto last = std::lower_bound(actions.begin(), actions.end(), r.getB(), [](const Action& a, Tick value)
 	{ return a.tick < value; });
 
 	return {first, last};
@@ -211,7 +214,7 @@ const std::span<const Action> Actions::getActionsInTickRange(TickRange r) const
 std::vector<const Action*> Actions::getActionsOnChannel(ID channelId, Scene scene) const
 {
 	std::vector<const Action*> out;
-	for (const Action& a : m_actions)
+	for (const Action& a : m_actions.get())
 		if (a.channelId == channelId && a.scene == scene)
 			out.push_back(&a);
 	return out;
@@ -221,6 +224,7 @@ std::vector<const Action*> Actions::getActionsOnChannel(ID channelId, Scene scen
 
 Action* Actions::findAction(ID id)
 {
+	m_actions.edit(); // The caller is going to write through the pointer
 	return const_cast<Action*>(std::as_const(*this).findAction(id));
 }
 
@@ -228,14 +232,14 @@ Action* Actions::findAction(ID id)
 
 void Actions::sort()
 {
-	std::ranges::sort(m_actions, std::ranges::less{}, &Action::tick);
+	std::ranges::sort(m_actions.edit(), std::ranges::less{}, &Action::tick);
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool Actions::exists(ID channelId, Scene scene, Tick tick, const MidiEvent& event) const
 {
-	for (const Action& a : m_actions)
+	for (const Action& a : m_actions.get())
 		if (a.channelId == channelId && a.tick == tick && a.event.getRaw() == event.getRaw() && a.scene == scene)
 			return true;
 	return false;
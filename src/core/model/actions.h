@@ -30,6 +30,7 @@
 #include "src/const.h"
 #include "src/core/actions/action.h"
 #include "src/core/midiEvent.h"
+#include "src/core/model/cow.h"
 #include "src/core/types.h"
 #include <functional>
 #include <map>
@@ -146,9 +147,10 @@ private:
 	/* m_actions
 	Stored actions. Must always be sorted tick-wise, ascending, to allow
 	the fetch alogrithm to work properly. Sorting is needed any time you add
-	a new action to the vector. */
+	a new action to the vector. Shared with the published Documents until
+	edited (see Cow). */
 
-	std::vector<Action> m_actions;
+	Cow<std::vector<Action>> m_actions;
 };
 } // namespace giada::m::model
 
@@ -28,6 +28,7 @@
 #include "src/core/plugins/plugin.h"
 #include "src/deps/mcl-utils/src/container.hpp"
 #include <cassert>
+#include <utility>
 #if G_DEBUG_MODE
 #include "src/utils/string.h"
 #include <fmt/core.h>
@@ -39,28 +40,34 @@ namespace giada::m::model
 {
 Channel* Channels::find(ID id)
 {
+	m_channels.edit(); // The caller is going to write through the pointer
 	return const_cast<Channel*>(std::as_const(*this).find(id));
 }
 
 const Channel* Channels::find(ID id) const
 {
-	auto it = std::find_if(m_channels.begin(), m_channels.end(), [id](const Channel& c)
+	const std::vector<Channel>& channels = m_channels.get();
+
+	auto it = std::find_if(channels.begin(), channels.end(), [id](const Channel& c)
 	{ return c.id == id; });
-	return it != m_channels.end() ? &*it : nullptr;
+	return it != channels.end() ? &*it : nullptr;
 }
 
 /* -------------------------------------------------------------------------- */
 
 Channel& Channels::get(ID id)
 {
+	m_channels.edit();
 	return const_cast<Channel&>(std::as_const(*this).get(id));
 }
 
 const Channel& Channels::get(ID id) const
 {
-	auto it = std::find_if(m_channels.begin(), m_channels.end(), [id](const Channel& c)
+	const std::vector<Channel>& channels = m_channels.get();
+
+	auto it = std::find_if(channels.begin(), channels.end(), [id](const Channel& c)
 	{ return c.id == id; });
-	assert(it != m_channels.end());
+	assert(it != channels.end());
 	return *it;
 }
 
@@ -68,26 +75,26 @@ const Channel& Channels::get(ID id) const
 
 Channel& Channels::getLast()
 {
-	return m_channels.back();
+	return m_channels.edit().back();
 }
 
 /* -------------------------------------------------------------------------- */
 
 std::vector<Channel>& Channels::getAll()
 {
-	return m_channels;
+	return m_channels.edit();
 }
 
 const std::vector<Channel>& Channels::getAll() const
 {
-	return m_channels;
+	return m_channels.get();
 }
 
 /* -------------------------------------------------------------------------- */
 
 const std::size_t Channels::getIndex(ID id) const
 {
-	return utils::container::indexOf(m_channels, get(id));
+	return utils::container::indexOf(m_channels.get(), get(id));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -95,7 +102,7 @@ const std::size_t Channels::getIndex(ID id) const
 const std::vector<ID> Channels::getAllIDs() const
 {
 	std::vector<ID> out;
-	for (const Channel& ch : m_channels)
+	for (const Channel& ch : m_channels.get())
 		out.push_back(ch.id);
 	return out;
 }
@@ -104,7 +111,7 @@ const std::vector<ID> Channels::getAllIDs() const
 
 bool Channels::anyOf(std::function<bool(const Channel&)> f) const
 {
-	return std::any_of(m_channels.begin(), m_channels.end(), f);
+	return std::ranges::any_of(m_channels.get(), f);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -115,7 +122,7 @@ void Channels::debug() const
 {
 	puts("model::channels");
 
-	for (int i = 0; const Channel& c : m_channels)
+	for (int i = 0; const Channel& c : m_channels.get())
 	{
 		fmt::print("\t{} - {}\n", i++, c.debug());
 
@@ -135,7 +142,7 @@ void Channels::debug() const
 std::vector<Channel*> Channels::getIf(std::function<bool(const Channel&)> f)
 {
 	std::vector<Channel*> out;
-	for (Channel& ch : m_channels)
+	for (Channel& ch : m_channels.edit())
 		if (f(ch))
 			out.push_back(&ch);
 	return out;
@@ -145,7 +152,7 @@ std::vector<Channel*> Channels::getIf(std::function<bool(const Channel&)> f)
 
 void Channels::remove(ID id)
 {
-	utils::container::removeIf(m_channels, [id](const Channel& c)
+	utils::container::removeIf(m_channels.edit(), [id](const Channel& c)
 	{ return c.id == id; });
 }
 
@@ -153,13 +160,14 @@ void Channels::remove(ID id)
 
 void Channels::add(Channel&& ch)
 {
-	m_channels.push_back(std::move(ch));
+	m_channels.edit().push_back(std::move(ch));
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Channels::add(Channel&& ch, std::size_t position)
 {
-	m_channels.insert(m_channels.begin() + std::min(position, m_channels.size()), std::move(ch));
+	std::vector<Channel>& channels = m_channels.edit();
+	channels.insert(channels.begin() + std::min(position, channels.size()), std::move(ch));
 }
 } // namespace giada::m::model
@@ -28,6 +28,7 @@
 #define G_MODEL_CHANNELS_H
 
 #include "src/core/channels/channel.h"
+#include "src/core/model/cow.h"
 #include "src/core/types.h"
 
 namespace giada::m::model
@@ -60,7 +61,7 @@ public:
 	void                  remove(ID);
 
 private:
-	std::vector<Channel> m_channels;
+	Cow<std::vector<Channel>> m_channels;
 };
 } // namespace giada::m::model
 
@@ -0,0 +1,161 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_MODEL_COW_H
+#define G_MODEL_COW_H
+
+#include "src/const.h"
+#include <cassert>
+#include <memory>
+#if G_DEBUG_MODE
+#include <cstddef>
+#include <ranges>
+#include <vector>
+#endif
+
+namespace giada::m::model
+{
+/* Cow
+Copy-on-write container for the heavy parts of the Document (Tracks, Channels,
+Actions). The Document edited by the main thread owns a private, mutable copy
+of T, so references to it stay valid across swaps. The Documents handed over to
+the realtime thread only share an immutable snapshot of it, taken when the Cow
+gets copied: the snapshot is made again only if T has been edited in the
+meantime, so a swap copies just what has changed.
+
+Editing is tracked by edit(): references obtained before a swap must not be used
+for writing after it, or the change won't be published. Get them again instead.
+Debug builds assert on such writes, as soon as the data is edited or published
+again. Read through the const accessors: the non-const ones are meant for
+writing, and may copy the data. */
+
+template <typename T>
+class Cow
+{
+public:
+	Cow()
+	: m_data(std::make_unique<T>())
+	, m_dirty(true)
+	{
+	}
+
+	Cow(const Cow& o)
+	: m_snapshot(o.share())
+	, m_dirty(false)
+	{
+	}
+
+	Cow(Cow&&) noexcept            = default;
+	Cow& operator=(Cow&&) noexcept = default;
+
+	Cow& operator=(const Cow& o)
+	{
+		if (this == &o)
+			return *this;
+		m_snapshot = o.share();
+		m_data.reset();
+		m_dirty = false;
+		return *this;
+	}
+
+	/* get
+	Returns read-only data. Safe to call from the realtime thread on the Document
+	it's given. */
+
+	const T& get() const
+	{
+		assert(m_data != nullptr || m_snapshot != nullptr);
+		return m_data != nullptr ? *m_data : *m_snapshot;
+	}
+
+	/* edit
+	Returns mutable data and marks it as changed, so that it will be published
+	on the next copy. Main thread only. */
+
+	T& edit()
+	{
+		if (m_data == nullptr)
+			m_data = std::make_unique<T>(*m_snapshot);
+		else
+			assertUntouched();
+		m_dirty = true;
+		return *m_data;
+	}
+
+private:
+	/* share
+	Returns the immutable snapshot of the data, refreshing it first if the data
+	has been edited since the last time. */
+
+	std::shared_ptr<const T> share() const
+	{
+		if (m_data != nullptr && m_dirty)
+		{
+			m_snapshot = std::make_shared<const T>(*m_data);
+			m_dirty    = false;
+#if G_DEBUG_MODE
+			m_fingerprint = fingerprint();
+#endif
+		}
+		else if (m_data != nullptr)
+			assertUntouched();
+		return m_snapshot;
+	}
+
+	/* assertUntouched
+	Makes sure the data hasn't been written since it was last published without
+	going through edit(), i.e. through a stale reference. */
+
+	void assertUntouched() const
+	{
+#if G_DEBUG_MODE
+		assert((m_dirty || fingerprint() == m_fingerprint) && "Cow written through a stale reference");
+#endif
+	}
+
+#if G_DEBUG_MODE
+	/* fingerprint
+	Returns the raw bytes of the elements of the mutable data. A shallow check,
+	but enough to catch stale references to Tracks too: editing their Channels
+	changes the state of the nested Cow. */
+
+	std::vector<std::byte> fingerprint() const
+	{
+		const std::byte* first = reinterpret_cast<const std::byte*>(std::ranges::data(*m_data));
+		return {first, first + std::ranges::size(*m_data) * sizeof(std::ranges::range_value_t<T>)};
+	}
+#endif
+
+	std::unique_ptr<T>               m_data;
+	mutable std::shared_ptr<const T> m_snapshot;
+	mutable bool                     m_dirty;
+#if G_DEBUG_MODE
+	mutable std::vector<std::byte> m_fingerprint; // Of m_data, when last published
+#endif
+};
+} // namespace giada::m::model
+
+#endif
@@ -29,6 +29,7 @@
 #include "src/core/channels/channelFactory.h"
 #include "src/core/conf.h"
 #include "src/core/model/shared.h"
+#include "src/core/rendering/renderGraph.h"
 #include "src/utils/vector.h"
 
 namespace giada::m::model
@@ -85,6 +86,14 @@ void Document::load(const Conf& conf)
 	kernelAudio.limitOutput             = conf.limitOutput;
 	kernelAudio.rsmpQuality             = conf.rsmpQuality;
 	kernelAudio.recTriggerLevel         = conf.recTriggerLevel;
+	kernelAudio.renderThreads           = conf.renderThreads;
+	kernelAudio.pluginTailTime          = conf.pluginTailTime;
+	kernelAudio.streamThreshold         = conf.streamThreshold;
+	kernelAudio.pcmCacheSize            = conf.pcmCacheSize;
+	kernelAudio.loadGovernor            = conf.loadGovernor;
+	kernelAudio.stretcherPool           = conf.stretcherPool;
+	kernelAudio.asyncStretch            = conf.asyncStretch;
+	kernelAudio.sampleStorage           = conf.sampleStorage;
 
 	kernelMidi.api         = conf.midiSystem;
 	kernelMidi.devicesOut  = conf.midiDevicesOut;
@@ -149,6 +158,14 @@ void Document::store(Conf& conf) const
 	conf.limitOutput      = kernelAudio.limitOutput;
 	conf.rsmpQuality      = kernelAudio.rsmpQuality;
 	conf.recTriggerLevel  = kernelAudio.recTriggerLevel;
+	conf.renderThreads    = kernelAudio.renderThreads;
+	conf.pluginTailTime   = kernelAudio.pluginTailTime;
+	conf.streamThreshold  = kernelAudio.streamThreshold;
+	conf.pcmCacheSize     = kernelAudio.pcmCacheSize;
+	conf.loadGovernor     = kernelAudio.loadGovernor;
+	conf.stretcherPool    = kernelAudio.stretcherPool;
+	conf.asyncStretch     = kernelAudio.asyncStretch;
+	conf.sampleStorage    = kernelAudio.sampleStorage;
 
 	conf.midiSystem     = kernelMidi.api;
 	conf.midiDevicesOut = kernelMidi.devicesOut;
@@ -186,6 +203,8 @@ void Document::debug() const
 	mixer.debug();
 	tracks.debug();
 	actions.debug();
+	if (renderGraph != nullptr)
+		renderGraph->debug();
 }
 #endif
 } // namespace giada::m::model
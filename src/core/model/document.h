@@ -36,12 +36,18 @@
 #include "src/core/model/mixer.h"
 #include "src/core/model/sequencer.h"
 #include "src/core/model/tracks.h"
+#include <memory>
 
 namespace giada::m
 {
 struct Conf;
 }
 
+namespace giada::m::rendering
+{
+class RenderGraph;
+}
+
 namespace giada::m::model
 {
 class Shared;
@@ -85,6 +91,13 @@ struct Document
 	Tracks      tracks;
 	Actions     actions;
 	Behaviors   behaviors;
+
+	/* renderGraph
+	The Tracks layout compiled for multi-core rendering. Kept up to date by
+	Model::swap(). Immutable, hence shared by the realtime and non-realtime
+	Documents. */
+
+	std::shared_ptr<const rendering::RenderGraph> renderGraph;
 };
 } // namespace giada::m::model
 
@@ -0,0 +1,57 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_MODEL_DOCUMENT_LOCK_H
+#define G_MODEL_DOCUMENT_LOCK_H
+
+#include "src/core/model/types.h"
+#include "src/core/rtEpoch.h"
+
+namespace giada::m::model
+{
+/* DocumentLock
+REALTIME scoped lock on the Document, built on top of the one provided by the
+Swapper class. Use this in the real-time thread to lock the Document. It also
+enters the Model's RtEpoch, so that non-realtime threads can wait for it to
+be released without spinning. */
+
+class DocumentLock
+{
+public:
+	DocumentLock(const AtomicSwapper&, const RtEpoch&);
+
+	const Document& get() const;
+
+private:
+	/* Order matters: the epoch is entered before locking the swapper and left
+	after unlocking it. */
+
+	RtEpoch::Guard        m_epochGuard;
+	AtomicSwapper::RtLock m_lock;
+};
+} // namespace giada::m::model
+
+#endif
@@ -59,6 +59,14 @@ public:
 	bool               limitOutput     = false;
 	Resampler::Quality rsmpQuality     = Resampler::Quality::LINEAR;
 	float              recTriggerLevel = 0.0f;
+	int                renderThreads   = G_DEFAULT_RENDER_THREADS;
+	int                pluginTailTime  = G_DEFAULT_PLUGIN_TAIL_TIME; // milliseconds
+	int                streamThreshold = G_DEFAULT_STREAM_THRESHOLD; // seconds
+	int                pcmCacheSize    = G_DEFAULT_PCM_CACHE_SIZE;   // MB
+	int                loadGovernor    = G_DEFAULT_LOAD_GOVERNOR;    // percent, 0 = disabled
+	int                stretcherPool   = G_DEFAULT_STRETCHER_POOL;   // Stretchers allocated on startup
+	bool               asyncStretch    = true;                       // Stretch ahead in background
+	SampleStorage      sampleStorage   = SampleStorage::FLOAT;       // For new samples
 
 private:
 	struct Shared
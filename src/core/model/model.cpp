@@ -30,11 +30,16 @@
 #include "src/core/model/document.h"
 #include "src/core/plugins/pluginFactory.h"
 #include "src/core/plugins/pluginManager.h"
+#include "src/core/rendering/renderGraph.h"
 #include "src/core/waveFactory.h"
 #include "src/utils/log.h"
 #include "src/utils/string.h"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <utility>
 #if G_DEBUG_MODE
 #include <fmt/core.h>
 #endif
@@ -44,8 +49,54 @@ using namespace mcl;
 
 namespace giada::m::model
 {
+namespace
+{
+/* Transactions_
+Transactions in progress on a thread. Each thread groups its own swaps: a
+thread without a Transaction still swaps immediately. */
+
+struct Transactions_
+{
+	int                     depth    = 0;
+	bool                    coalesce = false;
+	std::optional<SwapType> pending  = {};
+};
+
+thread_local Transactions_ transactions_;
+
+/* -------------------------------------------------------------------------- */
+
+int64_t now_()
+{
+	return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* merge_
+Returns the stronger of two SwapTypes, so that a listener is notified with the
+most significant change among the merged ones. */
+
+SwapType merge_(std::optional<SwapType> a, SwapType b)
+{
+	return a.has_value() ? std::min(*a, b) : b; // HARD < SOFT < NONE
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Model::Model()
 : onSwap(nullptr)
+, onCompileRenderGraph(nullptr)
+, m_reclaimer(m_rtEpoch)
+, m_lastSwap(0)
+#if G_DEBUG_MODE
+, m_swapCount(0)
+, m_swapsPerSecond(0)
+, m_swapCountStart(now_())
+#endif
 {
 }
 
@@ -53,6 +104,8 @@ Model::Model()
 
 void Model::init()
 {
+	for (const std::unique_ptr<ChannelShared>& c : m_shared.getAllChannels())
+		releaseStretcher(*c);
 	m_shared.init();
 
 	Document& document          = get();
@@ -68,6 +121,8 @@ void Model::init()
 
 void Model::reset()
 {
+	for (const std::unique_ptr<ChannelShared>& c : m_shared.getAllChannels())
+		releaseStretcher(*c);
 	m_shared.init();
 
 	Document& document          = get();
@@ -91,15 +146,17 @@ void Model::load(const Conf& conf)
 
 /* -------------------------------------------------------------------------- */
 
-LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality)
+LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality,
+    std::function<void(float)> progress)
 {
 	const float sampleRateRatio = sampleRate / static_cast<float>(patch.samplerate);
+	const Frame streamThreshold = get().kernelAudio.streamThreshold * sampleRate;
 
 	/* Lock the shared data. Real-time thread can't read from it until this method
 	goes out of scope. */
 
 	const SharedLock lock  = lockShared(SwapType::NONE);
-	const LoadState  state = m_shared.load(patch, pluginManager, get().sequencer, sampleRate, bufferSize, rsmpQuality);
+	const LoadState  state = m_shared.load(patch, pluginManager, get().sequencer, sampleRate, bufferSize, rsmpQuality, streamThreshold, progress);
 	get().load(patch, m_shared, sampleRateRatio);
 
 	return state;
@@ -139,19 +196,212 @@ bool Model::registerThread(Thread t, bool realtime) const
 
 Document&       Model::get() { return m_swapper.get(); }
 const Document& Model::get() const { return m_swapper.get(); }
-DocumentLock    Model::get_RT() const { return DocumentLock(m_swapper); }
+DocumentLock    Model::get_RT() const { return DocumentLock(m_swapper, m_rtEpoch); }
 
 /* -------------------------------------------------------------------------- */
 
 void Model::swap(SwapType t)
 {
-	m_swapper.swap();
+	if (transactions_.depth > 0)
+	{
+		transactions_.pending = merge_(transactions_.pending, t);
+		return;
+	}
+	publish(t);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::publish(SwapType t)
+{
+	t = merge_(std::exchange(transactions_.pending, std::nullopt), t);
+
+	compileRenderGraph();
+	lendStretchers();
+
+	/* The swapper waits for the realtime thread to leave the old Document.
+	Objects that might still be reachable through it (e.g. retired Waves) are
+	only freed after a grace period: see Reclaimer and SharedLock. */
+
+	m_reclaimer.advance([this]()
+	{ m_swapper.swap(); });
+	reclaimStretchers();
+	prerenderSamples();
+
+	const int64_t now = now_();
+	m_lastSwap.store(now);
+
+#if G_DEBUG_MODE
+	const auto oneSecond = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1));
+	m_swapCount.fetch_add(1);
+	if (now - m_swapCountStart.load() >= oneSecond.count())
+	{
+		m_swapsPerSecond.store(m_swapCount.exchange(0));
+		m_swapCountStart.store(now);
+	}
+#endif
+
 	if (onSwap != nullptr)
 		onSwap(t);
 }
 
 /* -------------------------------------------------------------------------- */
 
+Transaction Model::beginTransaction(bool coalesce)
+{
+	return Transaction(*this, coalesce);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::openTransaction(bool coalesce)
+{
+	if (transactions_.depth++ == 0)
+		transactions_.coalesce = coalesce;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::closeTransaction()
+{
+	assert(transactions_.depth > 0);
+
+	if (--transactions_.depth > 0 || !transactions_.pending.has_value())
+		return;
+
+	/* A coalescing Transaction that comes too close to the last swap leaves
+	its edits pending: flushCoalesced() or the next swap will publish them. */
+
+	if (transactions_.coalesce && !canPublishCoalesced())
+		return;
+
+	publish(*transactions_.pending);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::flushCoalesced()
+{
+	if (transactions_.depth == 0 && transactions_.pending.has_value() && canPublishCoalesced())
+		publish(*transactions_.pending);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Model::canPublishCoalesced() const
+{
+	const auto window = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+	    std::chrono::milliseconds(G_MODEL_COALESCE_MS));
+	return now_() - m_lastSwap.load() >= window.count();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::prerenderSamples()
+{
+	const Document& document = get();
+	const Scene     scene    = document.sequencer.a_getCurrentScene();
+
+	for (const Channel* ch : document.tracks.getChannels())
+	{
+		if (!ch->sampleChannel)
+			continue;
+		const Sample& sample = ch->sampleChannel->getSample(scene);
+		if (ch->shared->freezer != nullptr)
+			ch->shared->freezer->request(sample);
+		if (ch->shared->stretchStream != nullptr)
+			ch->shared->stretchStream->request(sample);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::resetStretcherPool(int size, int sampleRate)
+{
+	for (const std::unique_ptr<ChannelShared>& c : m_shared.getAllChannels())
+		releaseStretcher(*c);
+	m_stretcherPool.reset(size, sampleRate);
+	swap(SwapType::NONE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::compileRenderGraph()
+{
+	Document& document = get();
+
+	if (document.renderGraph != nullptr && document.renderGraph->isCompatible(document.tracks))
+		return;
+	document.renderGraph = std::make_shared<rendering::RenderGraph>(document.tracks, document.renderGraph.get());
+
+	if (onCompileRenderGraph != nullptr)
+		onCompileRenderGraph(*document.renderGraph);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::lendStretchers()
+{
+	for (const Channel* ch : get().tracks.getChannels())
+	{
+		if (!ch->sampleChannel || !ch->sampleChannel->hasElasticSamples() || ch->shared->stretcher.load() != nullptr)
+			continue;
+
+		Stretcher* stretcher = m_stretcherPool.acquire();
+		if (stretcher == nullptr)
+		{
+			u::log::print("[Model::lendStretchers] Stretcher pool exhausted, channel {} will be resampled\n", ch->id.getValue());
+			continue;
+		}
+
+		/* Another thread might be publishing too and have lent one in the
+		meantime. */
+
+		Stretcher* none = nullptr;
+		if (!ch->shared->stretcher.compare_exchange_strong(none, stretcher))
+			m_stretcherPool.release(stretcher);
+	}
+
+	if (!get().kernelAudio.asyncStretch)
+		return;
+
+	for (const Channel* ch : get().tracks.getChannels())
+	{
+		StretchStream* stream = ch->shared->stretchStream.get();
+		if (stream == nullptr || ch->shared->stretcher.load() == nullptr || stream->hasStretcher())
+			continue;
+
+		Stretcher* stretcher = m_stretcherPool.acquire();
+		if (stretcher == nullptr)
+			return;
+		if (!stream->lend(stretcher))
+			m_stretcherPool.release(stretcher);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::reclaimStretchers()
+{
+	for (const Channel* ch : get().tracks.getChannels())
+		if (ch->sampleChannel && !ch->sampleChannel->hasElasticSamples())
+			releaseStretcher(*ch->shared);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::releaseStretcher(ChannelShared& c)
+{
+	if (Stretcher* stretcher = c.stretcher.exchange(nullptr); stretcher != nullptr)
+		m_stretcherPool.release(stretcher);
+	if (c.stretchStream == nullptr)
+		return;
+	if (Stretcher* stretcher = c.stretchStream->reclaim(); stretcher != nullptr)
+		m_stretcherPool.release(stretcher);
+}
+
+/* -------------------------------------------------------------------------- */
+
 SharedLock Model::lockShared(SwapType t)
 {
 	return SharedLock(*this, t);
@@ -161,7 +411,14 @@ SharedLock Model::lockShared(SwapType t)
 
 bool Model::isRtLocked() const
 {
-	return m_swapper.isRtLocked();
+	return m_rtEpoch.isInside();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::waitRtUnlocked()
+{
+	m_rtEpoch.synchronize();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -199,20 +456,34 @@ ChannelShared& Model::addChannelShared(std::unique_ptr<ChannelShared> cs)
 
 void Model::removePlugin(const Plugin& p)
 {
-	const SharedLock lock = lockShared(SwapType::NONE);
-	m_shared.removePlugin(p);
+	m_reclaimer.retire(m_shared.removePlugin(p));
+	swap(SwapType::NONE);
 }
 
 void Model::removeWave(const Wave& w)
 {
-	const SharedLock lock = lockShared(SwapType::NONE);
-	m_shared.removeWave(w);
+	m_reclaimer.retire(m_shared.removeWave(w));
+	swap(SwapType::NONE);
 }
 
 void Model::removeChannelShared(const ChannelShared& c)
 {
-	const SharedLock lock = lockShared(SwapType::NONE);
-	m_shared.removeChannel(c);
+	releaseStretcher(*m_shared.findChannel(c.id));
+	m_reclaimer.retire(m_shared.removeChannel(c));
+	swap(SwapType::NONE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::startReclaimer() { m_reclaimer.start(); }
+void Model::stopReclaimer() { m_reclaimer.stop(); }
+void Model::collectPlugins() { m_reclaimer.collectPlugins(); }
+
+/* -------------------------------------------------------------------------- */
+
+Reclaimer::Stats Model::getReclaimerStats() const
+{
+	return m_reclaimer.getStats();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -239,11 +510,27 @@ void Model::debug()
 
 	puts("-------------------------------");
 	m_swapper.debug();
+	fmt::print("swaps per second: {}\n", getSwapsPerSecond());
+	const Reclaimer::Stats reclaimer = getReclaimerStats();
+	fmt::print("pending deletions: {} objects, {} bytes\n", reclaimer.objects, reclaimer.bytes);
 	puts("-------------------------------");
 
 	get().debug();
 	m_shared.debug();
 }
 
+/* -------------------------------------------------------------------------- */
+
+int Model::getSwapsPerSecond() const
+{
+	/* The rate is updated on swap: if nothing has been swapped for a while, the
+	last value is stale. */
+
+	const auto twoSeconds = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(2));
+	if (now_() - m_swapCountStart.load() >= twoSeconds.count())
+		return 0;
+	return m_swapsPerSecond.load();
+}
+
 #endif // G_DEBUG_MODE
 } // namespace giada::m::model
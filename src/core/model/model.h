@@ -32,21 +32,34 @@
 #include "src/core/model/actions.h"
 #include "src/core/model/behaviors.h"
 #include "src/core/model/channels.h"
+#include "src/core/model/documentLock.h"
 #include "src/core/model/kernelAudio.h"
 #include "src/core/model/kernelMidi.h"
 #include "src/core/model/loadState.h"
 #include "src/core/model/midiIn.h"
 #include "src/core/model/mixer.h"
+#include "src/core/model/reclaimer.h"
 #include "src/core/model/sequencer.h"
 #include "src/core/model/shared.h"
 #include "src/core/model/sharedLock.h"
+#include "src/core/model/transaction.h"
 #include "src/core/model/types.h"
 #include "src/core/plugins/plugin.h"
+#include "src/core/rtEpoch.h"
+#include "src/core/stretcherPool.h"
 #include "src/core/wave.h"
 #include "src/deps/mcl-atomic-swapper/src/atomic-swapper.hpp"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/utils/vector.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <optional>
+
+namespace giada::m::rendering
+{
+class RenderGraph;
+}
 
 namespace giada::m::model
 {
@@ -62,12 +75,38 @@ public:
 
 	bool isRtLocked() const;
 
+	/* waitRtUnlocked
+	Blocks until the realtime thread has released the Document it was reading
+	when this got called, if any. Sleeps instead of spinning (see RtEpoch).
+	Changes made before calling this are seen by the realtime thread from then
+	on. */
+
+	void waitRtUnlocked();
+
 	/* lockShared
 	Returns a scoped locker SharedLock object. Use this when you want to lock
 	the shared data: it won't be processed by Mixer. */
 
 	[[nodiscard]] SharedLock lockShared(SwapType t = SwapType::HARD);
 
+	/* beginTransaction
+	Returns a scoped Transaction object. Swaps requested by the calling thread
+	while it's alive are merged into a single one, performed when it goes out of
+	scope. Transactions can be nested: only the outermost one swaps. With
+	'coalesce', the final swap is also rate-limited to one every
+	G_MODEL_COALESCE_MS: use it for continuous controls only, and call
+	flushCoalesced() periodically from the same thread. Keep transactions short,
+	and don't wrap code that relies on a swap being done (e.g. Mixer's
+	stopInputRec()). SharedLock always swaps immediately. */
+
+	[[nodiscard]] Transaction beginTransaction(bool coalesce = false);
+
+	/* flushCoalesced
+	Performs the swap left pending by coalescing Transactions of the calling
+	thread, if G_MODEL_COALESCE_MS has passed since the last one. */
+
+	void flushCoalesced();
+
 	/* init
 	Initializes the internal Document. All values go back to default. */
 
@@ -87,7 +126,8 @@ public:
 	/* load (2)
 	Loads data from a Patch object. */
 
-	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality);
+	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality,
+	    std::function<void(float)> progress);
 
 	/* store
 	Stores data into a Conf object. */
@@ -108,16 +148,33 @@ public:
 	DocumentLock get_RT() const;
 
 	/* get
-	Returns a reference to the NON-REALTIME Document structure. */
+	Returns a reference to the NON-REALTIME Document structure. Don't write
+	through references obtained before a swap: get them again (see Cow). */
 
 	Document&       get();
 	const Document& get() const;
 
 	/* swap
-	Swap non-rt Document with the rt one. See 'SwapType' notes above. */
+	Swap non-rt Document with the rt one. Only Tracks, Channels and Actions
+	edited since the last swap get copied. See 'SwapType' notes above. Deferred
+	if the calling thread has a Transaction in progress. */
 
 	void swap(SwapType t);
 
+	/* prerenderSamples
+	Asks each sample channel to pre-render its pitched or stretched Sample for
+	the current scene (see Freezer), and to stretch it ahead of the playhead
+	in the meantime (see StretchStream). Done automatically on swap(). */
+
+	void prerenderSamples();
+
+	/* resetStretcherPool
+	Allocates 'size' Stretchers, lent to Sample channels while they have Samples
+	in ELASTIC mode. Stretchers are lent and taken back on swap(). Must be called
+	when the Mixer is disabled. */
+
+	void resetStretcherPool(int size, int sampleRate);
+
 	/* getAll[*] */
 
 	std::vector<std::unique_ptr<Wave>>&          getAllWaves();
@@ -139,15 +196,44 @@ public:
 	Plugin&        addPlugin(std::unique_ptr<Plugin>);
 	ChannelShared& addChannelShared(std::unique_ptr<ChannelShared>);
 
+	/* remove[*]
+	Detaches some shared data from the Model and swaps. The object is freed later
+	on by the Reclaimer, once the realtime thread is done with it: remove any
+	reference to it from the Document before calling this, or within the same
+	Transaction. */
+
 	void removePlugin(const Plugin&);
 	void removeWave(const Wave&);
 	void removeChannelShared(const ChannelShared&);
 
+	/* [start|stop]Reclaimer
+	Starts and stops the thread that frees removed shared data. Stopping frees
+	everything left, so the Mixer must be disabled. Main thread only. */
+
+	void startReclaimer();
+	void stopReclaimer();
+
+	/* collectPlugins
+	Frees the removed Plugins that the realtime thread is done with. Main thread
+	only, due to JUCE and VST3 internal workings: call it periodically. */
+
+	void collectPlugins();
+
+	/* getReclaimerStats
+	Returns how much removed shared data is waiting to be freed. */
+
+	Reclaimer::Stats getReclaimerStats() const;
+
 	void clearPlugins();
 	void clearWaves();
 
 #if G_DEBUG_MODE
 	void debug();
+
+	/* getSwapsPerSecond
+	Returns how many swaps have been performed during the last second. */
+
+	int getSwapsPerSecond() const;
 #endif
 
 	/* onSwap
@@ -156,9 +242,84 @@ public:
 
 	std::function<void(SwapType)> onSwap;
 
+	/* onCompileRenderGraph
+	Callback fired when a new RenderGraph has been compiled, right before it is
+	handed over to the realtime thread. Useful for preparing the resources
+	needed to execute it. */
+
+	std::function<void(const rendering::RenderGraph&)> onCompileRenderGraph;
+
 private:
+	friend SharedLock;
+	friend Transaction;
+
+	/* publish
+	Performs the actual swap, together with any swap left pending by the calling
+	thread's Transactions. */
+
+	void publish(SwapType);
+
+	/* [open|close]Transaction
+	Called by Transaction on construction and destruction. */
+
+	void openTransaction(bool coalesce);
+	void closeTransaction();
+
+	/* canPublishCoalesced
+	True if enough time has passed since the last swap to perform a coalesced
+	one. */
+
+	bool canPublishCoalesced() const;
+
+	/* compileRenderGraph
+	Compiles the RenderGraph of the current Document if its Tracks layout has
+	changed since the last compilation. Called right before swapping, so that
+	the realtime thread always gets a graph consistent with its Tracks. */
+
+	void compileRenderGraph();
+
+	/* lendStretchers
+	Gives a Stretcher to the Sample channels that need one. Called right before
+	swapping, so that the realtime thread finds it ready. Their StretchStreams
+	get one too if stretching in background is enabled, but only once all
+	channels are served: a stream without a Stretcher just doesn't help. */
+
+	void lendStretchers();
+
+	/* reclaimStretchers
+	Takes back Stretchers from the Sample channels that don't need them anymore.
+	Called right after swapping, when the realtime thread is done with them. */
+
+	void reclaimStretchers();
+
+	/* releaseStretcher
+	Gives the Stretchers of the channel and of its StretchStream, if any, back
+	to the pool. */
+
+	void releaseStretcher(ChannelShared&);
+
 	AtomicSwapper m_swapper;
 	Shared        m_shared;
+	StretcherPool m_stretcherPool;
+
+	/* m_rtEpoch
+	Tracks the realtime thread going in and out of the Document (see
+	DocumentLock), so that other threads can wait for it without spinning. */
+
+	RtEpoch   m_rtEpoch;
+	Reclaimer m_reclaimer;
+
+	/* m_lastSwap
+	Time of the last swap, in steady clock ticks. Swaps can come from different
+	threads. */
+
+	std::atomic<int64_t> m_lastSwap;
+
+#if G_DEBUG_MODE
+	std::atomic<int>     m_swapCount;
+	std::atomic<int>     m_swapsPerSecond;
+	std::atomic<int64_t> m_swapCountStart;
+#endif
 };
 } // namespace giada::m::model
 
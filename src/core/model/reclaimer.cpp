@@ -0,0 +1,225 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "src/core/model/reclaimer.h"
+#include "src/core/channels/channelShared.h"
+#include "src/core/const.h"
+#include "src/core/plugins/plugin.h"
+#include "src/core/rtEpoch.h"
+#include "src/core/wave.h"
+#include <algorithm>
+
+namespace giada::m::model
+{
+namespace
+{
+/* extract_
+Moves out the objects retired before 'generation'. */
+
+template <typename R>
+std::vector<R> extract_(std::vector<R>& source, uint64_t generation)
+{
+	auto it = std::stable_partition(source.begin(), source.end(), [generation](const R& r)
+	{ return r.generation >= generation; });
+
+	std::vector<R> out(std::make_move_iterator(it), std::make_move_iterator(source.end()));
+	source.erase(it, source.end());
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+template <typename R>
+void addStats_(const std::vector<R>& source, Reclaimer::Stats& stats)
+{
+	for (const R& r : source)
+	{
+		stats.objects += 1;
+		stats.bytes += r.bytes;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+template <typename R>
+bool hasCollectable_(const std::vector<R>& source, uint64_t generation)
+{
+	return std::any_of(source.begin(), source.end(), [generation](const R& r)
+	{ return r.generation < generation; });
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Reclaimer::Reclaimer(RtEpoch& e)
+: m_rtEpoch(e)
+, m_worker(G_RECLAIMER_RATE_MS)
+, m_generation(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Reclaimer::~Reclaimer()
+{
+	stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Reclaimer::Stats Reclaimer::getStats() const
+{
+	std::scoped_lock lock(m_mutex);
+
+	Stats stats;
+	addStats_(m_waves, stats);
+	addStats_(m_channels, stats);
+	addStats_(m_plugins, stats);
+	stats.objects += static_cast<int>(m_collectablePlugins.size());
+	return stats;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::start()
+{
+	m_worker.start([this]()
+	{ collect(); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::stop()
+{
+	m_worker.stop();
+	m_rtEpoch.synchronize();
+
+	std::vector<Retired<Wave>>           waves;
+	std::vector<Retired<ChannelShared>>  channels;
+	std::vector<Retired<Plugin>>         plugins;
+	std::vector<std::unique_ptr<Plugin>> collectablePlugins;
+	{
+		std::scoped_lock lock(m_mutex);
+		waves              = std::move(m_waves);
+		channels           = std::move(m_channels);
+		plugins            = std::move(m_plugins);
+		collectablePlugins = std::move(m_collectablePlugins);
+	}
+
+	/* Everything is destroyed here, out of the lock. */
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::retire(std::unique_ptr<Wave> w)
+{
+	if (w == nullptr)
+		return;
+	const std::size_t bytes = w->getDataSize();
+
+	std::scoped_lock lock(m_mutex);
+	m_waves.push_back({std::move(w), m_generation.load(), bytes});
+}
+
+void Reclaimer::retire(std::unique_ptr<ChannelShared> c)
+{
+	if (c == nullptr)
+		return;
+	const std::size_t bytes = c->audioBuffer.countSamples() * sizeof(float);
+
+	std::scoped_lock lock(m_mutex);
+	m_channels.push_back({std::move(c), m_generation.load(), bytes});
+}
+
+void Reclaimer::retire(std::unique_ptr<Plugin> p)
+{
+	if (p == nullptr)
+		return;
+
+	std::scoped_lock lock(m_mutex);
+	m_plugins.push_back({std::move(p), m_generation.load(), /*bytes=*/0});
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::advance(std::function<void()> swap)
+{
+	std::scoped_lock lock(m_mutex);
+	swap();
+	m_generation.fetch_add(1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::collectPlugins()
+{
+	std::vector<std::unique_ptr<Plugin>> plugins;
+	{
+		std::scoped_lock lock(m_mutex);
+		plugins = std::move(m_collectablePlugins);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::collect()
+{
+	const uint64_t generation = m_generation.load();
+
+	if (!hasCollectable(generation))
+		return;
+
+	/* The Document swapped in at 'generation' doesn't point to the objects
+	retired before it. Wait for the realtime thread to leave the older ones, in
+	case it's still reading them. */
+
+	m_rtEpoch.synchronize();
+
+	std::vector<Retired<Wave>>          waves;
+	std::vector<Retired<ChannelShared>> channels;
+	{
+		std::scoped_lock lock(m_mutex);
+		waves    = extract_(m_waves, generation);
+		channels = extract_(m_channels, generation);
+		for (Retired<Plugin>& p : extract_(m_plugins, generation))
+			m_collectablePlugins.push_back(std::move(p.object));
+	}
+
+	/* Waves and ChannelShared objects are destroyed here, out of the lock. */
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Reclaimer::hasCollectable(uint64_t generation) const
+{
+	std::scoped_lock lock(m_mutex);
+	return hasCollectable_(m_waves, generation) ||
+	       hasCollectable_(m_channels, generation) ||
+	       hasCollectable_(m_plugins, generation);
+}
+} // namespace giada::m::model
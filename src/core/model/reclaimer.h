@@ -0,0 +1,153 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_MODEL_RECLAIMER_H
+#define G_MODEL_RECLAIMER_H
+
+#include "src/core/worker.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace giada
+{
+class RtEpoch;
+}
+
+namespace giada::m
+{
+class Wave;
+class Plugin;
+struct ChannelShared;
+} // namespace giada::m
+
+namespace giada::m::model
+{
+/* Reclaimer
+Deferred deletion of shared data removed from the Model. Removed objects are
+retired here instead of being destroyed on the spot, as the realtime thread
+might still be reading them through the current Document. They are freed once a
+swap has been performed after their retirement (i.e. the Document doesn't point
+to them anymore) and the realtime thread has left the previous Document (see
+RtEpoch). Waves and ChannelShared objects are freed on a background thread;
+Plugins on the main thread instead, due to JUCE and VST3 internal workings. */
+
+class Reclaimer
+{
+public:
+	struct Stats
+	{
+		int         objects = 0;
+		std::size_t bytes   = 0;
+	};
+
+	Reclaimer(RtEpoch&);
+	~Reclaimer();
+
+	/* getStats
+	Returns the number of objects waiting to be freed and the memory they take,
+	as far as it's known. */
+
+	Stats getStats() const;
+
+	/* start
+	Starts the background thread. */
+
+	void start();
+
+	/* stop
+	Stops the background thread and frees all the retired objects, waiting for
+	the realtime thread if necessary. Main thread only. */
+
+	void stop();
+
+	/* retire
+	Takes ownership of an object detached from the Model. */
+
+	void retire(std::unique_ptr<Wave>);
+	void retire(std::unique_ptr<ChannelShared>);
+	void retire(std::unique_ptr<Plugin>);
+
+	/* advance
+	Performs the Document swap through the given function and tells the
+	Reclaimer about it. The swap happens under the same lock retire() stamps
+	objects with, so an object can't be stamped with a generation whose swap
+	has already happened while the swapped Document was still pointing to it. */
+
+	void advance(std::function<void()> swap);
+
+	/* collectPlugins
+	Frees the Plugins that are safe to delete. Main thread only. */
+
+	void collectPlugins();
+
+private:
+	template <typename T>
+	struct Retired
+	{
+		std::unique_ptr<T> object;
+		uint64_t           generation;
+		std::size_t        bytes;
+	};
+
+	/* collect
+	Frees Waves and ChannelShared objects retired before the last swap, and
+	makes Plugins retired before the last swap available to collectPlugins().
+	Called by the background thread. */
+
+	void collect();
+
+	/* hasCollectable
+	True if some objects have been retired before the given generation. */
+
+	bool hasCollectable(uint64_t generation) const;
+
+	RtEpoch& m_rtEpoch;
+	Worker   m_worker;
+
+	/* m_generation
+	Number of swaps performed so far. Retired objects are stamped with it.
+	Written under m_mutex, together with the swap. */
+
+	std::atomic<uint64_t> m_generation;
+
+	mutable std::mutex                  m_mutex;
+	std::vector<Retired<Wave>>          m_waves;
+	std::vector<Retired<ChannelShared>> m_channels;
+	std::vector<Retired<Plugin>>        m_plugins;
+
+	/* m_collectablePlugins
+	Plugins that are safe to delete, waiting for the main thread. */
+
+	std::vector<std::unique_ptr<Plugin>> m_collectablePlugins;
+};
+} // namespace giada::m::model
+
+#endif
@@ -29,11 +29,15 @@
 #include "src/core/plugins/pluginFactory.h"
 #include "src/core/plugins/pluginManager.h"
 #include "src/core/waveFactory.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/deps/mcl-utils/src/container.hpp"
 #if G_DEBUG_MODE
 #include <fmt/core.h>
+#include <set>
 #endif
+#include <algorithm>
 #include <fmt/ostream.h>
+#include <utility>
 
 namespace utils = mcl::utils;
 
@@ -78,11 +82,40 @@ typename T::element_type& add_(std::vector<T>& dest, T obj)
 
 /* -------------------------------------------------------------------------- */
 
-template <typename D, typename T>
-void remove_(D& dest, T& ref)
+template <typename T>
+std::unique_ptr<T> remove_(std::vector<std::unique_ptr<T>>& dest, const T& ref)
 {
-	utils::container::removeIf(dest, [&ref](const auto& other)
+	auto it = std::find_if(dest.begin(), dest.end(), [&ref](const std::unique_ptr<T>& other)
 	{ return other.get() == &ref; });
+	if (it == dest.end())
+		return nullptr;
+	std::unique_ptr<T> out = std::move(*it);
+	dest.erase(it);
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* hasSameData_
+True if two in-memory Waves hold the very same audio content. Hashes are cached
+in each Wave, so the full comparison runs only on a likely match. */
+
+bool hasSameData_(const Wave& a, const Wave& b)
+{
+	const mcl::AudioBuffer& bufferA = a.getBuffer();
+	const mcl::AudioBuffer& bufferB = b.getBuffer();
+
+	if (bufferA.countFrames() != bufferB.countFrames() ||
+	    bufferA.countChannels() != bufferB.countChannels() ||
+	    a.getRate() != b.getRate() ||
+	    a.getBits() != b.getBits() ||
+	    a.getHash() != b.getHash())
+		return false;
+
+	for (int ch = 0; ch < bufferA.countChannels(); ch++)
+		if (!std::ranges::equal(bufferA.getChannelView(ch), bufferB.getChannelView(ch)))
+			return false;
+	return true;
 }
 } // namespace
 
@@ -101,7 +134,8 @@ void Shared::init()
 
 /* -------------------------------------------------------------------------- */
 
-LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const Sequencer& sequencer, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality)
+LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const Sequencer& sequencer, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality,
+    Frame streamThreshold, std::function<void(float)> progress)
 {
 	init();
 
@@ -116,13 +150,16 @@ LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const S
 		getAllPlugins().push_back(std::move(p));
 	}
 
-	for (const Patch::Wave& pwave : patch.waves)
+	/* Plug-ins above are loaded on this thread, as some of them must be
+	instantiated on the main one. Waves are independent: decode them in parallel. */
+
+	std::vector<std::unique_ptr<Wave>> waves = waveFactory::deserializeWaves(patch.waves, sampleRate, rsmpQuality, streamThreshold, progress);
+	for (std::size_t i = 0; i < waves.size(); i++)
 	{
-		std::unique_ptr<Wave> w = waveFactory::deserializeWave(pwave, sampleRate, rsmpQuality);
-		if (w != nullptr)
-			getAllWaves().push_back(std::move(w));
+		if (waves[i] != nullptr)
+			addWave(std::move(waves[i]));
 		else
-			state.missingWaves.push_back(pwave.path);
+			state.missingWaves.push_back(patch.waves[i].path);
 	}
 
 	for (const Patch::Channel& pchannel : patch.channels)
@@ -149,6 +186,7 @@ void Shared::store(Patch& patch, const std::string& projectPath)
 
 		w->setPath(waveFactory::makeUniqueWavePath(projectPath, *w, getAllWaves()));
 		waveFactory::save(*w, w->getPath()); // TODO - error checking
+		waveFactory::savePeaks(*w);          // Optional, just a speed-up on load
 
 		patch.waves.push_back(waveFactory::serializeWave(*w));
 	}
@@ -168,7 +206,22 @@ void Shared::debug() const
 	puts("shared::waves");
 
 	for (int i = 0; const auto& w : m_waves)
-		fmt::print("\t{}) {} - ID={} name='{}'\n", i++, (void*)w.get(), w->id.getValue(), w->getPath());
+		fmt::print("\t{}) {} - ID={} name='{}' data={}{}\n", i++, (void*)w.get(), w->id.getValue(), w->getPath(),
+		    (void*)&std::as_const(*w).getBuffer(), w->isDataShared() ? " (shared)" : "");
+
+	/* Memory saved by Waves sharing the same audio data. */
+
+	std::set<const mcl::AudioBuffer*> buffers;
+	std::size_t                       saved = 0;
+
+	for (const auto& w : m_waves)
+	{
+		const mcl::AudioBuffer& buffer = std::as_const(*w).getBuffer();
+		if (!buffers.insert(&buffer).second)
+			saved += buffer.countFrames() * buffer.countChannels() * sizeof(float);
+	}
+
+	fmt::print("\tmemory saved by shared data: {} bytes\n", saved);
 
 	puts("shared::plugins");
 
@@ -193,15 +246,21 @@ ChannelShared*     Shared::findChannel(ID id) { return get_(m_channels, id); }
 
 /* -------------------------------------------------------------------------- */
 
-Wave&          Shared::addWave(std::unique_ptr<Wave> w) { return add_(m_waves, std::move(w)); }
 Plugin&        Shared::addPlugin(std::unique_ptr<Plugin> p) { return add_(m_plugins, std::move(p)); }
 ChannelShared& Shared::addChannel(std::unique_ptr<ChannelShared> cs) { return add_(m_channels, std::move(cs)); }
 
+Wave& Shared::addWave(std::unique_ptr<Wave> w)
+{
+	Wave& wave = add_(m_waves, shareWaveData(std::move(w)));
+	wave.computePeaks(); // For the waveform display, in background
+	return wave;
+}
+
 /* -------------------------------------------------------------------------- */
 
-void Shared::removePlugin(const Plugin& p) { remove_(m_plugins, p); }
-void Shared::removeWave(const Wave& w) { remove_(m_waves, w); }
-void Shared::removeChannel(const ChannelShared& c) { remove_(m_channels, c); }
+std::unique_ptr<Plugin>        Shared::removePlugin(const Plugin& p) { return remove_(m_plugins, p); }
+std::unique_ptr<Wave>          Shared::removeWave(const Wave& w) { return remove_(m_waves, w); }
+std::unique_ptr<ChannelShared> Shared::removeChannel(const ChannelShared& c) { return remove_(m_channels, c); }
 
 /* -------------------------------------------------------------------------- */
 
@@ -221,4 +280,30 @@ std::vector<Plugin*> Shared::findPlugins(std::vector<ID> pluginIds)
 	}
 	return out;
 }
+
+/* -------------------------------------------------------------------------- */
+
+std::unique_ptr<Wave> Shared::shareWaveData(std::unique_ptr<Wave> w) const
+{
+	/* Streamed Waves hold only a portion of their audio data in memory, nothing
+	to share there. Compact Waves are excluded as well, as their float buffer is
+	empty. */
+
+	if (!w->isResident())
+		return w;
+
+	for (const std::unique_ptr<Wave>& other : m_waves)
+	{
+		if (!other->isResident())
+			continue;
+		if (&std::as_const(*other).getBuffer() == &std::as_const(*w).getBuffer()) // Already shared
+			break;
+		if (hasSameData_(*w, *other))
+		{
+			w->shareData(*other);
+			break;
+		}
+	}
+	return w;
+}
 } // namespace giada::m::model
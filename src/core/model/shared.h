@@ -34,6 +34,7 @@
 #include "src/core/model/sequencer.h"
 #include "src/core/plugins/plugin.h"
 #include "src/core/wave.h"
+#include <functional>
 
 namespace giada::m
 {
@@ -53,9 +54,12 @@ public:
 	void init();
 
 	/* load
-	Loads shared data from a Patch object. */
+	Loads shared data from a Patch object. Waves longer than 'streamThreshold'
+	frames are streamed from disk (0 = never stream). Waves are decoded in
+	parallel, 'progress' reports the decoding progress. */
 
-	LoadState load(const Patch&, PluginManager&, const Sequencer&, int sampleRate, int bufferSize, Resampler::Quality);
+	LoadState load(const Patch&, PluginManager&, const Sequencer&, int sampleRate, int bufferSize, Resampler::Quality,
+	    Frame streamThreshold, std::function<void(float)> progress);
 
 	/* store
 	Stores shared data into a Patch object. */
@@ -88,9 +92,12 @@ public:
 	Plugin&        addPlugin(std::unique_ptr<Plugin>);
 	ChannelShared& addChannel(std::unique_ptr<ChannelShared>);
 
-	void removePlugin(const Plugin&);
-	void removeWave(const Wave&);
-	void removeChannel(const ChannelShared&);
+	/* remove[*]
+	Detaches some shared data and returns it, or nullptr if not found. */
+
+	std::unique_ptr<Plugin>        removePlugin(const Plugin&);
+	std::unique_ptr<Wave>          removeWave(const Wave&);
+	std::unique_ptr<ChannelShared> removeChannel(const ChannelShared&);
 
 	void clearPlugins();
 	void clearWaves();
@@ -98,6 +105,12 @@ public:
 	std::vector<Plugin*> findPlugins(std::vector<ID> pluginIds);
 
 private:
+	/* shareWaveData
+	Makes Wave 'w' share the audio buffer of an existing Wave with the same
+	content, if any. Shared buffers are copied on write. */
+
+	std::unique_ptr<Wave> shareWaveData(std::unique_ptr<Wave> w) const;
+
 	KernelAudio::Shared                         m_kernelAudio;
 	Sequencer::Shared                           m_sequencer;
 	Mixer::Shared                               m_mixer;
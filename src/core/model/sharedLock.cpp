@@ -33,13 +33,21 @@ SharedLock::SharedLock(Model& m, SwapType t)
 : m_model(m)
 , m_swapType(t)
 {
+	/* Swap right away, even within a Transaction: the realtime thread must
+	stop reading shared data before it gets modified. */
+
 	m_model.get().locked = true;
-	m_model.swap(SwapType::NONE);
+	m_model.publish(SwapType::NONE);
+
+	/* The realtime thread might have picked up the previous Document right
+	before the swap: wait for it to be released. */
+
+	m_model.waitRtUnlocked();
 }
 
 SharedLock::~SharedLock()
 {
 	m_model.get().locked = false;
-	m_model.swap(m_swapType);
+	m_model.publish(m_swapType);
 }
 } // namespace giada::m::model
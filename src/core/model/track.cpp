@@ -109,7 +109,12 @@ const Channel& Track::getGroupChannel() const
 
 Channel& Track::getGroupChannel()
 {
-	return const_cast<Channel&>(std::as_const(*this).getGroupChannel());
+	std::vector<Channel>& channels = m_channels.getAll();
+
+	assert(channels.size() > 0);
+	assert(channels[0].type == ChannelType::GROUP);
+
+	return channels[0];
 }
 
 /* -------------------------------------------------------------------------- */
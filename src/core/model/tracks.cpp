@@ -26,6 +26,7 @@
 
 #include "src/core/model/tracks.h"
 #include "src/deps/mcl-utils/src/container.hpp"
+#include <utility>
 
 namespace utils = mcl::utils;
 
@@ -33,7 +34,7 @@ namespace giada::m::model
 {
 const std::vector<Track>& Tracks::getAll() const
 {
-	return m_tracks;
+	return m_tracks.get();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -47,29 +48,39 @@ Track& Tracks::add(Channel&& groupChannel, int width, bool internal)
 
 Track& Tracks::add(int width, bool internal)
 {
-	m_tracks.push_back({m_tracks.size(), width, internal});
-	return m_tracks.back();
+	std::vector<Track>& tracks = m_tracks.edit();
+	tracks.push_back({tracks.size(), width, internal});
+	return tracks.back();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Tracks::remove(std::size_t index)
 {
-	assert(index < m_tracks.size());
+	std::vector<Track>& tracks = m_tracks.edit();
 
-	m_tracks.erase(m_tracks.begin() + index);
+	assert(index < tracks.size());
 
-	for (const auto [newIndex, track] : utils::container::enumerate(m_tracks))
+	tracks.erase(tracks.begin() + index);
+
+	for (const auto [newIndex, track] : utils::container::enumerate(tracks))
 		track.m_index = newIndex;
 }
 
 /* -------------------------------------------------------------------------- */
 
+const Track& Tracks::get(std::size_t index) const
+{
+	assert(index < m_tracks.get().size());
+
+	return m_tracks.get()[index];
+}
+
 Track& Tracks::get(std::size_t index)
 {
-	assert(index < m_tracks.size());
+	assert(index < m_tracks.get().size());
 
-	return m_tracks[index];
+	return m_tracks.edit()[index];
 }
 
 /* -------------------------------------------------------------------------- */
@@ -77,7 +88,7 @@ Track& Tracks::get(std::size_t index)
 const Channel& Tracks::getChannel(ID channelId) const
 {
 	const Channel* out = nullptr;
-	for (const Track& track : m_tracks)
+	for (const Track& track : m_tracks.get())
 	{
 		out = track.findChannel(channelId);
 		if (out != nullptr)
@@ -89,14 +100,18 @@ const Channel& Tracks::getChannel(ID channelId) const
 
 Channel& Tracks::getChannel(ID channelId)
 {
-	return const_cast<Channel&>(std::as_const(*this).getChannel(channelId));
+	/* Go through the owning Track, so that only its Channels get copied. */
+
+	Channel* out = getByChannel(channelId).findChannel(channelId);
+	assert(out != nullptr);
+	return *out;
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Tracks::forEachChannel(std::function<bool(Channel&)> f)
 {
-	for (Track& track : m_tracks)
+	for (Track& track : m_tracks.edit())
 		for (Channel& channel : track.getChannels().getAll())
 			if (!f(channel))
 				return;
@@ -107,7 +122,7 @@ void Tracks::forEachChannel(std::function<bool(Channel&)> f)
 std::vector<Channel*> Tracks::getChannelsIf(std::function<bool(const Channel&)> f)
 {
 	std::vector<Channel*> out;
-	for (Track& track : m_tracks)
+	for (Track& track : m_tracks.edit())
 	{
 		const std::vector<Channel*> tmp = track.getChannels().getIf(f);
 		out.insert(out.end(), tmp.begin(), tmp.end());
@@ -119,7 +134,7 @@ std::vector<Channel*> Tracks::getChannelsIf(std::function<bool(const Channel&)>
 
 bool Tracks::anyChannelOf(std::function<bool(const Channel&)> f) const
 {
-	for (const Track& track : m_tracks)
+	for (const Track& track : m_tracks.get())
 		if (track.getChannels().anyOf(f))
 			return true;
 	return false;
@@ -130,7 +145,7 @@ bool Tracks::anyChannelOf(std::function<bool(const Channel&)> f) const
 std::vector<const Channel*> Tracks::getChannels() const
 {
 	std::vector<const Channel*> out;
-	for (const Track& track : m_tracks)
+	for (const Track& track : m_tracks.get())
 		for (const Channel& channel : track.getChannels().getAll())
 			out.push_back(&channel);
 	return out;
@@ -142,7 +157,7 @@ std::vector<const Channel*> Tracks::getChannels() const
 
 void Tracks::debug() const
 {
-	for (const Track& track : m_tracks)
+	for (const Track& track : m_tracks.get())
 		track.debug();
 }
 
@@ -150,34 +165,44 @@ void Tracks::debug() const
 
 /* -------------------------------------------------------------------------- */
 
-Track& Tracks::getByChannel(ID channelId)
+const Track& Tracks::getByChannel(ID channelId) const
 {
-	const auto p = [channelId](Track& track)
+	const auto p = [channelId](const Track& track)
 	{
 		return utils::container::hasIf(track.getChannels().getAll(), [channelId](const Channel& ch)
 		{ return channelId == ch.id; });
 	};
-	auto it = utils::container::findIf(m_tracks, p);
-	assert(it != m_tracks.end());
+	const std::vector<Track>& tracks = m_tracks.get();
+
+	auto it = utils::container::findIf(tracks, p);
+	assert(it != tracks.end());
 	return *it;
 }
 
+Track& Tracks::getByChannel(ID channelId)
+{
+	/* Edit only once found: it might copy the vector. */
+
+	const std::size_t index = std::as_const(*this).getByChannel(channelId).getIndex();
+	return m_tracks.edit()[index];
+}
+
 /* -------------------------------------------------------------------------- */
 
 void Tracks::addChannel(Channel&& channel, std::size_t trackIndex)
 {
 	assert(channel.type != ChannelType::GROUP);
-	assert(trackIndex <= m_tracks.size());
+	assert(trackIndex <= m_tracks.get().size());
 
-	m_tracks[trackIndex].addChannel(std::move(channel));
+	m_tracks.edit()[trackIndex].addChannel(std::move(channel));
 }
 
 void Tracks::addChannel(Channel&& channel, std::size_t trackIndex, std::size_t position)
 {
 	assert(channel.type != ChannelType::GROUP);
-	assert(trackIndex <= m_tracks.size());
+	assert(trackIndex <= m_tracks.get().size());
 
-	m_tracks[trackIndex].addChannel(std::move(channel), position);
+	m_tracks.edit()[trackIndex].addChannel(std::move(channel), position);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -191,8 +216,8 @@ void Tracks::removeChannel(ID channelId)
 
 Channel& Tracks::getLastChannel(std::size_t trackIndex)
 {
-	assert(trackIndex <= m_tracks.size());
+	assert(trackIndex <= m_tracks.get().size());
 
-	return m_tracks[trackIndex].getLastChannel();
+	return m_tracks.edit()[trackIndex].getLastChannel();
 }
 } // namespace giada::m::model
@@ -27,6 +27,7 @@
 #ifndef G_MODEL_TRACKS_H
 #define G_MODEL_TRACKS_H
 
+#include "src/core/model/cow.h"
 #include "src/core/model/track.h"
 
 namespace giada::m
@@ -40,7 +41,9 @@ class Tracks
 {
 public:
 	const std::vector<Track>&   getAll() const;
+	const Track&                get(std::size_t index) const;
 	const Channel&              getChannel(ID) const;
+	const Track&                getByChannel(ID) const;
 	bool                        anyChannelOf(std::function<bool(const Channel&)> f) const;
 	std::vector<const Channel*> getChannels() const;
 
@@ -70,7 +73,11 @@ public:
 	std::vector<Channel*> getChannelsIf(std::function<bool(const Channel&)>);
 
 private:
-	std::vector<Track> m_tracks;
+	/* m_tracks
+	Shared with the published Documents until edited (see Cow). Editing a Channel
+	also copies the Tracks it lives in, but not the Channels of the other ones. */
+
+	Cow<std::vector<Track>> m_tracks;
 };
 } // namespace giada::m::model
 
@@ -32,12 +32,7 @@
 
 namespace giada::m::model
 {
-/* DocumentLock
-Alias for a REALTIME scoped lock provided by the Swapper class. Use this in the
-real-time thread to lock the Document. */
-
 using AtomicSwapper = mcl::AtomicSwapper<Document, /*size=*/6>;
-using DocumentLock  = AtomicSwapper::RtLock;
 
 /* SwapType
 Type of Document change.
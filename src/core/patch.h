@@ -131,8 +131,9 @@ struct Patch
 
 	struct Wave
 	{
-		ID          id;
-		std::string path;
+		ID            id;
+		std::string   path;
+		SampleStorage storage = SampleStorage::FLOAT;
 	};
 
 	struct Plugin
@@ -93,6 +93,7 @@ constexpr auto PATCH_KEY_CHANNEL_ARMED                = "armed";
 constexpr auto PATCH_KEY_WAVES                        = "waves";
 constexpr auto PATCH_KEY_WAVE_ID                      = "id";
 constexpr auto PATCH_KEY_WAVE_PATH                    = "path";
+constexpr auto PATCH_KEY_WAVE_STORAGE                 = "storage";
 constexpr auto PATCH_KEY_ACTIONS                      = "actions";
 constexpr auto PATCH_KEY_PLUGIN_ID                    = "id";
 constexpr auto PATCH_KEY_PLUGIN_JUCE_ID               = "juce_id";
@@ -182,8 +183,9 @@ void readWaves_(Patch& patch, const nlohmann::json& j, const std::string& basePa
 	for (const auto& jwave : j[PATCH_KEY_WAVES])
 	{
 		Patch::Wave w;
-		w.id   = jwave.value(PATCH_KEY_WAVE_ID, ++id);
-		w.path = utils::fs::join(basePath, jwave.value(PATCH_KEY_WAVE_PATH, ""));
+		w.id      = jwave.value(PATCH_KEY_WAVE_ID, ++id);
+		w.path    = utils::fs::join(basePath, jwave.value(PATCH_KEY_WAVE_PATH, ""));
+		w.storage = jwave.value(PATCH_KEY_WAVE_STORAGE, SampleStorage::FLOAT);
 		patch.waves.push_back(w);
 	}
 }
@@ -346,8 +348,9 @@ void writeWaves_(const Patch& patch, nlohmann::json& j)
 	for (const Patch::Wave& w : patch.waves)
 	{
 		nlohmann::json jwave;
-		jwave[PATCH_KEY_WAVE_ID]   = w.id;
-		jwave[PATCH_KEY_WAVE_PATH] = w.path;
+		jwave[PATCH_KEY_WAVE_ID]      = w.id;
+		jwave[PATCH_KEY_WAVE_PATH]    = w.path;
+		jwave[PATCH_KEY_WAVE_STORAGE] = w.storage;
 
 		j[PATCH_KEY_WAVES].push_back(jwave);
 	}
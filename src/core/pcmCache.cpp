@@ -0,0 +1,372 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/pcmCache.h"
+#include "src/core/wave.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+namespace giada::m::pcmCache
+{
+namespace
+{
+/* Each cache entry is a single file made of a fixed-size Header_, followed by
+the cache key string and by planar float audio data, one channel after another.
+Audio data starts on a DATA_ALIGNMENT boundary, so that the file can be safely
+memory-mapped. */
+
+constexpr std::array<char, 8> MAGIC          = {'G', 'I', 'A', 'D', 'A', 'P', 'C', 'M'};
+constexpr std::uint32_t       VERSION        = 1;
+constexpr std::size_t         DATA_ALIGNMENT = 64;
+constexpr const char*         EXTENSION      = ".pcm";
+
+struct Header_
+{
+	std::array<char, 8> magic;
+	std::uint32_t       version;
+	std::uint32_t       channels;
+	std::int64_t        frames;
+	std::int32_t        rate;
+	std::int32_t        bits;
+	std::uint64_t       keyHash;
+	std::uint64_t       keyLength;
+	std::uint64_t       dataOffset;
+};
+
+struct Entry_
+{
+	stdfs::path           path;
+	stdfs::file_time_type lastUse;
+	std::uintmax_t        size;
+};
+
+std::string                 path_;
+std::atomic<std::uintmax_t> maxSize_    = 0;
+std::mutex                  mutex_; // Guards folder scans and evictions
+std::atomic<int>            hits_       = 0;
+std::atomic<int>            misses_     = 0;
+std::atomic<std::uintmax_t> bytesSaved_ = 0;
+std::atomic<std::uintmax_t> size_       = 0;
+std::atomic<int>            tempId_     = 0; // Unique suffix for temporary files
+
+/* -------------------------------------------------------------------------- */
+
+/* hash_
+64-bit FNV-1a hash, good enough to name cache files. Collisions are caught by
+comparing the full key stored in each entry. */
+
+std::uint64_t hash_(const std::string& s)
+{
+	std::uint64_t h = 14695981039346656037ull;
+	for (const unsigned char c : s)
+	{
+		h ^= c;
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* makeKey_
+Returns a string that uniquely identifies the decoded audio of 'sourcePath':
+any change to the source file or to the conversion settings invalidates it.
+Returns an empty string if the source file can't be inspected. */
+
+std::string makeKey_(const std::string& sourcePath, int sampleRate, Resampler::Quality quality)
+{
+	std::error_code ec;
+
+	const stdfs::path           path  = stdfs::absolute(sourcePath, ec);
+	const std::uintmax_t        size  = stdfs::file_size(path, ec);
+	const stdfs::file_time_type mtime = stdfs::last_write_time(path, ec);
+
+	if (ec)
+		return "";
+	return fmt::format("{}|{}|{}|{}|{}", path.string(), size, mtime.time_since_epoch().count(),
+	    sampleRate, static_cast<int>(quality));
+}
+
+/* -------------------------------------------------------------------------- */
+
+stdfs::path makeEntryPath_(const std::string& key)
+{
+	return stdfs::path(path_) / fmt::format("{:016x}{}", hash_(key), EXTENSION);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<Entry_> scan_()
+{
+	std::vector<Entry_> entries;
+	std::error_code     ec;
+
+	for (const stdfs::directory_entry& e : stdfs::directory_iterator(path_, ec))
+	{
+		if (!e.is_regular_file(ec) || e.path().extension() != EXTENSION)
+			continue;
+		entries.push_back({e.path(), e.last_write_time(ec), e.file_size(ec)});
+	}
+	return entries;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* evict_
+Removes the least recently used entries until the cache fits 'maxSize_'. Entry
+files are touched on each read, so their modification time is the last time
+they were used. */
+
+void evict_()
+{
+	std::vector<Entry_> entries = scan_();
+	std::uintmax_t      total   = 0;
+
+	for (const Entry_& e : entries)
+		total += e.size;
+
+	std::sort(entries.begin(), entries.end(), [](const Entry_& a, const Entry_& b)
+	    { return a.lastUse < b.lastUse; });
+
+	for (const Entry_& e : entries)
+	{
+		if (total <= maxSize_)
+			break;
+		std::error_code ec;
+		if (!stdfs::remove(e.path, ec))
+			continue;
+		total -= e.size;
+		u::log::print("[pcmCache::evict] removed {}\n", e.path.string());
+	}
+
+	size_ = total;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+float Stats::getHitRate() const
+{
+	return hits + misses == 0 ? 0.0f : hits / static_cast<float>(hits + misses);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void init(const std::string& path, std::uintmax_t maxSize)
+{
+	std::scoped_lock lock(mutex_);
+
+	path_       = path;
+	maxSize_    = maxSize;
+	hits_       = 0;
+	misses_     = 0;
+	bytesSaved_ = 0;
+	size_       = 0;
+
+	if (maxSize_ == 0)
+		return;
+
+	std::error_code ec;
+	stdfs::create_directories(path_, ec);
+	if (ec)
+	{
+		u::log::print("[pcmCache::init] unable to create cache folder {}, cache disabled\n", path_);
+		maxSize_ = 0;
+		return;
+	}
+
+	evict_();
+
+	u::log::print("[pcmCache::init] cache folder {}, {} bytes used\n", path_, size_.load());
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool isEnabled()
+{
+	return maxSize_ > 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool read(const std::string& sourcePath, int sampleRate, Resampler::Quality quality, Wave& w)
+{
+	if (!isEnabled())
+		return false;
+
+	const std::string key       = makeKey_(sourcePath, sampleRate, quality);
+	const stdfs::path entryPath = makeEntryPath_(key);
+
+	std::ifstream ifs(entryPath, std::ios::binary);
+	if (key.empty() || !ifs)
+	{
+		misses_++;
+		return false;
+	}
+
+	Header_     header;
+	std::string storedKey;
+
+	ifs.read(reinterpret_cast<char*>(&header), sizeof(Header_));
+
+	const bool valid = ifs &&
+	                   header.magic == MAGIC &&
+	                   header.version == VERSION &&
+	                   header.channels > 0 &&
+	                   header.frames > 0 &&
+	                   header.rate == sampleRate &&
+	                   header.keyHash == hash_(key) &&
+	                   header.keyLength == key.size();
+
+	if (valid)
+	{
+		storedKey.resize(header.keyLength);
+		ifs.read(storedKey.data(), header.keyLength);
+	}
+
+	if (!valid || !ifs || storedKey != key)
+	{
+		misses_++;
+		return false;
+	}
+
+	w.alloc(static_cast<Frame>(header.frames), header.channels, header.rate, header.bits, sourcePath);
+
+	ifs.seekg(header.dataOffset);
+	for (int ch = 0; ch < static_cast<int>(header.channels); ch++)
+		ifs.read(reinterpret_cast<char*>(w.getBuffer().getChannelView(ch).data()), header.frames * sizeof(float));
+
+	if (!ifs)
+	{
+		u::log::print("[pcmCache::read] corrupted entry {}\n", entryPath.string());
+		misses_++;
+		return false;
+	}
+
+	/* Touch the entry, so that it becomes the most recently used one. */
+
+	std::error_code ec;
+	stdfs::last_write_time(entryPath, stdfs::file_time_type::clock::now(), ec);
+
+	hits_++;
+	bytesSaved_ += header.frames * header.channels * sizeof(float);
+
+	u::log::print("[pcmCache::read] cache hit for {}\n", sourcePath);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void write(const std::string& sourcePath, int sampleRate, Resampler::Quality quality, const Wave& w)
+{
+	if (!isEnabled())
+		return;
+
+	const std::string key = makeKey_(sourcePath, sampleRate, quality);
+	if (key.empty())
+		return;
+
+	const mcl::AudioBuffer& buffer = w.getBuffer();
+
+	Header_ header;
+	header.magic      = MAGIC;
+	header.version    = VERSION;
+	header.channels   = buffer.countChannels();
+	header.frames     = buffer.countFrames();
+	header.rate       = w.getRate();
+	header.bits       = w.getBits();
+	header.keyHash    = hash_(key);
+	header.keyLength  = key.size();
+	header.dataOffset = (sizeof(Header_) + key.size() + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+
+	const std::uintmax_t entrySize = header.dataOffset + header.frames * header.channels * sizeof(float);
+	if (entrySize > maxSize_)
+		return;
+
+	/* Write to a temporary file first and rename it when complete, so that a
+	concurrent reader never sees a half-written entry. */
+
+	const stdfs::path entryPath = makeEntryPath_(key);
+	const stdfs::path tempPath  = stdfs::path(entryPath).concat(fmt::format(".{}.tmp", tempId_++));
+
+	{
+		std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+
+		const std::vector<char> padding(header.dataOffset - sizeof(Header_) - key.size(), 0);
+
+		ofs.write(reinterpret_cast<const char*>(&header), sizeof(Header_));
+		ofs.write(key.data(), key.size());
+		ofs.write(padding.data(), padding.size());
+		for (int ch = 0; ch < buffer.countChannels(); ch++)
+			ofs.write(reinterpret_cast<const char*>(buffer.getChannelView(ch).data()), header.frames * sizeof(float));
+
+		if (!ofs)
+		{
+			u::log::print("[pcmCache::write] unable to write {}\n", tempPath.string());
+			ofs.close();
+			std::error_code ec;
+			stdfs::remove(tempPath, ec);
+			return;
+		}
+	}
+
+	std::scoped_lock lock(mutex_);
+
+	std::error_code ec;
+	stdfs::rename(tempPath, entryPath, ec);
+	if (ec)
+	{
+		stdfs::remove(tempPath, ec);
+		return;
+	}
+
+	evict_();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Stats getStats()
+{
+	return {hits_.load(), misses_.load(), bytesSaved_.load(), size_.load()};
+}
+} // namespace giada::m::pcmCache
@@ -0,0 +1,83 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_PCM_CACHE_H
+#define G_PCM_CACHE_H
+
+#include "src/core/resampler.h"
+#include <cstdint>
+#include <string>
+
+namespace giada::m
+{
+class Wave;
+}
+
+namespace giada::m::pcmCache
+{
+/* Stats
+Cache statistics since the last call to init(). 'bytesSaved' is the amount of
+decoded audio data read from the cache instead of being decoded again. */
+
+struct Stats
+{
+	int            hits       = 0;
+	int            misses     = 0;
+	std::uintmax_t bytesSaved = 0;
+	std::uintmax_t size       = 0; // Current size on disk, in bytes
+
+	float getHitRate() const;
+};
+
+/* init
+Enables the cache in folder 'path', which is created if missing. The cache
+holds up to 'maxSize' bytes: pass 0 to disable it. Resets statistics. */
+
+void init(const std::string& path, std::uintmax_t maxSize);
+
+/* isEnabled
+True if init() has been called with a valid folder and a non-zero size. */
+
+bool isEnabled();
+
+/* read
+Fills Wave 'w' with the cached audio data of file 'sourcePath', previously
+decoded at 'sampleRate' with the given resampler quality. The cache entry is
+invalid if the source file has changed since. Returns false on cache miss. */
+
+bool read(const std::string& sourcePath, int sampleRate, Resampler::Quality, Wave& w);
+
+/* write
+Stores the audio data of Wave 'w', decoded from file 'sourcePath', evicting the
+least recently used entries if the cache grows too big. */
+
+void write(const std::string& sourcePath, int sampleRate, Resampler::Quality, const Wave& w);
+
+Stats getStats();
+} // namespace giada::m::pcmCache
+
+#endif
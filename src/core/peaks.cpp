@@ -0,0 +1,403 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/peaks.h"
+#include "src/core/const.h"
+#include "src/core/worker.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+
+namespace giada::m
+{
+namespace
+{
+using Levels_ = std::vector<std::vector<Peaks::Peak>>;
+
+/* A peaks file is made of a fixed-size FileHeader_, followed by the Peaks of
+the first level. */
+
+constexpr std::array<char, 8> FILE_MAGIC   = {'G', 'I', 'A', 'D', 'A', 'P', 'K', 'S'};
+constexpr std::uint32_t       FILE_VERSION = 2;
+
+struct FileHeader_
+{
+	std::array<char, 8> magic;
+	std::uint32_t       version;
+	std::uint32_t       blockFrames;
+	std::int64_t        frames;
+	std::uint64_t       sourceSize;
+	std::int64_t        sourceMtime;
+	std::uint64_t       count; // Number of Peaks in the first level
+};
+
+Worker                            builder_(G_PEAKS_BUILDER_RATE_MS);
+std::mutex                        queueMutex_;
+std::vector<std::weak_ptr<Peaks>> queue_;
+std::atomic<bool>                 builderRunning_ = false;
+
+/* -------------------------------------------------------------------------- */
+
+Peaks::Peak merge_(Peaks::Peak a, Peaks::Peak b)
+{
+	return {std::min(a.min, b.min), std::max(a.max, b.max)};
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* reduce_
+Scans frames [a, b) of 'data' and returns their peak. */
+
+Peaks::Peak reduce_(const mcl::AudioBuffer& data, Frame a, Frame b)
+{
+	const int channels = data.countChannels();
+
+	Peaks::Peak out;
+	for (Frame i = a; i < b; i++)
+	{
+		float avg = 0.0f;
+		for (int j = 0; j < channels; j++)
+			avg += data.at(i, j);
+		avg /= channels;
+
+		out.min = std::min(out.min, avg);
+		out.max = std::max(out.max, avg);
+	}
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* resize_
+Shapes the pyramid so that it can hold the peaks of 'frames' frames: levels are
+added or removed as needed, until the last one is made of a single Peak. */
+
+void resize_(Levels_& levels, Frame frames)
+{
+	std::size_t size  = (frames + G_PEAKS_BLOCK_FRAMES - 1) / G_PEAKS_BLOCK_FRAMES;
+	std::size_t count = 0;
+	do
+	{
+		if (levels.size() == count)
+			levels.emplace_back();
+		levels[count++].resize(size);
+		size = (size + 1) / 2;
+	} while (levels[count - 1].size() > 1);
+
+	levels.resize(count);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* computeParents_
+Computes all the Peaks in the upper levels that depend on blocks [lo, hi) of
+the first level. */
+
+void computeParents_(Levels_& levels, std::size_t lo, std::size_t hi)
+{
+	for (std::size_t l = 1; l < levels.size(); l++)
+	{
+		const std::vector<Peaks::Peak>& children = levels[l - 1];
+
+		lo = lo / 2;
+		hi = (hi + 1) / 2;
+		for (std::size_t i = lo; i < hi; i++)
+			levels[l][i] = 2 * i + 1 < children.size() ? merge_(children[2 * i], children[2 * i + 1]) : children[2 * i];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* compute_
+Computes blocks [lo, hi) of the first level from 'data', then all the Peaks
+that depend on them in the following levels. */
+
+void compute_(Levels_& levels, const mcl::AudioBuffer& data, std::size_t lo, std::size_t hi)
+{
+	const Frame frames = data.countFrames();
+
+	for (std::size_t i = lo; i < hi; i++)
+	{
+		const Frame a = static_cast<Frame>(i) * G_PEAKS_BLOCK_FRAMES;
+		levels[0][i]  = reduce_(data, a, std::min(a + G_PEAKS_BLOCK_FRAMES, frames));
+	}
+
+	computeParents_(levels, lo, hi);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::shared_ptr<Peaks> Peaks::compute(std::shared_ptr<const mcl::AudioBuffer> data)
+{
+	assert(data != nullptr);
+
+	std::shared_ptr<Peaks> peaks = std::make_shared<Peaks>(std::move(data));
+
+	if (!builderRunning_.load())
+	{
+		peaks->build();
+		return peaks;
+	}
+
+	std::scoped_lock lock(queueMutex_);
+	queue_.push_back(peaks);
+	return peaks;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::optional<Peaks::Source> Peaks::getSource(const std::string& audioPath)
+{
+	std::error_code ec;
+
+	const std::uintmax_t                  size  = std::filesystem::file_size(audioPath, ec);
+	const std::filesystem::file_time_type mtime = std::filesystem::last_write_time(audioPath, ec);
+
+	if (ec)
+		return {};
+	return Source{size, mtime.time_since_epoch().count()};
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::shared_ptr<Peaks> Peaks::load(const std::string& path, const Source& source, Frame frames)
+{
+	std::ifstream ifs(path, std::ios::binary);
+	if (!ifs)
+		return nullptr;
+
+	FileHeader_ header;
+	ifs.read(reinterpret_cast<char*>(&header), sizeof(FileHeader_));
+
+	const std::size_t count = (frames + G_PEAKS_BLOCK_FRAMES - 1) / G_PEAKS_BLOCK_FRAMES;
+	const bool        valid = ifs &&
+	                   header.magic == FILE_MAGIC &&
+	                   header.version == FILE_VERSION &&
+	                   header.blockFrames == G_PEAKS_BLOCK_FRAMES &&
+	                   header.frames == frames &&
+	                   header.sourceSize == source.size &&
+	                   header.sourceMtime == source.mtime &&
+	                   header.count == count;
+
+	if (!valid)
+	{
+		u::log::print("[Peaks::load] {} is missing or stale\n", path);
+		return nullptr;
+	}
+
+	std::shared_ptr<Peaks> peaks = std::make_shared<Peaks>(nullptr);
+
+	resize_(peaks->m_levels, frames);
+	ifs.read(reinterpret_cast<char*>(peaks->m_levels[0].data()), count * sizeof(Peak));
+
+	if (!ifs)
+	{
+		u::log::print("[Peaks::load] {} is corrupted\n", path);
+		return nullptr;
+	}
+
+	computeParents_(peaks->m_levels, 0, count);
+	peaks->m_frames = frames;
+	peaks->m_ready.store(true);
+
+	return peaks;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Peaks::startBuilder()
+{
+	builderRunning_.store(true);
+	builder_.start([]()
+	{
+		std::vector<std::weak_ptr<Peaks>> pending;
+		{
+			std::scoped_lock lock(queueMutex_);
+			pending.swap(queue_);
+		}
+
+		/* Peaks whose Wave is gone in the meantime are just skipped. */
+
+		for (const std::weak_ptr<Peaks>& p : pending)
+			if (std::shared_ptr<Peaks> peaks = p.lock())
+				peaks->build();
+	});
+}
+
+void Peaks::stopBuilder()
+{
+	builder_.stop();
+	builderRunning_.store(false);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Peaks::Peaks(std::shared_ptr<const mcl::AudioBuffer> data)
+: m_source(std::move(data))
+, m_ready(false)
+, m_frames(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool  Peaks::isReady() const { return m_ready.load(); }
+Frame Peaks::countFrames() const { return m_frames; }
+
+/* -------------------------------------------------------------------------- */
+
+Peaks::Peak Peaks::get(const mcl::AudioBuffer& data, Frame a, Frame b) const
+{
+	assert(isReady());
+	assert(data.countFrames() == m_frames);
+
+	a = std::clamp(a, 0, m_frames);
+	b = std::clamp(b, a, m_frames);
+
+	/* Whole blocks [lo, hi) come from the pyramid, the frames around them from
+	audio data. */
+
+	std::size_t lo = (a + G_PEAKS_BLOCK_FRAMES - 1) / G_PEAKS_BLOCK_FRAMES;
+	std::size_t hi = b / G_PEAKS_BLOCK_FRAMES;
+
+	if (lo >= hi)
+		return reduce_(data, a, b);
+
+	Peak out = merge_(reduce_(data, a, lo * G_PEAKS_BLOCK_FRAMES), reduce_(data, hi * G_PEAKS_BLOCK_FRAMES, b));
+
+	/* Climb the pyramid: at each level take the Peaks at the edges of the range
+	that don't pair up with a sibling, then move on to the parents of the rest. */
+
+	for (const std::vector<Peak>& level : m_levels)
+	{
+		if (lo >= hi)
+			break;
+		if (lo % 2 == 1)
+			out = merge_(out, level[lo++]);
+		if (hi % 2 == 1)
+			out = merge_(out, level[--hi]);
+		lo /= 2;
+		hi /= 2;
+	}
+
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Peaks::update(std::shared_ptr<const mcl::AudioBuffer> data, Frame a, Frame b)
+{
+	assert(data != nullptr);
+
+	{
+		std::scoped_lock lock(m_mutex);
+		if (!m_ready.load())
+		{
+			m_source = std::move(data);
+			return;
+		}
+	}
+
+	const Frame frames = data->countFrames();
+
+	if (frames != m_frames)
+		b = frames;
+	a = std::clamp(a, 0, frames);
+	b = std::clamp(b, a, frames);
+
+	m_frames = frames;
+	resize_(m_levels, frames);
+	compute_(m_levels, *data, a / G_PEAKS_BLOCK_FRAMES, (b + G_PEAKS_BLOCK_FRAMES - 1) / G_PEAKS_BLOCK_FRAMES);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Peaks::save(const std::string& path, const Source& source) const
+{
+	assert(isReady());
+
+	const FileHeader_ header = {
+	    .magic       = FILE_MAGIC,
+	    .version     = FILE_VERSION,
+	    .blockFrames = G_PEAKS_BLOCK_FRAMES,
+	    .frames      = m_frames,
+	    .sourceSize  = source.size,
+	    .sourceMtime = source.mtime,
+	    .count       = m_levels[0].size()};
+
+	std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader_));
+	ofs.write(reinterpret_cast<const char*>(m_levels[0].data()), m_levels[0].size() * sizeof(Peak));
+
+	if (!ofs)
+	{
+		u::log::print("[Peaks::save] unable to write {}\n", path);
+		return false;
+	}
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Peaks::build()
+{
+	while (true)
+	{
+		std::shared_ptr<const mcl::AudioBuffer> source;
+		{
+			std::scoped_lock lock(m_mutex);
+			source = m_source;
+		}
+
+		if (source == nullptr) // Already computed
+			return;
+
+		Levels_ levels;
+		resize_(levels, source->countFrames());
+		compute_(levels, *source, 0, levels[0].size());
+
+		/* Audio data might have been edited while computing: start over if so. */
+
+		std::scoped_lock lock(m_mutex);
+		if (m_source != source)
+			continue;
+		m_levels = std::move(levels);
+		m_frames = source->countFrames();
+		m_source.reset();
+		m_ready.store(true);
+		return;
+	}
+}
+} // namespace giada::m
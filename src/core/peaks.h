@@ -0,0 +1,159 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_PEAKS_H
+#define G_PEAKS_H
+
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/types.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace giada::m
+{
+/* Peaks
+Min/max overview of the audio data of a Wave, used to draw waveforms at any
+zoom level. Peaks are stored in a pyramid: the first level holds one Peak
+every G_PEAKS_BLOCK_FRAMES frames, each following level halves the resolution
+of the previous one. The peak of any range can then be obtained by combining a
+handful of values, regardless of the range length. Peaks are computed once by a
+background builder thread, then updated incrementally as the audio data is
+edited. */
+
+class Peaks final
+{
+public:
+	/* Peak
+	Lowest and highest value of the mono mix-down of a range of frames. Both
+	always include zero, i.e. min <= 0 <= max. */
+
+	struct Peak
+	{
+		float min = 0.0f;
+		float max = 0.0f;
+	};
+
+	/* compute
+	Returns a new Peaks object, computed in background from 'data'. Audio data
+	is kept alive until done. If the builder thread is not running (e.g. no
+	Engine around) Peaks are computed right away instead. */
+
+	static std::shared_ptr<Peaks> compute(std::shared_ptr<const mcl::AudioBuffer> data);
+
+	/* Source
+	Identifies the audio file Peaks have been computed from, without reading
+	it: size and last modification time, as reported by the filesystem. */
+
+	struct Source
+	{
+		std::uint64_t size  = 0;
+		std::int64_t  mtime = 0;
+
+		bool operator==(const Source&) const = default;
+	};
+
+	/* getSource
+	Returns the Source of the given audio file, or nothing if the file can't be
+	accessed. */
+
+	static std::optional<Source> getSource(const std::string& audioPath);
+
+	/* load
+	Reads Peaks previously written with save(). They are valid only if they
+	refer to 'frames' frames of audio data, coming from the audio file
+	identified by 'source'. Returns nullptr if the file is missing, corrupted
+	or stale. */
+
+	static std::shared_ptr<Peaks> load(const std::string& path, const Source& source, Frame frames);
+
+	/* startBuilder, stopBuilder
+	Starts or stops the background builder thread, shared by all Peaks. */
+
+	static void startBuilder();
+	static void stopBuilder();
+
+	Peaks(std::shared_ptr<const mcl::AudioBuffer> data);
+	Peaks(const Peaks&)            = delete;
+	Peaks(Peaks&&)                 = delete;
+	Peaks& operator=(const Peaks&) = delete;
+	Peaks& operator=(Peaks&&)      = delete;
+
+	/* isReady
+	True if Peaks have been computed and can be read. */
+
+	bool isReady() const;
+
+	/* countFrames
+	Returns the number of frames Peaks refer to. */
+
+	Frame countFrames() const;
+
+	/* get
+	Returns the peak of frames [a, b) of 'data', i.e. the very same audio data
+	Peaks have been computed from. Only the frames at the edges of the range,
+	not covered by a whole block, are read from 'data'. Peaks must be ready. */
+
+	Peak get(const mcl::AudioBuffer& data, Frame a, Frame b) const;
+
+	/* update
+	Recomputes frames [a, b) after 'data' has been edited. If the length of the
+	audio data has changed, everything from 'a' onwards is recomputed. Waits
+	for nothing: if Peaks are not ready yet, the background computation simply
+	starts over with the new data. */
+
+	void update(std::shared_ptr<const mcl::AudioBuffer> data, Frame a, Frame b);
+
+	/* save
+	Writes Peaks to a binary file, along with the Source of the audio data they
+	refer to. Only the first level is stored: the others are computed again
+	from it on load(). Peaks must be ready. */
+
+	bool save(const std::string& path, const Source& source) const;
+
+private:
+	/* build
+	Computes all levels from scratch. Called by the background builder. */
+
+	void build();
+
+	/* Audio data to compute, if not ready yet. Guarded by m_mutex, as the
+	builder thread reads it while the main thread might replace it. */
+
+	std::shared_ptr<const mcl::AudioBuffer> m_source;
+	std::mutex                              m_mutex;
+	std::atomic<bool>                       m_ready;
+	std::vector<std::vector<Peak>>          m_levels;
+	Frame                                   m_frames;
+};
+} // namespace giada::m
+
+#endif
@@ -280,6 +280,14 @@ void Plugin::setCurrentProgram(int index) const
 
 /* -------------------------------------------------------------------------- */
 
+void Plugin::setNonRealtime(bool v) const
+{
+	if (valid)
+		m_plugin->setNonRealtime(v);
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Plugin::hasEditor() const
 {
 	return m_plugin->hasEditor();
@@ -35,6 +35,7 @@ Windows. */
 #define NOMINMAX
 #endif
 
+#include "src/core/dspLoad.h"
 #include "src/core/midiLearnParam.h"
 #include "src/core/plugins/pluginAudioPlayHead.h"
 #include "src/core/plugins/pluginHost.h"
@@ -85,6 +86,7 @@ public:
 	std::string                 getProgramName(int index) const;
 	void                        setParameter(int index, float value) const;
 	void                        setCurrentProgram(int index) const;
+	void                        setNonRealtime(bool) const;
 	PluginState                 getState() const;
 	juce::AudioProcessorEditor* createEditor() const;
 
@@ -115,6 +117,11 @@ public:
 
 	bool valid;
 
+	/* dspLoad
+	Time spent processing audio by this plug-in. */
+
+	DspLoad dspLoad;
+
 	std::function<void(int w, int h)> onEditorResize;
 
 private:
@@ -43,6 +43,8 @@ namespace giada::m
 {
 PluginHost::PluginHost(model::Model& m)
 : m_model(m)
+, m_audioBuffers(1)
+, m_bufferSize(0)
 {
 }
 
@@ -58,30 +60,46 @@ void PluginHost::reset(int bufferSize)
 
 void PluginHost::setBufferSize(int bufferSize)
 {
-	m_audioBuffer.setSize(G_MAX_IO_CHANS, bufferSize);
+	m_bufferSize = bufferSize;
+	for (juce::AudioBuffer<float>& buffer : m_audioBuffers)
+		buffer.setSize(G_MAX_IO_CHANS, bufferSize);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginHost::setNumWorkers(int numWorkers)
+{
+	assert(numWorkers > 0);
+
+	m_audioBuffers.resize(numWorkers);
+	setBufferSize(m_bufferSize);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
-    const juce::MidiBuffer* events)
+    const juce::MidiBuffer* events, std::size_t worker)
 {
-	assert(outBuf.countFrames() == m_audioBuffer.getNumSamples());
+	assert(worker < m_audioBuffers.size());
+
+	juce::AudioBuffer<float>& tempBuf = m_audioBuffers[worker];
+
+	assert(outBuf.countFrames() == tempBuf.getNumSamples());
 
 	if (plugins.empty())
 		return;
 
-	giadaToJuceTempBuf(outBuf);
+	giadaToJuceTempBuf(outBuf, tempBuf);
 
 	if (events == nullptr)
 	{
 		juce::MidiBuffer dummyEvents; // empty
-		processPlugins(plugins, dummyEvents);
+		processPlugins(plugins, dummyEvents, tempBuf);
 	}
 	else
-		processPlugins(plugins, *events);
+		processPlugins(plugins, *events, tempBuf);
 
-	juceToGiadaOutBuf(outBuf);
+	juceToGiadaOutBuf(outBuf, tempBuf);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -100,6 +118,8 @@ void PluginHost::freePlugin(ID pluginId)
 
 void PluginHost::freePlugins(const std::vector<ID> ids)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	for (const ID id : ids)
 		freePlugin(id);
 }
@@ -113,6 +133,14 @@ void PluginHost::freeAllPlugins()
 
 /* -------------------------------------------------------------------------- */
 
+void PluginHost::setNonRealtime(bool v)
+{
+	for (const std::unique_ptr<Plugin>& p : m_model.getAllPlugins())
+		p->setNonRealtime(v);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void PluginHost::setPluginParameter(ID pluginId, int paramIndex, float value)
 {
 	m_model.findPlugin(pluginId)->setParameter(paramIndex, value);
@@ -135,28 +163,28 @@ void PluginHost::toggleBypass(ID pluginId)
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf)
+void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& tempBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
-	assert(outBuf.countFrames() == m_audioBuffer.getNumSamples());
+	assert(outBuf.countChannels() == tempBuf.getNumChannels());
+	assert(outBuf.countFrames() == tempBuf.getNumSamples());
 
 	for (int ch = 0; ch < outBuf.countChannels(); ++ch)
 	{
 		const float* src = outBuf.getChannelView(ch).data();
-		float*       dst = m_audioBuffer.getWritePointer(ch);
+		float*       dst = tempBuf.getWritePointer(ch);
 
 		std::copy(src, src + outBuf.countFrames(), dst);
 	}
 }
 
-void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const
+void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf, const juce::AudioBuffer<float>& tempBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
-	assert(outBuf.countFrames() == m_audioBuffer.getNumSamples());
+	assert(outBuf.countChannels() == tempBuf.getNumChannels());
+	assert(outBuf.countFrames() == tempBuf.getNumSamples());
 
 	for (int ch = 0; ch < outBuf.countChannels(); ++ch)
 	{
-		const float* src = m_audioBuffer.getReadPointer(ch);
+		const float* src = tempBuf.getReadPointer(ch);
 		float*       dst = outBuf.getChannelView(ch).data();
 
 		std::copy(src, src + outBuf.countFrames(), dst);
@@ -165,7 +193,8 @@ void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, const juce::MidiBuffer& events)
+void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, const juce::MidiBuffer& events,
+    juce::AudioBuffer<float>& tempBuf)
 {
 	/* Plugins receive a mutable, local copy of the incoming MIDI buffer so they
 	can modify existing events or generate new ones; the resulting MIDI stream
@@ -176,23 +205,28 @@ void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, const juce:
 	for (Plugin* p : plugins)
 	{
 		if (!p->valid || p->isSuspended() || p->isBypassed())
+		{
+			p->dspLoad.add({});
 			continue;
-		processPlugin(p, localEvents);
+		}
+		processPlugin(p, localEvents, tempBuf);
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugin(Plugin* p, juce::MidiBuffer& events)
+void PluginHost::processPlugin(Plugin* p, juce::MidiBuffer& events, juce::AudioBuffer<float>& tempBuf)
 {
-	const Plugin::Buffer& pluginBuffer = p->process(m_audioBuffer, events);
+	const DspLoad::Timer timer(p->dspLoad);
+
+	const Plugin::Buffer& pluginBuffer = p->process(tempBuf, events);
 
 	/* Merge the plugin buffer back into the local one. Special care is needed
 	if audio channels mismatch. */
 
-	for (int i = 0, j = 0; i < m_audioBuffer.getNumChannels(); i++)
+	for (int i = 0, j = 0; i < tempBuf.getNumChannels(); i++)
 	{
-		m_audioBuffer.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
+		tempBuf.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
 		if (i < p->countMainOutChannels() - 1)
 			j++;
 	}
@@ -38,6 +38,7 @@ some enum defined in the JUCE GUI module. */
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <memory>
+#include <vector>
 
 namespace mcl
 {
@@ -73,6 +74,13 @@ public:
 
 	void setBufferSize(int);
 
+	/* setNumWorkers
+	Allocates one internal audio buffer for each render worker, so that plugin
+	stacks can be processed concurrently from multiple threads. Must be called
+	only when mixer is disabled. */
+
+	void setNumWorkers(int);
+
 	/* addPlugin
 	Loads a new plugin into memory. Returns a reference to the newly created
 	object. */
@@ -80,13 +88,15 @@ public:
 	const Plugin& addPlugin(std::unique_ptr<Plugin> p);
 
 	/* processStack
-	Applies the fx list to the buffer. */
+	Applies the fx list to the buffer. 'worker' is the index of the render worker
+	calling this function, used to pick the internal buffer. */
 
 	void processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
-	    const juce::MidiBuffer* events = nullptr);
+	    const juce::MidiBuffer* events = nullptr, std::size_t worker = 0);
 
 	/* freePlugin.
-	Unloads plugin from memory. */
+	Unloads plugin from memory, as soon as the audio thread is done with it (see
+	Model::collectPlugins()). */
 
 	void freePlugin(ID pluginId);
 
@@ -100,6 +110,13 @@ public:
 
 	void freeAllPlugins();
 
+	/* setNonRealtime
+	Switches all plug-ins to non-realtime processing, e.g. for offline rendering
+	where a plug-in may take all the time it needs. Must be called only when
+	mixer is disabled. */
+
+	void setNonRealtime(bool);
+
 	void setPluginParameter(ID pluginId, int paramIndex, float value);
 	void setPluginProgram(ID pluginId, int programIndex);
 	void toggleBypass(ID pluginId);
@@ -109,20 +126,24 @@ private:
 	Copies the Giada buffer 'outBuf' to the private JUCE buffer for local
 	processing. */
 
-	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf);
+	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& tempBuf) const;
 
 	/* juceToGiadaOutBuf
 	Copies the private JUCE buffer to Giada buffer 'outBuf'. */
 
-	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const;
+	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf, const juce::AudioBuffer<float>& tempBuf) const;
 
-	void processPlugins(const std::vector<Plugin*>&, const juce::MidiBuffer& events);
+	void processPlugins(const std::vector<Plugin*>&, const juce::MidiBuffer& events, juce::AudioBuffer<float>& tempBuf);
 
-	void processPlugin(Plugin*, juce::MidiBuffer& events);
+	void processPlugin(Plugin*, juce::MidiBuffer& events, juce::AudioBuffer<float>& tempBuf);
 
 	model::Model& m_model;
 
-	juce::AudioBuffer<float> m_audioBuffer;
+	/* m_audioBuffers
+	Internal buffers, one per render worker. */
+
+	std::vector<juce::AudioBuffer<float>> m_audioBuffers;
+	int                                   m_bufferSize;
 };
 } // namespace giada::m
 
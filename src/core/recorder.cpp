@@ -36,8 +36,9 @@
 
 namespace giada::m
 {
-Recorder::Recorder(Sequencer& s, ChannelManager& cm, Mixer& mx, ActionManager& a)
-: m_sequencer(s)
+Recorder::Recorder(model::Model& m, Sequencer& s, ChannelManager& cm, Mixer& mx, ActionManager& a)
+: m_model(m)
+, m_sequencer(s)
 , m_channelManager(cm)
 , m_mixer(mx)
 , m_actionRecorder(a)
@@ -70,6 +71,12 @@ void Recorder::stopActionRec()
 
 	m_mixer.stopActionRec();
 
+	/* From now on, publish all changes with a single swap. Mixer::stopActionRec()
+	above must have swapped already, so that the realtime thread stops
+	recording actions before they are consolidated. */
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	/* Restore record trigger mode to normal in case you want to record again
 	while the sequencer is running - if in SIGNAL mode, the sequencer would
 	pause otherwise (see https://github.com/monocasual/giada/issues/678). */
@@ -139,6 +146,12 @@ void Recorder::stopInputRec()
 	Frame                recordedFrames = m_mixer.stopInputRec();
 	const Scene          scene          = m_sequencer.getCurrentScene();
 
+	/* From now on, publish all changes with a single swap. Mixer::stopInputRec()
+	above must have swapped already, so that the realtime thread is done
+	writing into the rec buffer before it's read. */
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	/* Restore record trigger mode to normal in case you want to record again
 	while the sequencer is running - if in SIGNAL mode, the sequencer would
 	pause otherwise (see https://github.com/monocasual/giada/issues/678). */
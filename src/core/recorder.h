@@ -32,6 +32,11 @@
 #include "src/types.h"
 #include <cstddef>
 
+namespace giada::m::model
+{
+class Model;
+} // namespace giada::m::model
+
 namespace giada::m
 {
 class ActionManager;
@@ -41,7 +46,7 @@ class Sequencer;
 class Recorder final
 {
 public:
-	Recorder(Sequencer&, ChannelManager&, Mixer&, ActionManager&);
+	Recorder(model::Model&, Sequencer&, ChannelManager&, Mixer&, ActionManager&);
 
 	/* canEnableRecOnSignal
 	True if rec-on-signal can be enabled: can't set it while sequencer is
@@ -78,6 +83,7 @@ public:
 	void toggleFreeInputRec();
 
 private:
+	model::Model&   m_model;
 	Sequencer&      m_sequencer;
 	ChannelManager& m_channelManager;
 	Mixer&          m_mixer;
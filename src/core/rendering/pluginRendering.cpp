@@ -58,16 +58,16 @@ const juce::MidiBuffer& prepareMidiBuffer_(ChannelShared& shared)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-void renderAudioAndMidiPlugins(const Channel& ch, PluginHost& pluginHost)
+void renderAudioAndMidiPlugins(const Channel& ch, PluginHost& pluginHost, std::size_t worker)
 {
-	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, &prepareMidiBuffer_(*ch.shared));
+	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, &prepareMidiBuffer_(*ch.shared), worker);
 	ch.shared->midiBuffer.clear();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void renderAudioPlugins(const Channel& ch, PluginHost& pluginHost)
+void renderAudioPlugins(const Channel& ch, PluginHost& pluginHost, std::size_t worker)
 {
-	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, nullptr);
+	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, nullptr, worker);
 }
 } // namespace giada::m::rendering
@@ -38,14 +38,15 @@ namespace giada::m::rendering
 {
 /* renderAudioAndMidiPlugins
 Renders plug-ins using the shared juce::MidiBuffer for MIDI event rendering. It
-renders normal audio plug-ins too. */
+renders normal audio plug-ins too. 'worker' is the index of the render worker
+in charge of this Channel. */
 
-void renderAudioAndMidiPlugins(const Channel&, PluginHost&);
+void renderAudioAndMidiPlugins(const Channel&, PluginHost&, std::size_t worker);
 
 /* renderAudioPlugins
 Renders audio-only plug-ins. */
 
-void renderAudioPlugins(const Channel&, PluginHost&);
+void renderAudioPlugins(const Channel&, PluginHost&, std::size_t worker);
 } // namespace giada::m::rendering
 
 #endif
@@ -30,6 +30,7 @@
 #include "src/core/rendering/midiOutput.h"
 #include "src/core/rendering/midiReactions.h"
 #include "src/core/rendering/sampleReactions.h"
+#include <utility>
 
 namespace giada::m::rendering
 {
@@ -71,7 +72,7 @@ void Reactor::keyPress(ID channelId, Scene scene, float velocity, bool canRecord
 	}
 	else if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
+		for (const Channel& child : std::as_const(m_model).get().tracks.getByChannel(ch.id).getChannels().getAll())
 			if (child.type != ChannelType::GROUP)
 				keyPress(child.id, scene, velocity, canRecordActions, canQuantize, currentTickQuantized);
 	}
@@ -108,7 +109,7 @@ void Reactor::keyRelease(ID channelId, Scene scene, bool canRecordActions, Tick
 	}
 	else if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
+		for (const Channel& child : std::as_const(m_model).get().tracks.getByChannel(ch.id).getChannels().getAll())
 			if (child.type != ChannelType::GROUP)
 				keyRelease(child.id, scene, canRecordActions, currentTickQuantized);
 	}
@@ -146,7 +147,7 @@ void Reactor::keyKill(ID channelId, Scene scene, bool canRecordActions, Tick cur
 	}
 	else if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
+		for (const Channel& child : std::as_const(m_model).get().tracks.getByChannel(ch.id).getChannels().getAll())
 			if (child.type != ChannelType::GROUP)
 				keyKill(child.id, scene, canRecordActions, currentTickQuantized);
 	}
@@ -0,0 +1,166 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/rendering/renderGraph.h"
+#include "src/core/model/tracks.h"
+#include <atomic>
+#include <unordered_map>
+#if G_DEBUG_MODE
+#include <fmt/core.h>
+#endif
+
+namespace giada::m::rendering
+{
+namespace
+{
+std::atomic<uint64_t> nextId_ = 1;
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+RenderGraph::RenderGraph(const model::Tracks& tracks, const RenderGraph* previous)
+: m_id(nextId_.fetch_add(1, std::memory_order_relaxed))
+, m_previousId(previous != nullptr ? previous->m_id : 0)
+{
+	const std::vector<model::Track>& allTracks = tracks.getAll();
+
+	for (std::size_t trackIndex = 0; trackIndex < allTracks.size(); trackIndex++)
+	{
+		const model::Track& track = allTracks[trackIndex];
+		if (track.isInternal())
+			continue;
+
+		const std::vector<Channel>& channels  = track.getChannels().getAll();
+		const int                   groupNode = static_cast<int>(m_nodes.size());
+
+		/* The group Channel always sits at index 0. */
+
+		m_nodes.push_back({NodeType::GROUP, trackIndex, 0, channels[0].id, -1, static_cast<int>(channels.size()) - 1});
+		for (std::size_t channelIndex = 1; channelIndex < channels.size(); channelIndex++)
+			m_nodes.push_back({NodeType::CHANNEL, trackIndex, channelIndex, channels[channelIndex].id, groupNode, 0});
+	}
+
+	for (std::size_t i = 0; i < m_nodes.size(); i++)
+		if (m_nodes[i].numDeps == 0)
+			m_roots.push_back(static_cast<int>(i));
+
+	/* Match nodes with the previous graph, if any. */
+
+	if (previous != nullptr)
+	{
+		std::unordered_map<ID, int> previousNodes;
+		for (std::size_t i = 0; i < previous->m_nodes.size(); i++)
+			previousNodes[previous->m_nodes[i].channelId] = static_cast<int>(i);
+
+		for (Node& node : m_nodes)
+			if (const auto it = previousNodes.find(node.channelId); it != previousNodes.end())
+				node.previous = it->second;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderGraph::isCompatible(const model::Tracks& tracks) const
+{
+	const std::vector<model::Track>& allTracks = tracks.getAll();
+
+	std::size_t node = 0;
+	for (std::size_t trackIndex = 0; trackIndex < allTracks.size(); trackIndex++)
+	{
+		const model::Track& track = allTracks[trackIndex];
+		if (track.isInternal())
+			continue;
+
+		const std::vector<Channel>& channels = track.getChannels().getAll();
+		for (std::size_t channelIndex = 0; channelIndex < channels.size(); channelIndex++, node++)
+		{
+			if (node >= m_nodes.size())
+				return false;
+			const Node& n = m_nodes[node];
+			if (n.trackIndex != trackIndex || n.channelIndex != channelIndex || n.channelId != channels[channelIndex].id)
+				return false;
+		}
+	}
+
+	return node == m_nodes.size();
+}
+
+/* -------------------------------------------------------------------------- */
+
+const std::vector<RenderGraph::Node>& RenderGraph::getNodes() const
+{
+	return m_nodes;
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t RenderGraph::getId() const
+{
+	return m_id;
+}
+
+uint64_t RenderGraph::getPreviousId() const
+{
+	return m_previousId;
+}
+
+/* -------------------------------------------------------------------------- */
+
+const std::vector<int>& RenderGraph::getRoots() const
+{
+	return m_roots;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t RenderGraph::countRoots() const
+{
+	return m_roots.size();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if G_DEBUG_MODE
+
+void RenderGraph::debug() const
+{
+	puts("rendering::renderGraph");
+	fmt::print("\tid={} previous={} nodes={} roots={}\n", m_id, m_previousId, m_nodes.size(), m_roots.size());
+
+	for (std::size_t i = 0; i < m_nodes.size(); i++)
+	{
+		const Node& n = m_nodes[i];
+		fmt::print("\t{}) {} - track={} channel={} id={} parent={} deps={} previous={}\n",
+		    i, n.type == NodeType::GROUP ? "GROUP" : "CHANNEL", n.trackIndex, n.channelIndex,
+		    n.channelId.getValue(), n.parent, n.numDeps, n.previous);
+	}
+}
+
+#endif
+} // namespace giada::m::rendering
@@ -0,0 +1,120 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_RENDERING_RENDER_GRAPH_H
+#define G_RENDERING_RENDER_GRAPH_H
+
+#include "src/aliases.h"
+#include "src/const.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace giada::m::model
+{
+class Tracks;
+}
+
+namespace giada::m::rendering
+{
+/* RenderGraph
+The rendering dependencies of the Tracks layout, compiled into a graph of nodes.
+Each non-internal Channel is a node that depends on nothing; each group Channel
+is a node that depends on all the other Channels of its Track. Master in, master
+out and preview rendering are not part of the graph: they run serially before
+and after it on the audio thread.
+The graph is compiled on the main thread whenever the model is swapped and the
+Tracks layout has changed. It is immutable once compiled, so that it can be
+shared by the realtime and non-realtime Documents: the state needed to execute
+it on each block lives in the Renderer (see RenderState). */
+
+class RenderGraph
+{
+public:
+	enum class NodeType
+	{
+		CHANNEL,
+		GROUP
+	};
+
+	struct Node
+	{
+		NodeType    type;
+		std::size_t trackIndex;
+		std::size_t channelIndex;
+		ID          channelId;
+		int         parent   = -1; // Index of the node that depends on this one, if any
+		int         numDeps  = 0;  // Number of nodes this one depends on
+		int         previous = -1; // Index of the same node in the previous graph, if any
+	};
+
+	/* RenderGraph
+	Compiles the graph from a Tracks layout. If 'previous' is given, nodes are
+	matched against the previous graph, so that timing information collected
+	while executing it can be carried over. */
+
+	RenderGraph(const model::Tracks&, const RenderGraph* previous = nullptr);
+
+	/* isCompatible
+	True if this graph still describes the given Tracks layout, i.e. it doesn't
+	need to be compiled again. */
+
+	bool isCompatible(const model::Tracks&) const;
+
+	/* getId, getPreviousId
+	Returns the unique identifier of this graph and of the graph it was compiled
+	from (0 if none). */
+
+	uint64_t getId() const;
+	uint64_t getPreviousId() const;
+
+	const std::vector<Node>& getNodes() const;
+
+	/* getRoots
+	Returns the nodes with no dependencies, i.e. the ones that can be rendered
+	in parallel right away. */
+
+	const std::vector<int>& getRoots() const;
+
+	/* countRoots
+	Returns the number of root nodes. */
+
+	std::size_t countRoots() const;
+
+#if G_DEBUG_MODE
+	void debug() const;
+#endif
+
+private:
+	std::vector<Node> m_nodes;
+	std::vector<int>  m_roots;
+	uint64_t          m_id;
+	uint64_t          m_previousId;
+};
+} // namespace giada::m::rendering
+
+#endif
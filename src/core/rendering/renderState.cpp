@@ -0,0 +1,292 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "src/core/rendering/renderState.h"
+#include "src/core/const.h"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m::rendering
+{
+RenderState::Queue::Queue(std::size_t capacity)
+: m_top(0)
+, m_bottom(0)
+, m_items(std::make_unique<std::atomic<int>[]>(std::max<std::size_t>(capacity, 1)))
+, m_capacity(std::max<std::size_t>(capacity, 1))
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderState::Queue::reset()
+{
+	m_top.store(0, std::memory_order_relaxed);
+	m_bottom.store(0, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderState::Queue::push(int node)
+{
+	/* No need for a circular buffer: each node is pushed at most once per
+	block and the queue is reset before each block. */
+
+	const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	assert(static_cast<std::size_t>(bottom) < m_capacity);
+
+	m_items[bottom].store(node, std::memory_order_relaxed);
+	m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+int RenderState::Queue::pop()
+{
+	const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = m_top.load(std::memory_order_relaxed);
+
+	if (top > bottom) // Empty
+	{
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return -1;
+	}
+
+	int node = m_items[bottom].load(std::memory_order_relaxed);
+	if (top == bottom) // Last item: race against thieves
+	{
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			node = -1;
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return node;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int RenderState::Queue::steal()
+{
+	int64_t top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+	if (top >= bottom) // Empty
+		return -1;
+
+	const int node = m_items[top].load(std::memory_order_relaxed);
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return -1;
+	return node;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+RenderState::RenderState(std::size_t capacity)
+: m_graph(nullptr)
+, m_graphId(0)
+, m_numNodes(0)
+, m_capacity(capacity)
+, m_pending(std::make_unique<std::atomic<int>[]>(capacity))
+, m_timings(std::make_unique<Timing[]>(capacity))
+, m_previousTimings(std::make_unique<Timing[]>(capacity))
+, m_completed(0)
+, m_numQueues(0)
+, m_blocks(0)
+{
+	m_roots.reserve(capacity);
+	for (std::size_t i = 0; i < G_MAX_RENDER_THREADS; i++)
+		m_queues.push_back(std::make_unique<Queue>(capacity));
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t RenderState::getCapacity() const
+{
+	return m_capacity;
+}
+
+/* -------------------------------------------------------------------------- */
+
+double RenderState::getTime(std::size_t node) const
+{
+	assert(node < m_capacity);
+	return m_timings[node].time.load(std::memory_order_relaxed);
+}
+
+double RenderState::getMaxTime(std::size_t node) const
+{
+	assert(node < m_capacity);
+	return m_timings[node].maxTime.load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t RenderState::getGraphId() const
+{
+	return m_graphId.load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderState::inherit(const RenderState& other)
+{
+	/* The graph pointer of the other state is not used: it is valid for the
+	block it was prepared for only. */
+
+	if (other.getGraphId() == 0 || other.m_numNodes > m_capacity)
+		return;
+
+	m_numNodes = other.m_numNodes;
+	m_roots.assign(other.m_roots.begin(), other.m_roots.end());
+
+	for (std::size_t i = 0; i < m_numNodes; i++)
+	{
+		m_timings[i].time.store(other.getTime(i), std::memory_order_relaxed);
+		m_timings[i].maxTime.store(other.getMaxTime(i), std::memory_order_relaxed);
+	}
+	m_graphId.store(other.getGraphId(), std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderState::prepare(const RenderGraph& graph, std::size_t numQueues)
+{
+	assert(numQueues > 0 && numQueues <= m_queues.size());
+	assert(graph.getNodes().size() <= m_capacity);
+
+	/* The graph is looked up by id: a new graph might be allocated at the
+	address of a deleted one. Always refresh the pointer, which is valid for
+	the current block only. */
+
+	if (graph.getId() != getGraphId())
+		bind(graph);
+	else if (++m_blocks % G_RENDER_GRAPH_SORT_BLOCKS == 0)
+		sortRoots();
+	m_graph = &graph;
+
+	const std::vector<RenderGraph::Node>& nodes = graph.getNodes();
+
+	m_numQueues = numQueues;
+	m_completed.store(0, std::memory_order_relaxed);
+
+	for (std::size_t i = 0; i < nodes.size(); i++)
+		m_pending[i].store(nodes[i].numDeps, std::memory_order_relaxed);
+
+	for (std::size_t i = 0; i < m_numQueues; i++)
+		m_queues[i]->reset();
+
+	for (std::size_t i = 0; i < m_roots.size(); i++)
+		m_queues[i % m_numQueues]->push(m_roots[i]);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderState::bind(const RenderGraph& graph)
+{
+	const std::vector<RenderGraph::Node>& nodes = graph.getNodes();
+
+	/* Timing information can be carried over only if the new graph has been
+	compiled from the one in use. Nodes have been matched at compile time. */
+
+	const bool carryOver = getGraphId() != 0 && graph.getPreviousId() == getGraphId();
+
+	/* Copy instead of swapping the arrays: m_timings might be read by other
+	threads (see getTime()). */
+
+	if (carryOver)
+		for (std::size_t i = 0; i < m_numNodes; i++)
+		{
+			m_previousTimings[i].time.store(m_timings[i].time.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			m_previousTimings[i].maxTime.store(m_timings[i].maxTime.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+	for (std::size_t i = 0; i < nodes.size(); i++)
+	{
+		const int previous = carryOver ? nodes[i].previous : -1;
+		m_timings[i].time.store(previous >= 0 ? m_previousTimings[previous].time.load(std::memory_order_relaxed) : 0.0, std::memory_order_relaxed);
+		m_timings[i].maxTime.store(previous >= 0 ? m_previousTimings[previous].maxTime.load(std::memory_order_relaxed) : 0.0, std::memory_order_relaxed);
+	}
+
+	m_graph    = &graph;
+	m_numNodes = nodes.size();
+	m_graphId.store(graph.getId(), std::memory_order_relaxed);
+	m_blocks   = 0;
+	m_roots.assign(graph.getRoots().begin(), graph.getRoots().end()); // Capacity reserved, no allocation
+
+	sortRoots();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderState::sortRoots()
+{
+	for (std::size_t i = 1; i < m_roots.size(); i++)
+	{
+		const int    root = m_roots[i];
+		const double time = getTime(root);
+
+		std::size_t j = i;
+		for (; j > 0 && getTime(m_roots[j - 1]) < time; j--)
+			m_roots[j] = m_roots[j - 1];
+		m_roots[j] = root;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+int RenderState::take(std::size_t queue)
+{
+	assert(queue < m_numQueues);
+
+	int node = m_queues[queue]->pop();
+	for (std::size_t i = 1; node < 0 && i < m_numQueues; i++)
+		node = m_queues[(queue + i) % m_numQueues]->steal();
+	return node;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderState::complete(std::size_t queue, int node, double time)
+{
+	Timing& timing = m_timings[node];
+	timing.time.store(time, std::memory_order_relaxed);
+	if (time > timing.maxTime.load(std::memory_order_relaxed))
+		timing.maxTime.store(time, std::memory_order_relaxed);
+
+	/* The last dependency to complete makes the parent node ready. Push it
+	before marking this node as completed, so that workers don't leave while
+	there is still work to do. */
+
+	const int parent = m_graph->getNodes()[node].parent;
+	if (parent >= 0 && m_pending[parent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+		m_queues[queue]->push(parent);
+
+	m_completed.fetch_add(1, std::memory_order_release);
+}
+} // namespace giada::m::rendering
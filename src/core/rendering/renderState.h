@@ -0,0 +1,184 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RENDERING_RENDER_STATE_H
+#define G_RENDERING_RENDER_STATE_H
+
+#include "src/core/rendering/renderGraph.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace giada::m::rendering
+{
+/* RenderState
+The mutable state needed to execute a RenderGraph on each block: per-worker
+lock-free queues, pending dependency counters and per-node timings. Owned and
+used by the Renderer only, so that the RenderGraph itself stays immutable and
+can be shared by the realtime and non-realtime Documents. Sized for a maximum
+number of nodes: allocation happens on construction only. */
+
+class RenderState
+{
+public:
+	RenderState(std::size_t capacity);
+
+	/* getCapacity
+	Returns the maximum number of nodes a graph can have to be executed with
+	this state. */
+
+	std::size_t getCapacity() const;
+
+	/* getTime, getMaxTime
+	Returns the last and the maximum time spent rendering a node of the graph
+	in use, in microseconds. */
+
+	double getTime(std::size_t node) const;
+	double getMaxTime(std::size_t node) const;
+
+	/* getGraphId
+	Returns the id of the graph the timings refer to, 0 if none. Timings can be
+	read from any thread, as long as the state itself stays alive. */
+
+	uint64_t getGraphId() const;
+
+	/* inherit
+	Takes the graph in use and its timing information from another state. Used
+	when a bigger state replaces the current one. Realtime-safe. */
+
+	void inherit(const RenderState&);
+
+	/* prepare
+	Resets the internal state for a new block and spreads the root nodes of
+	'graph' across 'numQueues' worker queues. Switching to a new graph carries
+	over the timing information of the nodes it shares with the previous one.
+	Root nodes are sorted by their last rendering time every now and then, so
+	that the heaviest ones are picked up first and don't end up serialized
+	behind the light ones. Must be called by the audio thread before starting
+	the workers. Realtime-safe. */
+
+	void prepare(const RenderGraph& graph, std::size_t numQueues);
+
+	/* execute
+	Renders nodes, calling 'f(const Node&, std::size_t worker)' for each of them,
+	until the whole graph has been rendered. Nodes are taken from the queue
+	'queue' first, then stolen from the other ones. Each queue must be executed
+	by a single worker at a time. Realtime-safe. */
+
+	template <typename F>
+	void execute(std::size_t queue, std::size_t worker, F& f)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		const std::vector<RenderGraph::Node>& nodes = m_graph->getNodes();
+
+		while (m_completed.load(std::memory_order_acquire) < nodes.size())
+		{
+			const int node = take(queue);
+			if (node < 0)
+				continue;
+
+			const Clock::time_point start = Clock::now();
+			f(nodes[node], worker);
+			const Clock::time_point end = Clock::now();
+
+			complete(queue, node, std::chrono::duration<double, std::micro>(end - start).count());
+		}
+	}
+
+private:
+	/* Queue
+	A fixed-size Chase-Lev work-stealing deque of node indexes. The owner pushes
+	and pops at the bottom, thieves steal from the top. */
+
+	class Queue
+	{
+	public:
+		Queue(std::size_t capacity);
+
+		void reset();
+		void push(int);
+		int  pop();
+		int  steal();
+
+	private:
+		std::atomic<int64_t>                m_top;
+		std::atomic<int64_t>                m_bottom;
+		std::unique_ptr<std::atomic<int>[]> m_items;
+		std::size_t                         m_capacity;
+	};
+
+	/* Timing
+	Per-node timing information, in microseconds. */
+
+	struct Timing
+	{
+		std::atomic<double> time    = 0.0;
+		std::atomic<double> maxTime = 0.0;
+	};
+
+	/* bind
+	Switches to a new graph, carrying over timing information. */
+
+	void bind(const RenderGraph&);
+
+	/* sortRoots
+	Sorts root nodes by their last rendering time, heaviest first. Roots are
+	almost sorted from the previous run, so an insertion sort does the job. */
+
+	void sortRoots();
+
+	/* take
+	Returns a node ready to be rendered from the queue 'queue', or stolen from
+	another queue. Returns -1 if no node is available at the moment. */
+
+	int take(std::size_t queue);
+
+	/* complete
+	Marks a node as rendered, and pushes its parent to the queue 'queue' if all
+	its dependencies have been rendered. */
+
+	void complete(std::size_t queue, int node, double time);
+
+	const RenderGraph*                  m_graph;
+	std::atomic<uint64_t>               m_graphId;
+	std::size_t                         m_numNodes;
+	std::size_t                         m_capacity;
+	std::vector<int>                    m_roots;
+	std::vector<std::unique_ptr<Queue>> m_queues;
+	std::unique_ptr<std::atomic<int>[]> m_pending;
+	std::unique_ptr<Timing[]>           m_timings;
+	std::unique_ptr<Timing[]>           m_previousTimings;
+	std::atomic<std::size_t>            m_completed;
+	std::size_t                         m_numQueues;
+	int                                 m_blocks;
+};
+} // namespace giada::m::rendering
+
+#endif
@@ -33,7 +33,11 @@
 #include "src/core/rendering/pluginRendering.h"
 #include "src/core/rendering/sampleAdvance.h"
 #include "src/core/rendering/sampleRendering.h"
+#include "src/core/simd.h"
+#include <algorithm>
 #include <chrono>
+#include <fmt/core.h>
+#include <thread>
 #ifdef WITH_AUDIO_JACK
 #include "src/core/jackSynchronizer.h"
 #include "src/core/jackTransport.h"
@@ -57,6 +61,79 @@ double computeCPULoad_(const Now& startTime, unsigned int sampleRate, int buffer
 	return load;
 }
 
+/* -------------------------------------------------------------------------- */
+
+/* hasInputSignal_
+Tells whether a Channel is going to produce new signal in the current block,
+before any plug-in processing: a playing sample, the input monitor or incoming
+MIDI events for the plug-ins. */
+
+bool hasInputSignal_(const Channel& ch)
+{
+	if (ch.type == ChannelType::SAMPLE)
+		return ch.isPlaying() || ch.canReceiveAudio();
+	if (ch.type == ChannelType::MIDI)
+		return ch.shared->midiQueue.size_approx() > 0;
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool isAudible_(const mcl::AudioBuffer& b)
+{
+	for (int i = 0; i < b.countChannels(); i++)
+		if (simd::getPeak(b.getChannelView(i).data(), b.countFrames()) > G_SILENCE_THRESHOLD)
+			return true;
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* canSkip_
+Tells whether a Channel can skip rendering in the current block: no new signal
+is coming in and any plug-in tail has been silent for 'tailFrames'. */
+
+bool canSkip_(const Channel& ch, bool hasInput, Frame tailFrames)
+{
+	return !hasInput && (ch.plugins.empty() || ch.shared->idleFrames >= tailFrames);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* skip_
+Makes sure the buffer of a skipped Channel is silent. The buffer is cleared only
+once, when the Channel goes idle. Idle plug-ins account no processing time. */
+
+void skip_(const Channel& ch)
+{
+	for (Plugin* p : ch.plugins)
+		p->dspLoad.add({});
+
+	if (ch.shared->silent)
+		return;
+	ch.shared->audioBuffer.clear();
+	ch.shared->silent = true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* updateIdleFrames_
+Updates the idle frame counter after a Channel has been rendered. While plug-in
+tails ring out the output is measured, and counting restarts as long as it is
+audible. */
+
+void updateIdleFrames_(const Channel& ch, bool hasInput)
+{
+	ChannelShared& shared = *ch.shared;
+
+	shared.silent = false;
+
+	if (hasInput || isAudible_(shared.audioBuffer))
+		shared.idleFrames = 0;
+	else
+		shared.idleFrames += shared.audioBuffer.countFrames();
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
@@ -66,7 +143,8 @@ Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, JackSynchronizer& js,
 #else
 Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km)
 #endif
-: m_sequencer(s)
+: onResamplerFallback(nullptr)
+, m_sequencer(s)
 , m_mixer(m)
 , m_pluginHost(ph)
 , m_kernelMidi(km)
@@ -74,9 +152,82 @@ Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km)
 , m_jackSynchronizer(js)
 , m_jackTransport(jt)
 #endif
+, m_renderState(std::make_unique<RenderState>(0))
+, m_hasNextRenderState(false)
+, m_renderStateCapacity(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::startWorkers(int numWorkers)
+{
+	m_workerPool.start(numWorkers);
+	m_pluginHost.setNumWorkers(numWorkers);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::stopWorkers()
+{
+	m_workerPool.stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::reserveRenderState(std::size_t numNodes)
+{
+	std::scoped_lock lock(m_renderStateMutex);
+
+	if (numNodes <= m_renderStateCapacity)
+		return;
+
+	/* Grow geometrically, so that adding Channels one by one doesn't allocate
+	a new state each time. Allocate before taking the busy flag: the audio thread
+	only sees a short critical section, and just skips it if taken. */
+
+	m_renderStateCapacity = std::max(numNodes, m_renderStateCapacity * 2);
+
+	std::unique_ptr<RenderState> state = std::make_unique<RenderState>(m_renderStateCapacity);
+
+	while (m_renderStateBusy.test_and_set(std::memory_order_acquire))
+		std::this_thread::yield();
+	std::swap(m_nextRenderState, state);
+	m_hasNextRenderState.store(true, std::memory_order_relaxed);
+	m_renderStateBusy.clear(std::memory_order_release);
+
+	/* 'state' now holds either the one replaced by the audio thread earlier, or
+	one the audio thread never picked up. Either way, it is freed here. */
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if G_DEBUG_MODE
+
+void Renderer::debug(const RenderGraph& graph) const
 {
+	puts("rendering::renderer");
+
+	/* Keep the audio thread from replacing the state while reading from it. */
+
+	while (m_renderStateBusy.test_and_set(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	const RenderState&                    state = *m_renderState;
+	const std::vector<RenderGraph::Node>& nodes = graph.getNodes();
+
+	if (state.getGraphId() != graph.getId() || nodes.size() > state.getCapacity())
+		fmt::print("\tno timings for graph id={} (not rendered in parallel yet)\n", graph.getId());
+	else
+		for (std::size_t i = 0; i < nodes.size(); i++)
+			fmt::print("\t{}) channel={} time={:.1f}us max={:.1f}us\n", i, nodes[i].channelId.getValue(),
+			    state.getTime(i), state.getMaxTime(i));
+
+	m_renderStateBusy.clear(std::memory_order_release);
 }
 
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model& model) const
@@ -93,22 +244,61 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 
 	const model::DocumentLock documentLock = model.get_RT();
 	const model::Document&    document_RT  = documentLock.get();
-	const model::KernelAudio& kernelAudio  = document_RT.kernelAudio;
-	const model::Mixer&       mixer        = document_RT.mixer;
-	const model::Sequencer&   sequencer    = document_RT.sequencer;
-	const model::Tracks&      tracks       = document_RT.tracks;
-	const model::Actions&     actions      = document_RT.actions;
 
 	/* Mixer disabled or Kernel Audio not ready: nothing to do here. */
 
-	if (!mixer.a_isActive())
+	if (!document_RT.mixer.a_isActive())
 		return;
 
 #ifdef WITH_AUDIO_JACK
-	if (kernelAudio.api == RtAudio::Api::UNIX_JACK)
+	if (document_RT.kernelAudio.api == RtAudio::Api::UNIX_JACK)
 		m_jackSynchronizer.recvJackSync(m_jackTransport.getState());
 #endif
 
+	const DspLoad::Clock::time_point start = DspLoad::Clock::now();
+
+	render(out, in, document_RT);
+
+	/* Let the load governor know how long the block took. Offline rendering is
+	not accounted: it's not bound to real-time deadlines. */
+
+	const model::KernelAudio& kernelAudio = document_RT.kernelAudio;
+	const int                 bufferSize  = out.countFrames();
+	const int                 sampleRate  = static_cast<int>(kernelAudio.samplerate);
+
+	if (m_loadGovernor.update(DspLoad::Clock::now() - start, bufferSize, sampleRate, kernelAudio.loadGovernor))
+	{
+		assert(onResamplerFallback != nullptr);
+		onResamplerFallback(m_loadGovernor.isDegraded(), m_loadGovernor.getLoad(bufferSize, sampleRate));
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderOffline(mcl::AudioBuffer& out, const model::Model& model) const
+{
+	out.clear();
+
+	const model::DocumentLock documentLock = model.get_RT();
+
+	render(out, /*in=*/{}, documentLock.get());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Document& document_RT) const
+{
+	const model::KernelAudio& kernelAudio = document_RT.kernelAudio;
+	const model::Mixer&       mixer       = document_RT.mixer;
+	const model::Sequencer&   sequencer   = document_RT.sequencer;
+	const model::Tracks&      tracks      = document_RT.tracks;
+	const model::Actions&     actions     = document_RT.actions;
+
+	/* Pick up the latest volume and pan values first, as they bypass Document
+	swaps (see ChannelParams). */
+
+	advanceParams(tracks, document_RT.locked);
+
 	/* If the m_sequencer is running, advance it first (i.e. parse it for events).
 	Also advance channels (i.e. let them react to m_sequencer events), only if the
 	document is not locked: another thread might altering channel's data in the
@@ -137,6 +327,7 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 	const Channel& masterOutCh    = tracks.getChannel(MASTER_OUT_CHANNEL_ID);
 	const Channel& masterInCh     = tracks.getChannel(MASTER_IN_CHANNEL_ID);
 	const Channel& previewCh      = tracks.getChannel(PREVIEW_CHANNEL_ID);
+	const Frame    tailFrames     = static_cast<Frame>(kernelAudio.pluginTailTime) * sampleRate / 1000;
 
 	m_mixer.render(in, document_RT, maxFramesToRec);
 
@@ -144,8 +335,8 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 		renderMasterIn(masterInCh, mixer.getInBuffer());
 
 	if (!document_RT.locked)
-		renderTracks(tracks, masterOutCh.shared->audioBuffer, out, mixer.getInBuffer(),
-		    scene, hasSolos, sequencer.isRunning());
+		renderTracks(tracks, document_RT.renderGraph.get(), masterOutCh.shared->audioBuffer, out, mixer.getInBuffer(),
+		    scene, hasSolos, sequencer.isRunning(), tailFrames);
 
 	renderMasterOut(masterOutCh, out, kernelAudio.deviceOut.channelsStart);
 	if (mixer.renderPreview)
@@ -155,7 +346,21 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 
 	/* Post processing. */
 
-	m_mixer.finalizeOutput(mixer, out, mixer.inToOut, kernelAudio.limitOutput, masterOutCh.volume);
+	const ChannelParams::Ramp& masterOutRamp = masterOutCh.shared->params.getRamp();
+	m_mixer.finalizeOutput(mixer, out, mixer.inToOut, kernelAudio.limitOutput, masterOutRamp.volumeStart, masterOutRamp.volumeEnd);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::advanceParams(const model::Tracks& tracks, bool locked) const
+{
+	/* Internal channels are rendered even if the Document is locked: their
+	shared data is never touched in the meantime. */
+
+	for (const model::Track& track : tracks.getAll())
+		for (const Channel& c : track.getChannels().getAll())
+			if (!locked || c.isInternal())
+				c.shared->params.advance();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -188,53 +393,165 @@ void Renderer::advanceChannel(const Channel& ch, const Sequencer::EventBuffer& e
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderTracks(const model::Tracks& tracks, mcl::AudioBuffer& masterOut,
-    mcl::AudioBuffer& hardwareOut, const mcl::AudioBuffer& in, Scene scene, bool hasSolos,
-    bool seqIsRunning) const
+void Renderer::updateRenderState() const
+{
+	if (!m_hasNextRenderState.load(std::memory_order_relaxed))
+		return;
+	if (m_renderStateBusy.test_and_set(std::memory_order_acquire))
+		return;
+
+	m_nextRenderState->inherit(*m_renderState);
+	std::swap(m_renderState, m_nextRenderState);
+	m_hasNextRenderState.store(false, std::memory_order_relaxed);
+
+	m_renderStateBusy.clear(std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderTracks(const model::Tracks& tracks, const RenderGraph* graph,
+    mcl::AudioBuffer& masterOut, mcl::AudioBuffer& hardwareOut, const mcl::AudioBuffer& in,
+    Scene scene, bool hasSolos, bool seqIsRunning, Frame tailFrames) const
 {
 	masterOut.clear();
 
-	for (const model::Track& track : tracks.getAll())
-	{
-		if (track.isInternal())
-			continue;
+	const std::vector<model::Track>& allTracks = tracks.getAll();
 
-		const Channel& group = track.getGroupChannel();
-		group.shared->audioBuffer.clear();
+	/* Serial rendering: no worker threads available, nothing to parallelize or
+	no RenderState big enough yet (see reserveRenderState()). */
 
-		for (const Channel& c : track.getChannels().getAll())
+	if (m_workerPool.countWorkers() > 1)
+		updateRenderState();
+
+	if (m_workerPool.countWorkers() == 1 || graph == nullptr || graph->countRoots() <= 1 ||
+	    graph->getNodes().size() > m_renderState->getCapacity())
+	{
+		for (const model::Track& track : allTracks)
 		{
-			renderNormalChannel(c, in, scene, seqIsRunning);
-			if (!c.isAudible(hasSolos))
+			if (track.isInternal())
 				continue;
-			if (c.sendToMaster)
-				mergeChannel(c, group.shared->audioBuffer);
-			for (const int offset : c.extraOutputs)
-				mergeChannel(c, hardwareOut, offset);
+			renderTrack(track, in, scene, hasSolos, seqIsRunning, tailFrames, /*worker=*/0);
+			mergeTrack(track, masterOut, hardwareOut, hasSolos);
 		}
+		return;
+	}
+
+	/* Parallel rendering: execute the RenderGraph with one queue per worker.
+	WorkerPool::run() returns only when the whole graph has been rendered, so
+	merging Tracks to master below can safely happen on this thread. Merge order
+	is kept stable. */
+
+	assert(graph->isCompatible(tracks));
+
+	const std::size_t numQueues = m_workerPool.countWorkers();
+
+	auto renderNode = [&](const RenderGraph::Node& node, std::size_t worker)
+	{
+		const model::Track& track = allTracks[node.trackIndex];
+		if (node.type == RenderGraph::NodeType::CHANNEL)
+			renderNormalChannel(track.getChannels().getAll()[node.channelIndex], in, scene, seqIsRunning, tailFrames, worker);
+		else
+			renderGroup(track, hasSolos, tailFrames, worker);
+	};
+	auto job = [&](std::size_t queue, std::size_t worker)
+	{
+		m_renderState->execute(queue, worker, renderNode);
+	};
+
+	m_renderState->prepare(*graph, numQueues);
+	m_workerPool.run(numQueues, job);
+
+	for (const model::Track& track : allTracks)
+		if (!track.isInternal())
+			mergeTrack(track, masterOut, hardwareOut, hasSolos);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderTrack(const model::Track& track, const mcl::AudioBuffer& in,
+    Scene scene, bool hasSolos, bool seqIsRunning, Frame tailFrames, std::size_t worker) const
+{
+	for (const Channel& c : track.getChannels().getAll())
+		if (c.type != ChannelType::GROUP)
+			renderNormalChannel(c, in, scene, seqIsRunning, tailFrames, worker);
+
+	renderGroup(track, hasSolos, tailFrames, worker);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderGroup(const model::Track& track, bool hasSolos, Frame tailFrames, std::size_t worker) const
+{
+	const Channel&              group    = track.getGroupChannel();
+	const std::vector<Channel>& channels = track.getChannels().getAll();
+	const DspLoad::Timer        timer(group.shared->dspLoad);
+
+	const bool hasInput = std::any_of(channels.begin(), channels.end(), [hasSolos](const Channel& c)
+	    { return c.type != ChannelType::GROUP && c.isAudible(hasSolos) && c.sendToMaster && !c.shared->silent; });
+
+	if (canSkip_(group, hasInput, tailFrames))
+	{
+		skip_(group);
+		return;
+	}
+
+	group.shared->audioBuffer.clear();
+
+	for (const Channel& c : channels)
+		if (c.type != ChannelType::GROUP && c.isAudible(hasSolos) && c.sendToMaster)
+			mergeChannel(c, group.shared->audioBuffer);
+
+	renderAudioPlugins(group, m_pluginHost, worker);
+
+	updateIdleFrames_(group, hasInput);
+}
 
-		renderAudioPlugins(group, m_pluginHost);
+/* -------------------------------------------------------------------------- */
 
-		if (!group.isAudible(hasSolos))
+void Renderer::mergeTrack(const model::Track& track, mcl::AudioBuffer& masterOut,
+    mcl::AudioBuffer& hardwareOut, bool hasSolos) const
+{
+	for (const Channel& c : track.getChannels().getAll())
+	{
+		if (c.type == ChannelType::GROUP || !c.isAudible(hasSolos))
 			continue;
-		if (group.sendToMaster)
-			mergeChannel(group, masterOut);
-		for (const int offset : group.extraOutputs)
-			mergeChannel(group, hardwareOut, offset);
+		for (const int offset : c.extraOutputs)
+			mergeChannel(c, hardwareOut, offset);
 	}
+
+	const Channel& group = track.getGroupChannel();
+
+	if (!group.isAudible(hasSolos))
+		return;
+	if (group.sendToMaster)
+		mergeChannel(group, masterOut);
+	for (const int offset : group.extraOutputs)
+		mergeChannel(group, hardwareOut, offset);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::renderNormalChannel(const Channel& ch, const mcl::AudioBuffer& in,
-    Scene scene, bool seqIsRunning) const
+    Scene scene, bool seqIsRunning, Frame tailFrames, std::size_t worker) const
 {
+	const DspLoad::Timer timer(ch.shared->dspLoad);
+
+	const bool hasInput = hasInputSignal_(ch);
+
+	if (canSkip_(ch, hasInput, tailFrames))
+	{
+		skip_(ch);
+		return;
+	}
+
 	ch.shared->audioBuffer.clear();
 
 	if (ch.type == ChannelType::SAMPLE)
-		renderSampleChannel(ch, in, scene, seqIsRunning);
+		renderSampleChannel(ch, in, scene, seqIsRunning, worker);
 	else if (ch.type == ChannelType::MIDI)
-		renderMidiChannel(ch);
+		renderMidiChannel(ch, worker);
+
+	updateIdleFrames_(ch, hasInput);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -261,48 +578,71 @@ void Renderer::renderPreview(const Channel& ch, mcl::AudioBuffer& out) const
 	if (ch.isPlaying())
 		rendering::renderSampleChannel(ch, Scene{0}, /*seqIsRunning=*/false); // Sequencer status and scene are irrelevant here
 
-	out.sumAll(ch.shared->audioBuffer, ch.volume);
+	out.sumAll(ch.shared->audioBuffer, ch.shared->params.getVolume());
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene scene, bool seqIsRunning) const
+void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene scene, bool seqIsRunning, std::size_t worker) const
 {
 	assert(ch.type == ChannelType::SAMPLE);
 
+	if (ch.shared->resampler)
+		ch.shared->resampler->setFallback(m_loadGovernor.isDegraded());
+
 	if (ch.isPlaying())
 		rendering::renderSampleChannel(ch, scene, seqIsRunning);
 
 	if (ch.canReceiveAudio())
 		renderSampleChannelInput(ch, in); // record "clean" audio first	(i.e. not plugin-processed)
 
-	renderAudioPlugins(ch, m_pluginHost);
+	renderAudioPlugins(ch, m_pluginHost, worker);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderMidiChannel(const Channel& ch) const
+void Renderer::renderMidiChannel(const Channel& ch, std::size_t worker) const
 {
 	assert(ch.type == ChannelType::MIDI);
 
-	renderAudioAndMidiPlugins(ch, m_pluginHost);
+	renderAudioAndMidiPlugins(ch, m_pluginHost, worker);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::mergeChannel(const Channel& ch, mcl::AudioBuffer& out) const
 {
-	out.sumAll(ch.shared->audioBuffer, ch.pan.get(), ch.volume * ch.shared->volumeInternal.load());
+	if (ch.shared->silent)
+		return;
+
+	const mcl::AudioBuffer&    buf  = ch.shared->audioBuffer;
+	const ChannelParams::Ramp& ramp = ch.shared->params.getRamp();
+	const float                gain = ch.shared->volumeInternal.load();
+
+	assert(buf.countChannels() == static_cast<int>(ramp.panEnd.size()));
+	assert(buf.countFrames() == out.countFrames());
+
+	for (int i = 0; i < buf.countChannels() && i < out.countChannels(); i++)
+		simd::sumRamp(out.getChannelView(i).data(), buf.getChannelView(i).data(), buf.countFrames(),
+		    gain * ramp.getGainStart(i), gain * ramp.getGainEnd(i));
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::mergeChannel(const Channel& ch, mcl::AudioBuffer& out, int destChannelOffset) const
 {
-	assert(ch.shared->audioBuffer.countChannels() == static_cast<int>(ch.pan.get().size()));
+	if (ch.shared->silent)
+		return;
+
+	const mcl::AudioBuffer&    buf  = ch.shared->audioBuffer;
+	const ChannelParams::Ramp& ramp = ch.shared->params.getRamp();
+
+	assert(buf.countChannels() == static_cast<int>(ramp.panEnd.size()));
+	assert(buf.countFrames() == out.countFrames());
 
-	for (int i = 0; i < ch.shared->audioBuffer.countChannels(); i++)
-		if (destChannelOffset < out.countChannels())
-			out.sum(ch.shared->audioBuffer, i, i + destChannelOffset, ch.volume * ch.pan.get()[i]);
+	for (int i = 0; i < buf.countChannels(); i++)
+		if (i + destChannelOffset < out.countChannels())
+			simd::sumRamp(out.getChannelView(i + destChannelOffset).data(), buf.getChannelView(i).data(), buf.countFrames(),
+			    ramp.getGainStart(i), ramp.getGainEnd(i));
 }
 } // namespace giada::m::rendering
@@ -27,7 +27,15 @@
 #ifndef G_RENDERER_H
 #define G_RENDERER_H
 
+#include "src/core/loadGovernor.h"
+#include "src/core/rendering/renderGraph.h"
+#include "src/core/rendering/renderState.h"
+#include "src/core/rendering/workerPool.h"
 #include "src/core/sequencer.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace mcl
@@ -51,8 +59,10 @@ class JackTransport;
 
 namespace giada::m::model
 {
+struct Document;
 class Model;
 class Channels;
+class Track;
 class Tracks;
 } // namespace giada::m::model
 
@@ -69,7 +79,61 @@ public:
 
 	void render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model&) const;
 
+	/* renderOffline
+	Renders a block of audio regardless of the Mixer status, with no audio input.
+	Used for offline (non-realtime) rendering: the Mixer must be disabled, so that
+	the audio thread doesn't render at the same time. */
+
+	void renderOffline(mcl::AudioBuffer& out, const model::Model&) const;
+
+	/* startWorkers
+	Enables multi-core rendering, where Tracks are rendered in parallel by
+	'numWorkers' threads (the audio thread included). A value of 1 brings back
+	the serial rendering. Must be called only when mixer is disabled. */
+
+	void startWorkers(int numWorkers);
+
+	/* stopWorkers
+	Terminates all render workers. Must be called only when mixer is disabled. */
+
+	void stopWorkers();
+
+	/* reserveRenderState
+	Makes sure that a RenderGraph of 'numNodes' nodes can be executed. If not,
+	allocates a bigger RenderState and hands it over to the audio thread, which
+	picks it up at the beginning of the next block. Blocks rendered in the
+	meantime fall back to serial rendering. Never called by the audio thread. */
+
+	void reserveRenderState(std::size_t numNodes);
+
+#if G_DEBUG_MODE
+	/* debug
+	Prints the last and the maximum rendering time of each node of 'graph', as
+	measured by the render workers. Never called by the audio thread. */
+
+	void debug(const RenderGraph& graph) const;
+#endif
+
+	/* onResamplerFallback
+	Fired by the real-time thread when the load governor switches pitched
+	channels to the fallback resampling quality (true) or back to the configured
+	one (false), together with the current load in percent. */
+
+	std::function<void(bool fallback, float load)> onResamplerFallback;
+
 private:
+	/* render (2)
+	Renders a block of audio from the given realtime Document. */
+
+	void render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Document&) const;
+
+	/* updateRenderState
+	Takes the RenderState prepared by reserveRenderState(), if any. Does nothing
+	if the handover is in progress: it will be retried on the next block.
+	Realtime-safe. */
+
+	void updateRenderState() const;
+
 	/* advanceTracks
 	Processes Channels' static events (e.g. pre-recorded actions or sequencer
 	events) in the current audio block. Called when the sequencer is running. */
@@ -79,18 +143,56 @@ private:
 
 	void advanceChannel(const Channel&, const Sequencer::EventBuffer&, FrameRange, Frame quantizerStep) const;
 
-	void renderTracks(const model::Tracks&, mcl::AudioBuffer& masterOut,
+	/* advanceParams
+	Moves the volume and pan ramps of each Channel to the current block (see
+	ChannelParams). Only internal Channels are advanced if 'locked'. */
+
+	void advanceParams(const model::Tracks&, bool locked) const;
+
+	/* renderTracks
+	Renders all Tracks and merges them to master out. Rendering is spread across
+	the render workers by executing the RenderGraph, if there is more than one
+	worker and something to parallelize; it happens serially otherwise. Idle
+	Channels are skipped once their plug-ins have been silent for 'tailFrames'. */
+
+	void renderTracks(const model::Tracks&, const RenderGraph*, mcl::AudioBuffer& masterOut,
 	    mcl::AudioBuffer& hardwareOut, const mcl::AudioBuffer& in, Scene,
-	    bool hasSolos, bool seqIsRunning) const;
-	void renderNormalChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene, bool seqIsRunning) const;
+	    bool hasSolos, bool seqIsRunning, Frame tailFrames) const;
+
+	/* renderTrack
+	Renders all Channels of a Track into the Track's group buffer, plug-ins
+	included. Used for serial rendering. */
+
+	void renderTrack(const model::Track&, const mcl::AudioBuffer& in, Scene,
+	    bool hasSolos, bool seqIsRunning, Frame tailFrames, std::size_t worker) const;
+
+	/* renderGroup
+	Sums the already rendered Channels of a Track into the group buffer, then
+	processes the group plug-ins. */
+
+	void renderGroup(const model::Track&, bool hasSolos, Frame tailFrames, std::size_t worker) const;
+
+	/* mergeTrack
+	Merges the Track's group buffer to master out and any extra output. Must be
+	called serially after renderTrack(), as it writes to shared buffers. */
+
+	void mergeTrack(const model::Track&, mcl::AudioBuffer& masterOut,
+	    mcl::AudioBuffer& hardwareOut, bool hasSolos) const;
+
+	/* renderNormalChannel
+	Renders a Sample or MIDI Channel. Does nothing if the Channel has no input
+	signal and its plug-ins, if any, have been silent for 'tailFrames'. */
+
+	void renderNormalChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene, bool seqIsRunning, Frame tailFrames, std::size_t worker) const;
 	void renderMasterIn(const Channel&, mcl::AudioBuffer& in) const;
 	void renderMasterOut(const Channel&, mcl::AudioBuffer& out, int channelOffset) const;
 	void renderPreview(const Channel&, mcl::AudioBuffer& out) const;
-	void renderSampleChannel(const Channel&, const mcl::AudioBuffer& in, Scene, bool seqIsRunning) const;
-	void renderMidiChannel(const Channel&) const;
+	void renderSampleChannel(const Channel&, const mcl::AudioBuffer& in, Scene, bool seqIsRunning, std::size_t worker) const;
+	void renderMidiChannel(const Channel&, std::size_t worker) const;
 
 	/* mergeChannel
-	Merges the Channel's audio buffer with 'out'. */
+	Merges the Channel's audio buffer with 'out'. Does nothing if the buffer is
+	silent. */
 
 	void mergeChannel(const Channel&, mcl::AudioBuffer& out) const;
 
@@ -107,6 +209,30 @@ private:
 	JackSynchronizer& m_jackSynchronizer;
 	JackTransport&    m_jackTransport;
 #endif
+
+	mutable WorkerPool   m_workerPool;
+	mutable LoadGovernor m_loadGovernor;
+
+	/* m_renderState
+	The state used to execute the RenderGraph, owned by the audio thread. */
+
+	mutable std::unique_ptr<RenderState> m_renderState;
+
+	/* m_nextRenderState
+	A bigger RenderState ready to replace the current one if m_hasNextRenderState
+	is set, or the replaced one otherwise. Guarded by m_renderStateBusy, which the
+	audio thread only tries to acquire. */
+
+	mutable std::unique_ptr<RenderState> m_nextRenderState;
+	mutable std::atomic<bool>            m_hasNextRenderState;
+	mutable std::atomic_flag             m_renderStateBusy;
+
+	/* m_renderStateMutex, m_renderStateCapacity
+	Serialize reserveRenderState() calls and keep track of the capacity already
+	requested, without touching the state in use by the audio thread. */
+
+	std::mutex  m_renderStateMutex;
+	std::size_t m_renderStateCapacity;
 };
 } // namespace giada::m::rendering
 
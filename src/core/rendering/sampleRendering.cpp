@@ -26,30 +26,37 @@
 
 #include "src/core/rendering/sampleRendering.h"
 #include "src/core/channels/channel.h"
+#include "src/core/compactBuffer.h"
+#include "src/core/const.h"
+#include "src/core/diskStream.h"
+#include "src/core/freezer.h"
 #include "src/core/plugins/pluginHost.h"
 #include "src/core/rendering/sampleAdvance.h"
 #include "src/core/resampler.h"
+#include "src/core/stretchStream.h"
 #include "src/core/stretcher.h"
 #include "src/core/wave.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <optional>
+#include <utility>
 
 namespace giada::m::rendering
 {
 namespace
 {
-ReadResult readResampled_(const Sample& sample, mcl::AudioBuffer& dest, Frame start,
-    Frame offset, const Resampler& resampler)
+ReadResult readResampled_(const mcl::AudioBuffer& src, Frame start, Frame end, mcl::AudioBuffer& dest,
+    Frame offset, const Resampler& resampler, float ratio)
 {
-	assert(sample.wave != nullptr);
-
 	Resampler::Result res = resampler.process(
-	    /*input=*/sample.wave->getBuffer(),
+	    /*input=*/src,
 	    /*inputPos=*/start,
-	    /*inputLength=*/sample.range.getB(),
+	    /*inputLength=*/end,
 	    /*output=*/dest,
 	    /*outputLength=*/offset,
-	    /*ratio=*/sample.pitch);
+	    /*ratio=*/ratio);
 
 	return {
 	    static_cast<Frame>(res.used),
@@ -59,19 +66,18 @@ ReadResult readResampled_(const Sample& sample, mcl::AudioBuffer& dest, Frame st
 
 /* -------------------------------------------------------------------------- */
 
-ReadResult readStretched_(const Sample& sample, mcl::AudioBuffer& dest, Frame start,
-    Frame offset, Stretcher& stretcher)
+ReadResult readStretched_(const Sample& sample, const mcl::AudioBuffer& src, Frame start,
+    Frame end, bool endOfInput, mcl::AudioBuffer& dest, Frame offset, Stretcher& stretcher)
 {
-	assert(sample.wave != nullptr);
-
 	Stretcher::Result res = stretcher.process(
-	    /*input=*/sample.wave->getBuffer(),
+	    /*input=*/src,
 	    /*inputStart=*/start,
-	    /*inputEnd=*/sample.range.getB(),
+	    /*inputEnd=*/end,
 	    /*output=*/dest,
 	    /*outputStart=*/offset,
 	    /*timeRatio=*/sample.time,
-	    /*pitchRatio=*/sample.pitch);
+	    /*pitchRatio=*/sample.pitch,
+	    /*endOfInput=*/endOfInput);
 
 	return {
 	    static_cast<Frame>(res.used),
@@ -81,22 +87,132 @@ ReadResult readStretched_(const Sample& sample, mcl::AudioBuffer& dest, Frame st
 
 /* -------------------------------------------------------------------------- */
 
-ReadResult readCopy_(const Sample& sample, mcl::AudioBuffer& dest, Frame start,
-    Frame offset)
+ReadResult readCopy_(const mcl::AudioBuffer& src, Frame start, Frame end,
+    mcl::AudioBuffer& dest, Frame offset)
 {
-	assert(sample.wave != nullptr);
-
 	Frame used = dest.countFrames() - offset;
-	if (used > sample.range.getB() - start)
-		used = sample.range.getB() - start;
+	if (used > end - start)
+		used = end - start;
 
-	dest.setAll(sample.wave->getBuffer(), used, start, offset);
+	dest.setAll(src, used, start, offset);
 
 	return {used, used, true};
 }
 
 /* -------------------------------------------------------------------------- */
 
+/* read_
+Reads frames [start, end) from the 'src' buffer, according to the Sample playback
+mode. 'endOfInput' is false if more frames follow 'end' in a later call, i.e. when
+reading from a streamed Wave. */
+
+ReadResult read_(const Sample& sample, const mcl::AudioBuffer& src, Frame start, Frame end,
+    bool endOfInput, mcl::AudioBuffer& dest, Frame offset, const Resampler& resampler, Stretcher* stretcher)
+{
+	if (sample.playbackMode == PlaybackMode::TAPE)
+	{
+		if (sample.pitch == 1.0f)
+			return readCopy_(src, start, end, dest, offset);
+		else
+			return readResampled_(src, start, end, dest, offset, resampler, sample.pitch);
+	}
+
+	/* PlaybackMode::ELASTIC. With no Stretcher available (the pool is exhausted)
+	resample instead: the Sample keeps its duration, but not its pitch. */
+
+	if (stretcher != nullptr)
+		return readStretched_(sample, src, start, end, endOfInput, dest, offset, *stretcher);
+	return readResampled_(src, start, end, dest, offset, resampler, 1.0f / sample.time);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* countInputFrames_
+Returns how many input frames are needed to fill the output buffer from
+'offset' onwards: it depends on pitch (or time, when stretching), plus 'margin'
+extra frames for the resampler or the stretcher latency. Never more than
+'maxFrames', nor past the end of the Sample. */
+
+Frame countInputFrames_(const Sample& sample, const mcl::AudioBuffer& dest, Frame start, Frame offset,
+    Frame margin, Frame maxFrames)
+{
+	const Frame length = dest.countFrames() - offset;
+	const float ratio  = sample.playbackMode == PlaybackMode::ELASTIC ? 1.0f / sample.time : sample.pitch;
+
+	return std::min({static_cast<Frame>(std::ceil(length * ratio)) + margin, maxFrames, sample.range.getB() - start});
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* readCompact_
+Reads from a compact Wave. Only the frames needed by the current block are
+expanded to float: straight into the output buffer if no resampling or
+stretching is needed, into the 'window' scratch buffer otherwise. */
+
+ReadResult readCompact_(const Sample& sample, mcl::AudioBuffer& dest, Frame start,
+    Frame offset, const Resampler& resampler, Stretcher* stretcher, mcl::AudioBuffer& window)
+{
+	const CompactBuffer& src = *sample.wave->getCompact();
+	const Frame          end = sample.range.getB();
+
+	if (sample.playbackMode == PlaybackMode::TAPE && sample.pitch == 1.0f)
+	{
+		const Frame used = std::min(dest.countFrames() - offset, end - start);
+		src.read(dest, start, used, offset);
+		return {used, used, true};
+	}
+
+	const Frame frames = countInputFrames_(sample, dest, start, offset, G_COMPACT_READ_MARGIN, window.countFrames());
+
+	src.read(window, start, frames, 0);
+
+	return read_(sample, window, 0, frames, /*endOfInput=*/start + frames == end, dest, offset, resampler, stretcher);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* readStreamed_
+Reads from a Wave streamed from disk. Frames are read straight from the in-memory
+head if possible. Otherwise they are gathered into the stream window first, from
+the head and/or the disk stream, and read from there. On underrun the output is
+silenced, while the read position keeps moving on as if audio was there. */
+
+ReadResult readStreamed_(const Sample& sample, mcl::AudioBuffer& dest, Frame start,
+    Frame offset, const Resampler& resampler, Stretcher* stretcher)
+{
+	DiskStream&             stream = *sample.wave->getStream();
+	mcl::AudioBuffer&       window = stream.getWindow();
+	const mcl::AudioBuffer& head   = std::as_const(*sample.wave).getBuffer();
+	const Frame             end    = sample.range.getB();
+	const Frame             length = dest.countFrames() - offset;
+	const bool              isCopy = sample.playbackMode == PlaybackMode::TAPE && sample.pitch == 1.0f;
+	const float             ratio  = sample.playbackMode == PlaybackMode::ELASTIC ? 1.0f / sample.time : sample.pitch;
+	const Frame             margin = isCopy ? 0 : G_STREAM_READ_MARGIN;
+	const Frame             needed = countInputFrames_(sample, dest, start, offset, margin, window.countFrames());
+
+	if (start + needed <= head.countFrames())
+		return read_(sample, head, start, std::min(end, head.countFrames()), /*endOfInput=*/end <= head.countFrames(),
+		    dest, offset, resampler, stretcher);
+
+	Frame frames = 0;
+	if (start < head.countFrames())
+	{
+		frames = head.countFrames() - start;
+		window.setAll(head, frames, start, 0);
+	}
+	frames += stream.read(window, start + frames, needed - frames, frames);
+
+	if (frames == 0) // Underrun
+	{
+		dest.clear(offset);
+		return {std::clamp(static_cast<Frame>(length * ratio), 1, end - start), length, true};
+	}
+
+	return read_(sample, window, 0, frames, /*endOfInput=*/start + frames == end, dest, offset, resampler, stretcher);
+}
+
+/* -------------------------------------------------------------------------- */
+
 /* onSampleEnd
 Things to do when the last frame has been reached. 'natural' == true if the
 rendering has ended because the end of the sample has been reached.
@@ -147,18 +263,49 @@ void stop_(const Channel& ch, mcl::AudioBuffer& buf, Frame offset, bool seqIsRun
 
 /* -------------------------------------------------------------------------- */
 
+/* getStretcher_
+Returns the Stretcher lent to the channel, if any. The Model lends it only to
+channels with ELASTIC Samples, and takes it back as soon as there are none:
+don't touch it unless the current Sample is ELASTIC. */
+
+Stretcher* getStretcher_(const Channel& ch, const Sample& sample)
+{
+	if (sample.playbackMode != PlaybackMode::ELASTIC)
+		return nullptr;
+	return ch.shared->stretcher.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
 Frame render_(const Channel& ch, mcl::AudioBuffer& buf, Scene scene, Frame tracker, Frame offset, bool seqIsRunning, bool testEnd)
 {
-	const Sample&    sample    = ch.sampleChannel->getSample(scene);
-	const Resampler& resampler = ch.shared->resampler.value();
-	Stretcher&       stretcher = ch.shared->stretcher.value();
+	const Sample&     sample        = ch.sampleChannel->getSample(scene);
+	const Resampler&  resampler     = ch.shared->resampler.value();
+	Stretcher*        stretcher     = getStretcher_(ch, sample);
+	mcl::AudioBuffer& compactWindow = ch.shared->compactWindow.value();
+	Freezer*          freezer       = ch.shared->freezer.get();
+	StretchStream*    stream        = ch.shared->stretchStream.get();
 
 	if (sample.wave == nullptr)
 		return tracker;
 
 	while (true)
 	{
-		ReadResult res = readWave(sample, buf, tracker, offset, resampler, stretcher);
+		/* Play the frozen version of the Sample if available: just a copy, no
+		resampling nor stretching needed. Otherwise play what has been stretched
+		ahead in background, if any. */
+
+		std::optional<ReadResult> ahead = freezer != nullptr ? freezer->a_read(sample, buf, tracker, offset) : std::nullopt;
+		if (!ahead && stream != nullptr)
+			ahead = stream->a_read(sample, buf, tracker, offset);
+
+		/* Taking over from the stretch stream: the inline Stretcher still holds
+		the output of the last time it was used. */
+
+		if (!ahead && stream != nullptr && stream->a_handOver() && stretcher != nullptr)
+			stretcher->last();
+
+		const ReadResult res = ahead ? *ahead : readWave(sample, buf, tracker, offset, resampler, stretcher, compactWindow);
 		tracker += res.used;
 		offset += res.generated;
 
@@ -166,7 +313,8 @@ Frame render_(const Channel& ch, mcl::AudioBuffer& buf, Scene scene, Frame track
 		{
 			tracker = sample.range.getA();
 			ch.shared->resampler->last();
-			ch.shared->stretcher->last();
+			if (stretcher != nullptr)
+				stretcher->last();
 
 			if (testEnd)
 			{
@@ -199,7 +347,7 @@ void renderSampleChannel(const Channel& ch, Scene scene, bool seqIsRunning)
 
 	const auto        range     = ch.sampleChannel->getRange(scene);
 	const Resampler&  resampler = ch.shared->resampler.value();
-	Stretcher&        stretcher = ch.shared->stretcher.value();
+	Stretcher*        stretcher = getStretcher_(ch, ch.sampleChannel->getSample(scene));
 	mcl::AudioBuffer& buf       = ch.shared->audioBuffer;
 	Frame             tracker   = std::clamp(ch.shared->tracker.load(), range.getA(), range.getB()); /* Make sure tracker stays within begin-end range. */
 
@@ -216,7 +364,8 @@ void renderSampleChannel(const Channel& ch, Scene scene, bool seqIsRunning)
 
 		render_(ch, buf, scene, tracker, 0, seqIsRunning, /*testEnd=*/false);
 		resampler.last();
-		stretcher.last();
+		if (stretcher != nullptr)
+			stretcher->last();
 
 		/* Mode::REWIND: fill buffer from offset:  [abcdefghi|abcdfefg]
 		   Mode::STOP:   clear buffer from offset: [abcdefghi|--------] */
@@ -233,6 +382,18 @@ void renderSampleChannel(const Channel& ch, Scene scene, bool seqIsRunning)
 	}
 
 	ch.shared->tracker.store(tracker);
+
+	/* Let the stretch stream know where to render from next, e.g. the beginning
+	of the range after a rewind or a stop. */
+
+	if (StretchStream* stream = ch.shared->stretchStream.get(); stream != nullptr)
+		stream->a_prefetch(tracker);
+
+	/* Let the disk reader know where to read from next, if the Wave is streamed.
+	Never before the end of the in-memory head, which needs no streaming. */
+
+	if (const Wave* wave = ch.sampleChannel->getWave(scene); wave != nullptr && wave->isStreamed())
+		wave->getStream()->prefetch(std::max(tracker, wave->getBuffer().countFrames()));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -246,21 +407,22 @@ void renderSampleChannelInput(const Channel& ch, const mcl::AudioBuffer& in)
 /* -------------------------------------------------------------------------- */
 
 ReadResult readWave(const Sample& sample, mcl::AudioBuffer& out, Frame start,
-    Frame offset, const Resampler& resampler, Stretcher& stretcher)
+    Frame offset, const Resampler& resampler, Stretcher* stretcher, mcl::AudioBuffer& compactWindow)
 {
 	assert(sample.wave != nullptr);
 	assert(start >= 0);
-	assert(sample.range.getB() <= sample.wave->getBuffer().countFrames());
+	assert(sample.range.getB() <= sample.wave->getLength());
 	assert(offset < out.countFrames());
 
-	if (sample.playbackMode == PlaybackMode::TAPE)
-	{
-		if (sample.pitch == 1.0f)
-			return readCopy_(sample, out, start, offset);
-		else
-			return readResampled_(sample, out, start, offset, resampler);
-	}
-	else // PlaybackMode::ELASTIC
-		return readStretched_(sample, out, start, offset, stretcher);
+	if (sample.wave->isStreamed())
+		return readStreamed_(sample, out, start, offset, resampler, stretcher);
+	if (sample.wave->isCompact())
+		return readCompact_(sample, out, start, offset, resampler, stretcher, compactWindow);
+
+	/* Always read through a const Wave: the non-const getBuffer() might copy
+	the audio data, if shared with other Waves. */
+
+	return read_(sample, std::as_const(*sample.wave).getBuffer(), start, sample.range.getB(), /*endOfInput=*/true,
+	    out, offset, resampler, stretcher);
 }
 } // namespace giada::m::rendering
@@ -91,7 +91,14 @@ Copies input buffer to channel buffer: this enables the input monitoring. */
 
 void renderSampleChannelInput(const Channel&, const mcl::AudioBuffer&);
 
-ReadResult readWave(const Sample&, mcl::AudioBuffer&, Frame start, Frame offset, const Resampler&, Stretcher&);
+/* readWave
+Reads audio from the Sample's Wave into the given buffer, starting from frame
+'start' of the Wave and 'offset' of the buffer. 'compactWindow' is a scratch
+buffer used only if the Wave is compact. ELASTIC Samples are resampled if
+'stretcher' is nullptr. */
+
+ReadResult readWave(const Sample&, mcl::AudioBuffer&, Frame start, Frame offset, const Resampler&, Stretcher*,
+    mcl::AudioBuffer& compactWindow);
 } // namespace giada::m::rendering
 
 #endif
@@ -0,0 +1,272 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/rendering/workerPool.h"
+#include "src/const.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+#if G_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace giada::m::rendering
+{
+namespace
+{
+/* getPriority_
+Returns the scheduling policy and priority for the workers, packed into a single
+word, taken from the calling thread. Real-time priorities are lowered by one
+level, so that workers never preempt the thread they serve. */
+
+uint64_t getPriority_()
+{
+#if G_OS_WINDOWS
+	const int priority = GetThreadPriority(GetCurrentThread());
+	return static_cast<uint32_t>(priority);
+#else
+	int         policy;
+	sched_param param;
+	if (pthread_getschedparam(pthread_self(), &policy, &param) != 0)
+		return 0;
+	if (policy == SCHED_FIFO || policy == SCHED_RR)
+		param.sched_priority = std::max(sched_get_priority_min(policy), param.sched_priority - 1);
+	return (static_cast<uint64_t>(policy) << 32) | static_cast<uint32_t>(param.sched_priority);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* setPriority_
+Applies a packed priority from getPriority_() to the calling thread. Failures
+are not fatal, and not logged as this runs on a render thread: the worker just
+keeps its current priority. */
+
+void setPriority_(uint64_t priority)
+{
+#if G_OS_WINDOWS
+	SetThreadPriority(GetCurrentThread(), static_cast<int>(static_cast<uint32_t>(priority)));
+#else
+	sched_param param;
+	param.sched_priority = static_cast<int>(static_cast<uint32_t>(priority));
+	pthread_setschedparam(pthread_self(), static_cast<int>(priority >> 32), &param);
+#endif
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+WorkerPool::WorkerPool()
+: m_running(false)
+, m_signal(0)
+, m_cursor(0)
+, m_job(nullptr)
+, m_context(nullptr)
+, m_generation(0)
+, m_pending(0)
+, m_priority(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+WorkerPool::~WorkerPool()
+{
+	stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WorkerPool::start(int numWorkers)
+{
+	assert(numWorkers > 0);
+
+	stop();
+
+	/* Workers get their priority from the first thread calling run(). */
+
+	m_caller = {};
+	m_running.store(true);
+	for (int i = 1; i < numWorkers; i++)
+		m_threads.emplace_back([this, i]()
+		{ loop(static_cast<std::size_t>(i)); });
+
+	u::log::print("[WorkerPool::start] Started with {} workers\n", numWorkers);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WorkerPool::stop()
+{
+	if (m_threads.empty())
+		return;
+
+	m_running.store(false);
+	m_signal.fetch_add(1, std::memory_order_release);
+	m_signal.notify_all();
+
+	for (std::thread& t : m_threads)
+		t.join();
+	m_threads.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t WorkerPool::countWorkers() const
+{
+	return m_threads.size() + 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WorkerPool::run(std::size_t count, Job job, void* context)
+{
+	assert(count <= CURSOR_INDEX_MASK);
+
+	if (count == 0)
+		return;
+
+	/* No extra threads: just run everything on the calling one. */
+
+	if (m_threads.empty())
+	{
+		for (std::size_t i = 0; i < count; i++)
+			job(context, i, 0);
+		return;
+	}
+
+	/* Take the priority for the workers from the calling thread, the first time
+	it calls this function. Doesn't happen again until another thread (e.g. the
+	offline renderer) shows up. */
+
+	if (m_caller != std::this_thread::get_id())
+	{
+		m_caller = std::this_thread::get_id();
+		m_priority.store(getPriority_(), std::memory_order_relaxed);
+	}
+
+	/* Publish the new job. The release store on the cursor makes job, context
+	and pending counter visible to any worker that successfully claims a job. */
+
+	m_job.store(job, std::memory_order_relaxed);
+	m_context.store(context, std::memory_order_relaxed);
+	m_pending.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
+	m_cursor.store(makeCursor_(++m_generation, count, 0), std::memory_order_release);
+
+	m_signal.fetch_add(1, std::memory_order_release);
+	m_signal.notify_all();
+
+	/* The calling thread helps too, then waits for the other workers to
+	complete the jobs they have claimed (join barrier). */
+
+	drain(0);
+	join();
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t WorkerPool::makeCursor_(uint64_t generation, uint64_t count, uint64_t next)
+{
+	return (generation << (CURSOR_INDEX_BITS * 2)) | (count << CURSOR_INDEX_BITS) | next;
+}
+
+std::size_t WorkerPool::getCount_(uint64_t cursor)
+{
+	return static_cast<std::size_t>((cursor >> CURSOR_INDEX_BITS) & CURSOR_INDEX_MASK);
+}
+
+std::size_t WorkerPool::getNext_(uint64_t cursor)
+{
+	return static_cast<std::size_t>(cursor & CURSOR_INDEX_MASK);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WorkerPool::loop(std::size_t workerIndex)
+{
+	uint64_t priority = 0;
+	uint32_t signal   = m_signal.load(std::memory_order_acquire);
+	while (true)
+	{
+		m_signal.wait(signal, std::memory_order_acquire);
+		signal = m_signal.load(std::memory_order_acquire);
+
+		if (!m_running.load())
+			return;
+
+		if (const uint64_t p = m_priority.load(std::memory_order_relaxed); p != priority)
+		{
+			setPriority_(p);
+			priority = p;
+		}
+
+		drain(workerIndex);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WorkerPool::drain(std::size_t workerIndex)
+{
+	uint64_t cursor = m_cursor.load(std::memory_order_acquire);
+	while (getNext_(cursor) < getCount_(cursor))
+	{
+		/* Claim the next job. On failure 'cursor' is reloaded with the current
+		value and the loop tries again. */
+
+		if (!m_cursor.compare_exchange_weak(cursor, cursor + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+			continue;
+
+		const Job job = m_job.load(std::memory_order_relaxed);
+		job(m_context.load(std::memory_order_relaxed), getNext_(cursor), workerIndex);
+
+		m_pending.fetch_sub(1, std::memory_order_release);
+
+		cursor = m_cursor.load(std::memory_order_acquire);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WorkerPool::join()
+{
+	/* No kernel wait here, as this runs on the audio thread: sleeping on the
+	barrier would make the end of the block depend on the scheduler waking it
+	up in time. The jobs left have already been claimed and are running on the
+	other cores, so the wait is as short as the slowest of them. Yielding lets
+	a worker sharing this core finish its job. */
+
+	for (int i = 0; m_pending.load(std::memory_order_acquire) > 0; i++)
+		if (i >= JOIN_SPINS)
+			std::this_thread::yield();
+}
+} // namespace giada::m::rendering
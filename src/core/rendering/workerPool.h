@@ -0,0 +1,153 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_RENDERING_WORKER_POOL_H
+#define G_RENDERING_WORKER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace giada::m::rendering
+{
+/* WorkerPool
+A pool of pre-spawned threads used to split the audio rendering across multiple
+cores. The thread calling run() (i.e. the audio thread) takes part in the job as
+worker 0, so a pool of N workers spawns N - 1 additional threads. Workers take
+the scheduling priority of the calling thread, one level below it, so that they
+never preempt it. Jobs are claimed without locks and no allocations happen on
+the calling thread. */
+
+class WorkerPool
+{
+public:
+	/* Job
+	A function that renders the job at index 'jobIndex', executed by the worker
+	at index 'workerIndex'. */
+
+	using Job = void (*)(void* context, std::size_t jobIndex, std::size_t workerIndex);
+
+	WorkerPool();
+	~WorkerPool();
+
+	/* start
+	Spawns the worker threads, 'numWorkers' - 1 of them. Stops any previously
+	running thread first. Not realtime-safe: call it when the audio rendering
+	is suspended. */
+
+	void start(int numWorkers);
+
+	/* stop
+	Terminates and joins all worker threads. Not realtime-safe. */
+
+	void stop();
+
+	/* countWorkers
+	Returns the number of workers, including the calling thread. */
+
+	std::size_t countWorkers() const;
+
+	/* run
+	Executes 'count' jobs across all workers and returns when all of them are
+	completed (join barrier). The calling thread never sleeps on the barrier:
+	it spins for a while, then yields the CPU until the last job is done. */
+
+	void run(std::size_t count, Job, void* context);
+
+	/* run (2)
+	Same as above, for a callable with signature
+	void(std::size_t jobIndex, std::size_t workerIndex). */
+
+	template <typename F>
+	void run(std::size_t count, F& f)
+	{
+		run(count, [](void* context, std::size_t jobIndex, std::size_t workerIndex)
+		{ (*static_cast<F*>(context))(jobIndex, workerIndex); }, &f);
+	}
+
+private:
+	/* Cursor
+	Packs the current run generation, the number of jobs and the next job to
+	be claimed into a single atomic word. A worker can claim a job only if the
+	generation it has seen is still the current one, so that a late worker
+	never picks up a job from a stale (or future) run. */
+
+	static constexpr uint64_t CURSOR_INDEX_BITS = 20;
+	static constexpr uint64_t CURSOR_INDEX_MASK = (uint64_t{1} << CURSOR_INDEX_BITS) - 1;
+
+	/* JOIN_SPINS
+	How many times the calling thread checks the join barrier before it starts
+	yielding the CPU. Workers usually finish within a few microseconds of each
+	other. */
+
+	static constexpr int JOIN_SPINS = 256;
+
+	static uint64_t    makeCursor_(uint64_t generation, uint64_t count, uint64_t next);
+	static std::size_t getCount_(uint64_t cursor);
+	static std::size_t getNext_(uint64_t cursor);
+
+	/* loop
+	Main function of each worker thread: sleeps until a new run is signalled,
+	then helps draining jobs. */
+
+	void loop(std::size_t workerIndex);
+
+	/* drain
+	Claims and executes jobs until there are none left in the current run. */
+
+	void drain(std::size_t workerIndex);
+
+	/* join
+	Waits for the jobs claimed by the other workers to be completed. */
+
+	void join();
+
+	std::vector<std::thread> m_threads;
+	std::atomic<bool>        m_running;
+	std::atomic<uint32_t>    m_signal;
+	std::atomic<uint64_t>    m_cursor;
+	std::atomic<Job>         m_job;
+	std::atomic<void*>       m_context;
+	uint64_t                 m_generation;
+
+	/* m_pending
+	Jobs not completed yet in the current run. */
+
+	std::atomic<uint32_t> m_pending;
+
+	/* m_priority, m_caller
+	Scheduling priority for the workers, packed (see getPriority_()), and the
+	last thread it has been taken from. */
+
+	std::atomic<uint64_t> m_priority;
+	std::thread::id       m_caller;
+};
+} // namespace giada::m::rendering
+
+#endif
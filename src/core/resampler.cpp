@@ -26,16 +26,81 @@
 
 #include "src/core/resampler.h"
 #include "const.h"
+#include "src/core/simd.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/utils/log.h"
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdio>
 #include <new>
+#include <numbers>
 #include <utility>
 
 namespace giada::m
 {
+namespace
+{
+/* Built-in sinc filter parameters. CUTOFF is the low-pass cutoff relative to
+the Nyquist frequency, KAISER_BETA shapes the window for ~80 dB of stopband
+attenuation. */
+
+constexpr int    TABLE_RES   = 128;
+constexpr int    PHASES      = 256;
+constexpr double CUTOFF      = 0.9;
+constexpr double KAISER_BETA = 8.0;
+
+/* -------------------------------------------------------------------------- */
+
+/* besselI0_
+Modified Bessel function of the first kind, order 0, used by the Kaiser
+window. */
+
+double besselI0_(double x)
+{
+	double sum  = 1.0;
+	double term = 1.0;
+	for (int k = 1; k < 32; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* kernel_
+Value of the Kaiser-windowed sinc at 'distance' frames from its center, for a
+kernel 'zeros' frames wide on each side. */
+
+double kernel_(double distance, int zeros)
+{
+	if (distance >= zeros)
+		return 0.0;
+	const double x      = CUTOFF * distance * std::numbers::pi;
+	const double sinc   = x == 0.0 ? 1.0 : std::sin(x) / x;
+	const double window = distance / zeros;
+	return CUTOFF * sinc * besselI0_(KAISER_BETA * std::sqrt(1.0 - window * window)) / besselI0_(KAISER_BETA);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* lookup_
+Reads the kernel from the fine-grained table, with linear interpolation. */
+
+float lookup_(const float* table, float distance)
+{
+	const float pos   = distance * TABLE_RES;
+	const int   index = static_cast<int>(pos);
+	return table[index] + (pos - index) * (table[index + 1] - table[index]);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Resampler::MonoResampler::MonoResampler()
 : m_state(nullptr)
 , m_input(nullptr)
@@ -73,11 +138,6 @@ long Resampler::MonoResampler::callback(float** audio)
 {
 	assert(audio != nullptr);
 
-	/* Move pointer properly, taking into account read data and number of
-	channels in input data. */
-
-	*audio = m_input + m_inputPos;
-
 	/* Returns how many frames have been read in this callback shot. */
 
 	std::size_t frames = 0;
@@ -89,6 +149,14 @@ long Resampler::MonoResampler::callback(float** audio)
 	else
 		frames = m_inputLength - m_inputPos;
 
+	/* Hand a copy of the input data to libsamplerate, which might keep pointing
+	to unused frames across process() calls. The input buffer is only guaranteed
+	to be valid for the duration of a single call (e.g. when streaming from
+	disk). */
+
+	std::copy_n(m_input + m_inputPos, frames, m_chunk.data());
+	*audio = m_chunk.data();
+
 	m_usedFrames += frames;
 	m_inputPos += frames;
 
@@ -135,11 +203,300 @@ void Resampler::MonoResampler::last() const
 {
 	src_reset(m_state);
 }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Resampler::StereoResampler::StereoResampler()
+: m_quality(Quality::BUILTIN_SINC)
+, m_filter(nullptr)
+, m_count(0)
+, m_position(0.0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Resampler::StereoResampler::Filter& Resampler::StereoResampler::getFilter()
+{
+	static const Filter filter = []()
+	{
+		Filter out;
+
+		/* The table is padded with one extra frame of zeros: a stretched kernel
+		might look a bit past its last zero crossing. */
+
+		out.table.resize((ZEROS + 1) * TABLE_RES + 2, 0.0f);
+		for (int i = 0; i < ZEROS * TABLE_RES; i++)
+			out.table[i] = static_cast<float>(kernel_(i / static_cast<double>(TABLE_RES), ZEROS));
+
+		/* Each row of the bank is normalized, so that a constant signal goes
+		through untouched regardless of the fractional position. */
+
+		constexpr int TAPS = ZEROS * 2;
+		out.bank.resize((PHASES + 1) * TAPS);
+		for (int phase = 0; phase <= PHASES; phase++)
+		{
+			float* row = out.bank.data() + phase * TAPS;
+			double sum = 0.0;
+			for (int tap = 0; tap < TAPS; tap++)
+			{
+				const double distance = std::abs(tap - ZEROS + 1 - phase / static_cast<double>(PHASES));
+				row[tap]              = static_cast<float>(kernel_(distance, ZEROS));
+				sum += row[tap];
+			}
+			for (int tap = 0; tap < TAPS; tap++)
+				row[tap] = static_cast<float>(row[tap] / sum);
+		}
+		return out;
+	}();
+	return filter;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Resampler::StereoResampler::alloc(Quality quality)
+{
+	assert(isBuiltin(quality));
+
+	m_quality = quality;
+	m_filter  = &getFilter(); // Built here, never on the audio thread
+	last();
+}
+
+/* -------------------------------------------------------------------------- */
+
+int Resampler::StereoResampler::getRadius(float scale) const
+{
+	switch (m_quality)
+	{
+	case Quality::BUILTIN_LINEAR:
+		return 1;
+	case Quality::BUILTIN_CUBIC:
+		return 2;
+	default:
+		return std::min(static_cast<int>(std::ceil(ZEROS / scale)), MAX_RADIUS);
+	}
+}
+
 /* -------------------------------------------------------------------------- */
+
+void Resampler::StereoResampler::compact() const
+{
+	/* Drop old frames, keeping the ones the widest kernel could still need. */
+
+	const std::size_t frame = static_cast<std::size_t>(m_position);
+	if (frame <= MAX_RADIUS)
+		return;
+	const std::size_t drop = frame - MAX_RADIUS;
+	std::copy(m_left.begin() + drop, m_left.begin() + m_count, m_left.begin());
+	std::copy(m_right.begin() + drop, m_right.begin() + m_count, m_right.begin());
+	m_count -= drop;
+	m_position -= drop;
+}
+
 /* -------------------------------------------------------------------------- */
+
+std::size_t Resampler::StereoResampler::render(float* left, float* right, std::size_t frames, std::size_t limit,
+    float ratio, float scale, int radius) const
+{
+	/* Runs 'kernel' on each output frame. The kernel receives pointers to the
+	input frame at or right before the current position, plus the fractional
+	part of the position. */
+
+	std::size_t rendered = 0;
+	const auto  run      = [&](auto&& kernel)
+	{
+		double position = m_position;
+		while (rendered < frames && static_cast<std::size_t>(position) < limit)
+		{
+			const std::size_t frame = static_cast<std::size_t>(position);
+			const float       frac  = static_cast<float>(position - frame);
+			kernel(m_left.data() + frame, m_right.data() + frame, frac, left[rendered], right[rendered]);
+			position += ratio;
+			rendered++;
+		}
+		m_position = position;
+	};
+
+	switch (m_quality)
+	{
+	case Quality::BUILTIN_LINEAR:
+	{
+		run([](const float* l, const float* r, float frac, float& outL, float& outR)
+		{
+			outL = l[0] + frac * (l[1] - l[0]);
+			outR = r[0] + frac * (r[1] - r[0]);
+		});
+		break;
+	}
+	case Quality::BUILTIN_CUBIC:
+	{
+		/* Catmull-Rom spline through frames [-1, 2]. */
+
+		const auto cubic = [](const float* p, float frac)
+		{
+			return p[0] + 0.5f * frac * (p[1] - p[-1] + frac * (2.0f * p[-1] - 5.0f * p[0] + 4.0f * p[1] - p[2] + frac * (3.0f * (p[0] - p[1]) + p[2] - p[-1])));
+		};
+		run([&cubic](const float* l, const float* r, float frac, float& outL, float& outR)
+		{
+			outL = cubic(l, frac);
+			outR = cubic(r, frac);
+		});
+		break;
+	}
+	default:
+	{
+		const int taps = radius * 2;
+
+		if (scale == 1.0f)
+		{
+			/* Not decimating: interpolate between the two nearest precomputed
+			phases. */
+
+			const float* bank = m_filter->bank.data();
+			run([bank, radius, taps](const float* l, const float* r, float frac, float& outL, float& outR)
+			{
+				const float  phase = frac * PHASES;
+				const int    index = static_cast<int>(phase);
+				const float  t     = phase - index;
+				const float* row   = bank + index * taps;
+				float        a[2], b[2];
+				simd::dotProductStereo(a, l - radius + 1, r - radius + 1, row, taps);
+				simd::dotProductStereo(b, l - radius + 1, r - radius + 1, row + taps, taps);
+				outL = a[0] + t * (b[0] - a[0]);
+				outR = a[1] + t * (b[1] - a[1]);
+			});
+			break;
+		}
+
+		/* Decimating: the kernel is stretched by 1/scale, so it must be computed
+		for each fractional position. */
+
+		const float* table  = m_filter->table.data();
+		float*       coeffs = m_coeffs.data();
+		run([table, coeffs, scale, radius, taps](const float* l, const float* r, float frac, float& outL, float& outR)
+		{
+			float sum = 0.0f;
+			for (int tap = 0; tap < taps; tap++)
+			{
+				coeffs[tap] = lookup_(table, std::abs(tap - radius + 1 - frac) * scale);
+				sum += coeffs[tap];
+			}
+			float out[2];
+			simd::dotProductStereo(out, l - radius + 1, r - radius + 1, coeffs, taps);
+			outL = out[0] / sum;
+			outR = out[1] / sum;
+		});
+		break;
+	}
+	}
+
+	return rendered;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Resampler::Result Resampler::StereoResampler::process(const float* inputLeft, const float* inputRight,
+    std::size_t inputPos, std::size_t inputLength, float* outputLeft, float* outputRight,
+    std::size_t outputLength, float ratio) const
+{
+	assert(m_filter != nullptr); // Must be initialized first!
+
+	const float scale  = m_quality == Quality::BUILTIN_SINC ? std::clamp(1.0f / ratio, 1.0f / MAX_DECIMATION, 1.0f) : 1.0f;
+	const int   radius = getRadius(scale);
+
+	Result result;
+	while (result.generated < outputLength)
+	{
+		/* Render as much as the history buffers allow. */
+
+		result.generated += render(outputLeft + result.generated, outputRight + result.generated,
+		    outputLength - result.generated, m_count - radius, ratio, scale, radius);
+		if (result.generated == outputLength)
+			break;
+
+		/* Refill the history buffers: the kernel would read past the last frame
+		otherwise. Read only what the remaining output frames need, so that 'used'
+		follows the playback position closely, as with libsamplerate. */
+
+		compact();
+		if (inputPos < inputLength)
+		{
+			const double      lastPosition = m_position + (outputLength - result.generated - 1) * static_cast<double>(ratio);
+			const std::size_t needed       = static_cast<std::size_t>(lastPosition) + radius + 1 - m_count;
+			const std::size_t frames       = std::min({inputLength - inputPos, CAPACITY - m_count, needed});
+			std::copy_n(inputLeft + inputPos, frames, m_left.begin() + m_count);
+			std::copy_n(inputRight + inputPos, frames, m_right.begin() + m_count);
+			m_count += frames;
+			inputPos += frames;
+			result.used += frames;
+			continue;
+		}
+
+		/* Input is over: pad with silence and render until the last input frame,
+		the same flush libsamplerate does at the end of input. */
+
+		std::fill_n(m_left.begin() + m_count, radius, 0.0f);
+		std::fill_n(m_right.begin() + m_count, radius, 0.0f);
+		result.generated += render(outputLeft + result.generated, outputRight + result.generated,
+		    outputLength - result.generated, m_count, ratio, scale, radius);
+		break;
+	}
+
+	return result;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Resampler::StereoResampler::last() const
+{
+	/* Start over with MAX_RADIUS frames of silence behind the first input
+	frame. */
+
+	std::fill_n(m_left.begin(), MAX_RADIUS, 0.0f);
+	std::fill_n(m_right.begin(), MAX_RADIUS, 0.0f);
+	m_count    = MAX_RADIUS;
+	m_position = MAX_RADIUS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Resampler::StereoResampler::prime(const float* left, const float* right, std::size_t before, std::size_t frames) const
+{
+	last();
+
+	/* Replace the initial silence with the frames before, if any. */
+
+	const std::size_t past = std::min<std::size_t>(before, MAX_RADIUS);
+
+	assert(m_count + frames <= CAPACITY);
+
+	std::copy_n(left - past, past + frames, m_left.begin() + m_count - past);
+	std::copy_n(right - past, past + frames, m_right.begin() + m_count - past);
+	m_count += frames;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool Resampler::isBuiltin(Quality quality)
+{
+	return quality == Quality::BUILTIN_SINC ||
+	       quality == Quality::BUILTIN_CUBIC ||
+	       quality == Quality::BUILTIN_LINEAR;
+}
+
 /* -------------------------------------------------------------------------- */
 
 Resampler::Resampler()
+: m_quality(Quality::SINC_BEST)
+, m_hasFallback(false)
+, m_usingFallback(false)
+, m_wantFallback(false)
+, m_lag(0.0)
 {
 }
 
@@ -148,8 +505,91 @@ Resampler::Resampler()
 Resampler::Resampler(Quality quality)
 : Resampler()
 {
-	m_left.alloc(quality);
-	m_right.alloc(quality);
+	m_quality = quality;
+	if (isBuiltin(quality))
+	{
+		m_stereo.alloc(quality);
+	}
+	else
+	{
+		m_left.alloc(quality);
+		m_right.alloc(quality);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Resampler::Resampler(Quality quality, std::optional<Quality> fallback)
+: Resampler(quality)
+{
+	if (!fallback)
+		return;
+	assert(isBuiltin(*fallback));
+	m_fallback.alloc(*fallback);
+	m_hasFallback = true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Resampler::Result Resampler::processWith(bool fallback, const float* inputLeft, const float* inputRight,
+    std::size_t inputPos, std::size_t inputLength, float* outputLeft, float* outputRight,
+    std::size_t outputLength, float ratio) const
+{
+	if (fallback)
+		return m_fallback.process(inputLeft, inputRight, inputPos, inputLength, outputLeft, outputRight, outputLength, ratio);
+
+	if (isBuiltin(m_quality))
+		return m_stereo.process(inputLeft, inputRight, inputPos, inputLength, outputLeft, outputRight, outputLength, ratio);
+
+	const Result left  = m_left.process(inputLeft, inputPos, inputLength, outputLeft, outputLength, ratio);
+	const Result right = m_right.process(inputRight, inputPos, inputLength, outputRight, outputLength, ratio);
+
+	return {
+	    .used      = std::min(left.used, right.used),
+	    .generated = std::min(left.generated, right.generated)};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Resampler::resetWith(bool fallback) const
+{
+	if (fallback)
+	{
+		m_fallback.last();
+		return;
+	}
+	if (isBuiltin(m_quality))
+	{
+		m_stereo.last();
+		return;
+	}
+	m_left.last();
+	m_right.last();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Resampler::Result Resampler::restartWith(bool fallback, const float* inputLeft, const float* inputRight,
+    std::size_t inputPos, std::size_t rewind, std::size_t inputLength, float* outputLeft, float* outputRight,
+    std::size_t outputLength, float ratio) const
+{
+	assert(rewind <= inputPos);
+
+	if (fallback || isBuiltin(m_quality))
+	{
+		const StereoResampler& stereo = fallback ? m_fallback : m_stereo;
+		stereo.prime(inputLeft + inputPos - rewind, inputRight + inputPos - rewind, inputPos - rewind, rewind);
+		return stereo.process(inputLeft, inputRight, inputPos, inputLength, outputLeft, outputRight, outputLength, ratio);
+	}
+
+	/* libsamplerate can't be primed: feed it the rewound frames too. It reads
+	input in chunks, so it always consumes at least 'rewind' frames. */
+
+	resetWith(false);
+	Result result = processWith(false, inputLeft, inputRight, inputPos - rewind, inputLength, outputLeft,
+	    outputRight, outputLength, ratio);
+	result.used = result.used > rewind ? result.used - rewind : 0;
+	return result;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -174,19 +614,64 @@ Resampler::Result Resampler::process(
 	float*            outputRightPtr = output.getChannelView(1, outputStart).data();
 	const std::size_t outputLength   = static_cast<std::size_t>(output.countFrames()) - outputStart;
 
-	const Result left  = m_left.process(inputLeftPtr, inputStart, inputEnd, outputLeftPtr, outputLength, ratio);
-	const Result right = m_right.process(inputRightPtr, inputStart, inputEnd, outputRightPtr, outputLength, ratio);
-
-	return {
-	    .used      = std::min(left.used, right.used),
-	    .generated = std::min(left.generated, right.generated)};
+	if (m_usingFallback == m_wantFallback)
+	{
+		const Result result = processWith(m_usingFallback, inputLeftPtr, inputRightPtr, inputStart, inputEnd,
+		    outputLeftPtr, outputRightPtr, outputLength, ratio);
+		m_lag = std::max(0.0, m_lag + result.used - result.generated * static_cast<double>(ratio));
+		return result;
+	}
+
+	/* Switching quality. The old engine renders the first FADE_FRAMES frames
+	into the scratch buffers, without consuming input for real. The new one
+	starts over from where the old one is playing, i.e. 'm_lag' frames behind
+	the input position, and renders the whole block, fading in while the old one
+	fades out. */
+
+	const std::size_t fadeLength = std::min<std::size_t>(outputLength, FADE_FRAMES);
+	const Result      old        = processWith(m_usingFallback, inputLeftPtr, inputRightPtr, inputStart, inputEnd,
+	                m_fadeLeft.data(), m_fadeRight.data(), fadeLength, ratio);
+
+	m_usingFallback = m_wantFallback;
+
+	const std::size_t rewind = std::min({static_cast<std::size_t>(std::lround(m_lag)), inputStart, MAX_REWIND});
+	const Result      result = restartWith(m_usingFallback, inputLeftPtr, inputRightPtr, inputStart, rewind, inputEnd,
+	         outputLeftPtr, outputRightPtr, outputLength, ratio);
+
+	m_lag = std::max(0.0, rewind + result.used - result.generated * static_cast<double>(ratio));
+
+	const int fade = static_cast<int>(std::min({fadeLength, old.generated, result.generated}));
+	simd::applyGainRamp(outputLeftPtr, fade, 0.0f, 1.0f);
+	simd::applyGainRamp(outputRightPtr, fade, 0.0f, 1.0f);
+	simd::applyGainRamp(m_fadeLeft.data(), fade, 1.0f, 0.0f);
+	simd::applyGainRamp(m_fadeRight.data(), fade, 1.0f, 0.0f);
+	simd::sum(outputLeftPtr, m_fadeLeft.data(), fade, 1.0f);
+	simd::sum(outputRightPtr, m_fadeRight.data(), fade, 1.0f);
+
+	return result;
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Resampler::last() const
 {
-	m_left.last();
-	m_right.last();
+	m_lag = 0.0;
+	resetWith(false);
+	if (m_hasFallback)
+		resetWith(true);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Resampler::setFallback(bool fallback) const
+{
+	m_wantFallback = fallback && m_hasFallback;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Resampler::isUsingFallback() const
+{
+	return m_usingFallback;
 }
 } // namespace giada::m
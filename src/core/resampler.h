@@ -27,8 +27,11 @@
 #ifndef G_RESAMPLER_H
 #define G_RESAMPLER_H
 
+#include <array>
 #include <cstddef>
+#include <optional>
 #include <samplerate.h>
+#include <vector>
 
 namespace mcl
 {
@@ -46,9 +49,18 @@ public:
 		SINC_MEDIUM     = 1,
 		SINC_FASTEST    = 2,
 		ZERO_ORDER_HOLD = 3,
-		LINEAR          = 4
+		LINEAR          = 4,
+		BUILTIN_SINC    = 5,
+		BUILTIN_CUBIC   = 6,
+		BUILTIN_LINEAR  = 7
 	};
 
+	/* isBuiltin
+	True if the quality is provided by the built-in stereo resampler, false if
+	it is provided by libsamplerate. */
+
+	static bool isBuiltin(Quality);
+
 	/* Result
 	A Result object is returned by the process() function below, containing the
 	number of frames used from input and generated to output. */
@@ -61,6 +73,13 @@ public:
 
 	Resampler(); // Invalid
 	Resampler(Quality quality);
+
+	/* Resampler (2)
+	Also prepares a cheaper 'fallback' quality, to switch to with setFallback().
+	The fallback must be a built-in quality. */
+
+	Resampler(Quality quality, std::optional<Quality> fallback);
+
 	Resampler(const Resampler& o)          = delete;
 	Resampler(Resampler&&)                 = delete;
 	Resampler& operator=(const Resampler&) = delete;
@@ -83,6 +102,15 @@ public:
 
 	void last() const;
 
+	/* setFallback
+	Moves to the fallback quality, or back to the main one. The switch happens on
+	the next process() call, with a short crossfade between the two. Does nothing
+	if there is no fallback quality. Real-time thread only. */
+
+	void setFallback(bool) const;
+
+	bool isUsingFallback() const;
+
 private:
 	/* MonoResampler
 	A thin *mono* wrapper around libsamplerate. This class resamples a single
@@ -130,16 +158,148 @@ private:
 
 		static constexpr int CHUNK_LEN = 256;
 
-		SRC_STATE*          m_state;
-		Quality             m_quality;
-		mutable float*      m_input;       // Pointer to input data
-		mutable std::size_t m_inputPos;    // Where to read from input
-		mutable std::size_t m_inputLength; // Total number of frames in input data
-		mutable std::size_t m_usedFrames;  // How many frames have been read from input with a process() call
+		SRC_STATE*                   m_state;
+		Quality                      m_quality;
+		std::array<float, CHUNK_LEN> m_chunk;       // Input data handed to libsamplerate
+		mutable float*               m_input;       // Pointer to input data
+		mutable std::size_t          m_inputPos;    // Where to read from input
+		mutable std::size_t          m_inputLength; // Total number of frames in input data
+		mutable std::size_t          m_usedFrames;  // How many frames have been read from input with a process() call
+	};
+
+	/* StereoResampler
+	Built-in resampler that works on both channels at once: the filter kernel is
+	computed once per output frame and applied to the left and right channels in
+	a single SIMD pass. Input frames are copied into a fixed-size history buffer,
+	so nothing is allocated after construction. Provides windowed-sinc
+	(polyphase), cubic (Catmull-Rom) and linear interpolation. */
+
+	class StereoResampler
+	{
+	public:
+		StereoResampler(); // Invalid
+		StereoResampler(const StereoResampler& o)            = delete;
+		StereoResampler(StereoResampler&&)                   = delete;
+		StereoResampler& operator=(const StereoResampler& o) = delete;
+		StereoResampler& operator=(StereoResampler&&)        = delete;
+
+		/* process
+		Same as MonoResampler::process(), for a pair of channels. */
+
+		Result process(
+		    const float* inputLeft,
+		    const float* inputRight,
+		    std::size_t  inputPos,
+		    std::size_t  inputLength,
+		    float*       outputLeft,
+		    float*       outputRight,
+		    std::size_t  outputLength,
+		    float        ratio) const;
+
+		/* last
+		Call this when you are about to process the last chunk of data. */
+
+		void last() const;
+
+		/* prime
+		Starts over like last(), with 'frames' frames from 'left' and 'right'
+		already in the history buffers: the next output frame is the first of them.
+		Up to 'before' frames preceding it are read too, to feed the kernel. */
+
+		void prime(const float* left, const float* right, std::size_t before, std::size_t frames) const;
+
+		void alloc(Quality quality);
+
+	private:
+		/* Filter
+		Windowed-sinc kernel, shared by all instances. 'table' contains one side of
+		the kernel, sampled TABLE_RES times per frame. 'bank' contains the same
+		kernel split into PHASES + 1 fractional positions, ready to be applied to
+		ZEROS * 2 input frames. */
+
+		struct Filter
+		{
+			std::vector<float> table;
+			std::vector<float> bank;
+		};
+
+		/* ZEROS
+		Half-width of the sinc kernel, in input frames. */
+
+		static constexpr int ZEROS = 24;
+
+		/* MAX_DECIMATION
+		When pitching up (ratio > 1) the kernel is stretched by the ratio to move
+		its cutoff below the new Nyquist frequency. Past this ratio the kernel stops
+		growing and some aliasing is let through. */
+
+		static constexpr int MAX_DECIMATION = 8;
+		static constexpr int MAX_RADIUS     = ZEROS * MAX_DECIMATION;
+
+		/* CAPACITY
+		Size of the history buffer, in frames. */
+
+		static constexpr int CAPACITY = 4096;
+
+		static const Filter& getFilter();
+
+		int  getRadius(float scale) const;
+		void compact() const;
+
+		/* render
+		Renders up to 'frames' frames, stopping before the kernel center reaches
+		'limit' in the history buffers. Returns the number of frames rendered. */
+
+		std::size_t render(float* left, float* right, std::size_t frames, std::size_t limit,
+		    float ratio, float scale, int radius) const;
+
+		Quality                                   m_quality;
+		const Filter*                             m_filter;
+		mutable std::array<float, CAPACITY>       m_left;     // History of the left channel
+		mutable std::array<float, CAPACITY>       m_right;    // History of the right channel
+		mutable std::array<float, MAX_RADIUS * 2> m_coeffs;   // Kernel computed on the fly when pitching up
+		mutable std::size_t                       m_count;    // Number of frames in the history buffers
+		mutable double                            m_position; // Position of the next output frame in the history buffers
 	};
 
-	MonoResampler m_left;
-	MonoResampler m_right;
+	/* FADE_FRAMES
+	Length of the crossfade when switching to or from the fallback quality. */
+
+	static constexpr int FADE_FRAMES = 256;
+
+	/* MAX_REWIND
+	Max number of frames an engine can start behind the input position when
+	switching quality. Must fit in the StereoResampler history buffers. */
+
+	static constexpr std::size_t MAX_REWIND = 2048;
+
+	/* processWith, resetWith
+	Run or reset the fallback engine ('fallback' == true) or the main one. */
+
+	Result processWith(bool fallback, const float* inputLeft, const float* inputRight, std::size_t inputPos,
+	    std::size_t inputLength, float* outputLeft, float* outputRight, std::size_t outputLength, float ratio) const;
+	void   resetWith(bool fallback) const;
+
+	/* restartWith
+	Resets an engine and makes it play from 'rewind' frames before 'inputPos',
+	i.e. from where the other engine is playing. The rewound frames are not
+	accounted in the 'used' value of the result. */
+
+	Result restartWith(bool fallback, const float* inputLeft, const float* inputRight, std::size_t inputPos,
+	    std::size_t rewind, std::size_t inputLength, float* outputLeft, float* outputRight,
+	    std::size_t outputLength, float ratio) const;
+
+	Quality                                     m_quality;
+	bool                                        m_hasFallback;
+	MonoResampler                               m_left;
+	MonoResampler                               m_right;
+	StereoResampler                             m_stereo;
+	StereoResampler                             m_fallback;
+	mutable bool                                m_usingFallback; // Engine in use
+	mutable bool                                m_wantFallback;  // Engine requested with setFallback()
+	mutable double                              m_lag;           // Input frames read but not played yet
+	mutable std::array<float, FADE_FRAMES>      m_fadeLeft;      // Output of the old engine while crossfading
+	mutable std::array<float, FADE_FRAMES>      m_fadeRight;
 };
 } // namespace giada::m
 
@@ -0,0 +1,117 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "src/core/rtEpoch.h"
+#include "src/core/const.h"
+#include <chrono>
+#include <thread>
+
+namespace giada
+{
+RtEpoch::Guard::Guard(const RtEpoch& e)
+: m_epoch(e)
+, m_entered(e.enter())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+RtEpoch::Guard::~Guard()
+{
+	m_epoch.leave(m_entered);
+}
+
+/* -------------------------------------------------------------------------- */
+
+RtEpoch::RtEpoch()
+: m_readers{0, 0}
+, m_epoch(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RtEpoch::isInside() const
+{
+	return m_readers[0].load() > 0 || m_readers[1].load() > 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint32_t RtEpoch::enter() const
+{
+	/* Sequentially consistent, as every operation here. If synchronize() starts
+	a new epoch between the two lines below, it either sees this section as a
+	reader of the old epoch and waits for it, or this section sees the data
+	published before it. */
+
+	const uint32_t epoch = m_epoch.load();
+	getReaders(epoch).fetch_add(1);
+	return epoch;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RtEpoch::leave(uint32_t epoch) const
+{
+	getReaders(epoch).fetch_sub(1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RtEpoch::synchronize()
+{
+	if (!isInside())
+		return;
+
+	std::scoped_lock lock(m_mutex);
+
+	/* Start a new epoch and wait for the readers of the old one, twice. New
+	sections count as readers of the new epoch, so each wait is bounded. Two
+	rounds because a section may have read the epoch before a previous call to
+	synchronize() and registered itself only afterwards, in the other counter. */
+
+	waitReaders(m_epoch.fetch_add(1));
+	waitReaders(m_epoch.fetch_add(1));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RtEpoch::waitReaders(uint32_t epoch) const
+{
+	const std::atomic<uint32_t>& readers = getReaders(epoch);
+
+	while (readers.load() > 0)
+		std::this_thread::sleep_for(std::chrono::microseconds(G_RT_EPOCH_POLL_US));
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::atomic<uint32_t>& RtEpoch::getReaders(uint32_t epoch) const
+{
+	return m_readers[epoch % 2];
+}
+} // namespace giada
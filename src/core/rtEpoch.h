@@ -0,0 +1,113 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RT_EPOCH_H
+#define G_RT_EPOCH_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace giada
+{
+/* RtEpoch
+Handshake between the realtime thread and non-realtime ones. The realtime
+thread marks the beginning and the end of the sections where it reads shared
+data with enter() and leave(): both are lock-free and never block. Non-realtime
+threads call synchronize() to wait for a grace period, i.e. for the sections in
+progress, if any, to end. Waiting is done by polling with a short sleep: waking
+the waiters up from leave() would cost a system call on the realtime thread.
+Sections are counted per epoch: synchronize() starts a new epoch and waits for
+the readers of the previous ones only, so it can't be starved by a busy realtime
+thread. Sections may overlap (e.g. offline rendering while the audio thread
+is still running). */
+
+class RtEpoch
+{
+public:
+	/* Guard
+	Scoped enter()/leave() for the realtime thread. */
+
+	class Guard
+	{
+	public:
+		Guard(const RtEpoch&);
+		Guard(const Guard&)            = delete;
+		Guard& operator=(const Guard&) = delete;
+		~Guard();
+
+	private:
+		const RtEpoch& m_epoch;
+		uint32_t       m_entered;
+	};
+
+	RtEpoch();
+
+	/* isInside
+	True if some thread is within a section. */
+
+	bool isInside() const;
+
+	/* enter
+	Begins a section. Returns the epoch to pass to leave(). REALTIME safe. */
+
+	uint32_t enter() const;
+
+	/* leave
+	Ends a section begun in the given epoch. REALTIME safe: no system calls. */
+
+	void leave(uint32_t epoch) const;
+
+	/* synchronize
+	Blocks until all the sections in progress, if any, have ended. Data published
+	before calling this is seen by all subsequent sections. Returns immediately
+	if nobody is within a section. NON-REALTIME only. */
+
+	void synchronize();
+
+private:
+	/* waitReaders
+	Sleeps until no section of the given epoch is in progress. */
+
+	void waitReaders(uint32_t epoch) const;
+
+	std::atomic<uint32_t>& getReaders(uint32_t epoch) const;
+
+	/* m_readers
+	Number of threads within a section, for odd and even epochs. */
+
+	mutable std::array<std::atomic<uint32_t>, 2> m_readers;
+	std::atomic<uint32_t>                        m_epoch;
+
+	/* m_mutex
+	Serializes calls to synchronize(). */
+
+	std::mutex m_mutex;
+};
+} // namespace giada
+
+#endif
@@ -164,6 +164,20 @@ float Sequencer::calcBpmFromRec(Frame recordedFrames) const
 
 /* -------------------------------------------------------------------------- */
 
+Sequencer::State Sequencer::getState() const
+{
+	const model::Sequencer& sequencer = m_model.get().sequencer;
+
+	return {
+	    .status       = sequencer.status,
+	    .currentFrame = sequencer.a_getCurrentFrame(),
+	    .currentScene = sequencer.a_getCurrentScene(),
+	    .nextScene    = sequencer.a_getNextScene(),
+	    .sceneStatus  = sequencer.a_getSceneStatus()};
+}
+
+/* -------------------------------------------------------------------------- */
+
 Tick Sequencer::quantize(Tick t) const
 {
 	namespace math = mcl::utils::math;
@@ -448,6 +462,20 @@ void Sequencer::setStatus(SeqStatus s)
 
 /* -------------------------------------------------------------------------- */
 
+void Sequencer::setState(const State& state, int sampleRate)
+{
+	model::Sequencer& sequencer = m_model.get().sequencer;
+
+	sequencer.status = state.status;
+	sequencer.a_setCurrentFrame(state.currentFrame, sampleRate);
+	sequencer.a_setCurrentScene(state.currentScene);
+	sequencer.a_setNextScene(state.nextScene);
+	sequencer.a_setSceneStatus(state.sceneStatus);
+	m_model.swap(model::SwapType::NONE);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Sequencer::goToBeat(int beat, int sampleRate)
 {
 	const float bpm   = m_model.get().sequencer.getBpm();
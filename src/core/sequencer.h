@@ -76,6 +76,19 @@ public:
 
 	using EventBuffer = RingBuffer<Event, G_MAX_SEQUENCER_EVENTS>;
 
+	/* State
+	Status, position and scenes of the sequencer, as saved and restored around
+	offline rendering. */
+
+	struct State
+	{
+		SeqStatus   status       = SeqStatus::STOPPED;
+		Frame       currentFrame = 0;
+		Scene       currentScene = {};
+		Scene       nextScene    = {};
+		SceneStatus sceneStatus  = SceneStatus::IDLE;
+	};
+
 	Sequencer(model::Model&, MidiSynchronizer&, JackTransport&);
 
 	/* canQuantize
@@ -127,6 +140,11 @@ public:
 
 	float calcBpmFromRec(Frame recordedFrames) const;
 
+	/* getState
+	Returns the current status, position and scenes. */
+
+	State getState() const;
+
 	/* quantize
 	Quantizes the tick in input. */
 
@@ -173,6 +191,13 @@ public:
 
 	void setScene(Scene, bool forced);
 
+	/* setState
+	Sets status, position and scenes at once, without the side effects of
+	setStatus() and setScene() (MIDI clock, JACK transport, quantizer). Used
+	around offline rendering, when nobody else is listening. */
+
+	void setState(const State&, int sampleRate);
+
 #ifdef WITH_AUDIO_JACK
 	void jack_start();
 	void jack_stop();
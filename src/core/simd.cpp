@@ -0,0 +1,783 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/simd.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define G_SIMD_SSE2 1
+#define G_SIMD_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define G_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* G_TARGET_AVX2
+AVX2 kernels are compiled for AVX2 regardless of the global compiler flags, and
+only called if the CPU supports it. MSVC doesn't need any special attribute. */
+
+#if defined(G_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define G_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define G_TARGET_AVX2
+#endif
+
+namespace giada::m::simd
+{
+namespace
+{
+struct Kernels
+{
+	void (*sum)(float*, const float*, int, float);
+	void (*sumRamp)(float*, const float*, int, float, float);
+	void (*applyGain)(float*, int, float);
+	void (*applyGainRamp)(float*, int, float, float);
+	void (*clamp)(float*, int, float, float);
+	float (*getPeak)(const float*, int);
+	void (*int16ToFloat)(float*, const std::int16_t*, int);
+	void (*halfToFloat)(float*, const std::uint16_t*, int);
+	void (*dotProductStereo)(float*, const float*, const float*, const float*, int);
+};
+
+/* Half to float conversion: exponent and mantissa bits of a half are moved in
+place into a float, whose exponent is then re-biased by multiplying it by
+2^(127 - 15). This handles zeros and subnormals too, without branches. The sign
+bit is put back last. */
+
+constexpr float         INT16_SCALE = 1.0f / 32768.0f;
+constexpr float         HALF_SCALE  = 0x1p112f;
+constexpr std::uint32_t HALF_SIGN   = 0x8000;
+constexpr std::uint32_t HALF_BODY   = 0x7FFF;
+constexpr int           HALF_SHIFT  = 13; // Mantissa bits: float (23) - half (10)
+
+/* -------------------------------------------------------------------------- */
+
+namespace scalar
+{
+void sum(float* dest, const float* src, int count, float gain)
+{
+	for (int i = 0; i < count; i++)
+		dest[i] += src[i] * gain;
+}
+
+void sumRamp(float* dest, const float* src, int count, float gainStart, float gainEnd)
+{
+	const float step = (gainEnd - gainStart) / count;
+	for (int i = 0; i < count; i++)
+		dest[i] += src[i] * (gainStart + step * i);
+}
+
+void applyGain(float* buf, int count, float gain)
+{
+	for (int i = 0; i < count; i++)
+		buf[i] *= gain;
+}
+
+void applyGainRamp(float* buf, int count, float gainStart, float gainEnd)
+{
+	const float step = (gainEnd - gainStart) / count;
+	for (int i = 0; i < count; i++)
+		buf[i] *= gainStart + step * i;
+}
+
+void clamp(float* buf, int count, float min, float max)
+{
+	for (int i = 0; i < count; i++)
+		buf[i] = std::max(min, std::min(buf[i], max));
+}
+
+float getPeak(const float* buf, int count)
+{
+	float peak = 0.0f;
+	for (int i = 0; i < count; i++)
+		peak = std::max(peak, std::fabs(buf[i]));
+	return peak;
+}
+
+void int16ToFloat(float* dest, const std::int16_t* src, int count)
+{
+	for (int i = 0; i < count; i++)
+		dest[i] = src[i] * INT16_SCALE;
+}
+
+void halfToFloat(float* dest, const std::uint16_t* src, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		const std::uint32_t h = src[i];
+		const float         f = std::bit_cast<float>((h & HALF_BODY) << HALF_SHIFT) * HALF_SCALE;
+		dest[i]               = std::bit_cast<float>(std::bit_cast<std::uint32_t>(f) | (h & HALF_SIGN) << 16);
+	}
+}
+
+void dotProductStereo(float* out, const float* left, const float* right, const float* coeffs, int count)
+{
+	float l = 0.0f;
+	float r = 0.0f;
+	for (int i = 0; i < count; i++)
+	{
+		l += left[i] * coeffs[i];
+		r += right[i] * coeffs[i];
+	}
+	out[0] = l;
+	out[1] = r;
+}
+
+constexpr Kernels kernels = {sum, sumRamp, applyGain, applyGainRamp, clamp, getPeak, int16ToFloat, halfToFloat, dotProductStereo};
+} // namespace scalar
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_SIMD_SSE2
+namespace sse2
+{
+constexpr int WIDTH = 4;
+
+void sum(float* dest, const float* src, int count, float gain)
+{
+	const __m128 g = _mm_set1_ps(gain);
+	int          i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+	scalar::sum(dest + i, src + i, count - i, gain);
+}
+
+void sumRamp(float* dest, const float* src, int count, float gainStart, float gainEnd)
+{
+	const float  step  = (gainEnd - gainStart) / count;
+	const __m128 steps = _mm_mul_ps(_mm_set1_ps(step), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+	int          i     = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m128 g = _mm_add_ps(_mm_set1_ps(gainStart + step * i), steps);
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+	}
+	for (; i < count; i++)
+		dest[i] += src[i] * (gainStart + step * i);
+}
+
+void applyGain(float* buf, int count, float gain)
+{
+	const __m128 g = _mm_set1_ps(gain);
+	int          i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		_mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), g));
+	scalar::applyGain(buf + i, count - i, gain);
+}
+
+void applyGainRamp(float* buf, int count, float gainStart, float gainEnd)
+{
+	const float  step  = (gainEnd - gainStart) / count;
+	const __m128 steps = _mm_mul_ps(_mm_set1_ps(step), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+	int          i     = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m128 g = _mm_add_ps(_mm_set1_ps(gainStart + step * i), steps);
+		_mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), g));
+	}
+	for (; i < count; i++)
+		buf[i] *= gainStart + step * i;
+}
+
+void clamp(float* buf, int count, float min, float max)
+{
+	const __m128 lo = _mm_set1_ps(min);
+	const __m128 hi = _mm_set1_ps(max);
+	int          i  = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		_mm_storeu_ps(buf + i, _mm_max_ps(lo, _mm_min_ps(_mm_loadu_ps(buf + i), hi)));
+	scalar::clamp(buf + i, count - i, min, max);
+}
+
+float getPeak(const float* buf, int count)
+{
+	const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128       peak = _mm_setzero_ps();
+	int          i    = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		peak = _mm_max_ps(peak, _mm_and_ps(_mm_loadu_ps(buf + i), mask));
+
+	alignas(16) float lanes[WIDTH];
+	_mm_store_ps(lanes, peak);
+	const float result = std::max({lanes[0], lanes[1], lanes[2], lanes[3]});
+	return std::max(result, scalar::getPeak(buf + i, count - i));
+}
+
+/* halfToFloat_
+Converts four halves, zero-extended to 32 bits. */
+
+__m128 halfToFloat_(__m128i h)
+{
+	const __m128i body = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(HALF_BODY)), HALF_SHIFT);
+	const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(HALF_SIGN)), 16);
+	const __m128  f    = _mm_mul_ps(_mm_castsi128_ps(body), _mm_set1_ps(HALF_SCALE));
+	return _mm_or_ps(f, _mm_castsi128_ps(sign));
+}
+
+void int16ToFloat(float* dest, const std::int16_t* src, int count)
+{
+	const __m128 scale = _mm_set1_ps(INT16_SCALE);
+	int          i     = 0;
+	for (; i + WIDTH * 2 <= count; i += WIDTH * 2)
+	{
+		/* Interleaving a vector with itself and shifting right by 16 sign-extends
+		each 16-bit value to 32 bits. */
+
+		const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+		const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+		_mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+		_mm_storeu_ps(dest + i + WIDTH, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+	}
+	scalar::int16ToFloat(dest + i, src + i, count - i);
+}
+
+void halfToFloat(float* dest, const std::uint16_t* src, int count)
+{
+	const __m128i zero = _mm_setzero_si128();
+	int           i    = 0;
+	for (; i + WIDTH * 2 <= count; i += WIDTH * 2)
+	{
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm_storeu_ps(dest + i, halfToFloat_(_mm_unpacklo_epi16(v, zero)));
+		_mm_storeu_ps(dest + i + WIDTH, halfToFloat_(_mm_unpackhi_epi16(v, zero)));
+	}
+	scalar::halfToFloat(dest + i, src + i, count - i);
+}
+
+/* horizontalSum_
+Adds up the four lanes of a register. */
+
+float horizontalSum_(__m128 v)
+{
+	const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+	return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+void dotProductStereo(float* out, const float* left, const float* right, const float* coeffs, int count)
+{
+	__m128 l = _mm_setzero_ps();
+	__m128 r = _mm_setzero_ps();
+	int    i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m128 c = _mm_loadu_ps(coeffs + i);
+		l              = _mm_add_ps(l, _mm_mul_ps(_mm_loadu_ps(left + i), c));
+		r              = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(right + i), c));
+	}
+	float tail[2];
+	scalar::dotProductStereo(tail, left + i, right + i, coeffs + i, count - i);
+	out[0] = horizontalSum_(l) + tail[0];
+	out[1] = horizontalSum_(r) + tail[1];
+}
+
+constexpr Kernels kernels = {sum, sumRamp, applyGain, applyGainRamp, clamp, getPeak, int16ToFloat, halfToFloat, dotProductStereo};
+} // namespace sse2
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_SIMD_AVX2
+namespace avx2
+{
+constexpr int WIDTH = 8;
+
+G_TARGET_AVX2 void sum(float* dest, const float* src, int count, float gain)
+{
+	const __m256 g = _mm256_set1_ps(gain);
+	int          i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		_mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+	scalar::sum(dest + i, src + i, count - i, gain);
+}
+
+G_TARGET_AVX2 void sumRamp(float* dest, const float* src, int count, float gainStart, float gainEnd)
+{
+	const float  step  = (gainEnd - gainStart) / count;
+	const __m256 steps = _mm256_mul_ps(_mm256_set1_ps(step), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+	int          i     = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m256 g = _mm256_add_ps(_mm256_set1_ps(gainStart + step * i), steps);
+		_mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+	}
+	for (; i < count; i++)
+		dest[i] += src[i] * (gainStart + step * i);
+}
+
+G_TARGET_AVX2 void applyGain(float* buf, int count, float gain)
+{
+	const __m256 g = _mm256_set1_ps(gain);
+	int          i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		_mm256_storeu_ps(buf + i, _mm256_mul_ps(_mm256_loadu_ps(buf + i), g));
+	scalar::applyGain(buf + i, count - i, gain);
+}
+
+G_TARGET_AVX2 void applyGainRamp(float* buf, int count, float gainStart, float gainEnd)
+{
+	const float  step  = (gainEnd - gainStart) / count;
+	const __m256 steps = _mm256_mul_ps(_mm256_set1_ps(step), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+	int          i     = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m256 g = _mm256_add_ps(_mm256_set1_ps(gainStart + step * i), steps);
+		_mm256_storeu_ps(buf + i, _mm256_mul_ps(_mm256_loadu_ps(buf + i), g));
+	}
+	for (; i < count; i++)
+		buf[i] *= gainStart + step * i;
+}
+
+G_TARGET_AVX2 void clamp(float* buf, int count, float min, float max)
+{
+	const __m256 lo = _mm256_set1_ps(min);
+	const __m256 hi = _mm256_set1_ps(max);
+	int          i  = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		_mm256_storeu_ps(buf + i, _mm256_max_ps(lo, _mm256_min_ps(_mm256_loadu_ps(buf + i), hi)));
+	scalar::clamp(buf + i, count - i, min, max);
+}
+
+G_TARGET_AVX2 float getPeak(const float* buf, int count)
+{
+	const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	__m256       peak = _mm256_setzero_ps();
+	int          i    = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		peak = _mm256_max_ps(peak, _mm256_and_ps(_mm256_loadu_ps(buf + i), mask));
+
+	alignas(32) float lanes[WIDTH];
+	_mm256_store_ps(lanes, peak);
+	const float result = *std::max_element(lanes, lanes + WIDTH);
+	return std::max(result, scalar::getPeak(buf + i, count - i));
+}
+
+G_TARGET_AVX2 void int16ToFloat(float* dest, const std::int16_t* src, int count)
+{
+	const __m256 scale = _mm256_set1_ps(INT16_SCALE);
+	int          i     = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+		_mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+	}
+	scalar::int16ToFloat(dest + i, src + i, count - i);
+}
+
+G_TARGET_AVX2 void halfToFloat(float* dest, const std::uint16_t* src, int count)
+{
+	const __m256i bodyMask = _mm256_set1_epi32(HALF_BODY);
+	const __m256i signMask = _mm256_set1_epi32(HALF_SIGN);
+	const __m256  scale    = _mm256_set1_ps(HALF_SCALE);
+	int           i        = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m256i h    = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+		const __m256i body = _mm256_slli_epi32(_mm256_and_si256(h, bodyMask), HALF_SHIFT);
+		const __m256i sign = _mm256_slli_epi32(_mm256_and_si256(h, signMask), 16);
+		const __m256  f    = _mm256_mul_ps(_mm256_castsi256_ps(body), scale);
+		_mm256_storeu_ps(dest + i, _mm256_or_ps(f, _mm256_castsi256_ps(sign)));
+	}
+	scalar::halfToFloat(dest + i, src + i, count - i);
+}
+
+G_TARGET_AVX2 float horizontalSum_(__m256 v)
+{
+	return sse2::horizontalSum_(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+G_TARGET_AVX2 void dotProductStereo(float* out, const float* left, const float* right, const float* coeffs, int count)
+{
+	__m256 l = _mm256_setzero_ps();
+	__m256 r = _mm256_setzero_ps();
+	int    i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const __m256 c = _mm256_loadu_ps(coeffs + i);
+		l              = _mm256_add_ps(l, _mm256_mul_ps(_mm256_loadu_ps(left + i), c));
+		r              = _mm256_add_ps(r, _mm256_mul_ps(_mm256_loadu_ps(right + i), c));
+	}
+	float tail[2];
+	scalar::dotProductStereo(tail, left + i, right + i, coeffs + i, count - i);
+	out[0] = horizontalSum_(l) + tail[0];
+	out[1] = horizontalSum_(r) + tail[1];
+}
+
+constexpr Kernels kernels = {sum, sumRamp, applyGain, applyGainRamp, clamp, getPeak, int16ToFloat, halfToFloat, dotProductStereo};
+} // namespace avx2
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_SIMD_NEON
+namespace neon
+{
+constexpr int WIDTH = 4;
+
+void sum(float* dest, const float* src, int count, float gain)
+{
+	int i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		vst1q_f32(dest + i, vmlaq_n_f32(vld1q_f32(dest + i), vld1q_f32(src + i), gain));
+	scalar::sum(dest + i, src + i, count - i, gain);
+}
+
+void sumRamp(float* dest, const float* src, int count, float gainStart, float gainEnd)
+{
+	const float       step     = (gainEnd - gainStart) / count;
+	const float       lanes[4] = {0.0f, step, step * 2.0f, step * 3.0f};
+	const float32x4_t steps    = vld1q_f32(lanes);
+	int               i        = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const float32x4_t g = vaddq_f32(vdupq_n_f32(gainStart + step * i), steps);
+		vst1q_f32(dest + i, vmlaq_f32(vld1q_f32(dest + i), vld1q_f32(src + i), g));
+	}
+	for (; i < count; i++)
+		dest[i] += src[i] * (gainStart + step * i);
+}
+
+void applyGain(float* buf, int count, float gain)
+{
+	int i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		vst1q_f32(buf + i, vmulq_n_f32(vld1q_f32(buf + i), gain));
+	scalar::applyGain(buf + i, count - i, gain);
+}
+
+void applyGainRamp(float* buf, int count, float gainStart, float gainEnd)
+{
+	const float       step     = (gainEnd - gainStart) / count;
+	const float       lanes[4] = {0.0f, step, step * 2.0f, step * 3.0f};
+	const float32x4_t steps    = vld1q_f32(lanes);
+	int               i        = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const float32x4_t g = vaddq_f32(vdupq_n_f32(gainStart + step * i), steps);
+		vst1q_f32(buf + i, vmulq_f32(vld1q_f32(buf + i), g));
+	}
+	for (; i < count; i++)
+		buf[i] *= gainStart + step * i;
+}
+
+void clamp(float* buf, int count, float min, float max)
+{
+	const float32x4_t lo = vdupq_n_f32(min);
+	const float32x4_t hi = vdupq_n_f32(max);
+	int               i  = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		vst1q_f32(buf + i, vmaxq_f32(lo, vminq_f32(vld1q_f32(buf + i), hi)));
+	scalar::clamp(buf + i, count - i, min, max);
+}
+
+float getPeak(const float* buf, int count)
+{
+	float32x4_t peak = vdupq_n_f32(0.0f);
+	int         i    = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(buf + i)));
+
+	float lanes[WIDTH];
+	vst1q_f32(lanes, peak);
+	const float result = std::max({lanes[0], lanes[1], lanes[2], lanes[3]});
+	return std::max(result, scalar::getPeak(buf + i, count - i));
+}
+
+void int16ToFloat(float* dest, const std::int16_t* src, int count)
+{
+	int i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+		vst1q_f32(dest + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(src + i))), INT16_SCALE));
+	scalar::int16ToFloat(dest + i, src + i, count - i);
+}
+
+void halfToFloat(float* dest, const std::uint16_t* src, int count)
+{
+	const uint32x4_t bodyMask = vdupq_n_u32(HALF_BODY);
+	const uint32x4_t signMask = vdupq_n_u32(HALF_SIGN);
+	int              i        = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const uint32x4_t  h    = vmovl_u16(vld1_u16(src + i));
+		const uint32x4_t  body = vshlq_n_u32(vandq_u32(h, bodyMask), HALF_SHIFT);
+		const uint32x4_t  sign = vshlq_n_u32(vandq_u32(h, signMask), 16);
+		const float32x4_t f    = vmulq_n_f32(vreinterpretq_f32_u32(body), HALF_SCALE);
+		vst1q_f32(dest + i, vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(f), sign)));
+	}
+	scalar::halfToFloat(dest + i, src + i, count - i);
+}
+
+void dotProductStereo(float* out, const float* left, const float* right, const float* coeffs, int count)
+{
+	float32x4_t l = vdupq_n_f32(0.0f);
+	float32x4_t r = vdupq_n_f32(0.0f);
+	int         i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		const float32x4_t c = vld1q_f32(coeffs + i);
+		l                   = vmlaq_f32(l, vld1q_f32(left + i), c);
+		r                   = vmlaq_f32(r, vld1q_f32(right + i), c);
+	}
+	float lanesL[WIDTH], lanesR[WIDTH], tail[2];
+	vst1q_f32(lanesL, l);
+	vst1q_f32(lanesR, r);
+	scalar::dotProductStereo(tail, left + i, right + i, coeffs + i, count - i);
+	out[0] = lanesL[0] + lanesL[1] + lanesL[2] + lanesL[3] + tail[0];
+	out[1] = lanesR[0] + lanesR[1] + lanesR[2] + lanesR[3] + tail[1];
+}
+
+constexpr Kernels kernels = {sum, sumRamp, applyGain, applyGainRamp, clamp, getPeak, int16ToFloat, halfToFloat, dotProductStereo};
+} // namespace neon
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+/* hasAvx2_
+Runtime check for AVX2 support, OS support for the extended registers
+included. */
+
+#ifdef G_SIMD_AVX2
+bool hasAvx2_()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx     = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	/* The CPU model is filled in by a libgcc constructor, which might not have
+	run yet: this is called during static initialization. */
+
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+const Kernels& getKernels_(InstructionSet is)
+{
+	switch (is)
+	{
+#ifdef G_SIMD_SSE2
+	case InstructionSet::SSE2:
+		return sse2::kernels;
+#endif
+#ifdef G_SIMD_AVX2
+	case InstructionSet::AVX2:
+		return avx2::kernels;
+#endif
+#ifdef G_SIMD_NEON
+	case InstructionSet::NEON:
+		return neon::kernels;
+#endif
+	default:
+		return scalar::kernels;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+InstructionSet detect_()
+{
+#if defined(G_SIMD_AVX2)
+	return hasAvx2_() ? InstructionSet::AVX2 : InstructionSet::SSE2;
+#elif defined(G_SIMD_NEON)
+	return InstructionSet::NEON;
+#else
+	return InstructionSet::SCALAR;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+const InstructionSet        bestInstructionSet_ = detect_();
+std::atomic<InstructionSet> instructionSet_     = bestInstructionSet_;
+std::atomic<const Kernels*> kernels_            = &getKernels_(bestInstructionSet_);
+
+/* -------------------------------------------------------------------------- */
+
+const Kernels& kernels()
+{
+	return *kernels_.load(std::memory_order_relaxed);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+InstructionSet getBestInstructionSet()
+{
+	return bestInstructionSet_;
+}
+
+/* -------------------------------------------------------------------------- */
+
+InstructionSet getInstructionSet()
+{
+	return instructionSet_.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void setInstructionSet(InstructionSet is)
+{
+	if (!isSupported(is))
+		is = InstructionSet::SCALAR;
+	instructionSet_.store(is);
+	kernels_.store(&getKernels_(is));
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool isSupported(InstructionSet is)
+{
+	switch (is)
+	{
+	case InstructionSet::SCALAR:
+		return true;
+	case InstructionSet::SSE2:
+		return bestInstructionSet_ == InstructionSet::SSE2 || bestInstructionSet_ == InstructionSet::AVX2;
+	case InstructionSet::AVX2:
+		return bestInstructionSet_ == InstructionSet::AVX2;
+	case InstructionSet::NEON:
+		return bestInstructionSet_ == InstructionSet::NEON;
+	default:
+		return false;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::string toString(InstructionSet is)
+{
+	switch (is)
+	{
+	case InstructionSet::SSE2:
+		return "SSE2";
+	case InstructionSet::AVX2:
+		return "AVX2";
+	case InstructionSet::NEON:
+		return "NEON";
+	default:
+		return "scalar";
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sum(float* dest, const float* src, int count, float gain)
+{
+	assert(dest != nullptr && src != nullptr && count >= 0);
+	kernels().sum(dest, src, count, gain);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sumRamp(float* dest, const float* src, int count, float gainStart, float gainEnd)
+{
+	assert(dest != nullptr && src != nullptr && count >= 0);
+	if (gainStart == gainEnd)
+		kernels().sum(dest, src, count, gainStart);
+	else if (count > 0)
+		kernels().sumRamp(dest, src, count, gainStart, gainEnd);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void applyGain(float* buf, int count, float gain)
+{
+	assert(buf != nullptr && count >= 0);
+	kernels().applyGain(buf, count, gain);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void applyGainRamp(float* buf, int count, float gainStart, float gainEnd)
+{
+	assert(buf != nullptr && count >= 0);
+	if (count > 0)
+		kernels().applyGainRamp(buf, count, gainStart, gainEnd);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clamp(float* buf, int count, float min, float max)
+{
+	assert(buf != nullptr && count >= 0);
+	kernels().clamp(buf, count, min, max);
+}
+
+/* -------------------------------------------------------------------------- */
+
+float getPeak(const float* buf, int count)
+{
+	assert(buf != nullptr && count >= 0);
+	return kernels().getPeak(buf, count);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void int16ToFloat(float* dest, const std::int16_t* src, int count)
+{
+	assert(dest != nullptr && src != nullptr && count >= 0);
+	kernels().int16ToFloat(dest, src, count);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void halfToFloat(float* dest, const std::uint16_t* src, int count)
+{
+	assert(dest != nullptr && src != nullptr && count >= 0);
+	kernels().halfToFloat(dest, src, count);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void dotProductStereo(float* out, const float* left, const float* right, const float* coeffs, int count)
+{
+	assert(out != nullptr && left != nullptr && right != nullptr && coeffs != nullptr && count >= 0);
+	kernels().dotProductStereo(out, left, right, coeffs, count);
+}
+} // namespace giada::m::simd
@@ -0,0 +1,127 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_SIMD_H
+#define G_SIMD_H
+
+#include <cstdint>
+#include <string>
+
+/* simd
+Vectorized kernels for the hot audio loops. Each kernel is implemented for
+SSE2, AVX2 and NEON, plus a scalar fallback. The best implementation available
+on the current CPU is picked at startup (runtime dispatch). All kernels work on
+contiguous channels of 'count' samples and are realtime-safe. */
+
+namespace giada::m::simd
+{
+enum class InstructionSet
+{
+	SCALAR,
+	SSE2,
+	AVX2,
+	NEON
+};
+
+/* getBestInstructionSet
+Returns the best instruction set supported by the current CPU. */
+
+InstructionSet getBestInstructionSet();
+
+/* getInstructionSet
+Returns the instruction set currently in use. */
+
+InstructionSet getInstructionSet();
+
+/* setInstructionSet
+Forces the kernels to a specific instruction set. Falls back to the scalar
+implementation if the CPU doesn't support it. Useful for testing and
+benchmarking only. */
+
+void setInstructionSet(InstructionSet);
+
+/* isSupported
+True if the given instruction set can run on the current CPU. */
+
+bool isSupported(InstructionSet);
+
+std::string toString(InstructionSet);
+
+/* sum
+Adds 'src' multiplied by 'gain' to 'dest'. Use a per-channel gain (i.e.
+volume * pan[channel]) to sum with gain and pan. */
+
+void sum(float* dest, const float* src, int count, float gain);
+
+/* sumRamp
+Like sum(), with a gain that moves linearly from 'gainStart' (included) to
+'gainEnd' (excluded). Falls back to sum() if the two gains are equal. */
+
+void sumRamp(float* dest, const float* src, int count, float gainStart, float gainEnd);
+
+/* applyGain
+Multiplies each sample by 'gain'. */
+
+void applyGain(float* buf, int count, float gain);
+
+/* applyGainRamp
+Multiplies each sample by a gain that moves linearly from 'gainStart'
+(included) to 'gainEnd' (excluded). */
+
+void applyGainRamp(float* buf, int count, float gainStart, float gainEnd);
+
+/* clamp
+Limits each sample to the [min, max] range. */
+
+void clamp(float* buf, int count, float min, float max);
+
+/* getPeak
+Returns the maximum absolute value in the buffer. */
+
+float getPeak(const float* buf, int count);
+
+/* int16ToFloat
+Converts signed 16-bit integer samples to float, in the [-1.0, 1.0) range. */
+
+void int16ToFloat(float* dest, const std::int16_t* src, int count);
+
+/* halfToFloat
+Converts IEEE 754 half-precision samples to float. Infinities and NaNs are not
+supported, as they never appear in audio data. Subnormal values (below ~6e-5)
+become zero if the CPU flushes denormals to zero. */
+
+void halfToFloat(float* dest, const std::uint16_t* src, int count);
+
+/* dotProductStereo
+Multiplies both 'left' and 'right' by the same 'coeffs' in a single pass and
+sums the products. Results go to out[0] (left) and out[1] (right). Used by
+filters that run the same kernel over a stereo pair. */
+
+void dotProductStereo(float* out, const float* left, const float* right, const float* coeffs, int count);
+} // namespace giada::m::simd
+
+#endif
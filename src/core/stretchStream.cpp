@@ -0,0 +1,533 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/stretchStream.h"
+#include "src/core/const.h"
+#include "src/core/stretcher.h"
+#include "src/core/wave.h"
+#include "src/core/worker.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <thread>
+#include <utility>
+
+namespace giada::m
+{
+namespace
+{
+Worker                      worker_(G_STRETCH_STREAM_RATE_MS);
+std::mutex                  streamsMutex_;
+std::condition_variable     streamsCv_;
+std::vector<StretchStream*> streams_;
+std::vector<StretchStream*> snapshot_;          // For the worker only
+const StretchStream*        filling_        = nullptr; // Guarded by streamsMutex_
+std::atomic<bool>           nonRealtime_    = false;
+std::atomic<int>            totalUnderruns_ = 0;
+
+/* -------------------------------------------------------------------------- */
+
+/* fillStream_
+Fills a single stream, unless it has been unregistered in the meantime. As in
+DiskStream, the lock is held only to mark the stream as being filled, not while
+stretching. */
+
+bool fillStream_(StretchStream* stream)
+{
+	{
+		std::scoped_lock lock(streamsMutex_);
+		if (std::find(streams_.begin(), streams_.end(), stream) == streams_.end())
+			return false;
+		filling_ = stream;
+	}
+
+	const bool busy = stream->fill();
+
+	{
+		std::scoped_lock lock(streamsMutex_);
+		filling_ = nullptr;
+	}
+	streamsCv_.notify_all();
+
+	return busy;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* fillStreams_
+Keeps rendering all registered streams until their ring buffers are full.
+Works on a snapshot of the list, so that streams can be added and removed while
+rendering. */
+
+void fillStreams_()
+{
+	bool busy = true;
+	while (busy)
+	{
+		busy = false;
+		{
+			std::scoped_lock lock(streamsMutex_);
+			snapshot_.assign(streams_.begin(), streams_.end());
+		}
+		for (StretchStream* stream : snapshot_)
+			busy |= fillStream_(stream);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* waitForWorker_
+Waits for the worker to be done with 'stream', if it is filling it. */
+
+void waitForWorker_(std::unique_lock<std::mutex>& lock, const StretchStream* stream)
+{
+	streamsCv_.wait(lock, [stream]()
+	{ return filling_ != stream; });
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void StretchStream::startWorker() { worker_.start(fillStreams_); }
+void StretchStream::stopWorker() { worker_.stop(); }
+void StretchStream::setNonRealtime(bool v) { nonRealtime_.store(v); }
+int  StretchStream::getTotalUnderruns() { return totalUnderruns_.load(); }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+StretchStream::StretchStream()
+: m_lent(nullptr)
+, m_stretcher(nullptr)
+, m_origin(0)
+, m_input(0)
+, m_output(0)
+, m_base(0)
+, m_end(0)
+, m_consumed(0)
+, m_wanted(0)
+, m_seek(false)
+, m_reading(false)
+, m_underruns(0)
+, m_position(0)
+, m_streaming(false)
+, m_handOver(false)
+, m_active(false)
+{
+	std::scoped_lock lock(streamsMutex_);
+	streams_.push_back(this);
+}
+
+/* -------------------------------------------------------------------------- */
+
+StretchStream::~StretchStream()
+{
+	/* Unregister first, then wait for the worker in case it is filling this
+	very stream: nobody touches it afterwards. */
+
+	std::unique_lock lock(streamsMutex_);
+	std::erase(streams_, this);
+	waitForWorker_(lock, this);
+}
+
+/* -------------------------------------------------------------------------- */
+
+int StretchStream::getUnderruns() const { return m_underruns.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+bool StretchStream::hasStretcher() const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_lent != nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool StretchStream::lend(Stretcher* stretcher)
+{
+	assert(stretcher != nullptr);
+
+	std::scoped_lock lock(m_mutex);
+	if (m_lent != nullptr)
+		return false;
+	m_lent = stretcher;
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Stretcher* StretchStream::reclaim()
+{
+	Stretcher* stretcher = nullptr;
+	{
+		std::scoped_lock lock(m_mutex);
+		stretcher = std::exchange(m_lent, nullptr);
+	}
+
+	/* The worker may have picked the Stretcher up right before: wait for it to
+	finish its current cycle. It will see there's no Stretcher on the next
+	one. */
+
+	if (stretcher != nullptr)
+	{
+		std::unique_lock lock(streamsMutex_);
+		waitForWorker_(lock, this);
+	}
+
+	return stretcher;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void StretchStream::request(const Sample& sample)
+{
+	const Key key = makeKey(sample);
+
+	std::scoped_lock lock(m_mutex);
+
+	if (m_requested == key)
+		return;
+
+	m_requested = key;
+	m_pending   = Job{key, key.source != nullptr ? sample.wave->getSharedBuffer() : nullptr};
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::optional<rendering::ReadResult> StretchStream::a_read(const Sample& sample, mcl::AudioBuffer& dest, Frame start, Frame offset)
+{
+	const Key key = makeKey(sample);
+	if (key.source == nullptr || nonRealtime_.load())
+		return {};
+
+	m_active = true;
+
+	/* The 'reading' flag must be raised before looking at the rendered region,
+	whose end must be loaded before its base: see the counterpart in fill() and
+	waitForConsumer(). */
+
+	m_reading.store(true);
+
+	const std::int64_t end  = m_end.load(std::memory_order_acquire);
+	const std::int64_t base = m_base.load();
+	std::int64_t       pos  = -1;
+
+	if (base < end && m_key == key)
+	{
+		const bool next = m_position >= base && m_position < end && decodePosition(m_positions[at(m_position)]) == start;
+		pos             = next ? m_position : locate(base, end, start);
+	}
+
+	/* Copy up to the end of the pass, if within reach. Otherwise leave the last
+	rendered frame alone: its tag tells where the playhead goes next. */
+
+	const std::int64_t limit    = pos < 0 ? pos : std::min(pos + dest.countFrames() - offset, end);
+	std::int64_t       last     = pos;
+	bool               finished = false;
+
+	while (last < limit && !finished)
+		finished = m_positions[at(last++)] < 0;
+	if (!finished && last == end)
+		--last;
+
+	const Frame frames = static_cast<Frame>(std::max<std::int64_t>(last - pos, 0));
+
+	if (frames == 0)
+	{
+		/* Frames after the rendered region are about to come: drop the ones
+		before, so that the worker has room for them. */
+
+		if (pos == end)
+			m_consumed.store(end, std::memory_order_relaxed);
+		m_reading.store(false, std::memory_order_release);
+
+		if (m_streaming && pos >= 0)
+		{
+			m_underruns.fetch_add(1, std::memory_order_relaxed);
+			totalUnderruns_.fetch_add(1, std::memory_order_relaxed);
+		}
+		m_handOver |= m_streaming;
+		m_streaming = false;
+		return {};
+	}
+
+	const Frame ringPos = at(pos);
+	const Frame first   = std::min(frames, G_STRETCH_RING_FRAMES - ringPos);
+
+	dest.setAll(m_ring, first, ringPos, offset);
+	if (first < frames) // Wrap around
+		dest.setAll(m_ring, frames - first, 0, offset + first);
+
+	const Frame next = finished ? key.b : decodePosition(m_positions[at(last)]);
+
+	m_reading.store(false, std::memory_order_release);
+
+	m_position  = last;
+	m_streaming = true;
+	m_consumed.store(m_position, std::memory_order_relaxed);
+
+	return rendering::ReadResult{next - start, frames, finished};
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool StretchStream::a_handOver() { return std::exchange(m_handOver, false); }
+
+/* -------------------------------------------------------------------------- */
+
+void StretchStream::a_prefetch(Frame f)
+{
+	if (!std::exchange(m_active, false))
+		return;
+
+	m_wanted.store(f, std::memory_order_relaxed);
+
+	m_reading.store(true);
+
+	const std::int64_t end   = m_end.load(std::memory_order_acquire);
+	const std::int64_t base  = m_base.load();
+	const bool         next  = m_position >= base && m_position < end && decodePosition(m_positions[at(m_position)]) == f;
+	const bool         found = base < end && (next || locate(base, end, f) >= 0);
+
+	m_reading.store(false, std::memory_order_release);
+
+	if (!found)
+		m_seek.store(true);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool StretchStream::fill()
+{
+	std::optional<Job> job;
+	Stretcher*         stretcher = nullptr;
+	{
+		std::scoped_lock lock(m_mutex);
+		job.swap(m_pending);
+		stretcher = m_lent;
+	}
+
+	/* A different Stretcher (or none) has been lent in the meantime: start the
+	current Job over with it. */
+
+	if (stretcher != m_stretcher)
+	{
+		m_stretcher = stretcher;
+		if (!job)
+			job = m_job;
+	}
+
+	if (job)
+	{
+		m_job = std::move(*job);
+		if (m_job.source == nullptr || m_stretcher == nullptr)
+		{
+			release();
+			return false;
+		}
+		if (!m_ring.isAllocd())
+		{
+			m_ring.alloc(G_STRETCH_RING_FRAMES, G_MAX_IO_CHANS);
+			m_chunk.alloc(G_STRETCH_CHUNK_FRAMES, G_MAX_IO_CHANS);
+			m_positions.assign(G_STRETCH_RING_FRAMES, 0);
+		}
+		m_seek.store(false);
+		restart(m_wanted.load());
+	}
+	else if (m_job.source == nullptr || m_stretcher == nullptr)
+		return false;
+	else if (m_seek.exchange(false))
+		restart(m_wanted.load());
+
+	/* Make room for a whole chunk, plus the extra frame appended when a pass
+	ends with nothing left to retrieve (see below). Frames about to be written
+	overwrite the oldest ones in the ring buffer: move the base forward first,
+	then make sure the consumer is not reading the old frames in the meantime. */
+
+	const std::int64_t base     = m_base.load(std::memory_order_relaxed);
+	const std::int64_t end      = m_end.load(std::memory_order_relaxed);
+	const std::int64_t consumed = std::max(m_consumed.load(std::memory_order_relaxed), base);
+
+	if (end - consumed + G_STRETCH_CHUNK_FRAMES + 1 > G_STRETCH_RING_FRAMES)
+		return false;
+
+	const std::int64_t newBase = std::max(base, end + G_STRETCH_CHUNK_FRAMES + 1 - G_STRETCH_RING_FRAMES);
+	if (newBase != base)
+	{
+		m_base.store(newBase);
+		waitForConsumer();
+	}
+
+	const Key&              key = m_job.key;
+	const Stretcher::Result res = m_stretcher->process(*m_job.source, m_input, key.b, m_chunk, 0, key.time, key.pitch);
+
+	/* A pass may end with nothing left to retrieve: add a silent frame then, so
+	that there's always a last frame to flag (see below). */
+
+	const bool passEnded = res.finished || (res.used == 0 && res.generated == 0);
+	Frame      written   = static_cast<Frame>(res.generated);
+
+	if (passEnded && written == 0)
+	{
+		m_chunk.clear(0, 1);
+		written = 1;
+	}
+
+	const Frame ringPos = at(end);
+	const Frame first   = std::min(written, G_STRETCH_RING_FRAMES - ringPos);
+
+	m_ring.setAll(m_chunk, first, 0, ringPos);
+	if (first < written) // Wrap around
+		m_ring.setAll(m_chunk, written - first, first, 0);
+
+	/* Frames map linearly to the Wave frames of the pass, as in Freezer::a_read().
+	The stretcher latency makes the last ones map past the end of the Sample
+	range: clamp them. */
+
+	for (Frame i = 0; i < written; i++)
+		m_positions[at(end + i)] = std::min(m_origin + static_cast<Frame>((m_output + i) / static_cast<double>(key.time)), key.b);
+
+	/* End of the pass: flag its last frame and start over from the beginning of
+	the Sample range, ready for a loop. */
+
+	if (passEnded)
+	{
+		const Frame last  = at(end + written - 1);
+		m_positions[last] = encodeLast(m_positions[last]);
+
+		if (!res.finished)
+			m_stretcher->last();
+		m_origin = key.a;
+		m_input  = key.a;
+		m_output = 0;
+	}
+	else
+	{
+		m_input += static_cast<Frame>(res.used);
+		m_output += written;
+	}
+
+	m_end.store(end + written, std::memory_order_release);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+StretchStream::Key StretchStream::makeKey(const Sample& sample)
+{
+	if (sample.wave == nullptr || !sample.wave->isResident() || sample.range.getLength() <= 0)
+		return {};
+	if (sample.playbackMode != PlaybackMode::ELASTIC)
+		return {};
+
+	return {
+	    .source = &std::as_const(*sample.wave).getBuffer(),
+	    .a      = sample.range.getA(),
+	    .b      = sample.range.getB(),
+	    .pitch  = sample.pitch,
+	    .time   = sample.time};
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame StretchStream::encodeLast(Frame f) { return -f - 1; }
+Frame StretchStream::decodePosition(Frame f) { return f < 0 ? -f - 1 : f; }
+
+/* -------------------------------------------------------------------------- */
+
+Frame StretchStream::at(std::int64_t f) const
+{
+	return static_cast<Frame>(f % G_STRETCH_RING_FRAMES);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void StretchStream::restart(Frame start)
+{
+	const Key& key = m_job.key;
+
+	m_base.store(m_end.load());
+	waitForConsumer();
+
+	m_key    = key;
+	m_origin = start >= key.a && start < key.b ? start : key.a;
+	m_input  = m_origin;
+	m_output = 0;
+	m_stretcher->last();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void StretchStream::release()
+{
+	m_base.store(m_end.load());
+	waitForConsumer();
+
+	m_key = {};
+	m_ring.free();
+	m_chunk.free();
+	m_positions = {};
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::int64_t StretchStream::locate(std::int64_t from, std::int64_t to, Frame start) const
+{
+	/* Frames are tagged every 1/time Wave frames at most. */
+
+	const Frame step = static_cast<Frame>(std::ceil(1.0f / m_key.time));
+
+	for (std::int64_t f = from; f < to; f++)
+		if (const Frame pos = decodePosition(m_positions[at(f)]); pos >= start && pos - start < step)
+			return f;
+
+	/* Not rendered yet, but the current pass is getting there. */
+
+	if (to == from)
+		return -1;
+
+	const Frame tail = m_positions[at(to - 1)];
+	if (tail >= 0 && tail < start && start - tail < G_STRETCH_CHUNK_FRAMES)
+		return to;
+
+	return -1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void StretchStream::waitForConsumer() const
+{
+	while (m_reading.load())
+		std::this_thread::yield();
+}
+} // namespace giada::m
@@ -0,0 +1,247 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_STRETCH_STREAM_H
+#define G_STRETCH_STREAM_H
+
+#include "src/core/rendering/sampleRendering.h"
+#include "src/core/stretcher.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/types.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace giada::m
+{
+/* StretchStream
+Time-stretches an ELASTIC Sample ahead of the playhead, so that the realtime
+thread only has to copy frames instead of running Rubber Band. A background
+worker thread renders into a lock-free ring buffer, starting from the position
+requested by the consumer with a_prefetch(), and keeps going past the end of the
+Sample range from its beginning, ready for loops. The consumer stretches inline
+whenever the stream can't help: underruns, jumps outside the rendered region
+(e.g. a rewind) or Sample changes not picked up by the worker yet. Single
+producer (the worker), single consumer (the thread that renders the channel).
+One StretchStream per sample channel, living in ChannelShared. The Stretcher
+the worker runs is borrowed from the Model's StretcherPool: nothing is streamed
+without one. */
+
+class StretchStream final
+{
+public:
+	/* startWorker, stopWorker
+	Starts or stops the background worker thread, shared by all streams. */
+
+	static void startWorker();
+	static void stopWorker();
+
+	/* setNonRealtime
+	Makes all streams step aside, so that offline rendering always stretches
+	inline, with repeatable results. */
+
+	static void setNonRealtime(bool);
+
+	/* getTotalUnderruns
+	Returns the number of underruns occurred across all streams so far. */
+
+	static int getTotalUnderruns();
+
+	StretchStream();
+	StretchStream(const StretchStream&)            = delete;
+	StretchStream(StretchStream&&)                 = delete;
+	StretchStream& operator=(const StretchStream&) = delete;
+	StretchStream& operator=(StretchStream&&)      = delete;
+	~StretchStream();
+
+	int  getUnderruns() const;
+	bool hasStretcher() const;
+
+	/* lend
+	Gives the stream a Stretcher to render with. Returns false if the stream
+	already has one, lent by another thread in the meantime: the caller keeps
+	ownership in that case. */
+
+	bool lend(Stretcher*);
+
+	/* reclaim
+	Takes back the lent Stretcher, if any, waiting for the worker to stop using
+	it. Streamed audio is dropped. Not for the real-time thread. */
+
+	Stretcher* reclaim();
+
+	/* request
+	Asks for 'sample' to be streamed. Any previously streamed audio is dropped
+	if it doesn't need it (no Wave, not ELASTIC, Wave not fully in memory). */
+
+	void request(const Sample&);
+
+	/* a_read
+	Reads the stretched version of 'sample' into 'dest' from frame 'offset',
+	starting at frame 'start' of the Wave. Returns nothing if those frames are
+	not in the ring buffer: stretch them inline then. Realtime thread only. */
+
+	std::optional<rendering::ReadResult> a_read(const Sample&, mcl::AudioBuffer& dest, Frame start, Frame offset);
+
+	/* a_handOver
+	True once after a_read() has stopped providing audio: the inline Stretcher
+	must be reset before taking over, or it would play its stale output first.
+	Realtime thread only. */
+
+	bool a_handOver();
+
+	/* a_prefetch
+	Tells the worker where the consumer will read next. Ignored if a_read()
+	hasn't been called since the last a_prefetch(), e.g. while the Sample is
+	being played by the Freezer: there's no point in rendering it again.
+	Realtime thread only. */
+
+	void a_prefetch(Frame);
+
+	/* fill
+	Renders the next chunk of frames, if needed. Returns true if some work has
+	been done. Worker thread only. */
+
+	bool fill();
+
+private:
+	/* Key
+	Everything the stretched audio depends on. The audio data is identified by
+	address, as in Freezer::Key. */
+
+	struct Key
+	{
+		bool operator==(const Key&) const = default;
+
+		const mcl::AudioBuffer* source = nullptr; // Nullptr = nothing to stream
+		Frame                   a      = 0;
+		Frame                   b      = 0;
+		float                   pitch  = 1.0f;
+		float                   time   = 1.0f;
+	};
+
+	/* Job
+	A pending stream request. */
+
+	struct Job
+	{
+		Key                                     key;
+		std::shared_ptr<const mcl::AudioBuffer> source;
+	};
+
+	static Key makeKey(const Sample&);
+
+	/* encodeLast, decodePosition
+	Each rendered frame is tagged with the Wave frame the playhead is on when
+	the frame is played. The last frame of a pass over the Sample range is
+	flagged by storing it as a negative number. */
+
+	static Frame encodeLast(Frame);
+	static Frame decodePosition(Frame);
+
+	/* restart
+	Drops the ring buffer content and starts rendering from Wave frame 'start',
+	or from the beginning of the Sample range if 'start' falls outside. Worker
+	thread only. */
+
+	void restart(Frame start);
+
+	/* release
+	Drops the ring buffer altogether. Worker thread only. */
+
+	void release();
+
+	/* locate
+	Returns the first frame in the ring buffer region [from, to) tagged with
+	Wave frame 'start'. Frames are not tagged with every Wave frame when the
+	Sample gets shorter: the closest one following 'start' is fine then. Returns
+	'to' if 'start' is about to be rendered, -1 if it won't be. */
+
+	std::int64_t locate(std::int64_t from, std::int64_t to, Frame start) const;
+
+	/* at
+	Returns the position in the ring buffer of frame 'f'. */
+
+	Frame at(std::int64_t f) const;
+
+	/* waitForConsumer
+	Spins until the consumer is done reading from the ring buffer. Worker thread
+	only. */
+
+	void waitForConsumer() const;
+
+	/* Pending Job, the last requested Key and the lent Stretcher, shared with
+	the threads that call request(), lend() and reclaim(). */
+
+	mutable std::mutex m_mutex;
+	std::optional<Job> m_pending;
+	Key                m_requested;
+	Stretcher*         m_lent;
+
+	/* Current Job and rendering state. Worker thread only. */
+
+	Job              m_job;
+	Stretcher*       m_stretcher; // Copy of m_lent taken at the start of fill()
+	mcl::AudioBuffer m_chunk;
+	Frame            m_origin; // Wave frame the current pass started from
+	Frame            m_input;  // Next Wave frame fed to the Stretcher
+	Frame            m_output; // Frames rendered in the current pass
+
+	/* Ring buffer, allocated only while streaming, and the Wave frame each of
+	its frames is tagged with. Written by the worker while the consumer is not
+	allowed to read them: see m_base below. */
+
+	Key                m_key;
+	mcl::AudioBuffer   m_ring;
+	std::vector<Frame> m_positions;
+
+	/* m_base, m_end
+	Frames [m_base, m_end) currently available in the ring buffer. Counted from
+	the creation of the stream, never going back. Written by the worker only. */
+
+	std::atomic<std::int64_t> m_base;
+	std::atomic<std::int64_t> m_end;
+
+	std::atomic<std::int64_t> m_consumed; // Next frame the consumer will read
+	std::atomic<Frame>        m_wanted;   // Next Wave frame the consumer needs
+	std::atomic<bool>         m_seek;     // Restart from m_wanted
+	std::atomic<bool>         m_reading;  // Consumer is copying from the ring buffer
+	std::atomic<int>          m_underruns;
+
+	/* Consumer state. Realtime thread only. */
+
+	std::int64_t m_position;  // Next frame to read
+	bool         m_streaming; // Last a_read() returned audio
+	bool         m_handOver;  // See a_handOver()
+	bool         m_active;    // a_read() called since last a_prefetch()
+};
+} // namespace giada::m
+
+#endif
@@ -50,7 +50,8 @@ Stretcher::Result Stretcher::process(
     mcl::AudioBuffer&       output,
     std::size_t             outputStart,
     double                  timeRatio,
-    double                  pitchRatio)
+    double                  pitchRatio,
+    bool                    endOfInput)
 {
 	/* General algorithm -
 	1. While the output buffer still has room:
@@ -116,7 +117,7 @@ Stretcher::Result Stretcher::process(
 		spent and will never produce anything else, no matter what we do, so we
 		bail out immediately instead of looping further. */
 
-		if (!inputIsAvailable && m_stretcher.available() < 0)
+		if (!inputIsAvailable && endOfInput && m_stretcher.available() < 0)
 		{
 			fullyDrained = true;
 			break;
@@ -145,7 +146,8 @@ Stretcher::Result Stretcher::process(
 			/* If this batch covers everything left in the input file, this is
 			the last input we'll ever hand over. Tell the stretcher so via the
 			`final` flag below, so it knows to flush its internal buffers rather
-			than wait for more input that isn't coming. */
+			than wait for more input that isn't coming. Unless the caller has
+			more input to give in the next call ('endOfInput' == false). */
 
 			inputIsAvailable = framesToProcess < framesRemaining;
 
@@ -154,14 +156,14 @@ Stretcher::Result Stretcher::process(
 			queued inside the stretcher until a later call to available()/retrieve()),
 			or it may produce nothing yet if it's still filling its internal window. */
 
-			m_stretcher.process(inputPtrs, framesToProcess, !inputIsAvailable);
+			m_stretcher.process(inputPtrs, framesToProcess, !inputIsAvailable && endOfInput);
 			framesUsed += framesToProcess;
 
 			/* Re-check available(). The process() call above may have just been
 			the final flush, in which case draining could already be complete
 			(available() now -1) with nothing to retrieve. */
 
-			if (!inputIsAvailable && m_stretcher.available() < 0)
+			if (!inputIsAvailable && endOfInput && m_stretcher.available() < 0)
 			{
 				fullyDrained = true;
 				break;
@@ -183,6 +185,12 @@ Stretcher::Result Stretcher::process(
 		framesGenerated += framesRetrieved;
 		outputIsEmpty = framesGenerated < outputLength;
 
+		/* Input range consumed, but more input will come with the next call:
+		return what has been generated so far. */
+
+		if (!inputIsAvailable && !endOfInput)
+			break;
+
 		/* Safety check: input is gone and nothing is available from the stretcher,
 		but make sure to avoid spinning forever just in case retrieve() still
 		returns nothing here. */
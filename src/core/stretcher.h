@@ -69,7 +69,9 @@ public:
 	'output', starting at 'outputStart', using the given time/pitch ratios.
 	Since Rubber Band doesn't guarantee a fixed input/output ratio per call,
 	this may take several calls to fully drain real audio after the input
-	range ends: see Result::finished. */
+	range ends: see Result::finished. Pass 'endOfInput' = false if more input
+	will follow 'inputEnd' in a later call (e.g. when streaming from disk): the
+	function then returns as soon as the input range has been consumed. */
 
 	Result process(
 	    const mcl::AudioBuffer& input,
@@ -78,7 +80,8 @@ public:
 	    mcl::AudioBuffer&       output,
 	    std::size_t             outputStart,
 	    double                  timeRatio,
-	    double                  pitchRatio);
+	    double                  pitchRatio,
+	    bool                    endOfInput = true);
 
 private:
 	RubberBand::RubberBandStretcher m_stretcher;
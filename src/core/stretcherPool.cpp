@@ -0,0 +1,91 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/stretcherPool.h"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m
+{
+void StretcherPool::reset(int size, int sampleRate)
+{
+	std::scoped_lock lock(m_mutex);
+
+	assert(m_free.size() == m_stretchers.size());
+
+	m_stretchers.clear();
+	m_free.clear();
+	m_free.reserve(size);
+
+	for (int i = 0; i < size; i++)
+		m_free.push_back(m_stretchers.emplace_back(std::make_unique<Stretcher>(sampleRate)).get());
+}
+
+/* -------------------------------------------------------------------------- */
+
+Stretcher* StretcherPool::acquire()
+{
+	std::scoped_lock lock(m_mutex);
+
+	if (m_free.empty())
+		return nullptr;
+
+	Stretcher* stretcher = m_free.back();
+	m_free.pop_back();
+	return stretcher;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void StretcherPool::release(Stretcher* stretcher)
+{
+	assert(stretcher != nullptr);
+
+	stretcher->last(); // Start from scratch on next use
+
+	std::scoped_lock lock(m_mutex);
+
+	assert(std::ranges::find(m_free, stretcher) == m_free.end());
+	assert(m_free.size() < m_stretchers.size());
+
+	m_free.push_back(stretcher);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t StretcherPool::countFree() const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_free.size();
+}
+
+std::size_t StretcherPool::countAll() const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_stretchers.size();
+}
+} // namespace giada::m
@@ -0,0 +1,78 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2026 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_STRETCHER_POOL_H
+#define G_STRETCHER_POOL_H
+
+#include "src/core/stretcher.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace giada::m
+{
+/* StretcherPool
+A fixed set of Stretchers, allocated once and lent to Sample channels only
+while they play something in ELASTIC mode. A Stretcher is a heavy object:
+giving one to every Sample channel would waste memory and slow down channel
+creation. Thread-safe: the Model lends and takes back Stretchers on every
+swap, and swaps can happen on the main, MIDI and JACK threads. Never use it
+from the real-time thread though. */
+
+class StretcherPool final
+{
+public:
+	/* reset
+	Allocates 'size' Stretchers for the given sample rate, replacing the old
+	ones. No Stretcher must be lent at this point. */
+
+	void reset(int size, int sampleRate);
+
+	/* acquire
+	Lends a Stretcher. Returns nullptr if the pool is exhausted. Never
+	allocates. */
+
+	Stretcher* acquire();
+
+	/* release
+	Resets a Stretcher and gives it back to the pool. The real-time thread must
+	not be using it anymore. */
+
+	void release(Stretcher*);
+
+	std::size_t countFree() const;
+	std::size_t countAll() const;
+
+private:
+	mutable std::mutex                      m_mutex;
+	std::vector<std::unique_ptr<Stretcher>> m_stretchers;
+	std::vector<Stretcher*>                 m_free;
+};
+} // namespace giada::m
+
+#endif
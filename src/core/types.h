@@ -96,6 +96,13 @@ enum class InputRecMode : int
 	RIGID = 0,
 	FREE
 };
+
+enum class SampleStorage : int
+{
+	FLOAT = 0,
+	INT16,
+	HALF
+};
 } // namespace giada
 
 #endif
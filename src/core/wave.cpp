@@ -26,6 +26,7 @@
 
 #include "src/core/wave.h"
 #include "src/deps/mcl-utils/src/fs.hpp"
+#include <bit>
 #include <cassert>
 #include <fmt/core.h>
 
@@ -35,10 +36,12 @@ namespace giada::m
 {
 Wave::Wave(ID id)
 : id(id)
+, m_buffer(std::make_shared<mcl::AudioBuffer>())
 , m_rate(0)
 , m_bits(0)
 , m_logical(false)
 , m_edited(false)
+, m_hash(0)
 {
 }
 
@@ -46,12 +49,17 @@ Wave::Wave(ID id)
 
 Wave::Wave(const Wave& other)
 : id(other.id)
-, m_buffer(other.getBuffer())
+, m_buffer(other.m_buffer)
+, m_stream(other.isStreamed() ? DiskStream::open(other.m_path, other.m_buffer->countFrames(), other.m_stream->getCapacity()) : nullptr)
+, m_compact(other.m_compact)
 , m_rate(other.m_rate)
 , m_bits(other.m_bits)
 , m_logical(false)
 , m_edited(false)
 , m_path(other.m_path)
+, m_peaksFile(other.m_peaksFile)
+, m_peaksSource(other.m_peaksSource)
+, m_hash(other.m_hash)
 {
 }
 
@@ -59,10 +67,14 @@ Wave::Wave(const Wave& other)
 
 void Wave::alloc(Frame size, int channels, int rate, int bits, const std::string& path)
 {
-	m_buffer.alloc(size, channels);
-	m_rate = rate;
-	m_bits = bits;
-	m_path = path;
+	m_buffer = std::make_shared<mcl::AudioBuffer>(size, channels);
+	m_hash   = 0;
+	m_rate   = rate;
+	m_bits   = bits;
+	m_path   = path;
+	m_compact.reset();
+	m_peaks.reset();
+	m_peaksFile.clear();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -79,17 +91,95 @@ std::string Wave::getPath() const { return m_path; }
 int         Wave::getBits() const { return m_bits; }
 bool        Wave::isLogical() const { return m_logical; }
 bool        Wave::isEdited() const { return m_edited; }
+bool        Wave::isStreamed() const { return m_stream != nullptr; }
+DiskStream* Wave::getStream() const { return m_stream.get(); }
 
 /* -------------------------------------------------------------------------- */
 
-mcl::AudioBuffer&       Wave::getBuffer() { return m_buffer; }
-const mcl::AudioBuffer& Wave::getBuffer() const { return m_buffer; }
+bool                 Wave::isCompact() const { return m_compact != nullptr; }
+const CompactBuffer* Wave::getCompact() const { return m_compact.get(); }
+bool                 Wave::isResident() const { return !isStreamed() && !isCompact(); }
+
+/* -------------------------------------------------------------------------- */
+
+SampleStorage Wave::getStorage() const
+{
+	return isCompact() ? m_compact->getStorage() : SampleStorage::FLOAT;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t Wave::getDataSize() const
+{
+	const std::size_t floatSize = m_buffer->countFrames() * m_buffer->countChannels() * sizeof(float);
+	return floatSize + (isCompact() ? m_compact->getSize() : 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame Wave::getLength() const
+{
+	if (isStreamed())
+		return m_stream->getLength();
+	if (isCompact())
+		return m_compact->countFrames();
+	return m_buffer->countFrames();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Wave::isDataShared() const
+{
+	return m_buffer.use_count() > 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::uint64_t Wave::getHash() const
+{
+	if (m_hash != 0)
+		return m_hash;
+
+	/* 64-bit FNV-1a over the raw sample bits, plus buffer dimensions. */
+
+	std::uint64_t h = 14695981039346656037ull;
+
+	const auto mix = [&h](std::uint64_t v)
+	{ h = (h ^ v) * 1099511628211ull; };
+
+	mix(m_buffer->countFrames());
+	mix(m_buffer->countChannels());
+	for (int ch = 0; ch < m_buffer->countChannels(); ch++)
+		for (const float f : m_buffer->getChannelView(ch))
+			mix(std::bit_cast<std::uint32_t>(f));
+
+	m_hash = h == 0 ? 1 : h;
+	return m_hash;
+}
+
+/* -------------------------------------------------------------------------- */
+
+mcl::AudioBuffer& Wave::getBuffer()
+{
+	if (isDataShared())
+		m_buffer = std::make_shared<mcl::AudioBuffer>(*m_buffer);
+	m_hash = 0;
+	return *m_buffer;
+}
+
+const mcl::AudioBuffer& Wave::getBuffer() const { return *m_buffer; }
+
+std::shared_ptr<const mcl::AudioBuffer> Wave::getSharedBuffer() const { return m_buffer; }
+
+/* -------------------------------------------------------------------------- */
+
+const Peaks* Wave::getPeaks() const { return m_peaks.get(); }
 
 /* -------------------------------------------------------------------------- */
 
 float Wave::getDuration() const
 {
-	return m_buffer.countFrames() / static_cast<float>(m_rate);
+	return getLength() / static_cast<float>(m_rate);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -104,6 +194,11 @@ std::string Wave::getExtension() const
 void Wave::setRate(int v) { m_rate = v; }
 void Wave::setLogical(bool l) { m_logical = l; }
 void Wave::setEdited(bool e) { m_edited = e; }
+void Wave::setPeaksFile(const std::string& f, const Peaks::Source& s)
+{
+	m_peaksFile   = f;
+	m_peaksSource = s;
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -119,6 +214,67 @@ void Wave::setPath(const std::string& p, int wid)
 
 void Wave::replaceData(mcl::AudioBuffer&& b)
 {
-	m_buffer = std::move(b);
+	m_buffer = std::make_shared<mcl::AudioBuffer>(std::move(b));
+	m_hash   = 0;
+	m_stream.reset();
+	m_compact.reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setStream(std::unique_ptr<DiskStream> s)
+{
+	m_stream = std::move(s);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::shareData(const Wave& o)
+{
+	assert(!o.isStreamed());
+
+	m_buffer  = o.m_buffer;
+	m_compact = o.m_compact;
+	m_hash    = o.m_hash;
+	m_rate    = o.m_rate;
+	m_bits    = o.m_bits;
+	m_stream.reset();
+	m_peaks.reset();
+	m_peaksFile.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setCompact(std::shared_ptr<const CompactBuffer> c)
+{
+	assert(!isStreamed());
+
+	m_compact = std::move(c);
+	m_buffer  = std::make_shared<mcl::AudioBuffer>();
+	m_hash    = 0;
+	m_peaks.reset();
+	m_peaksFile.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::computePeaks()
+{
+	if (m_peaks == nullptr && m_peaksFile.empty() && isResident())
+		m_peaks = Peaks::compute(m_buffer);
+}
+
+void Wave::loadPeaks()
+{
+	if (m_peaks == nullptr && !m_peaksFile.empty() && isResident())
+		m_peaks = Peaks::load(m_peaksFile, m_peaksSource, m_buffer->countFrames());
+	m_peaksFile.clear();
+	computePeaks();
+}
+
+void Wave::updatePeaks(Frame a, Frame b)
+{
+	if (m_peaks != nullptr)
+		m_peaks->update(m_buffer, a, b);
 }
 } // namespace giada::m
@@ -27,9 +27,14 @@
 #ifndef G_WAVE_H
 #define G_WAVE_H
 
+#include "src/core/compactBuffer.h"
+#include "src/core/diskStream.h"
+#include "src/core/peaks.h"
 #include "src/core/types.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/types.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace giada::m
@@ -52,12 +57,85 @@ public:
 	bool        isLogical() const;
 	bool        isEdited() const;
 
+	/* getLength
+	Returns the total number of frames. Differs from getBuffer().countFrames()
+	only if the Wave is streamed from disk or compact. */
+
+	Frame getLength() const;
+
+	/* isStreamed
+	True if only the head of the Wave lives in memory, the rest being read from
+	disk on the fly through a DiskStream. */
+
+	bool isStreamed() const;
+
+	/* getStream
+	Returns the DiskStream attached to this Wave, if streamed. Nullptr otherwise.
+	The stream is an I/O channel rather than part of the Wave state, hence
+	available through a const Wave too. */
+
+	DiskStream* getStream() const;
+
+	/* isCompact
+	True if audio data is stored in a CompactBuffer, i.e. with 16 bits per
+	sample. The float buffer is empty in that case. */
+
+	bool isCompact() const;
+
+	/* getCompact
+	Returns the CompactBuffer holding audio data, if compact. Nullptr otherwise. */
+
+	const CompactBuffer* getCompact() const;
+
+	/* getStorage
+	Returns how audio data is stored in memory. */
+
+	SampleStorage getStorage() const;
+
+	/* isResident
+	True if the whole audio data lives in memory as float, i.e. the Wave is
+	neither streamed nor compact. Only resident Waves can be edited. */
+
+	bool isResident() const;
+
+	/* getDataSize
+	Returns the amount of memory taken by audio data, in bytes. */
+
+	std::size_t getDataSize() const;
+
+	/* isDataShared
+	True if the audio buffer is shared with other Waves. See shareData(). */
+
+	bool isDataShared() const;
+
+	/* getHash
+	Returns a hash of the audio content, computed on first request and cached
+	until the audio buffer is accessed for writing. */
+
+	std::uint64_t getHash() const;
+
 	/* getBuffer
-	Returns a (non-)const reference to the underlying audio buffer. */
+	Returns a (non-)const reference to the underlying audio buffer. If the Wave
+	is streamed, the buffer contains the head only. The non-const version makes
+	a private copy of the buffer first, if shared with other Waves. */
 
 	mcl::AudioBuffer&       getBuffer();
 	const mcl::AudioBuffer& getBuffer() const;
 
+	/* getSharedBuffer
+	Returns a shared reference to the underlying audio buffer, for reading it
+	outside the Wave (e.g. from a background thread). The Wave will make a
+	private copy of it on the next write access. */
+
+	std::shared_ptr<const mcl::AudioBuffer> getSharedBuffer() const;
+
+	/* getPeaks
+	Returns the peak overview of the audio data, used to draw the waveform.
+	Nullptr if never computed (see computePeaks()). Peaks might not be ready
+	yet, if still being computed in background. */
+
+	const Peaks* getPeaks() const;
+
 	/* setPath
 	Sets new path 'p'. If 'id' != -1 inserts a numeric id next to the file
 	extension, e.g. : /path/to/sample-[id].wav */
@@ -68,22 +146,75 @@ public:
 	void setLogical(bool l);
 	void setEdited(bool e);
 
+	/* setPeaksFile
+	Sets the file where the peak overview can be read from, instead of
+	computing it again, together with the Source of the audio file this Wave
+	has been read from. The file is read lazily by loadPeaks(). */
+
+	void setPeaksFile(const std::string&, const Peaks::Source&);
+
 	/* replaceData
-	Replaces internal audio buffer with 'b' by moving it. */
+	Replaces internal audio buffer with 'b' by moving it. The Wave is no longer
+	streamed nor compact afterwards. Peaks are left untouched: call updatePeaks()
+	next. */
 
 	void replaceData(mcl::AudioBuffer&& b);
 
+	/* setStream
+	Attaches a DiskStream that provides the frames following the in-memory
+	buffer. */
+
+	void setStream(std::unique_ptr<DiskStream>);
+
+	/* setCompact
+	Replaces the float audio data with a compact version of it. */
+
+	void setCompact(std::shared_ptr<const CompactBuffer>);
+
+	/* shareData
+	Makes this Wave point to the audio buffer of Wave 'o' (and take its rate and
+	bit depth) without copying any data. The buffer is duplicated later on only
+	if one of the Waves modifies it (copy-on-write). */
+
+	void shareData(const Wave& o);
+
+	/* computePeaks
+	Starts computing the peak overview in background, if not done yet. Resident
+	Waves only. The builder holds a reference to the audio buffer until done,
+	so any write access in the meantime makes a private copy of it. Does nothing
+	if a peaks file has been set: see loadPeaks(). */
+
+	void computePeaks();
+
+	/* loadPeaks
+	Reads the peak overview from the peaks file, if any. Falls back to
+	computePeaks() if the file is unusable or doesn't match the audio data. */
+
+	void loadPeaks();
+
+	/* updatePeaks
+	Refreshes the peak overview after frames [a, b) have been edited. Pass the
+	new length as 'b' if the edit has moved any following frame. */
+
+	void updatePeaks(Frame a, Frame b);
+
 	void alloc(Frame size, int channels, int rate, int bits, const std::string& path);
 
 	ID id;
 
 private:
-	mcl::AudioBuffer m_buffer;
-	int              m_rate;
-	int              m_bits;
-	bool             m_logical; // memory only (a take)
-	bool             m_edited;  // edited via editor
-	std::string      m_path;    // E.g. /path/to/my/sample.wav
+	std::shared_ptr<mcl::AudioBuffer>    m_buffer;    // Never null, possibly shared
+	std::unique_ptr<DiskStream>          m_stream;
+	std::shared_ptr<const CompactBuffer> m_compact;   // Immutable, possibly shared
+	std::shared_ptr<Peaks>               m_peaks;     // Null = not computed
+	int                                  m_rate;
+	int                                  m_bits;
+	bool                                 m_logical;   // memory only (a take)
+	bool                                 m_edited;    // edited via editor
+	std::string                          m_path;      // E.g. /path/to/my/sample.wav
+	std::string                          m_peaksFile; // Empty = none
+	Peaks::Source                        m_peaksSource;
+	mutable std::uint64_t                m_hash;      // 0 = not computed yet
 };
 } // namespace giada::m
 
@@ -25,19 +25,31 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/waveFactory.h"
+#include "src/core/compactBuffer.h"
 #include "src/core/const.h"
+#include "src/core/diskStream.h"
 #include "src/core/idManager.h"
 #include "src/core/patch.h"
+#include "src/core/pcmCache.h"
+#include "src/core/peaks.h"
 #include "src/core/wave.h"
 #include "src/core/waveFx.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/deps/mcl-utils/src/fs.hpp"
 #include "src/utils/log.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <filesystem>
 #include <fmt/core.h>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <samplerate.h>
 #include <sndfile.h>
+#include <thread>
+#include <utility>
 
 namespace utils = mcl::utils;
 
@@ -45,7 +57,46 @@ namespace giada::m::waveFactory
 {
 namespace
 {
-IdManager waveId_;
+IdManager  waveId_;
+std::mutex waveIdMutex_;
+
+/* -------------------------------------------------------------------------- */
+
+/* generateWaveId_
+Thread-safe access to the Wave ID generator, as Waves might be created by
+multiple threads at once (see deserializeWaves()). A valid 'id' is kept as is
+and makes the generator move past it. */
+
+ID generateWaveId_(ID id = {})
+{
+	std::scoped_lock lock(waveIdMutex_);
+	if (id.isValid())
+	{
+		waveId_.set(id);
+		return id;
+	}
+	return waveId_.generate();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* isExpensive_
+True if loading the file requires more than a plain PCM read, i.e. a
+compressed format or a sample rate conversion. */
+
+bool isExpensive_(const SF_INFO& header, int samplerate)
+{
+	switch (header.format & SF_FORMAT_TYPEMASK)
+	{
+	case SF_FORMAT_WAV:
+	case SF_FORMAT_AIFF:
+	case SF_FORMAT_W64:
+	case SF_FORMAT_RF64:
+		return header.samplerate != samplerate;
+	default:
+		return true;
+	}
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -77,6 +128,37 @@ std::string makeWavePath_(const std::string& base, const m::Wave& w, int k)
 
 /* -------------------------------------------------------------------------- */
 
+/* makePeaksPath_
+Returns the path of the peaks file that goes along with the audio file 'path',
+e.g. /path/to/sample.wav -> /path/to/sample.wav.peaks */
+
+std::string makePeaksPath_(const std::string& path)
+{
+	return path + ".peaks";
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* saveStreamed_
+A streamed Wave can't be edited, so its content is the source file: just copy it
+over, unless source and destination are the same file. */
+
+int saveStreamed_(const Wave& w, const std::string& path)
+{
+	if (w.getPath() == path)
+		return G_RES_OK;
+	std::error_code ec;
+	std::filesystem::copy_file(w.getPath(), path, std::filesystem::copy_options::overwrite_existing, ec);
+	if (ec)
+	{
+		u::log::print("[waveFactory::save] unable to copy {} to {}: {}\n", w.getPath(), path, ec.message());
+		return G_RES_ERR_IO;
+	}
+	return G_RES_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool isWavePathUnique_(const m::Wave& skip, const std::string& path,
     const std::vector<std::unique_ptr<Wave>>& waves)
 {
@@ -113,12 +195,14 @@ std::string makeUniqueWavePath(const std::string& base, const m::Wave& w,
 
 void reset()
 {
+	std::scoped_lock lock(waveIdMutex_);
 	waveId_ = IdManager();
 }
 
 /* -------------------------------------------------------------------------- */
 
-Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality quality)
+Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality quality,
+    Frame streamThreshold)
 {
 	if (path == "" || utils::fs::isDir(path))
 	{
@@ -144,13 +228,33 @@ Result createFromFile(const std::string& path, ID id, int samplerate, Resampler:
 		return {G_RES_ERR_WRONG_DATA};
 	}
 
-	waveId_.set(id);
+	/* Long samples are streamed from disk: only the head is loaded here, the
+	rest is read on the fly by a DiskStream. Streaming requires no sample rate
+	conversion, which is performed on the whole Wave. */
+
+	const Frame headFrames = G_STREAM_HEAD_SECONDS * header.samplerate;
+	const bool  isLong     = streamThreshold > 0 && header.frames > std::max(streamThreshold, headFrames);
+	const bool  stream     = isLong && header.samplerate == samplerate;
+	const Frame readFrames = stream ? headFrames : static_cast<Frame>(header.frames);
+
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(generateWaveId_(id));
+
+	/* Decoding compressed formats and converting sample rate are expensive:
+	look for an already decoded copy in the PCM cache first. */
+
+	const bool cacheable = !stream && isExpensive_(header, samplerate);
+
+	if (cacheable && pcmCache::read(path, samplerate, quality, *wave))
+	{
+		sf_close(fileIn);
+		u::log::print("[waveFactory::create] new Wave created from cache, {} frames\n", wave->getLength());
+		return {G_RES_OK, std::move(wave)};
+	}
 
-	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate(id));
-	wave->alloc(header.frames, header.channels, header.samplerate, getBits_(header), path);
+	wave->alloc(readFrames, header.channels, header.samplerate, getBits_(header), path);
 
-	std::vector<float> tempData(header.frames * header.channels);
-	if (sf_readf_float(fileIn, tempData.data(), header.frames) != header.frames)
+	std::vector<float> tempData(readFrames * header.channels);
+	if (sf_readf_float(fileIn, tempData.data(), readFrames) != readFrames)
 		u::log::print("[waveFactory::create] warning: incomplete read!\n");
 
 	sf_close(fileIn);
@@ -159,13 +263,22 @@ Result createFromFile(const std::string& path, ID id, int samplerate, Resampler:
 	deinterleave samples here so the in-memory layout matches AudioBuffer. */
 	// TODO - add libsndfile wrapper with auto cleanup for sf_close()
 
-	for (sf_count_t i = 0; i < header.frames; ++i)
+	for (Frame i = 0; i < readFrames; ++i)
 		for (int ch = 0; ch < header.channels; ++ch)
 			wave->getBuffer().getChannelView(ch).data()[i] = tempData[i * header.channels + ch];
 
 	if (header.channels == 1 && !wfx::monoToStereo(*wave))
 		return {G_RES_ERR_PROCESSING};
 
+	if (stream)
+	{
+		const Frame capacity = std::max(G_STREAM_RING_SECONDS * samplerate, G_STREAM_WINDOW_FRAMES * 2);
+		wave->setStream(DiskStream::open(path, readFrames, capacity));
+		if (!wave->isStreamed())
+			return {G_RES_ERR_IO};
+		u::log::print("[waveFactory::create] streaming from disk, {} frames preloaded\n", readFrames);
+	}
+
 	if (wave->getRate() != samplerate)
 	{
 		u::log::print("[waveFactory::create] file sample rate ({}) != project sample rate ({}), conversion needed\n",
@@ -174,7 +287,10 @@ Result createFromFile(const std::string& path, ID id, int samplerate, Resampler:
 			return {G_RES_ERR_PROCESSING};
 	}
 
-	u::log::print("[waveFactory::create] new Wave created, {} frames\n", wave->getBuffer().countFrames());
+	if (cacheable)
+		pcmCache::write(path, samplerate, quality, *wave);
+
+	u::log::print("[waveFactory::create] new Wave created, {} frames\n", wave->getLength());
 
 	return {G_RES_OK, std::move(wave)};
 }
@@ -184,7 +300,7 @@ Result createFromFile(const std::string& path, ID id, int samplerate, Resampler:
 std::unique_ptr<Wave> createEmpty(int frames, int channels, int samplerate,
     const std::string& name)
 {
-	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate());
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(generateWaveId_());
 	wave->alloc(frames, channels, samplerate, G_DEFAULT_BIT_DEPTH, name);
 	wave->setLogical(true);
 
@@ -198,15 +314,38 @@ std::unique_ptr<Wave> createEmpty(int frames, int channels, int samplerate,
 
 std::unique_ptr<Wave> createFromWave(const Wave& src, int a, int b)
 {
+	/* A streamed Wave can only be duplicated as a whole, by streaming the same
+	file again. Same for compact Waves, that share the compact data. */
+
+	if (!src.isResident())
+	{
+		assert(a == -1 && b == -1);
+		std::unique_ptr<Wave> wave = std::make_unique<Wave>(src);
+		wave->id                   = generateWaveId_();
+		return wave;
+	}
+
 	a = a == -1 ? 0 : a;
 	b = b == -1 ? src.getBuffer().countFrames() : b;
 
 	const int channels = src.getBuffer().countChannels();
 	const int frames   = b - a;
 
-	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate());
-	wave->alloc(frames, channels, src.getRate(), src.getBits(), src.getPath());
-	wave->getBuffer().setAll(src.getBuffer(), frames, 0, 0);
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(generateWaveId_());
+
+	/* A whole copy just shares the audio data with the source Wave, which will be
+	duplicated only if one of the two gets edited. */
+
+	if (frames == src.getBuffer().countFrames())
+	{
+		wave->shareData(src);
+		wave->setPath(src.getPath());
+	}
+	else
+	{
+		wave->alloc(frames, channels, src.getRate(), src.getBits(), src.getPath());
+		wave->getBuffer().setAll(src.getBuffer(), frames, /*srcOffset=*/a, /*destOffset=*/0);
+	}
 	wave->setLogical(true);
 
 	u::log::print("[waveFactory::createFromWave] new Wave created, {} frames\n", frames);
@@ -216,14 +355,75 @@ std::unique_ptr<Wave> createFromWave(const Wave& src, int a, int b)
 
 /* -------------------------------------------------------------------------- */
 
-std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality quality)
+std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality quality,
+    Frame streamThreshold)
 {
-	return createFromFile(w.path, w.id, samplerate, quality).wave;
+	std::unique_ptr<Wave> wave = createFromFile(w.path, w.id, samplerate, quality, streamThreshold).wave;
+	if (wave == nullptr)
+		return nullptr;
+	if (w.storage != SampleStorage::FLOAT)
+		setStorage(*wave, w.storage);
+
+	/* Peaks are read later on, when first displayed. Remember which audio file
+	they must match: a cheap check of size and modification time, with no need
+	to go through the audio data. */
+
+	const std::string peaksPath = makePeaksPath_(w.path);
+	if (wave->isResident() && utils::fs::fileExists(peaksPath))
+		if (const std::optional<Peaks::Source> source = Peaks::getSource(w.path); source.has_value())
+			wave->setPeaksFile(peaksPath, *source);
+	return wave;
 }
 
+std::vector<std::unique_ptr<Wave>> deserializeWaves(const std::vector<Patch::Wave>& waves, int samplerate,
+    Resampler::Quality quality, Frame streamThreshold, std::function<void(float)> progress)
+{
+	std::vector<std::unique_ptr<Wave>> out(waves.size());
+	std::atomic<std::size_t>           next = 0;
+	std::atomic<std::size_t>           done = 0;
+
+	/* Each thread picks the next Wave to decode, until there are none left. */
+
+	const auto decode = [&]()
+	{
+		for (std::size_t i = next++; i < waves.size(); i = next++)
+		{
+			out[i] = deserializeWave(waves[i], samplerate, quality, streamThreshold);
+			done++;
+			done.notify_one();
+		}
+	};
+
+	const std::size_t numThreads = std::min<std::size_t>(waves.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < numThreads; i++)
+		threads.emplace_back(decode);
+
+	/* Progress is reported from the calling thread only, as the callback might
+	touch the UI. */
+
+	for (std::size_t d = done.load(); d < waves.size(); d = done.load())
+	{
+		progress(d / static_cast<float>(waves.size()));
+		done.wait(d);
+	}
+
+	for (std::thread& t : threads)
+		t.join();
+
+	progress(1.0f);
+
+	u::log::print("[waveFactory::deserializeWaves] {} Waves decoded with {} threads\n", waves.size(), numThreads);
+
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
 const Patch::Wave serializeWave(const Wave& w)
 {
-	return {w.id, utils::fs::basename(w.getPath())};
+	return {w.id, utils::fs::basename(w.getPath()), w.getStorage()};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -236,23 +436,35 @@ int resample(Wave& w, Resampler::Quality quality, int samplerate)
 	mcl::AudioBuffer newData;
 	newData.alloc(newSizeFrames, w.getBuffer().countChannels());
 
-	SRC_DATA src_data;
-	src_data.data_in       = w.getBuffer().getDataView().data();
-	src_data.input_frames  = w.getBuffer().countFrames();
-	src_data.data_out      = newData.getDataView().data();
-	src_data.output_frames = newSizeFrames;
-	src_data.src_ratio     = ratio;
-
 	u::log::print("[waveFactory::resample] resampling: new size={} frames\n", newSizeFrames);
 
-	int ret = src_simple(&src_data, static_cast<int>(quality), w.getBuffer().countChannels());
-	if (ret != 0)
+	if (Resampler::isBuiltin(quality))
+	{
+		/* The built-in resampler wants the opposite ratio: input frames read for
+		each output frame. */
+
+		const Resampler resampler(quality);
+		resampler.process(w.getBuffer(), 0, w.getBuffer().countFrames(), newData, 0, 1 / ratio);
+	}
+	else
 	{
-		u::log::print("[waveFactory::resample] resampling error: {}\n", src_strerror(ret));
-		return G_RES_ERR_PROCESSING;
+		SRC_DATA src_data;
+		src_data.data_in       = w.getBuffer().getDataView().data();
+		src_data.input_frames  = w.getBuffer().countFrames();
+		src_data.data_out      = newData.getDataView().data();
+		src_data.output_frames = newSizeFrames;
+		src_data.src_ratio     = ratio;
+
+		int ret = src_simple(&src_data, static_cast<int>(quality), w.getBuffer().countChannels());
+		if (ret != 0)
+		{
+			u::log::print("[waveFactory::resample] resampling error: {}\n", src_strerror(ret));
+			return G_RES_ERR_PROCESSING;
+		}
 	}
 
 	w.replaceData(std::move(newData));
+	w.updatePeaks(0, w.getLength());
 	w.setRate(samplerate);
 
 	return G_RES_OK;
@@ -260,11 +472,47 @@ int resample(Wave& w, Resampler::Quality quality, int samplerate)
 
 /* -------------------------------------------------------------------------- */
 
+int setStorage(Wave& w, SampleStorage storage)
+{
+	if (w.getStorage() == storage)
+		return G_RES_OK;
+
+	if (w.isStreamed())
+	{
+		u::log::print("[waveFactory::setStorage] can't change storage of a streamed Wave\n");
+		return G_RES_ERR_WRONG_DATA;
+	}
+
+	/* Compact to compact conversions go through float. */
+
+	if (w.isCompact())
+		w.replaceData(w.getCompact()->toFloat());
+
+	if (storage != SampleStorage::FLOAT)
+		w.setCompact(std::make_shared<const CompactBuffer>(std::as_const(w).getBuffer(), storage));
+	else
+		w.computePeaks(); // Compact Waves have none
+
+	u::log::print("[waveFactory::setStorage] Wave {} storage changed, {} bytes in use\n", w.id.getValue(), w.getDataSize());
+
+	return G_RES_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+
 int save(const Wave& w, const std::string& path)
 {
+	if (w.isStreamed())
+		return saveStreamed_(w, path);
+
+	/* Compact Waves are saved as float, as any other Wave. */
+
+	const mcl::AudioBuffer  expanded = w.isCompact() ? w.getCompact()->toFloat() : mcl::AudioBuffer();
+	const mcl::AudioBuffer& buffer   = w.isCompact() ? expanded : w.getBuffer();
+
 	SF_INFO header;
 	header.samplerate = w.getRate();
-	header.channels   = w.getBuffer().countChannels();
+	header.channels   = buffer.countChannels();
 	header.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
 
 	SNDFILE* file = sf_open(path.c_str(), SFM_WRITE, &header);
@@ -275,11 +523,26 @@ int save(const Wave& w, const std::string& path)
 		return G_RES_ERR_IO;
 	}
 
-	if (sf_writef_float(file, w.getBuffer().getDataView().data(), w.getBuffer().countFrames()) != w.getBuffer().countFrames())
+	if (sf_writef_float(file, buffer.getDataView().data(), buffer.countFrames()) != buffer.countFrames())
 		u::log::print("[waveFactory::save] warning: incomplete write!\n");
 
 	sf_close(file);
 
 	return G_RES_OK;
 }
+
+/* -------------------------------------------------------------------------- */
+
+int savePeaks(const Wave& w)
+{
+	const Peaks* peaks = w.getPeaks();
+	if (!w.isResident() || peaks == nullptr || !peaks->isReady())
+		return G_RES_ERR_NO_DATA;
+
+	const std::optional<Peaks::Source> source = Peaks::getSource(w.getPath());
+	if (!source.has_value())
+		return G_RES_ERR_IO;
+
+	return peaks->save(makePeaksPath_(w.getPath()), *source) ? G_RES_OK : G_RES_ERR_IO;
+}
 } // namespace giada::m::waveFactory
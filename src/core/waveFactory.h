@@ -32,8 +32,10 @@
 #include "src/core/resampler.h"
 #include "src/core/types.h"
 #include "src/core/wave.h"
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace giada::m::waveFactory
 {
@@ -53,7 +55,8 @@ void reset();
     auto-generate it. The function converts the Wave sample rate if it doesn't
     match the desired one as specified in 'samplerate'. */
 
-Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality);
+Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality,
+    Frame streamThreshold = 0);
 
 /* createEmpty
     Creates a new silent Wave object. */
@@ -70,20 +73,45 @@ std::unique_ptr<Wave> createFromWave(const Wave& src, int a = -1, int b = -1);
 /* (de)serializeWave
     Creates a new Wave given the patch raw data and vice versa. */
 
-std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality);
+std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality,
+    Frame streamThreshold = 0);
 const Patch::Wave     serializeWave(const Wave& w);
 
+/* deserializeWaves
+Same as deserializeWave() above, for multiple Waves at once. Waves are decoded
+and resampled in parallel on a pool of temporary threads. 'progress' is called
+on the calling thread. Missing Waves are returned as nullptr, in the same order
+as in 'waves'. */
+
+std::vector<std::unique_ptr<Wave>> deserializeWaves(const std::vector<Patch::Wave>&, int samplerate,
+    Resampler::Quality, Frame streamThreshold, std::function<void(float)> progress);
+
 /* resample
     Change sample rate of 'w' to the desider value. The 'quality' parameter sets
     the algorithm to use for the conversion. */
 
 int resample(Wave&, Resampler::Quality, int samplerate);
 
+/* setStorage
+Converts the in-memory audio data of 'w' to the given storage. Streamed Waves
+are left untouched and G_RES_ERR_WRONG_DATA is returned. */
+
+int setStorage(Wave& w, SampleStorage);
+
 /* save
     Writes Wave data to file 'path'. Only 'wav' format is supported for now. */
 
 int save(const Wave& w, const std::string& path);
 
+/* savePeaks
+Writes the peak overview of 'w' next to its audio file, so that it doesn't have
+to be computed again on the next load. Must be called after the audio file has
+been written: peaks are bound to its size and modification time. Returns
+G_RES_ERR_NO_DATA if peaks are not available, i.e. the Wave is not resident or
+still being analyzed. */
+
+int savePeaks(const Wave& w);
+
 std::string makeUniqueWavePath(const std::string& base, const m::Wave& w,
     const std::vector<std::unique_ptr<Wave>>& waves);
 } // namespace giada::m::waveFactory
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <utility>
 
 /* Windows fix */
 #ifdef _WIN32
@@ -83,6 +84,7 @@ void normalize(Wave& w, int a, int b)
 		for (int j = 0; j < w.getBuffer().countChannels(); j++)
 			w.getBuffer().at(i, j) = w.getBuffer().at(i, j) * (1.0f / peak);
 	}
+	w.updatePeaks(a, b);
 	w.setEdited(true);
 }
 
@@ -90,15 +92,24 @@ void normalize(Wave& w, int a, int b)
 
 int monoToStereo(Wave& w)
 {
-	if (w.getBuffer().countChannels() >= G_MAX_IO_CHANS)
+	/* Functions that replace the whole audio data read the old one through a
+	const reference, so that a buffer shared with other Waves is not needlessly
+	copied (see Wave::getBuffer()). */
+
+	const mcl::AudioBuffer& buffer = std::as_const(w).getBuffer();
+
+	if (buffer.countChannels() >= G_MAX_IO_CHANS)
 		return G_RES_OK;
 
 	mcl::AudioBuffer newData;
-	newData.alloc(w.getBuffer().countFrames(), G_MAX_IO_CHANS);
+	newData.alloc(buffer.countFrames(), G_MAX_IO_CHANS);
 
 	for (int i = 0; i < newData.countFrames(); i++)
 		for (int j = 0; j < newData.countChannels(); j++)
-			newData.at(i, j) = w.getBuffer().at(i, 0);
+			newData.at(i, j) = buffer.at(i, 0);
+
+	/* Both channels hold the same data as before: the mono mix-down, and so the
+	peaks, are unchanged. */
 
 	w.replaceData(std::move(newData));
 
@@ -114,6 +125,7 @@ void silence(Wave& w, int a, int b)
 	for (int i = a; i < b; i++)
 		for (int j = 0; j < w.getBuffer().countChannels(); j++)
 			w.getBuffer().at(i, j) = 0.0f;
+	w.updatePeaks(a, b);
 	w.setEdited(true);
 }
 
@@ -121,32 +133,35 @@ void silence(Wave& w, int a, int b)
 
 void cut(Wave& w, int a, int b)
 {
+	const mcl::AudioBuffer& buffer = std::as_const(w).getBuffer();
+
 	if (a < 0)
 		a = 0;
-	if (b > w.getBuffer().countFrames())
-		b = w.getBuffer().countFrames();
+	if (b > buffer.countFrames())
+		b = buffer.countFrames();
 
 	/* Create a new temp wave and copy there the original one, skipping the a-b
 	range. */
 
-	int newSize = w.getBuffer().countFrames() - (b - a);
+	int newSize = buffer.countFrames() - (b - a);
 
 	mcl::AudioBuffer newData;
-	newData.alloc(newSize, w.getBuffer().countChannels());
+	newData.alloc(newSize, buffer.countChannels());
 
 	u::log::print("[wfx::cut] cutting from {} to {}\n", a, b);
 
-	for (int i = 0, k = 0; i < w.getBuffer().countFrames(); i++)
+	for (int i = 0, k = 0; i < buffer.countFrames(); i++)
 	{
 		if (i < a || i >= b)
 		{
-			for (int j = 0; j < w.getBuffer().countChannels(); j++)
-				newData.at(k, j) = w.getBuffer().at(i, j);
+			for (int j = 0; j < buffer.countChannels(); j++)
+				newData.at(k, j) = buffer.at(i, j);
 			k++;
 		}
 	}
 
 	w.replaceData(std::move(newData));
+	w.updatePeaks(a, newSize);
 	w.setEdited(true);
 }
 
@@ -154,23 +169,26 @@ void cut(Wave& w, int a, int b)
 
 void trim(Wave& w, Frame a, Frame b)
 {
+	const mcl::AudioBuffer& buffer = std::as_const(w).getBuffer();
+
 	if (a < 0)
 		a = 0;
-	if (b > w.getBuffer().countFrames())
-		b = w.getBuffer().countFrames();
+	if (b > buffer.countFrames())
+		b = buffer.countFrames();
 
 	Frame newSize = b - a;
 
 	mcl::AudioBuffer newData;
-	newData.alloc(newSize, w.getBuffer().countChannels());
+	newData.alloc(newSize, buffer.countChannels());
 
 	u::log::print("[wfx::trim] trimming from {} to {} (area = {})\n", a, b, b - a);
 
 	for (int i = 0; i < newData.countFrames(); i++)
 		for (int j = 0; j < newData.countChannels(); j++)
-			newData.at(i, j) = w.getBuffer().at(i + a, j);
+			newData.at(i, j) = buffer.at(i + a, j);
 
 	w.replaceData(std::move(newData));
+	w.updatePeaks(0, newSize);
 	w.setEdited(true);
 }
 
@@ -179,12 +197,14 @@ void trim(Wave& w, Frame a, Frame b)
 void paste(const Wave& src, Wave& des, Frame a)
 {
 	const mcl::AudioBuffer& srcBuffer = src.getBuffer();
-	const mcl::AudioBuffer& desBuffer = des.getBuffer();
+	const mcl::AudioBuffer& desBuffer = std::as_const(des).getBuffer();
 
 	assert(srcBuffer.countChannels() == desBuffer.countChannels());
 
+	const Frame newSize = srcBuffer.countFrames() + desBuffer.countFrames();
+
 	mcl::AudioBuffer newData;
-	newData.alloc(srcBuffer.countFrames() + desBuffer.countFrames(), desBuffer.countChannels());
+	newData.alloc(newSize, desBuffer.countChannels());
 
 	/* |---original data---|///paste data///|---original data---|
 	         des[0, a)      src[0, src.size)   des[a, des.size)	*/
@@ -194,6 +214,7 @@ void paste(const Wave& src, Wave& des, Frame a)
 	newData.setAll(desBuffer, /*framesToCopy=*/-1, /*srcOffset=*/a, /*dstOffset=*/srcBuffer.countFrames() + a);
 
 	des.replaceData(std::move(newData));
+	des.updatePeaks(a, newSize);
 	des.setEdited(true);
 }
 
@@ -213,6 +234,7 @@ void fade(Wave& w, int a, int b, Fade type)
 		for (int i = b; i >= a; i--, m += d)
 			fadeFrame_(w, i, m);
 
+	w.updatePeaks(a, b + 1);
 	w.setEdited(true);
 }
 
@@ -253,6 +275,7 @@ void shift(Wave& w, Frame offset)
 		std::rotate(begin, begin + offset, begin + frames);
 	}
 
+	w.updatePeaks(0, frames);
 	w.setEdited(true);
 }
 
@@ -267,6 +290,7 @@ void reverse(Wave& w, Frame a, Frame b)
 		std::reverse(begin, end);
 	}
 
+	w.updatePeaks(a, b);
 	w.setEdited(true);
 }
 } // namespace giada::m::wfx
@@ -25,13 +25,18 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/worker.h"
-#include "src/deps/mcl-utils/src/time.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 
 namespace giada
 {
-Worker::Worker(int sleep)
+Worker::Worker(int sleep, int rtPoll)
 : m_running(false)
+, m_wakeUp(0)
+, m_pending(false)
 , m_sleep(sleep)
+, m_rtPoll(rtPoll)
 {
 }
 
@@ -46,16 +51,36 @@ Worker::~Worker()
 
 void Worker::start(std::function<void()> f) const
 {
-	namespace time = mcl::utils::time;
-
 	stop();
 	m_running.store(true);
 	m_thread = std::thread([this, f]()
 	{
 		while (m_running.load() == true)
 		{
+			m_pending.store(false);
 			f();
-			time::sleep(m_sleep);
+
+			/* Sleep until notified or timed out. If the realtime thread can
+			notify too, wake up every 'rtPoll' milliseconds to check its flag.
+			Notifications that piled up in the meantime are all served by the
+			next run. */
+
+			using Clock = std::chrono::steady_clock;
+
+			const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(m_sleep);
+			while (m_running.load() && !m_pending.load())
+			{
+				const Clock::time_point now = Clock::now();
+				if (now >= deadline)
+					break;
+				Clock::duration timeout = deadline - now;
+				if (m_rtPoll > 0)
+					timeout = std::min<Clock::duration>(timeout, std::chrono::milliseconds(m_rtPoll));
+				if (m_wakeUp.try_acquire_for(timeout))
+					break;
+			}
+			while (m_wakeUp.try_acquire())
+				continue;
 		}
 	});
 }
@@ -65,8 +90,26 @@ void Worker::start(std::function<void()> f) const
 void Worker::stop() const
 {
 	m_running.store(false);
-	if (m_thread.joinable())
-		m_thread.join();
+	if (!m_thread.joinable())
+		return;
+	m_wakeUp.release(); // Don't wait for the sleep time to expire
+	m_thread.join();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Worker::notify() const
+{
+	m_wakeUp.release();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Worker::notify_RT() const
+{
+	assert(m_rtPoll > 0);
+
+	m_pending.store(true);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -29,6 +29,7 @@
 
 #include <atomic>
 #include <functional>
+#include <semaphore>
 #include <thread>
 
 namespace giada
@@ -36,17 +37,42 @@ namespace giada
 class Worker
 {
 public:
-	Worker(int sleep);
+	/* Worker
+	'rtPoll' is how often, in milliseconds, the sleeping worker checks for
+	notifications coming from the realtime thread (see notify_RT()). Zero if it
+	never gets any. */
+
+	Worker(int sleep, int rtPoll = 0);
 	~Worker();
 
+	/* start
+	Runs the function on a separate thread over and over, waiting at most
+	'sleep' milliseconds between each run. Call notify() to wake it up earlier. */
+
 	void start(std::function<void()>) const;
 	void stop() const;
 	void setSleep(int sleep);
 
+	/* notify
+	Wakes the worker up, so that it runs the function right away. Never blocks,
+	but it might perform a system call to wake the sleeping thread: not for the
+	realtime thread. */
+
+	void notify() const;
+
+	/* notify_RT
+	Asks the worker to run the function on its next check, i.e. within 'rtPoll'
+	milliseconds. Just sets a flag: no locks, no system calls. */
+
+	void notify_RT() const;
+
 private:
-	mutable std::thread       m_thread;
-	mutable std::atomic<bool> m_running;
-	int                       m_sleep;
+	mutable std::thread               m_thread;
+	mutable std::atomic<bool>         m_running;
+	mutable std::counting_semaphore<> m_wakeUp;
+	mutable std::atomic<bool>         m_pending;
+	int                               m_sleep;
+	int                               m_rtPoll;
 };
 } // namespace giada
 
@@ -132,6 +132,7 @@ Data::Data(const m::Channel& c, Scene scene, std::size_t trackIndex, std::size_t
 , m_playStatus(&c.shared->playStatus)
 , m_recStatus(&c.shared->recStatus)
 , m_readActions(&c.shared->readActions)
+, m_dspLoad(&c.shared->dspLoad)
 {
 	if (c.type == ChannelType::SAMPLE)
 		sample = std::make_optional<SampleData>(c, scene);
@@ -149,6 +150,8 @@ bool          Data::isSoloed() const { return g_engine->getChannelsApi().get(id)
 bool          Data::isArmed() const { return g_engine->getChannelsApi().get(id).armed; }
 bool          Data::isActive() const { return g_engine->getChannelsApi().get(id).isActive(); }
 
+m::DspLoad::Value Data::getDspLoad() const { return g_engine->getMainApi().getDspLoad(*m_dspLoad); }
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
@@ -27,6 +27,7 @@
 #ifndef G_GLUE_CHANNEL_H
 #define G_GLUE_CHANNEL_H
 
+#include "src/core/dspLoad.h"
 #include "src/core/types.h"
 #include "src/core/weakAtomic.h"
 #include "src/deps/geompp/src/line.hpp"
@@ -98,6 +99,12 @@ struct Data
 	bool          isArmed() const;
 	bool          isActive() const;
 
+	/* getDspLoad
+	Returns the time spent rendering this channel, plug-ins included, as a
+	percentage of the audio block duration. */
+
+	m::DspLoad::Value getDspLoad() const;
+
 	ID                      id;
 	std::size_t             trackIndex;
 	std::size_t             channelIndex;
@@ -119,6 +126,7 @@ private:
 	WeakAtomic<ChannelStatus>* m_playStatus;
 	WeakAtomic<ChannelStatus>* m_recStatus;
 	WeakAtomic<bool>*          m_readActions;
+	const m::DspLoad*          m_dspLoad;
 };
 
 struct Track
@@ -55,6 +55,7 @@
 #include "src/gui/dialogs/pluginChooser.h"
 #include "src/gui/dialogs/pluginList.h"
 #include "src/gui/dialogs/sampleEditor.h"
+#include "src/gui/dialogs/warnings.h"
 #include "src/gui/ui.h"
 
 extern giada::v::Ui*     g_ui;
@@ -80,6 +81,18 @@ void openBrowserForProjectSave()
 
 /* -------------------------------------------------------------------------- */
 
+void openBrowserForBounce(m::Bouncer::Stems stems)
+{
+	const auto callback = [stems](void* data)
+	{ c::storage::bounce(data, stems); };
+
+	v::gdWindow* childWin = new v::gdBrowserSave(g_ui->getI18Text(v::LangMap::BROWSER_BOUNCE),
+	    g_ui->model.patchPath, g_ui->model.projectName, callback, {}, g_ui->model);
+	g_ui->openSubWindow(childWin);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void openBrowserForSampleLoad(ID channelId)
 {
 	v::gdWindow* w = new v::gdBrowserLoad(g_ui->getI18Text(v::LangMap::BROWSER_OPENSAMPLE),
@@ -184,6 +197,11 @@ void openSampleEditor(ID channelId)
 	resulting in a broken Editor (gdSampleEditor's destructor frees the loaded
 	sample). */
 	g_ui->closeSubWindow(WID_SAMPLE_EDITOR);
+	if (g_engine->getSampleEditorApi().makeResident(channelId) != G_RES_OK)
+	{
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_CHANNEL_CANTREADSAMPLE));
+		return;
+	}
 	g_ui->openSubWindow(new v::gdSampleEditor(channelId, g_ui->model));
 }
 
@@ -50,6 +50,7 @@ namespace giada::c::layout
 {
 void openBrowserForProjectLoad();
 void openBrowserForProjectSave();
+void openBrowserForBounce(m::Bouncer::Stems);
 void openBrowserForSampleLoad(ID channelId);
 void openAboutWindow();
 void openKeyGrabberWindow(int key, std::function<bool(int)>);
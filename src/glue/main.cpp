@@ -323,6 +323,22 @@ double getCpuLoad() { return g_engine->getMainApi().getCpuLoad(); }
 
 /* -------------------------------------------------------------------------- */
 
+m::DspLoad::Value getMixerDspLoad() { return g_engine->getMainApi().getMixerDspLoad(); }
+
+/* -------------------------------------------------------------------------- */
+
+m::model::Reclaimer::Stats getPendingDeletions() { return g_engine->getMainApi().getPendingDeletions(); }
+
+/* -------------------------------------------------------------------------- */
+
+int getStreamUnderruns() { return g_engine->getMainApi().getStreamUnderruns(); }
+
+/* -------------------------------------------------------------------------- */
+
+void collectPlugins() { g_engine->getMainApi().collectPlugins(); }
+
+/* -------------------------------------------------------------------------- */
+
 #if G_DEBUG_MODE
 
 void printDebugInfo()
@@ -27,6 +27,8 @@
 #ifndef G_MAIN_H
 #define G_MAIN_H
 
+#include "src/core/dspLoad.h"
+#include "src/core/model/reclaimer.h"
 #include "src/core/types.h"
 #include "src/scene.h"
 #include "src/types.h"
@@ -149,6 +151,30 @@ void   toggleInputRecording();
 void   setScene(Scene, bool forced);
 double getCpuLoad();
 
+/* getMixerDspLoad
+Returns the time spent by the Mixer processing the input, as a percentage of
+the audio block duration. */
+
+m::DspLoad::Value getMixerDspLoad();
+
+/* getPendingDeletions
+Returns how much removed data is waiting to be freed, once the audio thread is
+done with it. */
+
+m::model::Reclaimer::Stats getPendingDeletions();
+
+/* getStreamUnderruns
+Returns how many times a streamed sample, read from disk or stretched in
+background, wasn't ready in time for the audio thread. */
+
+int getStreamUnderruns();
+
+/* collectPlugins
+Frees the removed plug-ins the audio thread is done with. Call it periodically
+from the main thread. */
+
+void collectPlugins();
+
 #if G_DEBUG_MODE
 void printDebugInfo();
 #endif
@@ -111,6 +111,13 @@ juce::AudioProcessorEditor* Plugin::createEditor() const
 
 /* -------------------------------------------------------------------------- */
 
+m::DspLoad::Value Plugin::getDspLoad() const
+{
+	return g_engine->getMainApi().getDspLoad(m_plugin.dspLoad);
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Plugin::hasEditor() const
 {
 	return m_plugin.hasEditor();
@@ -27,6 +27,7 @@
 #ifndef G_GLUE_PLUGIN_H
 #define G_GLUE_PLUGIN_H
 
+#include "src/core/dspLoad.h"
 #include "src/core/types.h"
 #include "src/types.h"
 #include <functional>
@@ -77,6 +78,12 @@ struct Plugin
 	juce::AudioProcessorEditor* createEditor() const;
 	bool                        hasEditor() const;
 
+	/* getDspLoad
+	Returns the time spent processing audio by this plug-in, as a percentage of
+	the audio block duration. */
+
+	m::DspLoad::Value getDspLoad() const;
+
 	void setResizeCallback(std::function<void(int, int)> f);
 
 	ID          id;
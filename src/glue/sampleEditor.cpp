@@ -49,7 +49,7 @@ Data::Data(const m::Channel& c, Scene scene)
 {
 	if (!isValid())
 		return;
-	waveSize     = c.sampleChannel->getWave(scene)->getBuffer().countFrames();
+	waveSize     = c.sampleChannel->getWave(scene)->getLength();
 	waveBits     = c.sampleChannel->getWave(scene)->getBits();
 	waveDuration = c.sampleChannel->getWave(scene)->getDuration();
 	waveRate     = c.sampleChannel->getWave(scene)->getRate();
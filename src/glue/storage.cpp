@@ -169,6 +169,35 @@ void saveProject(void* data)
 
 /* -------------------------------------------------------------------------- */
 
+void bounce(void* data, m::Bouncer::Stems stems)
+{
+	v::gdBrowserSave* browser = static_cast<v::gdBrowserSave*>(data);
+
+	const std::string fileName = utils::fs::stripExt(browser->getName());
+	const std::string filePath = utils::fs::join(browser->getCurrentPath(), fileName + ".wav");
+
+	if (!validateFileName_(fileName))
+		return;
+
+	if (utils::fs::fileExists(filePath) &&
+	    !v::gdConfirmWin(g_ui->getI18Text(v::LangMap::COMMON_WARNING),
+	        g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_FILEEXISTS)))
+		return;
+
+	auto uiProgress     = g_ui->mainWindow->getScopedProgress(g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_BOUNCING));
+	auto engineProgress = [&uiProgress](float v)
+	{ uiProgress.setProgress(v); };
+
+	const m::Bouncer::Options options = {.path = filePath, .stems = stems};
+
+	if (g_engine->getStorageApi().bounce(options, engineProgress) == G_RES_OK)
+		browser->do_callback();
+	else
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_BOUNCINGERROR));
+}
+
+/* -------------------------------------------------------------------------- */
+
 void loadSample(void* data)
 {
 	v::gdBrowserLoad* browser  = static_cast<v::gdBrowserLoad*>(data);
@@ -27,6 +27,8 @@
 #ifndef G_GLUE_STORAGE_H
 #define G_GLUE_STORAGE_H
 
+#include "src/core/bouncer.h"
+
 /* giada::c::storage
 Persistence functions. Only the main thread can use these! */
 
@@ -34,6 +36,7 @@ namespace giada::c::storage
 {
 void loadProject(void* data);
 void saveProject(void* data);
+void bounce(void* data, m::Bouncer::Stems);
 void loadSample(void* data);
 } // namespace giada::c::storage
 
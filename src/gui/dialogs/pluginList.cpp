@@ -26,6 +26,7 @@
 
 #include "src/gui/dialogs/pluginList.h"
 #include "src/glue/layout.h"
+#include "src/gui/const.h"
 #include "src/gui/elems/basics/liquidScroll.h"
 #include "src/gui/elems/basics/textButton.h"
 #include "src/gui/elems/mainWindow/keyboard/channel.h"
@@ -40,6 +41,7 @@ namespace giada::v
 gdPluginList::gdPluginList(ID channelId, geompp::Rect<int> bounds)
 : gdWindow(u::gui::getCenterWinBounds(bounds), "", WID_FX_LIST)
 , m_channelId(channelId)
+, m_refreshCounter(0)
 {
 	end();
 
@@ -95,6 +97,20 @@ void gdPluginList::rebuild()
 
 /* -------------------------------------------------------------------------- */
 
+void gdPluginList::refresh()
+{
+	if (++m_refreshCounter % (G_GUI_FPS / 2) != 0)
+		return;
+	m_refreshCounter = 0;
+
+	/* The last child is the 'add plug-in' button. */
+
+	for (int i = 0; i < list->countChildren() - 1; i++)
+		static_cast<gePluginElement*>(list->child(i))->refresh();
+}
+
+/* -------------------------------------------------------------------------- */
+
 const gePluginElement& gdPluginList::getNextElement(const gePluginElement& currEl) const
 {
 	const int curr = list->find(currEl);
@@ -42,6 +42,7 @@ public:
 	~gdPluginList();
 
 	void rebuild() override;
+	void refresh() override;
 
 	const gePluginElement& getNextElement(const gePluginElement& curr) const;
 	const gePluginElement& getPrevElement(const gePluginElement& curr) const;
@@ -52,6 +53,7 @@ private:
 
 	ID                 m_channelId;
 	c::plugin::Plugins m_plugins;
+	int                m_refreshCounter;
 };
 } // namespace giada::v
 
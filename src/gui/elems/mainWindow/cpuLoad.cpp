@@ -61,7 +61,15 @@ void geCpuLoad::refresh()
 
 	const double load = c::main::getCpuLoad();
 
+	const m::DspLoad::Value          mixerLoad = c::main::getMixerDspLoad();
+	const m::model::Reclaimer::Stats pending   = c::main::getPendingDeletions();
+	const int                        underruns = c::main::getStreamUnderruns();
+
+	const std::string tooltip = fmt::format("Mixer DSP: {:.1f}% (max {:.1f}%)\nPending deletions: {} ({:.1f} MB)\nStream underruns: {}",
+	    mixerLoad.average, mixerLoad.max, pending.objects, pending.bytes / (1024.0 * 1024.0), underruns);
+
 	m_text->setLabel(fmt::format("CPU: {:.1f}%", load));
+	m_text->copy_tooltip(tooltip.c_str());
 	m_meter->value(load);
 
 	redraw();
@@ -31,6 +31,7 @@
 #include "src/gui/graphics.h"
 #include "src/utils/string.h"
 #include <FL/fl_draw.H>
+#include <fmt/core.h>
 
 namespace giada::v
 {
@@ -38,6 +39,7 @@ geChannelButton::geChannelButton(const c::channel::Data& d)
 : gePlayButton()
 , m_channel(d)
 , m_imgExtraOuputs(std::make_unique<Fl_SVG_Image>(nullptr, graphics::extraOutputs))
+, m_dspLoadCounter(0)
 {
 }
 
@@ -45,6 +47,8 @@ geChannelButton::geChannelButton(const c::channel::Data& d)
 
 void geChannelButton::refresh()
 {
+	refreshDspLoad();
+
 	switch (m_channel.getPlayStatus())
 	{
 	case ChannelStatus::OFF:
@@ -88,6 +92,27 @@ void geChannelButton::draw()
 		const auto bounds       = geompp::Rect(x(), y(), 10, 10).withShiftedX(w() - 16).withVerticalCenter(parentCenter);
 		drawImage(*m_imgExtraOuputs, bounds);
 	}
+	if (!m_dspLoad.empty())
+	{
+		const int          rightMargin = m_channel.extraOutputsCount > 0 ? 20 : 4;
+		const geompp::Rect bounds      = geompp::Rect(x(), y(), w() - rightMargin, h());
+		drawText(m_dspLoad, bounds, FL_HELVETICA, G_GUI_FONT_SIZE_BASE, G_COLOR_GREY_4, FL_ALIGN_RIGHT);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void geChannelButton::refreshDspLoad()
+{
+	if (++m_dspLoadCounter % (G_GUI_FPS / 2) != 0)
+		return;
+	m_dspLoadCounter = 0;
+
+	/* Show the readout only when the load is significant, to keep idle channels
+	clean. */
+
+	const m::DspLoad::Value load = m_channel.getDspLoad();
+	m_dspLoad                    = load.average >= 0.1f ? fmt::format("DSP {:.1f}%", load.average) : "";
 }
 
 /* -------------------------------------------------------------------------- */
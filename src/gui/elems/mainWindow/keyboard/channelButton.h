@@ -30,6 +30,7 @@
 #include "src/gui/elems/playButton.h"
 #include <FL/Fl_SVG_Image.H>
 #include <memory>
+#include <string>
 
 namespace giada::c::channel
 {
@@ -51,10 +52,18 @@ public:
 	void setActionRecordState();
 
 protected:
+	/* refreshDspLoad
+	Updates the DSP load readout, a few times per second. */
+
+	void refreshDspLoad();
+
 	const c::channel::Data& m_channel;
 
 private:
 	std::unique_ptr<Fl_SVG_Image> m_imgExtraOuputs;
+
+	int         m_dspLoadCounter;
+	std::string m_dspLoad;
 };
 } // namespace giada::v
 
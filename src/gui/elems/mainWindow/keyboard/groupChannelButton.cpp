@@ -44,6 +44,7 @@ void geGroupChannelButton::refresh()
 {
 	const std::string l = m_channel.name.empty() ? g_ui->getI18Text(LangMap::MAIN_CHANNEL_DEFAULTGROUPNAME) : m_channel.name;
 	copy_label(l.c_str());
+	refreshDspLoad();
 	redraw();
 }
 } // namespace giada::v
@@ -90,6 +90,14 @@ geMainMenu::geMainMenu()
 	{ c::layout::openBrowserForProjectSave(); }),
 	    makeMenuItem_(LangMap::MAIN_MENU_FILE_CLOSEPROJECT, [](Fl_Widget*, void*)
 	{ c::main::closeProject(); }),
+	    beginSubMenu_(LangMap::MAIN_MENU_FILE_BOUNCE),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_BOUNCE_MASTER, [](Fl_Widget*, void*)
+	{ c::layout::openBrowserForBounce(m::Bouncer::Stems::NONE); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_BOUNCE_TRACKS, [](Fl_Widget*, void*)
+	{ c::layout::openBrowserForBounce(m::Bouncer::Stems::TRACKS); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_BOUNCE_CHANNELS, [](Fl_Widget*, void*)
+	{ c::layout::openBrowserForBounce(m::Bouncer::Stems::CHANNELS); }),
+	    endSubMenu_(),
 #if G_DEBUG_MODE
 	    makeMenuItem_(LangMap::MAIN_MENU_FILE_DEBUGSTATS, [](Fl_Widget*, void*)
 	{ c::main::printDebugInfo(); }),
@@ -29,6 +29,7 @@
 #include "src/gui/dialogs/pluginList.h"
 #include "src/gui/dialogs/pluginWindow.h"
 #include "src/gui/dialogs/pluginWindowGUI.h"
+#include "src/gui/elems/basics/box.h"
 #include "src/gui/elems/basics/choice.h"
 #include "src/gui/elems/basics/imageButton.h"
 #include "src/gui/elems/basics/pack.h"
@@ -38,6 +39,7 @@
 #include "src/utils/gui.h"
 #include "src/utils/log.h"
 #include <cassert>
+#include <fmt/core.h>
 #include <string>
 
 extern giada::v::Ui* g_ui;
@@ -50,12 +52,14 @@ gePluginElement::gePluginElement(int x, int y, int w, int h, const c::plugin::Pl
 {
 	button       = new geTextButton("");
 	program      = new geChoice();
+	dspLoad      = new geBox("", FL_ALIGN_RIGHT);
 	bypass       = new geTextButton("");
 	shiftUpBtn   = new geImageButton(graphics::upOff, graphics::upOn);
 	shiftDownBtn = new geImageButton(graphics::downOff, graphics::downOn);
 	remove       = new geImageButton(graphics::removeOff, graphics::removeOn);
 	addWidget(button);
 	addWidget(program);
+	addWidget(dspLoad, 70);
 	addWidget(bypass, G_GUI_UNIT);
 	addWidget(shiftUpBtn, G_GUI_UNIT);
 	addWidget(shiftDownBtn, G_GUI_UNIT);
@@ -107,6 +111,8 @@ gePluginElement::gePluginElement(int x, int y, int w, int h, const c::plugin::Pl
 	{ shiftUp(); };
 	shiftDownBtn->onClick = [this]()
 	{ shiftDown(); };
+
+	refresh();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -118,6 +124,19 @@ ID gePluginElement::getPluginId() const
 
 /* -------------------------------------------------------------------------- */
 
+void gePluginElement::refresh()
+{
+	if (!m_plugin.valid)
+		return;
+
+	const m::DspLoad::Value load = m_plugin.getDspLoad();
+
+	dspLoad->setLabel(fmt::format("DSP {:.1f}%", load.average));
+	dspLoad->copy_tooltip(fmt::format("Max: {:.1f}%", load.max).c_str());
+}
+
+/* -------------------------------------------------------------------------- */
+
 void gePluginElement::shiftUp()
 {
 	const gdPluginList* parent = static_cast<const gdPluginList*>(window());
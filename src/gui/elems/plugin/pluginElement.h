@@ -33,6 +33,7 @@
 
 namespace giada::v
 {
+class geBox;
 class geChoice;
 class geTextButton;
 class geImageButton;
@@ -43,8 +44,14 @@ public:
 
 	ID getPluginId() const;
 
+	/* refresh
+	Updates the DSP load readout. */
+
+	void refresh();
+
 	geTextButton*  button;
 	geChoice*      program;
+	geBox*         dspLoad;
 	geTextButton*  bypass;
 	geImageButton* shiftUpBtn;
 	geImageButton* shiftDownBtn;
@@ -87,7 +87,7 @@ void geWaveTools::rebuild(const c::sampleEditor::Data& d)
 
 void geWaveTools::refresh()
 {
-	waveform->redraw();
+	waveform->refresh();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -54,6 +54,7 @@ geWaveform::geWaveform(int x, int y, int w, int h, bool gridEnabled, int gridVal
 , m_resizedA(false)
 , m_resizedB(false)
 , m_ratio(0.0f)
+, m_peaksPending(false)
 {
 	m_waveform.size = w;
 
@@ -101,56 +102,36 @@ int geWaveform::alloc(int datasize, bool force)
 
 	u::log::print("[geWaveform::alloc] {} pixels, {} m_ratio\n", m_waveform.size, m_ratio);
 
-	int offset = h() / 2;
-	int zero   = y() + offset; // center, zero amplitude (-inf dB)
+	const int offset = h() / 2;
+	const int zero   = y() + offset; // center, zero amplitude (-inf dB)
 
-	/* Frid frequency: store a grid point every 'gridFreq' frame (if grid is
+	/* Grid frequency: store a grid point every 'gridFreq' frame (if grid is
 	enabled). TODO - this will cause round off errors, since gridFreq is integer. */
 
-	int gridFreq = m_grid.level != 0 ? wave.getBuffer().countFrames() / m_grid.level : 0;
+	const int gridFreq = m_grid.level != 0 ? wave.getBuffer().countFrames() / m_grid.level : 0;
 
-	/* Resampling the waveform, hardcore way. Many thanks to
-	http://fourier.eng.hmc.edu/e161/lectures/resize/node3.html */
+	if (gridFreq != 0)
+		for (int k = gridFreq; k < wave.getBuffer().countFrames(); k += gridFreq)
+			m_grid.points.push_back(k);
 
-	for (int i = 0; i < m_waveform.size; i++)
-	{
-
-		/* Scan the original waveform in chunks [pc, pn]. */
-
-		int pc = i * m_ratio;       // current point TODO - int until we switch to uint32_t for Wave size...
-		int pn = (i + 1) * m_ratio; // next point    TODO - int until we switch to uint32_t for Wave size...
-
-		float peaksup = 0.0f;
-		float peakinf = 0.0f;
+	/* Peaks are computed in background: draw a flat line until they are ready,
+	refresh() will try again later on. */
 
-		for (int k = pc; k < pn; k++)
-		{ // TODO - int until we switch to uint32_t for Wave size...
+	const m::Peaks* peaks = wave.getPeaks();
+	m_peaksPending        = peaks == nullptr || !peaks->isReady();
 
-			if (k >= wave.getBuffer().countFrames())
-				continue;
+	/* Each pixel covers frames [pc, pn) of the waveform. Peaks return the
+	highest and lowest values in that range without scanning it. */
 
-			/* Compute average of stereo signal. */
-
-			float avg = 0.0f;
-			for (int j = 0; j < wave.getBuffer().countChannels(); j++)
-				avg += wave.getBuffer().getChannelView(j).data()[k];
-			avg /= wave.getBuffer().countChannels();
-
-			/* Find peaks (greater and lower). */
-
-			if (avg > peaksup)
-				peaksup = avg;
-			else if (avg <= peakinf)
-				peakinf = avg;
-
-			/* Fill up grid vector. */
+	for (int i = 0; i < m_waveform.size; i++)
+	{
+		const Frame pc = i * m_ratio;       // current point
+		const Frame pn = (i + 1) * m_ratio; // next point
 
-			if (gridFreq != 0 && (int)k % gridFreq == 0 && k != 0)
-				m_grid.points.push_back(k);
-		}
+		const m::Peaks::Peak peak = m_peaksPending ? m::Peaks::Peak{} : peaks->get(wave.getBuffer(), pc, pn);
 
-		m_waveform.sup[i] = zero - (peaksup * offset);
-		m_waveform.inf[i] = zero - (peakinf * offset);
+		m_waveform.sup[i] = zero - (peak.max * offset);
+		m_waveform.inf[i] = zero - (peak.min * offset);
 
 		// avoid window overflow
 
@@ -639,6 +620,19 @@ void geWaveform::stretchToWindow()
 
 /* -------------------------------------------------------------------------- */
 
+void geWaveform::refresh()
+{
+	if (m_peaksPending && m_data->isValid())
+	{
+		const m::Peaks* peaks = m_data->sample.wave->getPeaks();
+		if (peaks != nullptr && peaks->isReady())
+			alloc(m_waveform.size, /*force=*/true);
+	}
+	redraw();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void geWaveform::rebuild(const c::sampleEditor::Data& d)
 {
 	m_data = &d;
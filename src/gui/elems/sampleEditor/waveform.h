@@ -83,6 +83,12 @@ public:
 
 	void stretchToWindow();
 
+	/* refresh
+	Redraws the waveform. Recomputes it first if it was waiting for the Wave
+	peaks to be ready. */
+
+	void refresh();
+
 	/* rebuild
 	Redraws the waveform. */
 
@@ -204,6 +210,7 @@ private:
 	float m_ratio;
 	int   m_mouseX;
 	int   m_mouseY;
+	bool  m_peaksPending; // Waveform drawn flat, waiting for peaks
 };
 } // namespace giada::v
 
@@ -92,11 +92,17 @@ LangMap::LangMap()
 	m_data[MESSAGE_STORAGE_FILEHASINVALIDCHARS] = "The file name contains invalid characters.";
 	m_data[MESSAGE_STORAGE_FILEEXISTS]          = "File exists: overwrite?";
 	m_data[MESSAGE_STORAGE_SAVINGFILEERROR]     = "Unable to save this sample!";
+	m_data[MESSAGE_STORAGE_BOUNCING]            = "Bouncing...";
+	m_data[MESSAGE_STORAGE_BOUNCINGERROR]       = "Unable to bounce the project!";
 
 	m_data[MAIN_MENU_FILE]                  = "File";
 	m_data[MAIN_MENU_FILE_OPENPROJECT]      = "Open project...";
 	m_data[MAIN_MENU_FILE_SAVEPROJECT]      = "Save project...";
 	m_data[MAIN_MENU_FILE_CLOSEPROJECT]     = "Close project";
+	m_data[MAIN_MENU_FILE_BOUNCE]           = "Bounce";
+	m_data[MAIN_MENU_FILE_BOUNCE_MASTER]    = "Master output...";
+	m_data[MAIN_MENU_FILE_BOUNCE_TRACKS]    = "Master output + track stems...";
+	m_data[MAIN_MENU_FILE_BOUNCE_CHANNELS]  = "Master output + channel stems...";
 	m_data[MAIN_MENU_FILE_DEBUGSTATS]       = "Debug stats";
 	m_data[MAIN_MENU_FILE_QUIT]             = "Quit Giada";
 	m_data[MAIN_MENU_EDIT]                  = "Edit";
@@ -249,6 +255,7 @@ LangMap::LangMap()
 	m_data[BROWSER_SAVEPROJECT]     = "Save project";
 	m_data[BROWSER_OPENSAMPLE]      = "Open sample";
 	m_data[BROWSER_SAVESAMPLE]      = "Save sample";
+	m_data[BROWSER_BOUNCE]          = "Bounce";
 	m_data[BROWSER_OPENPLUGINSDIR]  = "Open plug-ins directory";
 
 	m_data[MIDIINPUT_MASTER_TITLE]           = "MIDI Input Setup (global)";
@@ -297,25 +304,28 @@ LangMap::LangMap()
 	m_data[CONFIG_TITLE]        = "Settings";
 	m_data[CONFIG_RESTARTGIADA] = "Restart Giada for the changes to take effect.";
 
-	m_data[CONFIG_AUDIO_TITLE]                 = "Audio";
-	m_data[CONFIG_AUDIO_SYSTEM]                = "System";
-	m_data[CONFIG_AUDIO_BUFFERSIZE]            = "Buffer size";
-	m_data[CONFIG_AUDIO_TOTALOUTPUTCHANNELS]   = "Total output channels";
-	m_data[CONFIG_AUDIO_SAMPLERATE]            = "Sample rate";
-	m_data[CONFIG_AUDIO_OUTPUTDEVICE]          = "Output device";
-	m_data[CONFIG_AUDIO_OUTPUTCHANNELS]        = "Master out channels";
-	m_data[CONFIG_AUDIO_LIMITOUTPUT]           = "Limit output";
-	m_data[CONFIG_AUDIO_INPUTDEVICE]           = "Input device";
-	m_data[CONFIG_AUDIO_INPUTCHANNELS]         = "Master in channels";
-	m_data[CONFIG_AUDIO_RECTHRESHOLD]          = "Rec threshold (dB)";
-	m_data[CONFIG_AUDIO_ENABLEINPUT]           = "Enable Input";
-	m_data[CONFIG_AUDIO_RESAMPLING]            = "Resampling";
-	m_data[CONFIG_AUDIO_RESAMPLING_SINCBEST]   = "Sinc best quality (very slow)";
-	m_data[CONFIG_AUDIO_RESAMPLING_SINCMEDIUM] = "Sinc medium quality (slow)";
-	m_data[CONFIG_AUDIO_RESAMPLING_SINCBASIC]  = "Sinc basic quality (medium)";
-	m_data[CONFIG_AUDIO_RESAMPLING_ZEROORDER]  = "Zero Order Hold (fast)";
-	m_data[CONFIG_AUDIO_RESAMPLING_LINEAR]     = "Linear (very fast)";
-	m_data[CONFIG_AUDIO_NODEVICESFOUND]        = "-- no devices found --";
+	m_data[CONFIG_AUDIO_TITLE]                    = "Audio";
+	m_data[CONFIG_AUDIO_SYSTEM]                   = "System";
+	m_data[CONFIG_AUDIO_BUFFERSIZE]               = "Buffer size";
+	m_data[CONFIG_AUDIO_TOTALOUTPUTCHANNELS]      = "Total output channels";
+	m_data[CONFIG_AUDIO_SAMPLERATE]               = "Sample rate";
+	m_data[CONFIG_AUDIO_OUTPUTDEVICE]             = "Output device";
+	m_data[CONFIG_AUDIO_OUTPUTCHANNELS]           = "Master out channels";
+	m_data[CONFIG_AUDIO_LIMITOUTPUT]              = "Limit output";
+	m_data[CONFIG_AUDIO_INPUTDEVICE]              = "Input device";
+	m_data[CONFIG_AUDIO_INPUTCHANNELS]            = "Master in channels";
+	m_data[CONFIG_AUDIO_RECTHRESHOLD]             = "Rec threshold (dB)";
+	m_data[CONFIG_AUDIO_ENABLEINPUT]              = "Enable Input";
+	m_data[CONFIG_AUDIO_RESAMPLING]               = "Resampling";
+	m_data[CONFIG_AUDIO_RESAMPLING_SINCBEST]      = "Sinc best quality (very slow)";
+	m_data[CONFIG_AUDIO_RESAMPLING_SINCMEDIUM]    = "Sinc medium quality (slow)";
+	m_data[CONFIG_AUDIO_RESAMPLING_SINCBASIC]     = "Sinc basic quality (medium)";
+	m_data[CONFIG_AUDIO_RESAMPLING_ZEROORDER]     = "Zero Order Hold (fast)";
+	m_data[CONFIG_AUDIO_RESAMPLING_LINEAR]        = "Linear (very fast)";
+	m_data[CONFIG_AUDIO_RESAMPLING_BUILTINSINC]   = "Built-in sinc (fast)";
+	m_data[CONFIG_AUDIO_RESAMPLING_BUILTINCUBIC]  = "Built-in cubic (very fast)";
+	m_data[CONFIG_AUDIO_RESAMPLING_BUILTINLINEAR] = "Built-in linear (fastest)";
+	m_data[CONFIG_AUDIO_NODEVICESFOUND]           = "-- no devices found --";
 
 	m_data[CONFIG_MIDI_TITLE]           = "MIDI";
 	m_data[CONFIG_MIDI_SYSTEM]          = "System";
@@ -97,11 +97,17 @@ public:
 	static constexpr auto MESSAGE_STORAGE_FILEHASINVALIDCHARS = "message_storage_fileHasInvalidChars";
 	static constexpr auto MESSAGE_STORAGE_FILEEXISTS          = "message_storage_fileExists";
 	static constexpr auto MESSAGE_STORAGE_SAVINGFILEERROR     = "message_storage_savingFileError";
+	static constexpr auto MESSAGE_STORAGE_BOUNCING            = "message_storage_bouncing";
+	static constexpr auto MESSAGE_STORAGE_BOUNCINGERROR       = "message_storage_bouncingError";
 
 	static constexpr auto MAIN_MENU_FILE                  = "main_menu_file";
 	static constexpr auto MAIN_MENU_FILE_OPENPROJECT      = "main_menu_file_openProject";
 	static constexpr auto MAIN_MENU_FILE_SAVEPROJECT      = "main_menu_file_saveProject";
 	static constexpr auto MAIN_MENU_FILE_CLOSEPROJECT     = "main_menu_file_closeProject";
+	static constexpr auto MAIN_MENU_FILE_BOUNCE           = "main_menu_file_bounce";
+	static constexpr auto MAIN_MENU_FILE_BOUNCE_MASTER    = "main_menu_file_bounce_master";
+	static constexpr auto MAIN_MENU_FILE_BOUNCE_TRACKS    = "main_menu_file_bounce_tracks";
+	static constexpr auto MAIN_MENU_FILE_BOUNCE_CHANNELS  = "main_menu_file_bounce_channels";
 	static constexpr auto MAIN_MENU_FILE_DEBUGSTATS       = "main_menu_file_debugStats";
 	static constexpr auto MAIN_MENU_FILE_QUIT             = "main_menu_file_quit";
 	static constexpr auto MAIN_MENU_EDIT                  = "main_menu_edit";
@@ -249,6 +255,7 @@ public:
 	static constexpr auto BROWSER_SAVEPROJECT     = "browser_saveProject";
 	static constexpr auto BROWSER_OPENSAMPLE      = "browser_openSample";
 	static constexpr auto BROWSER_SAVESAMPLE      = "browser_saveSample";
+	static constexpr auto BROWSER_BOUNCE          = "browser_bounce";
 	static constexpr auto BROWSER_OPENPLUGINSDIR  = "browser_openPluginsDir";
 
 	static constexpr auto MIDIINPUT_MASTER_TITLE           = "midiInput_master_title";
@@ -291,25 +298,28 @@ public:
 	static constexpr auto CONFIG_TITLE        = "config_title";
 	static constexpr auto CONFIG_RESTARTGIADA = "config_restartGiada";
 
-	static constexpr auto CONFIG_AUDIO_TITLE                 = "config_audio_title";
-	static constexpr auto CONFIG_AUDIO_SYSTEM                = "config_audio_system";
-	static constexpr auto CONFIG_AUDIO_BUFFERSIZE            = "config_audio_bufferSize";
-	static constexpr auto CONFIG_AUDIO_TOTALOUTPUTCHANNELS   = "config_audio_totalOutputChannels";
-	static constexpr auto CONFIG_AUDIO_SAMPLERATE            = "config_audio_sampleRate";
-	static constexpr auto CONFIG_AUDIO_OUTPUTDEVICE          = "config_audio_outputDevice";
-	static constexpr auto CONFIG_AUDIO_OUTPUTCHANNELS        = "config_audio_outputChannels";
-	static constexpr auto CONFIG_AUDIO_LIMITOUTPUT           = "config_audio_limitOutput";
-	static constexpr auto CONFIG_AUDIO_INPUTDEVICE           = "config_audio_inputDevice";
-	static constexpr auto CONFIG_AUDIO_INPUTCHANNELS         = "config_audio_inputChannels";
-	static constexpr auto CONFIG_AUDIO_RECTHRESHOLD          = "config_audio_recThreshold";
-	static constexpr auto CONFIG_AUDIO_ENABLEINPUT           = "config_audio_enableInput";
-	static constexpr auto CONFIG_AUDIO_RESAMPLING            = "config_audio_reseampling";
-	static constexpr auto CONFIG_AUDIO_RESAMPLING_SINCBEST   = "config_audio_reseampling_sincBest";
-	static constexpr auto CONFIG_AUDIO_RESAMPLING_SINCMEDIUM = "config_audio_reseampling_sincMedium";
-	static constexpr auto CONFIG_AUDIO_RESAMPLING_SINCBASIC  = "config_audio_reseampling_sincBasic";
-	static constexpr auto CONFIG_AUDIO_RESAMPLING_ZEROORDER  = "config_audio_reseampling_zeroOrder";
-	static constexpr auto CONFIG_AUDIO_RESAMPLING_LINEAR     = "config_audio_reseampling_linear";
-	static constexpr auto CONFIG_AUDIO_NODEVICESFOUND        = "config_audio_noDevicesFound";
+	static constexpr auto CONFIG_AUDIO_TITLE                    = "config_audio_title";
+	static constexpr auto CONFIG_AUDIO_SYSTEM                   = "config_audio_system";
+	static constexpr auto CONFIG_AUDIO_BUFFERSIZE               = "config_audio_bufferSize";
+	static constexpr auto CONFIG_AUDIO_TOTALOUTPUTCHANNELS      = "config_audio_totalOutputChannels";
+	static constexpr auto CONFIG_AUDIO_SAMPLERATE               = "config_audio_sampleRate";
+	static constexpr auto CONFIG_AUDIO_OUTPUTDEVICE             = "config_audio_outputDevice";
+	static constexpr auto CONFIG_AUDIO_OUTPUTCHANNELS           = "config_audio_outputChannels";
+	static constexpr auto CONFIG_AUDIO_LIMITOUTPUT              = "config_audio_limitOutput";
+	static constexpr auto CONFIG_AUDIO_INPUTDEVICE              = "config_audio_inputDevice";
+	static constexpr auto CONFIG_AUDIO_INPUTCHANNELS            = "config_audio_inputChannels";
+	static constexpr auto CONFIG_AUDIO_RECTHRESHOLD             = "config_audio_recThreshold";
+	static constexpr auto CONFIG_AUDIO_ENABLEINPUT              = "config_audio_enableInput";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING               = "config_audio_reseampling";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_SINCBEST      = "config_audio_reseampling_sincBest";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_SINCMEDIUM    = "config_audio_reseampling_sincMedium";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_SINCBASIC     = "config_audio_reseampling_sincBasic";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_ZEROORDER     = "config_audio_reseampling_zeroOrder";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_LINEAR        = "config_audio_reseampling_linear";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_BUILTINSINC   = "config_audio_reseampling_builtinSinc";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_BUILTINCUBIC  = "config_audio_reseampling_builtinCubic";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_BUILTINLINEAR = "config_audio_reseampling_builtinLinear";
+	static constexpr auto CONFIG_AUDIO_NODEVICESFOUND           = "config_audio_noDevicesFound";
 
 	static constexpr auto CONFIG_MIDI_TITLE           = "config_midi_title";
 	static constexpr auto CONFIG_MIDI_SYSTEM          = "config_midi_system";
@@ -194,10 +194,12 @@ void Ui::refresh()
 
 	m_blinker = (m_blinker + 1) % BLINK_RATE;
 
-	/* Refresh Sample Editor and Action Editor for dynamic playhead. */
+	/* Refresh Sample Editor and Action Editor for dynamic playhead, Plug-in
+	List for DSP load. */
 
 	refreshSubWindow(WID_SAMPLE_EDITOR);
 	refreshSubWindow(WID_ACTION_EDITOR);
+	refreshSubWindow(WID_FX_LIST);
 }
 
 /* -------------------------------------------------------------------------- */
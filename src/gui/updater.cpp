@@ -25,6 +25,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/gui/updater.h"
+#include "src/glue/main.h"
 #include "src/gui/ui.h"
 #include "src/utils/gui.h"
 
@@ -62,6 +63,7 @@ void Updater::update(void* p) { static_cast<Updater*>(p)->update(); }
 
 void Updater::update()
 {
+	c::main::collectPlugins();
 	m_ui.refresh();
 	Fl::add_timeout(G_GUI_REFRESH_RATE, update, this); // Repeat
 }
@@ -37,6 +37,7 @@ bool        isProject(const std::string& s);
 std::string getConfigDirPath();
 std::string getMidiMapsPath();
 std::string getLangMapsPath();
+std::string getPcmCachePath();
 
 /* createConfigFolder
 Creates the configuration folder that holds the .conf file. */
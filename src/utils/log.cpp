@@ -35,6 +35,21 @@ namespace utils = mcl::utils;
 
 namespace giada::u::log
 {
+namespace
+{
+void write_(const std::string& line)
+{
+	if (mode == LOG_MODE_FILE && file.is_open())
+		file << line;
+	else
+		fmt::print("{}", line);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 bool init(int m)
 {
 	mode = m;
@@ -52,7 +67,32 @@ bool init(int m)
 
 void close()
 {
+	std::scoped_lock lock(mutex);
+
+	std::string line;
+	while (lines.try_dequeue(line))
+		write_(line);
+
 	if (mode == LOG_MODE_FILE)
 		file.close();
 }
+
+/* -------------------------------------------------------------------------- */
+
+void flush()
+{
+	/* Lines queued by other threads while draining are picked up by the loop,
+	after releasing the lock: those threads have given up writing them. */
+
+	do
+	{
+		std::unique_lock lock(mutex, std::try_to_lock);
+		if (!lock.owns_lock())
+			return;
+
+		std::string line;
+		while (lines.try_dequeue(line))
+			write_(line);
+	} while (lines.size_approx() > 0);
+}
 } // namespace giada::u::log
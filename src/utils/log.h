@@ -31,10 +31,12 @@
 
 #include "src/const.h"
 #include "src/core/const.h"
+#include "src/deps/concurrentqueue/concurrentqueue.h"
 #include "src/utils/fs.h"
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -51,8 +53,10 @@
 
 namespace giada::u::log
 {
-inline std::ofstream file;
-inline int           mode;
+inline std::ofstream                            file;
+inline int                                      mode;
+inline moodycamel::ConcurrentQueue<std::string> lines; // Formatted lines waiting to be written
+inline std::mutex                               mutex; // Held by the thread writing lines out
 
 /* init
 Initializes logger. Mode defines where to write the output: LOG_MODE_STDOUT,
@@ -62,15 +66,26 @@ bool init(int mode);
 
 void close();
 
+/* flush
+Writes queued lines out, unless another thread is already doing it: that
+thread will take care of them. Never waits. */
+
+void flush();
+
+/* print
+Formats a line and queues it for writing. Logging happens from multiple threads,
+background workers included (disk reader, freezer, ...): they never wait for
+another thread busy writing to the console or to the log file. Formatting
+allocates memory, so never call this from the audio thread or the render
+workers. */
+
 template <typename... Args>
 static void print(const char* format, Args&&... args)
 {
 	if (mode == LOG_MODE_MUTE)
 		return;
-	if (mode == LOG_MODE_FILE && file.is_open())
-		fmt::print(file, fmt::runtime(format), args...);
-	else
-		fmt::print(fmt::runtime(format), args...);
+	lines.enqueue(fmt::format(fmt::runtime(format), args...));
+	flush();
 }
 } // namespace giada::u::log
 
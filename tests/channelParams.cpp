@@ -0,0 +1,101 @@
+#include "../src/core/channels/channelParams.h"
+#include "../src/core/const.h"
+#include "../src/core/simd.h"
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("ChannelParams")
+{
+	ChannelParams params;
+	params.reset(0.5f, G_DEFAULT_PAN);
+
+	SECTION("Test reset has no ramp")
+	{
+		params.advance();
+
+		const ChannelParams::Ramp& ramp = params.getRamp();
+		REQUIRE(ramp.volumeStart == 0.5f);
+		REQUIRE(ramp.volumeEnd == 0.5f);
+	}
+
+	SECTION("Test ramp towards new values")
+	{
+		params.setVolume(1.0f);
+		params.setPan(0.0f); // Hard left
+		params.advance();
+
+		const ChannelParams::Ramp& ramp = params.getRamp();
+		REQUIRE(ramp.getGainStart(0) == 0.5f);
+		REQUIRE(ramp.getGainStart(1) == 0.5f);
+		REQUIRE(ramp.getGainEnd(0) == 1.0f);
+		REQUIRE(ramp.getGainEnd(1) == 0.0f);
+
+		params.advance();
+
+		REQUIRE(params.getRamp().getGainStart(0) == 1.0f);
+		REQUIRE(params.getRamp().getGainEnd(0) == 1.0f);
+	}
+
+	SECTION("Test stress")
+	{
+		/* A writer thread sets 10k values per second, while this thread renders
+		blocks of 64 frames as fast as it can. Ramps must never jump: each block
+		starts where the previous one ended. */
+
+		constexpr int   BLOCK_SIZE = 64;
+		constexpr int   CHANGES    = 5000;
+		constexpr float LAST       = 0.25f;
+
+		std::atomic<bool> done = false;
+
+		std::thread writer([&params, &done]()
+		{
+			for (int i = 0; i < CHANGES; i++)
+			{
+				params.setVolume((i % 100) / 100.0f);
+				params.setPan((i % 10) / 10.0f);
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+			params.setVolume(LAST);
+			done.store(true);
+		});
+
+		const std::vector<float> src(BLOCK_SIZE, 1.0f);
+		std::vector<float>       dest(BLOCK_SIZE);
+		float                    lastGain = params.getRamp().getGainEnd(0);
+		int                      blocks   = 0;
+		int                      jumps    = 0;
+		bool                     inRange  = true;
+
+		while (!done.load())
+		{
+			params.advance();
+
+			const ChannelParams::Ramp& ramp = params.getRamp();
+			if (ramp.getGainStart(0) != lastGain)
+				jumps++;
+			lastGain = ramp.getGainEnd(0);
+
+			std::fill(dest.begin(), dest.end(), 0.0f);
+			simd::sumRamp(dest.data(), src.data(), BLOCK_SIZE, ramp.getGainStart(0), ramp.getGainEnd(0));
+			for (const float f : dest)
+				inRange = inRange && f >= 0.0f && f <= G_MAX_VOLUME;
+			blocks++;
+		}
+		writer.join();
+
+		params.advance();
+
+		REQUIRE(blocks > 0);
+		REQUIRE(jumps == 0);
+		REQUIRE(inRange);
+		REQUIRE(params.getRamp().volumeEnd == LAST);
+	}
+}
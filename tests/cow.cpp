@@ -0,0 +1,117 @@
+#include "../src/core/model/cow.h"
+#include "../src/core/channels/channelFactory.h"
+#include "../src/core/model/tracks.h"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("Cow")
+{
+	using model::Cow;
+
+	Cow<std::vector<int>> cow;
+	cow.edit() = {1, 2, 3};
+
+	const int* owned = cow.get().data();
+
+	SECTION("Test copies share the same snapshot")
+	{
+		const Cow<std::vector<int>> a = cow;
+		const Cow<std::vector<int>> b = cow;
+
+		REQUIRE(a.get() == std::vector<int>{1, 2, 3});
+		REQUIRE(&a.get() == &b.get());
+		REQUIRE(&a.get() != &cow.get());
+	}
+
+	SECTION("Test edit refreshes the snapshot")
+	{
+		const Cow<std::vector<int>> a = cow;
+		cow.edit().push_back(4);
+		const Cow<std::vector<int>> b = cow;
+
+		REQUIRE(a.get() == std::vector<int>{1, 2, 3});
+		REQUIRE(b.get() == std::vector<int>{1, 2, 3, 4});
+		REQUIRE(&a.get() != &b.get());
+	}
+
+	SECTION("Test owner data is stable across copies")
+	{
+		Cow<std::vector<int>> a;
+		a = cow;
+		cow.edit()[0] = 10;
+		a             = cow;
+
+		REQUIRE(cow.get().data() == owned);
+		REQUIRE(a.get()[0] == 10);
+	}
+
+	SECTION("Test editing a copy")
+	{
+		Cow<std::vector<int>> a = cow;
+		a.edit().push_back(4);
+
+		REQUIRE(a.get().size() == 4);
+		REQUIRE(cow.get().size() == 3);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("Cow in Tracks")
+{
+	std::vector<std::unique_ptr<ChannelShared>> shared;
+	model::Tracks                               tracks;
+
+	auto makeChannel = [&shared](ChannelType type)
+	{
+		channelFactory::Data data = channelFactory::create(/*id=*/{}, type, /*sampleRate=*/44100,
+		    /*bufferSize=*/1024, Resampler::Quality::LINEAR, /*overdubProtection=*/false);
+		shared.push_back(std::move(data.shared));
+		return std::move(data.channel);
+	};
+
+	tracks.add(makeChannel(ChannelType::GROUP), /*width=*/0, /*internal=*/false);
+	tracks.add(makeChannel(ChannelType::GROUP), /*width=*/0, /*internal=*/false);
+	tracks.addChannel(makeChannel(ChannelType::SAMPLE), 0);
+	tracks.addChannel(makeChannel(ChannelType::SAMPLE), 1);
+
+	const ID id0 = tracks.getAll()[0].getChannels().getAll()[1].id;
+	const ID id1 = tracks.getAll()[1].getChannels().getAll()[1].id;
+
+	const model::Tracks before = tracks; // As if published by a swap
+
+	SECTION("Test untouched Tracks are shared")
+	{
+		const model::Tracks after = tracks;
+
+		REQUIRE(&after.getAll() == &before.getAll());
+	}
+
+	SECTION("Test editing a Channel copies its Track only")
+	{
+		tracks.getChannel(id0).volume = 0.5f;
+
+		const model::Tracks after = tracks;
+
+		REQUIRE(&after.getAll() != &before.getAll());
+		REQUIRE(after.getChannel(id0).volume == 0.5f);
+		REQUIRE(before.getChannel(id0).volume != 0.5f);
+		REQUIRE(&after.getChannel(id1) == &before.getChannel(id1));
+	}
+
+	SECTION("Test reading doesn't copy")
+	{
+		const model::Tracks& constTracks = tracks;
+
+		REQUIRE(constTracks.getChannel(id0).id == id0);
+		REQUIRE(constTracks.getByChannel(id1).getIndex() == 1);
+		REQUIRE(constTracks.get(0).getNumChannels() == 2);
+
+		const model::Tracks after = tracks;
+
+		REQUIRE(&after.getAll() == &before.getAll());
+	}
+}
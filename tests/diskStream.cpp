@@ -0,0 +1,72 @@
+#include "../src/core/diskStream.h"
+#include "../src/core/const.h"
+#include "../src/core/resampler.h"
+#include "../src/core/wave.h"
+#include "../src/core/waveFactory.h"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("DiskStream")
+{
+	constexpr int  SAMPLE_RATE   = 44100;
+	constexpr int  BLOCK_SIZE    = 1024;
+	constexpr auto TEST_WAV_PATH = TEST_RESOURCES_DIR "test.wav";
+
+	/* The test file is longer than the ring buffer capacity: this makes sure
+	the ring buffer wraps around at least once. */
+
+	waveFactory::Result res = waveFactory::createFromFile(TEST_WAV_PATH,
+	    /*ID=*/{}, /*sampleRate=*/SAMPLE_RATE, Resampler::Quality::LINEAR);
+
+	REQUIRE(res.status == G_RES_OK);
+
+	mcl::AudioBuffer&           expected = res.wave->getBuffer();
+	std::unique_ptr<DiskStream> stream   = DiskStream::open(TEST_WAV_PATH, /*start=*/0, /*capacity=*/G_STREAM_WINDOW_FRAMES);
+	mcl::AudioBuffer            out(BLOCK_SIZE, G_MAX_IO_CHANS);
+
+	REQUIRE(stream != nullptr);
+	REQUIRE(stream->getLength() == expected.countFrames());
+	REQUIRE(stream->getLength() > stream->getCapacity());
+
+	SECTION("Test invalid file")
+	{
+		REQUIRE(DiskStream::open("/path/to/nowhere.wav", 0, G_STREAM_WINDOW_FRAMES) == nullptr);
+	}
+
+	SECTION("Test underrun")
+	{
+		/* Disk reader not running: nothing can be read. */
+
+		REQUIRE(stream->read(out, /*start=*/0, BLOCK_SIZE, /*destOffset=*/0) == 0);
+		REQUIRE(stream->getUnderruns() == 1);
+	}
+
+	SECTION("Test non-realtime read")
+	{
+		DiskStream::startReader();
+		DiskStream::setNonRealtime(true);
+
+		bool equal = true;
+		for (Frame f = 0; f < stream->getLength(); f += BLOCK_SIZE)
+		{
+			const Frame count = std::min(BLOCK_SIZE, stream->getLength() - f);
+
+			REQUIRE(stream->read(out, f, count, /*destOffset=*/0) == count);
+			stream->prefetch(f + count);
+
+			for (Frame i = 0; i < count; i++)
+				for (int ch = 0; ch < G_MAX_IO_CHANS; ch++)
+					equal &= out.at(i, ch) == expected.at(f + i, ch);
+		}
+
+		DiskStream::setNonRealtime(false);
+		DiskStream::stopReader();
+
+		REQUIRE(equal);
+		REQUIRE(stream->getUnderruns() == 0);
+	}
+}
@@ -0,0 +1,64 @@
+#include "../src/core/dspLoad.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+
+using namespace giada::m;
+using namespace std::chrono_literals;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("DspLoad")
+{
+	static const int BUFFER_SIZE = 441;   // 10 ms of audio...
+	static const int SAMPLE_RATE = 44100; // ...at 44.1 kHz
+
+	DspLoad dspLoad;
+
+	SECTION("Test initial state")
+	{
+		const DspLoad::Value v = dspLoad.get(BUFFER_SIZE, SAMPLE_RATE);
+
+		REQUIRE(v.average == 0.0f);
+		REQUIRE(v.max == 0.0f);
+	}
+
+	SECTION("Test average")
+	{
+		for (int i = 0; i < 1000; i++)
+			dspLoad.add(5ms);
+
+		const DspLoad::Value v = dspLoad.get(BUFFER_SIZE, SAMPLE_RATE);
+
+		REQUIRE_THAT(v.average, WithinAbs(50.0f, 0.5));
+		REQUIRE_THAT(v.max, WithinAbs(50.0f, 0.5));
+	}
+
+	SECTION("Test max")
+	{
+		dspLoad.add(8ms);
+		for (int i = 0; i < 10; i++)
+			dspLoad.add(1ms);
+
+		const DspLoad::Value v = dspLoad.get(BUFFER_SIZE, SAMPLE_RATE);
+
+		REQUIRE(v.average < 80.0f);
+		REQUIRE_THAT(v.max, WithinAbs(80.0f, 0.5));
+	}
+
+	SECTION("Test max expiration")
+	{
+		dspLoad.add(8ms);
+		for (int i = 0; i < 1000; i++)
+			dspLoad.add(1ms);
+
+		REQUIRE_THAT(dspLoad.get(BUFFER_SIZE, SAMPLE_RATE).max, WithinAbs(10.0f, 0.5));
+	}
+
+	SECTION("Test invalid audio settings")
+	{
+		dspLoad.add(5ms);
+
+		REQUIRE(dspLoad.get(0, SAMPLE_RATE).average == 0.0f);
+		REQUIRE(dspLoad.get(BUFFER_SIZE, 0).average == 0.0f);
+	}
+}
@@ -0,0 +1,97 @@
+#include "../src/core/freezer.h"
+#include "../src/core/const.h"
+#include "../src/core/wave.h"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <optional>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("Freezer")
+{
+	constexpr int SAMPLE_RATE  = 44100;
+	constexpr int WAVE_SIZE    = 20000;
+	constexpr int BUFFER_SIZE  = 1024;
+	constexpr int NUM_CHANNELS = 2;
+
+	Wave wave({});
+	wave.alloc(WAVE_SIZE, NUM_CHANNELS, SAMPLE_RATE, /*bits=*/32, "path/to/sample.wav");
+	for (int i = 0; i < WAVE_SIZE; i++)
+	{
+		wave.getBuffer().at(i, 0) = static_cast<float>(i + 1);
+		wave.getBuffer().at(i, 1) = static_cast<float>(i + 1);
+	}
+
+	Sample sample = {
+	    .wave  = &wave,
+	    .range = {1000, 15000},
+	    .pitch = 2.0f};
+
+	/* No renderer thread running here: Samples are frozen right away. */
+
+	std::shared_ptr<Freezer> freezer = std::make_shared<Freezer>(Resampler::Quality::LINEAR, SAMPLE_RATE);
+	freezer->request(sample);
+
+	REQUIRE(freezer->isFrozen(sample));
+
+	SECTION("Test playback")
+	{
+		mcl::AudioBuffer out(BUFFER_SIZE, NUM_CHANNELS);
+		Frame            tracker   = sample.range.getA();
+		Frame            generated = 0;
+
+		while (tracker < sample.range.getB())
+		{
+			const std::optional<rendering::ReadResult> res = freezer->a_read(sample, out, tracker, /*offset=*/0);
+
+			REQUIRE(res.has_value());
+			REQUIRE(res->used >= 0);
+			REQUIRE(res->generated > 0);
+
+			tracker += res->used;
+			generated += res->generated;
+		}
+
+		/* The whole range has been played exactly once, at double speed. */
+
+		REQUIRE(tracker == sample.range.getB());
+		REQUIRE(generated > sample.range.getLength() / 2 - BUFFER_SIZE);
+		REQUIRE(generated < sample.range.getLength() / 2 + BUFFER_SIZE);
+	}
+
+	SECTION("Test changes")
+	{
+		mcl::AudioBuffer out(BUFFER_SIZE, NUM_CHANNELS);
+
+		sample.pitch = 1.5f;
+
+		REQUIRE_FALSE(freezer->isFrozen(sample));
+		REQUIRE_FALSE(freezer->a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+
+		freezer->request(sample);
+
+		REQUIRE(freezer->isFrozen(sample));
+	}
+
+	SECTION("Test release")
+	{
+		Sample unpitched = sample;
+		unpitched.pitch  = 1.0f;
+
+		freezer->request(unpitched);
+
+		REQUIRE_FALSE(freezer->isFrozen(sample));
+		REQUIRE_FALSE(freezer->isFrozen(unpitched));
+	}
+
+	SECTION("Test edit")
+	{
+		/* Writing to the Wave makes a private copy of the audio data, no longer
+		matching the frozen one. */
+
+		wave.getBuffer().at(0, 0) = 0.0f;
+
+		REQUIRE_FALSE(freezer->isFrozen(sample));
+	}
+}
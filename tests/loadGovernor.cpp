@@ -0,0 +1,104 @@
+#include "../src/core/loadGovernor.h"
+#include "../src/core/const.h"
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+
+using namespace giada;
+using namespace giada::m;
+using namespace std::chrono_literals;
+
+TEST_CASE("LoadGovernor")
+{
+	static const int BUFFER_SIZE = 441;   // 10 ms of audio...
+	static const int SAMPLE_RATE = 44100; // ...at 44.1 kHz
+	static const int THRESHOLD   = 80;    // percent
+	static const int HOLD_BLOCKS = G_LOAD_GOVERNOR_HOLD_MS / 10;
+
+	LoadGovernor governor;
+
+	/* run
+	Feeds 'blocks' blocks that took 'd' to render, with the given threshold.
+	Returns the number of transitions. */
+
+	const auto run = [&governor](int blocks, std::chrono::microseconds d, int threshold)
+	{
+		int transitions = 0;
+		for (int i = 0; i < blocks; i++)
+			transitions += governor.update(d, BUFFER_SIZE, SAMPLE_RATE, threshold) ? 1 : 0;
+		return transitions;
+	};
+
+	SECTION("Test fallback quality")
+	{
+		REQUIRE(LoadGovernor::getFallbackQuality(Resampler::Quality::SINC_BEST) == Resampler::Quality::BUILTIN_CUBIC);
+		REQUIRE(LoadGovernor::getFallbackQuality(Resampler::Quality::BUILTIN_SINC) == Resampler::Quality::BUILTIN_CUBIC);
+		REQUIRE_FALSE(LoadGovernor::getFallbackQuality(Resampler::Quality::LINEAR).has_value());
+		REQUIRE_FALSE(LoadGovernor::getFallbackQuality(Resampler::Quality::BUILTIN_CUBIC).has_value());
+	}
+
+	SECTION("Test normal load")
+	{
+		REQUIRE(run(1000, 5ms, THRESHOLD) == 0);
+		REQUIRE_FALSE(governor.isDegraded());
+	}
+
+	SECTION("Test overload")
+	{
+		REQUIRE(run(100, 9ms, THRESHOLD) == 1);
+		REQUIRE(governor.isDegraded());
+		REQUIRE(governor.getLoad(BUFFER_SIZE, SAMPLE_RATE) > THRESHOLD);
+	}
+
+	SECTION("Test hysteresis")
+	{
+		/* Load drops below the threshold, but not enough: stay degraded. */
+
+		run(100, 9ms, THRESHOLD);
+
+		REQUIRE(run(HOLD_BLOCKS * 2, 6ms, THRESHOLD) == 0);
+		REQUIRE(governor.isDegraded());
+	}
+
+	SECTION("Test restore after hold time")
+	{
+		/* Load drops below the restore level: wait for the hold time, then go
+		back to the configured quality. */
+
+		run(100, 9ms, THRESHOLD);
+
+		REQUIRE(run(HOLD_BLOCKS / 2, 1ms, THRESHOLD) == 0);
+		REQUIRE(governor.isDegraded());
+		REQUIRE(run(HOLD_BLOCKS, 1ms, THRESHOLD) == 1);
+		REQUIRE_FALSE(governor.isDegraded());
+	}
+
+	SECTION("Test back-off")
+	{
+		/* Overloaded again right after restoring: the next hold time is longer. */
+
+		run(100, 9ms, THRESHOLD);
+		while (governor.isDegraded())
+			run(1, 1ms, THRESHOLD);
+
+		run(100, 9ms, THRESHOLD);
+		REQUIRE(governor.isDegraded());
+
+		REQUIRE(run(HOLD_BLOCKS * 3 / 2, 1ms, THRESHOLD) == 0);
+		REQUIRE(governor.isDegraded());
+		REQUIRE(run(HOLD_BLOCKS, 1ms, THRESHOLD) == 1);
+		REQUIRE_FALSE(governor.isDegraded());
+	}
+
+	SECTION("Test disabled")
+	{
+		REQUIRE(run(1000, 9ms, /*threshold=*/0) == 0);
+		REQUIRE_FALSE(governor.isDegraded());
+
+		/* Disabling the governor restores the quality at once. */
+
+		run(100, 9ms, THRESHOLD);
+		REQUIRE(governor.isDegraded());
+		REQUIRE(run(1, 9ms, /*threshold=*/0) == 1);
+		REQUIRE_FALSE(governor.isDegraded());
+	}
+}
@@ -0,0 +1,86 @@
+#include "../src/core/pcmCache.h"
+#include "../src/core/const.h"
+#include "../src/core/resampler.h"
+#include "../src/core/wave.h"
+#include "../src/core/waveFactory.h"
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("pcmCache")
+{
+	constexpr int  SAMPLE_RATE   = 44100;
+	constexpr auto TEST_WAV_PATH = TEST_RESOURCES_DIR "test.wav";
+
+	const std::filesystem::path cachePath = std::filesystem::temp_directory_path() / "giada-pcm-cache-test";
+	std::filesystem::remove_all(cachePath);
+
+	waveFactory::Result res = waveFactory::createFromFile(TEST_WAV_PATH,
+	    /*ID=*/{}, /*sampleRate=*/SAMPLE_RATE, Resampler::Quality::LINEAR);
+
+	REQUIRE(res.status == G_RES_OK);
+
+	const Wave& source = *res.wave;
+
+	SECTION("Test disabled cache")
+	{
+		pcmCache::init(cachePath.string(), 0);
+		pcmCache::write(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::LINEAR, source);
+
+		Wave wave({});
+		REQUIRE(pcmCache::isEnabled() == false);
+		REQUIRE(pcmCache::read(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::LINEAR, wave) == false);
+	}
+
+	SECTION("Test write and read")
+	{
+		pcmCache::init(cachePath.string(), /*maxSize=*/64 * 1024 * 1024);
+
+		Wave wave({});
+		REQUIRE(pcmCache::read(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::LINEAR, wave) == false);
+
+		pcmCache::write(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::LINEAR, source);
+
+		REQUIRE(pcmCache::read(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::LINEAR, wave) == true);
+		REQUIRE(wave.getRate() == source.getRate());
+		REQUIRE(wave.getBits() == source.getBits());
+		REQUIRE(wave.getBuffer().countFrames() == source.getBuffer().countFrames());
+		REQUIRE(wave.getBuffer().countChannels() == source.getBuffer().countChannels());
+
+		for (int i = 0; i < source.getBuffer().countFrames(); i++)
+			for (int j = 0; j < source.getBuffer().countChannels(); j++)
+				REQUIRE(wave.getBuffer().at(i, j) == source.getBuffer().at(i, j));
+
+		/* Different conversion settings make a different cache entry. */
+
+		REQUIRE(pcmCache::read(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::SINC_BEST, wave) == false);
+
+		const pcmCache::Stats stats = pcmCache::getStats();
+
+		REQUIRE(stats.hits == 1);
+		REQUIRE(stats.misses == 2);
+		REQUIRE(stats.bytesSaved == source.getBuffer().countFrames() * source.getBuffer().countChannels() * sizeof(float));
+		REQUIRE(stats.size > stats.bytesSaved);
+	}
+
+	SECTION("Test eviction")
+	{
+		/* Room for just one entry: writing a second one evicts the first. */
+
+		const std::uintmax_t dataSize = source.getBuffer().countFrames() * source.getBuffer().countChannels() * sizeof(float);
+
+		pcmCache::init(cachePath.string(), /*maxSize=*/dataSize + 4096);
+		pcmCache::write(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::LINEAR, source);
+		pcmCache::write(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::SINC_BEST, source);
+
+		Wave wave({});
+		REQUIRE(pcmCache::getStats().size <= dataSize + 4096);
+		REQUIRE(pcmCache::read(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::LINEAR, wave) !=
+		        pcmCache::read(TEST_WAV_PATH, SAMPLE_RATE, Resampler::Quality::SINC_BEST, wave));
+	}
+
+	pcmCache::init(cachePath.string(), 0);
+	std::filesystem::remove_all(cachePath);
+}
@@ -0,0 +1,152 @@
+#include "../src/core/peaks.h"
+#include "../src/core/const.h"
+#include "../src/core/wave.h"
+#include "../src/core/waveFx.h"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace giada;
+using namespace giada::m;
+
+namespace
+{
+/* scanPeak_
+Reference implementation: a plain scan of frames [a, b). */
+
+Peaks::Peak scanPeak_(const mcl::AudioBuffer& data, Frame a, Frame b)
+{
+	Peaks::Peak out;
+	for (Frame i = a; i < b; i++)
+	{
+		const float avg = (data.at(i, 0) + data.at(i, 1)) / 2.0f;
+		out.min         = std::min(out.min, avg);
+		out.max         = std::max(out.max, avg);
+	}
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool matches_(const Peaks& peaks, const mcl::AudioBuffer& data)
+{
+	const Frame frames = data.countFrames();
+	const Frame step   = G_PEAKS_BLOCK_FRAMES / 3; // Ranges not aligned to blocks
+
+	for (Frame a = 0; a < frames; a += step * 31)
+		for (Frame b = a; b <= frames; b += step * 37)
+		{
+			const Peaks::Peak p = peaks.get(data, a, b);
+			const Peaks::Peak q = scanPeak_(data, a, b);
+			if (p.min != q.min || p.max != q.max)
+				return false;
+		}
+	return true;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("Peaks")
+{
+	static const int SAMPLE_RATE = 44100;
+	static const int BUFFER_SIZE = 20011; // Not a multiple of G_PEAKS_BLOCK_FRAMES
+	static const int BIT_DEPTH   = 32;
+
+	Wave wave({});
+	wave.alloc(BUFFER_SIZE, 2, SAMPLE_RATE, BIT_DEPTH, "path/to/sample.wav");
+	for (int i = 0; i < BUFFER_SIZE; i++)
+	{
+		wave.getBuffer().at(i, 0) = std::sin(i * 0.01f) * (i % 17) / 17.0f;
+		wave.getBuffer().at(i, 1) = std::cos(i * 0.03f) * (i % 5) / 5.0f;
+	}
+
+	/* No builder thread running here: Peaks are computed right away. */
+
+	wave.computePeaks();
+
+	REQUIRE(wave.getPeaks() != nullptr);
+	REQUIRE(wave.getPeaks()->isReady());
+
+	SECTION("Test computation")
+	{
+		REQUIRE(wave.getPeaks()->countFrames() == BUFFER_SIZE);
+		REQUIRE(matches_(*wave.getPeaks(), wave.getBuffer()));
+	}
+
+	SECTION("Test update after in-place edit")
+	{
+		wfx::fade(wave, 3000, 9000, wfx::Fade::IN);
+
+		REQUIRE(matches_(*wave.getPeaks(), wave.getBuffer()));
+	}
+
+	SECTION("Test update after cut")
+	{
+		wfx::cut(wave, 1000, 5555);
+
+		REQUIRE(wave.getPeaks()->countFrames() == wave.getBuffer().countFrames());
+		REQUIRE(matches_(*wave.getPeaks(), wave.getBuffer()));
+	}
+
+	SECTION("Test update after paste")
+	{
+		Wave other(wave);
+		wfx::paste(other, wave, 777);
+
+		REQUIRE(wave.getPeaks()->countFrames() == BUFFER_SIZE * 2);
+		REQUIRE(matches_(*wave.getPeaks(), wave.getBuffer()));
+	}
+
+	SECTION("Test save and load")
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "giada-peaks-test.peaks").string();
+
+		const Peaks::Source source = {.size = 1024, .mtime = 42};
+
+		REQUIRE(wave.getPeaks()->save(path, source));
+
+		std::shared_ptr<Peaks> loaded = Peaks::load(path, source, BUFFER_SIZE);
+
+		REQUIRE(loaded != nullptr);
+		REQUIRE(loaded->isReady());
+		REQUIRE(matches_(*loaded, wave.getBuffer()));
+
+		/* Peaks must not be loaded if the audio file has changed. */
+
+		REQUIRE(Peaks::load(path, {.size = 1024, .mtime = 43}, BUFFER_SIZE) == nullptr);
+		REQUIRE(Peaks::load(path, {.size = 1025, .mtime = 42}, BUFFER_SIZE) == nullptr);
+		REQUIRE(Peaks::load(path, source, BUFFER_SIZE - 1) == nullptr);
+
+		/* A stale peaks file makes the Wave compute its Peaks again. */
+
+		Wave other(wave);
+		wfx::fade(other, 0, 5000, wfx::Fade::IN);
+		other.setPeaksFile(path, {.size = 1, .mtime = 1});
+		other.loadPeaks();
+
+		REQUIRE(other.getPeaks() != nullptr);
+		REQUIRE(matches_(*other.getPeaks(), other.getBuffer()));
+
+		std::filesystem::remove(path);
+	}
+
+	SECTION("Test source")
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "giada-peaks-test.wav").string();
+
+		REQUIRE_FALSE(Peaks::getSource(path).has_value());
+
+		std::ofstream(path) << "data";
+		const std::optional<Peaks::Source> source = Peaks::getSource(path);
+
+		REQUIRE(source.has_value());
+		REQUIRE(source->size == 4);
+
+		std::filesystem::remove(path);
+	}
+}
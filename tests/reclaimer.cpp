@@ -0,0 +1,109 @@
+#include "../src/core/const.h"
+#include "../src/core/model/reclaimer.h"
+#include "../src/core/rtEpoch.h"
+#include "../src/core/wave.h"
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace giada;
+
+TEST_CASE("Reclaimer")
+{
+	static const int SAMPLE_RATE = 44100;
+	static const int BUFFER_SIZE = 4096;
+	static const int CHANNELS    = 2;
+	static const int BIT_DEPTH   = 32;
+
+	RtEpoch             epoch;
+	m::model::Reclaimer reclaimer(epoch);
+
+	auto makeWave = [](ID id)
+	{
+		auto wave = std::make_unique<m::Wave>(id);
+		wave->alloc(BUFFER_SIZE, CHANNELS, SAMPLE_RATE, BIT_DEPTH, "path/to/sample.wav");
+		return wave;
+	};
+
+	auto swap = []()
+	{};
+
+	auto waitForObjects = [&reclaimer](int count)
+	{
+		const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (reclaimer.getStats().objects != count && std::chrono::steady_clock::now() < timeout)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return reclaimer.getStats().objects == count;
+	};
+
+	SECTION("Test stats")
+	{
+		std::unique_ptr<m::Wave> wave = makeWave(ID{1});
+		const std::size_t        size = wave->getDataSize();
+
+		reclaimer.retire(std::move(wave));
+		reclaimer.retire(makeWave(ID{2}));
+		reclaimer.retire(std::unique_ptr<m::Wave>()); // Ignored
+
+		REQUIRE(reclaimer.getStats().objects == 2);
+		REQUIRE(reclaimer.getStats().bytes == size * 2);
+	}
+
+	SECTION("Test objects are freed only after a swap")
+	{
+		reclaimer.start();
+		reclaimer.retire(makeWave(ID{1}));
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(G_RECLAIMER_RATE_MS * 2));
+
+		REQUIRE(reclaimer.getStats().objects == 1);
+
+		reclaimer.advance(swap);
+		reclaimer.retire(makeWave(ID{2}));
+
+		REQUIRE(waitForObjects(1));
+
+		reclaimer.advance(swap);
+
+		REQUIRE(waitForObjects(0));
+	}
+
+	SECTION("Test objects are freed only once the realtime thread is done")
+	{
+		reclaimer.start();
+		reclaimer.retire(makeWave(ID{1}));
+		reclaimer.advance(swap);
+
+		{
+			RtEpoch::Guard guard(epoch);
+			std::this_thread::sleep_for(std::chrono::milliseconds(G_RECLAIMER_RATE_MS * 2));
+
+			REQUIRE(reclaimer.getStats().objects == 1);
+		}
+
+		REQUIRE(waitForObjects(0));
+	}
+
+	SECTION("Test swap is performed on advance")
+	{
+		reclaimer.start();
+		reclaimer.retire(makeWave(ID{1}));
+
+		bool swapped = false;
+		reclaimer.advance([&swapped]()
+		{ swapped = true; });
+
+		REQUIRE(swapped);
+		REQUIRE(waitForObjects(0));
+	}
+
+	SECTION("Test stop")
+	{
+		reclaimer.start();
+		reclaimer.retire(makeWave(ID{1}));
+		reclaimer.stop();
+
+		REQUIRE(reclaimer.getStats().objects == 0);
+	}
+}
@@ -0,0 +1,132 @@
+#include "../src/core/rendering/renderGraph.h"
+#include "../src/core/channels/channelFactory.h"
+#include "../src/core/model/tracks.h"
+#include "../src/core/rendering/renderState.h"
+#include "../src/core/types.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("RenderGraph")
+{
+	using rendering::RenderGraph;
+
+	std::vector<std::unique_ptr<ChannelShared>> shared;
+	model::Tracks                               tracks;
+
+	auto makeChannel = [&shared](ChannelType type)
+	{
+		channelFactory::Data data = channelFactory::create(/*id=*/{}, type, /*sampleRate=*/44100,
+		    /*bufferSize=*/1024, Resampler::Quality::LINEAR, /*overdubProtection=*/false);
+		shared.push_back(std::move(data.shared));
+		return std::move(data.channel);
+	};
+
+	/* Two tracks: the first one with three Sample Channels, the second one with
+	just the group Channel. */
+
+	tracks.add(makeChannel(ChannelType::GROUP), /*width=*/0, /*internal=*/false);
+	tracks.add(makeChannel(ChannelType::GROUP), /*width=*/0, /*internal=*/false);
+	for (int i = 0; i < 3; i++)
+		tracks.addChannel(makeChannel(ChannelType::SAMPLE), 0);
+
+	RenderGraph graph(tracks);
+
+	SECTION("Test compilation")
+	{
+		const std::vector<RenderGraph::Node>& nodes = graph.getNodes();
+
+		REQUIRE(nodes.size() == 5);
+		REQUIRE(graph.countRoots() == 4); // Three channels + the empty group
+		REQUIRE(nodes[0].type == RenderGraph::NodeType::GROUP);
+		REQUIRE(nodes[0].numDeps == 3);
+		REQUIRE(nodes[1].parent == 0);
+		REQUIRE(nodes[4].type == RenderGraph::NodeType::GROUP);
+		REQUIRE(nodes[4].numDeps == 0);
+		REQUIRE(graph.isCompatible(tracks));
+	}
+
+	SECTION("Test layout change")
+	{
+		tracks.addChannel(makeChannel(ChannelType::SAMPLE), 1);
+
+		REQUIRE_FALSE(graph.isCompatible(tracks));
+
+		const RenderGraph next(tracks, &graph);
+
+		REQUIRE(next.getNodes().size() == 6);
+		REQUIRE(next.getPreviousId() == graph.getId());
+		REQUIRE(next.getNodes()[0].previous == 0);
+		REQUIRE(next.getNodes()[5].previous == -1); // The new channel
+	}
+
+	SECTION("Test execution")
+	{
+		static const std::size_t NUM_WORKERS = 3;
+
+		rendering::RenderState state(graph.getNodes().size());
+
+		for (int block = 0; block < 100; block++)
+		{
+			std::vector<std::atomic<int>> rendered(graph.getNodes().size());
+			std::atomic<bool>             validOrder = true;
+
+			auto renderNode = [&](const RenderGraph::Node& node, std::size_t)
+			{
+				/* A group must be rendered after all its channels. */
+				if (node.type == RenderGraph::NodeType::GROUP)
+					for (std::size_t i = 0; i < graph.getNodes().size(); i++)
+						if (graph.getNodes()[i].parent == &node - graph.getNodes().data() && rendered[i].load() == 0)
+							validOrder.store(false);
+				rendered[&node - graph.getNodes().data()].fetch_add(1);
+			};
+
+			state.prepare(graph, NUM_WORKERS);
+
+			std::vector<std::thread> workers;
+			for (std::size_t i = 0; i < NUM_WORKERS; i++)
+				workers.emplace_back([&state, &renderNode, i]()
+				{ state.execute(i, i, renderNode); });
+			for (std::thread& t : workers)
+				t.join();
+
+			REQUIRE(validOrder.load());
+			for (const std::atomic<int>& r : rendered)
+				REQUIRE(r.load() == 1);
+		}
+	}
+
+	SECTION("Test timings are carried over")
+	{
+		rendering::RenderState state(16);
+
+		/* The last channel is the heaviest one. */
+
+		auto renderNode = [&](const RenderGraph::Node& node, std::size_t)
+		{
+			if (node.channelId == graph.getNodes()[3].channelId)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		};
+
+		state.prepare(graph, 1);
+		state.execute(0, 0, renderNode);
+
+		REQUIRE(state.getGraphId() == graph.getId());
+		REQUIRE(state.getTime(3) > state.getTime(1));
+
+		tracks.addChannel(makeChannel(ChannelType::SAMPLE), 1);
+		const RenderGraph next(tracks, &graph);
+
+		state.prepare(next, 1);
+		state.execute(0, 0, renderNode);
+
+		REQUIRE(state.getGraphId() == next.getId());
+		REQUIRE(state.getMaxTime(3) >= 1000.0);
+		REQUIRE(state.getMaxTime(5) < 1000.0);
+	}
+}
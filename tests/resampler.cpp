@@ -0,0 +1,242 @@
+#include "../src/core/resampler.h"
+#include "../src/core/const.h"
+#include "../src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+using namespace giada;
+using namespace giada::m;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+/* makeConstant_
+Fills both channels with the same value. */
+
+mcl::AudioBuffer makeConstant_(int frames, float value)
+{
+	mcl::AudioBuffer out(frames, G_MAX_IO_CHANS);
+	for (int i = 0; i < frames; i++)
+		for (int j = 0; j < G_MAX_IO_CHANS; j++)
+			out.at(i, j) = value;
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* makeSine_
+Fills both channels with a sine wave, the right one with inverted phase. 'freq'
+is relative to the sample rate. */
+
+mcl::AudioBuffer makeSine_(int frames, double freq)
+{
+	mcl::AudioBuffer out(frames, G_MAX_IO_CHANS);
+	for (int i = 0; i < frames; i++)
+	{
+		out.at(i, 0) = static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * freq * i));
+		out.at(i, 1) = -out.at(i, 0);
+	}
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+double getRms_(const mcl::AudioBuffer& buf, int channel, int start, int end)
+{
+	double sum = 0.0;
+	for (int i = start; i < end; i++)
+		sum += buf.at(i, channel) * buf.at(i, channel);
+	return std::sqrt(sum / (end - start));
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("Resampler - built-in")
+{
+	constexpr int INPUT_SIZE  = 8192;
+	constexpr int OUTPUT_SIZE = 4096;
+
+	const std::vector<std::pair<Resampler::Quality, std::string>> qualities = {
+	    {Resampler::Quality::BUILTIN_SINC, "sinc"},
+	    {Resampler::Quality::BUILTIN_CUBIC, "cubic"},
+	    {Resampler::Quality::BUILTIN_LINEAR, "linear"}};
+
+	REQUIRE_FALSE(Resampler::isBuiltin(Resampler::Quality::SINC_FASTEST));
+
+	for (const auto& [quality, name] : qualities)
+	{
+		REQUIRE(Resampler::isBuiltin(quality));
+
+		SECTION("Test constant signal - " + name)
+		{
+			const mcl::AudioBuffer input = makeConstant_(INPUT_SIZE, 0.5f);
+			mcl::AudioBuffer       output(OUTPUT_SIZE, G_MAX_IO_CHANS);
+
+			const Resampler         resampler(quality);
+			const Resampler::Result res = resampler.process(input, 0, INPUT_SIZE, output, 0, 1.3f);
+
+			REQUIRE(res.generated == OUTPUT_SIZE);
+			REQUIRE(res.used <= INPUT_SIZE);
+
+			/* Skip the fade-in from the initial silence. */
+
+			for (int i = 64; i < OUTPUT_SIZE; i++)
+			{
+				REQUIRE_THAT(output.at(i, 0), WithinAbs(0.5f, 0.001));
+				REQUIRE_THAT(output.at(i, 1), WithinAbs(0.5f, 0.001));
+			}
+		}
+
+		SECTION("Test sine - " + name)
+		{
+			constexpr double FREQ  = 0.01;
+			constexpr float  RATIO = 0.75f;
+
+			const mcl::AudioBuffer input = makeSine_(INPUT_SIZE, FREQ);
+			mcl::AudioBuffer       output(OUTPUT_SIZE, G_MAX_IO_CHANS);
+
+			const Resampler resampler(quality);
+			resampler.process(input, 0, INPUT_SIZE, output, 0, RATIO);
+
+			/* No latency is added: output frame i matches input frame
+			i * RATIO. */
+
+			for (int i = 64; i < OUTPUT_SIZE; i++)
+			{
+				const float expected = static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * FREQ * i * RATIO));
+				REQUIRE_THAT(output.at(i, 0), WithinAbs(expected, 0.005));
+				REQUIRE_THAT(output.at(i, 1), WithinAbs(-expected, 0.005));
+			}
+		}
+
+		SECTION("Test chunked processing - " + name)
+		{
+			/* Feeding the resampler in small blocks must give the same result as
+			processing everything in one go. */
+
+			constexpr int BLOCK_SIZE = 100;
+
+			const mcl::AudioBuffer input = makeSine_(INPUT_SIZE, 0.03);
+			mcl::AudioBuffer       whole(OUTPUT_SIZE, G_MAX_IO_CHANS);
+			mcl::AudioBuffer       block(BLOCK_SIZE, G_MAX_IO_CHANS);
+
+			const Resampler resamplerA(quality);
+			const Resampler resamplerB(quality);
+			resamplerA.process(input, 0, INPUT_SIZE, whole, 0, 1.7f);
+
+			std::size_t inputPos = 0;
+			for (int i = 0; i < OUTPUT_SIZE; i += BLOCK_SIZE)
+			{
+				const Resampler::Result res = resamplerB.process(input, inputPos, INPUT_SIZE, block, 0, 1.7f);
+				REQUIRE(res.generated == BLOCK_SIZE);
+				for (int j = 0; j < BLOCK_SIZE && i + j < OUTPUT_SIZE; j++)
+				{
+					REQUIRE(block.at(j, 0) == whole.at(i + j, 0));
+					REQUIRE(block.at(j, 1) == whole.at(i + j, 1));
+				}
+				inputPos += res.used;
+			}
+		}
+
+		SECTION("Test end of input - " + name)
+		{
+			/* All input frames are rendered, then the resampler stops. */
+
+			const mcl::AudioBuffer input = makeConstant_(1000, 0.5f);
+			mcl::AudioBuffer       output(OUTPUT_SIZE, G_MAX_IO_CHANS);
+
+			const Resampler         resampler(quality);
+			const Resampler::Result res = resampler.process(input, 0, 1000, output, 0, 0.5f);
+
+			REQUIRE(res.used == 1000);
+			REQUIRE(res.generated == 2000);
+		}
+
+		SECTION("Test input consumption - " + name)
+		{
+			/* Input is read as needed, not ahead of time: the playback position
+			would run away from what is being heard otherwise. */
+
+			const mcl::AudioBuffer input = makeConstant_(INPUT_SIZE, 0.5f);
+			mcl::AudioBuffer       output(100, G_MAX_IO_CHANS);
+
+			const Resampler         resampler(quality);
+			const Resampler::Result res = resampler.process(input, 0, INPUT_SIZE, output, 0, 2.0f);
+
+			REQUIRE(res.generated == 100);
+			REQUIRE(res.used >= 200);
+			REQUIRE(res.used <= 200 + 64);
+		}
+	}
+
+	SECTION("Test aliasing")
+	{
+		/* A tone at 0.45 of the sample rate, pitched up 1.5 times, lands above the
+		Nyquist frequency: whatever comes out is aliasing. The sinc filter must
+		reject it way better than the interpolators. */
+
+		const mcl::AudioBuffer input = makeSine_(INPUT_SIZE, 0.45);
+
+		const auto getAliasing = [&input](Resampler::Quality quality)
+		{
+			mcl::AudioBuffer output(OUTPUT_SIZE, G_MAX_IO_CHANS);
+			const Resampler  resampler(quality);
+			resampler.process(input, 0, INPUT_SIZE, output, 0, 1.5f);
+			return getRms_(output, 0, 512, OUTPUT_SIZE) / getRms_(input, 0, 0, INPUT_SIZE);
+		};
+
+		const double sinc   = getAliasing(Resampler::Quality::BUILTIN_SINC);
+		const double linear = getAliasing(Resampler::Quality::BUILTIN_LINEAR);
+
+		REQUIRE(sinc < 0.001); // -60 dB
+		REQUIRE(sinc < linear / 100.0);
+	}
+
+	SECTION("Test fallback")
+	{
+		/* Switching to the fallback quality and back, block after block. The
+		crossfade must not introduce clicks nor time jumps: the output keeps
+		following the input sine. */
+
+		constexpr double FREQ       = 0.01;
+		constexpr float  RATIO      = 0.75f;
+		constexpr int    BLOCK_SIZE = 256;
+
+		const mcl::AudioBuffer input = makeSine_(INPUT_SIZE, FREQ);
+		mcl::AudioBuffer       block(BLOCK_SIZE, G_MAX_IO_CHANS);
+
+		const Resampler resampler(Resampler::Quality::BUILTIN_SINC, Resampler::Quality::BUILTIN_CUBIC);
+
+		std::size_t inputPos = 0;
+		for (int i = 0; i < OUTPUT_SIZE; i += BLOCK_SIZE)
+		{
+			const bool fallback = i >= BLOCK_SIZE * 4 && i < BLOCK_SIZE * 10;
+			resampler.setFallback(fallback);
+
+			const Resampler::Result res = resampler.process(input, inputPos, INPUT_SIZE, block, 0, RATIO);
+			REQUIRE(res.generated == BLOCK_SIZE);
+			REQUIRE(resampler.isUsingFallback() == fallback);
+
+			for (int j = i == 0 ? 64 : 0; j < BLOCK_SIZE; j++)
+			{
+				const float expected = static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * FREQ * (i + j) * RATIO));
+				REQUIRE_THAT(block.at(j, 0), WithinAbs(expected, 0.01));
+				REQUIRE_THAT(block.at(j, 1), WithinAbs(-expected, 0.01));
+			}
+			inputPos += res.used;
+		}
+	}
+
+	SECTION("Test fallback - unavailable")
+	{
+		const Resampler resampler(Resampler::Quality::BUILTIN_SINC);
+		resampler.setFallback(true);
+
+		REQUIRE_FALSE(resampler.isUsingFallback());
+	}
+}
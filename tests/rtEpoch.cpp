@@ -0,0 +1,101 @@
+#include "../src/core/rtEpoch.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace giada;
+
+TEST_CASE("RtEpoch")
+{
+	RtEpoch epoch;
+
+	SECTION("Test idle")
+	{
+		REQUIRE(epoch.isInside() == false);
+
+		epoch.synchronize();
+
+		REQUIRE(epoch.isInside() == false);
+	}
+
+	SECTION("Test sections")
+	{
+		{
+			RtEpoch::Guard guard(epoch);
+			REQUIRE(epoch.isInside() == true);
+			{
+				RtEpoch::Guard overlapping(epoch);
+				REQUIRE(epoch.isInside() == true);
+			}
+			REQUIRE(epoch.isInside() == true);
+		}
+		REQUIRE(epoch.isInside() == false);
+	}
+
+	SECTION("Test synchronize waits for the section in progress")
+	{
+		std::atomic<bool> entered = false;
+		std::atomic<bool> done    = false;
+
+		std::thread realtime([&]()
+		{
+			RtEpoch::Guard guard(epoch);
+			entered.store(true);
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			done.store(true);
+		});
+
+		while (!entered.load())
+			std::this_thread::yield();
+
+		epoch.synchronize();
+
+		REQUIRE(done.load() == true);
+
+		realtime.join();
+	}
+
+	SECTION("Test synchronize against a busy realtime thread")
+	{
+		/* The realtime thread enters a new section as soon as it leaves the
+		previous one: synchronize() must not be starved. Each version of the data
+		is retired only after a grace period, so it must never be retired while a
+		section is still reading it. */
+
+		std::atomic<bool> running  = true;
+		std::atomic<int>  sections = 0;
+		std::atomic<int>  current  = 0;
+		std::atomic<int>  retired  = -1;
+		std::atomic<bool> valid    = true;
+
+		std::thread realtime([&]()
+		{
+			while (running.load())
+			{
+				RtEpoch::Guard guard(epoch);
+				const int      version = current.load();
+				sections.fetch_add(1);
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+				if (retired.load() >= version)
+					valid.store(false);
+			}
+		});
+
+		while (sections.load() == 0)
+			std::this_thread::yield();
+
+		for (int version = 1; version <= 200; version++)
+		{
+			current.store(version);
+			epoch.synchronize();
+			retired.store(version - 1);
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+
+		running.store(false);
+		realtime.join();
+
+		REQUIRE(valid.load() == true);
+	}
+}
@@ -24,7 +24,8 @@ TEST_CASE("rendering::sampleRendering")
 	channelShared.quantizer.emplace();
 	channelShared.renderQueue.emplace(/*size=*/16);
 	channelShared.resampler.emplace(Resampler::Quality::LINEAR);
-	channelShared.stretcher.emplace(48000);
+	channelShared.compactWindow.emplace(G_COMPACT_WINDOW_FRAMES, NUM_CHANNELS);
+	channelShared.freezer = std::make_shared<m::Freezer>(Resampler::Quality::LINEAR, 48000);
 
 	SECTION("Test initialization")
 	{
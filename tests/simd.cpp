@@ -0,0 +1,204 @@
+#include "../src/core/simd.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace giada::m;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+std::vector<float> makeSignal_(int count, float amplitude)
+{
+	std::vector<float> out(count);
+	for (int i = 0; i < count; i++)
+		out[i] = amplitude * std::sin(i * 0.1f);
+	return out;
+}
+} // namespace
+
+TEST_CASE("simd")
+{
+	/* Odd sizes make sure the scalar tail of each kernel is exercised too. */
+
+	static const int SIZE = 1027;
+
+	const std::vector<simd::InstructionSet> sets = {
+	    simd::InstructionSet::SCALAR, simd::InstructionSet::SSE2,
+	    simd::InstructionSet::AVX2, simd::InstructionSet::NEON};
+
+	for (const simd::InstructionSet set : sets)
+	{
+		if (!simd::isSupported(set))
+			continue;
+
+		simd::setInstructionSet(set);
+
+		SECTION("Test sum - " + simd::toString(set))
+		{
+			std::vector<float>       dest = makeSignal_(SIZE, 0.5f);
+			const std::vector<float> src  = makeSignal_(SIZE, 0.8f);
+
+			simd::sum(dest.data(), src.data(), SIZE, 0.25f);
+
+			for (int i = 0; i < SIZE; i++)
+				REQUIRE_THAT(dest[i], WithinAbs(0.5f * std::sin(i * 0.1f) + 0.2f * std::sin(i * 0.1f), 0.0001));
+		}
+
+		SECTION("Test sum ramp - " + simd::toString(set))
+		{
+			std::vector<float>       dest(SIZE, 0.5f);
+			const std::vector<float> src(SIZE, 1.0f);
+
+			simd::sumRamp(dest.data(), src.data(), SIZE, 0.0f, 1.0f);
+
+			REQUIRE(dest[0] == 0.5f);
+			for (int i = 0; i < SIZE; i++)
+				REQUIRE_THAT(dest[i], WithinAbs(0.5f + i / static_cast<float>(SIZE), 0.0001));
+		}
+
+		SECTION("Test gain - " + simd::toString(set))
+		{
+			std::vector<float> buf = makeSignal_(SIZE, 1.0f);
+
+			simd::applyGain(buf.data(), SIZE, 0.5f);
+
+			for (int i = 0; i < SIZE; i++)
+				REQUIRE_THAT(buf[i], WithinAbs(0.5f * std::sin(i * 0.1f), 0.0001));
+		}
+
+		SECTION("Test gain ramp - " + simd::toString(set))
+		{
+			std::vector<float> buf(SIZE, 1.0f);
+
+			simd::applyGainRamp(buf.data(), SIZE, 0.0f, 1.0f);
+
+			REQUIRE(buf[0] == 0.0f);
+			for (int i = 0; i < SIZE; i++)
+				REQUIRE_THAT(buf[i], WithinAbs(i / static_cast<float>(SIZE), 0.0001));
+		}
+
+		SECTION("Test clamp - " + simd::toString(set))
+		{
+			std::vector<float> buf = makeSignal_(SIZE, 2.0f);
+
+			simd::clamp(buf.data(), SIZE, -1.0f, 1.0f);
+
+			for (int i = 0; i < SIZE; i++)
+				REQUIRE(std::abs(buf[i]) <= 1.0f);
+		}
+
+		SECTION("Test peak - " + simd::toString(set))
+		{
+			std::vector<float> buf = makeSignal_(SIZE, 0.5f);
+			buf[SIZE - 1]          = -0.9f; // In the scalar tail
+			REQUIRE(simd::getPeak(buf.data(), SIZE) == 0.9f);
+
+			buf[SIZE - 1] = 0.0f;
+			buf[8]        = -0.95f; // In the vectorized body
+			REQUIRE(simd::getPeak(buf.data(), SIZE) == 0.95f);
+		}
+
+		SECTION("Test int16 to float - " + simd::toString(set))
+		{
+			std::vector<std::int16_t> src(SIZE);
+			for (int i = 0; i < SIZE; i++)
+				src[i] = static_cast<std::int16_t>(i * 64 - 32768);
+			std::vector<float> dest(SIZE);
+
+			simd::int16ToFloat(dest.data(), src.data(), SIZE);
+
+			for (int i = 0; i < SIZE; i++)
+				REQUIRE(dest[i] == src[i] / 32768.0f);
+		}
+
+		SECTION("Test half to float - " + simd::toString(set))
+		{
+			/* Pairs of half-precision bit patterns and their exact float value. */
+
+			const std::vector<std::pair<std::uint16_t, float>> values = {
+			    {0x0000, 0.0f}, {0x8000, -0.0f}, {0x3C00, 1.0f}, {0xBC00, -1.0f}, {0x3800, 0.5f},
+			    {0x3555, 0.333251953125f}, {0x7BFF, 65504.0f}, {0x0400, 0x1p-14f}};
+
+			std::vector<std::uint16_t> src(SIZE);
+			for (int i = 0; i < SIZE; i++)
+				src[i] = values[i % values.size()].first;
+			std::vector<float> dest(SIZE);
+
+			simd::halfToFloat(dest.data(), src.data(), SIZE);
+
+			for (int i = 0; i < SIZE; i++)
+				REQUIRE(dest[i] == values[i % values.size()].second);
+		}
+
+		SECTION("Test stereo dot product - " + simd::toString(set))
+		{
+			const std::vector<float> left   = makeSignal_(SIZE, 0.5f);
+			const std::vector<float> right  = makeSignal_(SIZE, -0.25f);
+			const std::vector<float> coeffs = makeSignal_(SIZE, 1.0f);
+
+			double expectedL = 0.0;
+			double expectedR = 0.0;
+			for (int i = 0; i < SIZE; i++)
+			{
+				expectedL += left[i] * coeffs[i];
+				expectedR += right[i] * coeffs[i];
+			}
+
+			float out[2];
+			simd::dotProductStereo(out, left.data(), right.data(), coeffs.data(), SIZE);
+
+			REQUIRE_THAT(out[0], WithinAbs(expectedL, 0.001));
+			REQUIRE_THAT(out[1], WithinAbs(expectedR, 0.001));
+		}
+	}
+
+	simd::setInstructionSet(simd::getBestInstructionSet());
+}
+
+/* Micro-benchmark: scalar vs best SIMD throughput on typical block sizes. Run
+with './giada --run-tests "[!benchmark]"'. */
+
+TEST_CASE("simd benchmark", "[!benchmark]")
+{
+	const simd::InstructionSet best = simd::getBestInstructionSet();
+
+	for (const int blockSize : {64, 256, 1024})
+	{
+		for (const simd::InstructionSet set : {simd::InstructionSet::SCALAR, best})
+		{
+			simd::setInstructionSet(set);
+
+			const std::string  suffix = " - " + simd::toString(set) + " - " + std::to_string(blockSize) + " frames";
+			std::vector<float> dest   = makeSignal_(blockSize, 0.5f);
+			std::vector<float> src    = makeSignal_(blockSize, 0.5f);
+
+			BENCHMARK("sum" + suffix)
+			{
+				simd::sum(dest.data(), src.data(), blockSize, 0.5f);
+				return dest[0];
+			};
+			BENCHMARK("gain ramp" + suffix)
+			{
+				simd::applyGainRamp(dest.data(), blockSize, 1.0f, 0.99f);
+				return dest[0];
+			};
+			BENCHMARK("clamp" + suffix)
+			{
+				simd::clamp(dest.data(), blockSize, -1.0f, 1.0f);
+				return dest[0];
+			};
+			BENCHMARK("peak" + suffix)
+			{
+				return simd::getPeak(src.data(), blockSize);
+			};
+		}
+	}
+
+	simd::setInstructionSet(best);
+}
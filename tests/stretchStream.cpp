@@ -0,0 +1,180 @@
+#include "../src/core/stretchStream.h"
+#include "../src/core/const.h"
+#include "../src/core/stretcher.h"
+#include "../src/core/wave.h"
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("StretchStream")
+{
+	constexpr int SAMPLE_RATE  = 44100;
+	constexpr int WAVE_SIZE    = 100000;
+	constexpr int BUFFER_SIZE  = 1024;
+	constexpr int NUM_CHANNELS = 2;
+
+	Wave wave({});
+	wave.alloc(WAVE_SIZE, NUM_CHANNELS, SAMPLE_RATE, /*bits=*/32, "path/to/sample.wav");
+	for (int i = 0; i < WAVE_SIZE; i++)
+	{
+		wave.getBuffer().at(i, 0) = static_cast<float>(i + 1);
+		wave.getBuffer().at(i, 1) = static_cast<float>(i + 1);
+	}
+
+	Sample sample = {
+	    .wave         = &wave,
+	    .range        = {1000, 90000},
+	    .time         = 2.0f,
+	    .playbackMode = PlaybackMode::ELASTIC};
+
+	/* No worker thread running here: streams are filled by hand. */
+
+	Stretcher        stretcher(SAMPLE_RATE);
+	StretchStream    stream;
+	mcl::AudioBuffer out(BUFFER_SIZE, NUM_CHANNELS);
+
+	const auto fill = [&stream]()
+	{
+		while (stream.fill())
+			;
+	};
+
+	REQUIRE_FALSE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+
+	stream.request(sample);
+	fill();
+
+	/* Nothing is streamed without a Stretcher. */
+
+	REQUIRE_FALSE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+
+	stream.lend(&stretcher);
+	fill();
+
+	SECTION("Test playback")
+	{
+		Frame tracker   = sample.range.getA();
+		Frame generated = 0;
+		bool  finished  = false;
+
+		while (!finished)
+		{
+			const std::optional<rendering::ReadResult> res = stream.a_read(sample, out, tracker, /*offset=*/0);
+
+			REQUIRE(res.has_value());
+			REQUIRE(res->used >= 0);
+			REQUIRE(res->generated > 0);
+
+			tracker += res->used;
+			generated += res->generated;
+			finished = res->finished;
+
+			stream.a_prefetch(tracker);
+			fill();
+		}
+
+		/* The whole range has been played exactly once, at half speed. */
+
+		REQUIRE(tracker == sample.range.getB());
+		REQUIRE(generated > sample.range.getLength() * 2 - BUFFER_SIZE);
+		REQUIRE(generated < sample.range.getLength() * 2 + G_FREEZE_RENDER_MARGIN);
+		REQUIRE(stream.getUnderruns() == 0);
+
+		/* Ready for a loop. */
+
+		REQUIRE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+	}
+
+	SECTION("Test jump")
+	{
+		constexpr Frame JUMP = 50000;
+
+		REQUIRE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+		REQUIRE_FALSE(stream.a_read(sample, out, JUMP, /*offset=*/0).has_value());
+		REQUIRE(stream.a_handOver());
+		REQUIRE_FALSE(stream.a_handOver());
+
+		stream.a_prefetch(JUMP);
+		fill();
+
+		const std::optional<rendering::ReadResult> res = stream.a_read(sample, out, JUMP, /*offset=*/0);
+
+		REQUIRE(res.has_value());
+		REQUIRE(res->generated == BUFFER_SIZE);
+		REQUIRE(stream.getUnderruns() == 0);
+	}
+
+	SECTION("Test underrun")
+	{
+		Frame     tracker = sample.range.getA();
+		const int total   = StretchStream::getTotalUnderruns();
+
+		while (const std::optional<rendering::ReadResult> res = stream.a_read(sample, out, tracker, /*offset=*/0))
+			tracker += res->used;
+
+		REQUIRE(tracker > sample.range.getA());
+		REQUIRE(tracker < sample.range.getB());
+		REQUIRE(stream.getUnderruns() == 1);
+		REQUIRE(StretchStream::getTotalUnderruns() == total + 1);
+		REQUIRE(stream.a_handOver());
+
+		/* The worker is still rendering the same pass: no need to start over. */
+
+		stream.a_prefetch(tracker);
+		fill();
+
+		REQUIRE(stream.a_read(sample, out, tracker, /*offset=*/0).has_value());
+	}
+
+	SECTION("Test changes")
+	{
+		sample.time = 1.5f;
+
+		REQUIRE_FALSE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+
+		stream.request(sample);
+		fill();
+
+		REQUIRE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+	}
+
+	SECTION("Test release")
+	{
+		Sample tape       = sample;
+		tape.playbackMode = PlaybackMode::TAPE;
+
+		stream.request(tape);
+		fill();
+
+		REQUIRE_FALSE(stream.a_read(tape, out, sample.range.getA(), /*offset=*/0).has_value());
+		REQUIRE_FALSE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+	}
+
+	SECTION("Test reclaim")
+	{
+		REQUIRE(stream.hasStretcher());
+		REQUIRE(stream.reclaim() == &stretcher);
+		REQUIRE_FALSE(stream.hasStretcher());
+		REQUIRE(stream.reclaim() == nullptr);
+
+		fill();
+
+		REQUIRE_FALSE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+
+		stream.lend(&stretcher);
+		fill();
+
+		REQUIRE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+	}
+
+	SECTION("Test non-realtime")
+	{
+		StretchStream::setNonRealtime(true);
+
+		REQUIRE_FALSE(stream.a_read(sample, out, sample.range.getA(), /*offset=*/0).has_value());
+
+		StretchStream::setNonRealtime(false);
+	}
+}
@@ -0,0 +1,70 @@
+#include "../src/core/stretcherPool.h"
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace giada::m;
+
+TEST_CASE("StretcherPool")
+{
+	constexpr int SIZE = 4;
+
+	StretcherPool pool;
+
+	SECTION("Test empty pool")
+	{
+		REQUIRE(pool.countAll() == 0);
+		REQUIRE(pool.acquire() == nullptr);
+	}
+
+	pool.reset(SIZE, /*sampleRate=*/44100);
+
+	SECTION("Test reset")
+	{
+		REQUIRE(pool.countAll() == SIZE);
+		REQUIRE(pool.countFree() == SIZE);
+	}
+
+	SECTION("Test acquire until exhausted")
+	{
+		std::set<Stretcher*> lent;
+		for (int i = 0; i < SIZE; i++)
+			lent.insert(pool.acquire());
+
+		REQUIRE(lent.size() == SIZE);
+		REQUIRE_FALSE(lent.contains(nullptr));
+		REQUIRE(pool.countFree() == 0);
+		REQUIRE(pool.acquire() == nullptr);
+	}
+
+	SECTION("Test release")
+	{
+		Stretcher* a = pool.acquire();
+		Stretcher* b = pool.acquire();
+
+		pool.release(a);
+		REQUIRE(pool.countFree() == SIZE - 1);
+		REQUIRE(pool.acquire() == a);
+
+		pool.release(a);
+		pool.release(b);
+		REQUIRE(pool.countFree() == SIZE);
+	}
+
+	SECTION("Test concurrent acquire and release")
+	{
+		std::vector<std::thread> threads;
+		for (int i = 0; i < SIZE; i++)
+			threads.emplace_back([&pool]()
+			{
+				for (int j = 0; j < 1000; j++)
+					if (Stretcher* s = pool.acquire(); s != nullptr)
+						pool.release(s);
+			});
+		for (std::thread& t : threads)
+			t.join();
+
+		REQUIRE(pool.countFree() == SIZE);
+	}
+}
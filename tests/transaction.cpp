@@ -0,0 +1,96 @@
+#include "../src/core/model/transaction.h"
+#include "../src/core/const.h"
+#include "../src/core/model/model.h"
+#include "../src/core/types.h"
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Transaction")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	model::Model model;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+
+	std::vector<model::SwapType> swaps;
+	model.onSwap = [&swaps](model::SwapType t)
+	{
+		swaps.push_back(t);
+	};
+
+	SECTION("Test swaps are merged into one")
+	{
+		{
+			const model::Transaction transaction = model.beginTransaction();
+			model.swap(model::SwapType::SOFT);
+			model.swap(model::SwapType::HARD);
+			model.swap(model::SwapType::NONE);
+
+			REQUIRE(swaps.empty());
+		}
+
+		REQUIRE(swaps == std::vector{model::SwapType::HARD});
+	}
+
+	SECTION("Test nested transactions")
+	{
+		{
+			const model::Transaction outer = model.beginTransaction();
+			{
+				const model::Transaction inner = model.beginTransaction();
+				model.swap(model::SwapType::SOFT);
+			}
+			REQUIRE(swaps.empty());
+		}
+
+		REQUIRE(swaps == std::vector{model::SwapType::SOFT});
+	}
+
+	SECTION("Test empty transactions don't swap")
+	{
+		{
+			const model::Transaction transaction = model.beginTransaction();
+		}
+
+		REQUIRE(swaps.empty());
+	}
+
+	SECTION("Test SharedLock swaps right away")
+	{
+		const model::Transaction transaction = model.beginTransaction();
+		model.swap(model::SwapType::SOFT);
+		{
+			const model::SharedLock lock = model.lockShared(model::SwapType::NONE);
+			REQUIRE(swaps == std::vector{model::SwapType::SOFT});
+		}
+		REQUIRE(swaps.size() == 2);
+	}
+
+	SECTION("Test coalescing")
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(G_MODEL_COALESCE_MS));
+
+		for (int i = 0; i < 10; i++)
+		{
+			const model::Transaction transaction = model.beginTransaction(/*coalesce=*/true);
+			model.swap(model::SwapType::SOFT);
+		}
+
+		REQUIRE(swaps.size() == 1);
+
+		model.flushCoalesced(); // Too early
+		REQUIRE(swaps.size() == 1);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(G_MODEL_COALESCE_MS));
+		model.flushCoalesced();
+		REQUIRE(swaps.size() == 2);
+
+		model.flushCoalesced(); // Nothing left
+		REQUIRE(swaps.size() == 2);
+	}
+}
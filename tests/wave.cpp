@@ -1,6 +1,7 @@
 #include "../src/core/wave.h"
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
+#include <utility>
 
 TEST_CASE("Wave")
 {
@@ -43,5 +44,29 @@ TEST_CASE("Wave")
 			REQUIRE(wave.getBasename() == "sample");
 			REQUIRE(wave.getBasename(true) == "sample.wav");
 		}
+
+		SECTION("test shared data")
+		{
+			wave.getBuffer().at(0, 0) = 0.5f;
+
+			m::Wave other(ID{2});
+			other.shareData(wave);
+
+			REQUIRE(wave.isDataShared());
+			REQUIRE(other.isDataShared());
+			REQUIRE(&std::as_const(wave).getBuffer() == &std::as_const(other).getBuffer());
+			REQUIRE(wave.getHash() == other.getHash());
+			REQUIRE(other.getRate() == SAMPLE_RATE);
+
+			/* Writing to a shared buffer makes a private copy first. */
+
+			other.getBuffer().at(0, 0) = 1.0f;
+
+			REQUIRE(!wave.isDataShared());
+			REQUIRE(!other.isDataShared());
+			REQUIRE(wave.getBuffer().at(0, 0) == 0.5f);
+			REQUIRE(other.getBuffer().at(0, 0) == 1.0f);
+			REQUIRE(wave.getHash() != other.getHash());
+		}
 	}
 }
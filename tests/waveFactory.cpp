@@ -51,4 +51,28 @@ TEST_CASE("waveFactory")
 		REQUIRE(res.wave->isLogical() == false);
 		REQUIRE(res.wave->isEdited() == false);
 	}
+	SECTION("test storage")
+	{
+		waveFactory::Result res = waveFactory::createFromFile(TEST_WAV_PATH,
+		    /*ID=*/{}, /*sampleRate=*/SAMPLE_RATE, Resampler::Quality::LINEAR);
+
+		const int         frames    = res.wave->getBuffer().countFrames();
+		const std::size_t floatSize = res.wave->getDataSize();
+
+		REQUIRE(waveFactory::setStorage(*res.wave, SampleStorage::INT16) == G_RES_OK);
+		REQUIRE(res.wave->isCompact());
+		REQUIRE(res.wave->isResident() == false);
+		REQUIRE(res.wave->getStorage() == SampleStorage::INT16);
+		REQUIRE(res.wave->getLength() == frames);
+		REQUIRE(res.wave->getDataSize() == floatSize / 2);
+
+		REQUIRE(waveFactory::setStorage(*res.wave, SampleStorage::HALF) == G_RES_OK);
+		REQUIRE(res.wave->getStorage() == SampleStorage::HALF);
+		REQUIRE(res.wave->getLength() == frames);
+
+		REQUIRE(waveFactory::setStorage(*res.wave, SampleStorage::FLOAT) == G_RES_OK);
+		REQUIRE(res.wave->isResident());
+		REQUIRE(res.wave->getBuffer().countFrames() == frames);
+		REQUIRE(res.wave->getDataSize() == floatSize);
+	}
 }
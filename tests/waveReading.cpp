@@ -1,3 +1,5 @@
+#include "../src/core/compactBuffer.h"
+#include "../src/core/const.h"
 #include "../src/core/resampler.h"
 #include "../src/core/wave.h"
 #include "../src/utils/vector.h"
@@ -19,8 +21,9 @@ TEST_CASE("WaveReading")
 		wave.getBuffer().at(i, 0) = static_cast<float>(i + 1);
 		wave.getBuffer().at(i, 1) = static_cast<float>(i + 1);
 	}
-	m::Resampler resampler;
-	m::Stretcher stretcher(/*sampleRate=*/44100);
+	m::Resampler     resampler;
+	m::Stretcher     stretcher(/*sampleRate=*/44100);
+	mcl::AudioBuffer compactWindow(G_COMPACT_WINDOW_FRAMES, NUM_CHANNELS);
 
 	const Sample sample = {
 	    .wave  = &wave,
@@ -35,7 +38,7 @@ TEST_CASE("WaveReading")
 		SECTION("Regular fill")
 		{
 			m::rendering::ReadResult res = rendering::readWave(sample, out,
-			    /*start=*/0, /*offset=*/0, resampler, stretcher);
+			    /*start=*/0, /*offset=*/0, resampler, &stretcher, compactWindow);
 
 			bool allFilled       = true;
 			int  numFramesFilled = 0;
@@ -55,7 +58,7 @@ TEST_CASE("WaveReading")
 		SECTION("Partial fill")
 		{
 			m::rendering::ReadResult res = rendering::readWave(sample, out,
-			    /*start=*/0, /*offset=*/BUFFER_SIZE / 2, resampler, stretcher);
+			    /*start=*/0, /*offset=*/BUFFER_SIZE / 2, resampler, &stretcher, compactWindow);
 
 			int numFramesFilled = 0;
 			for (int i = 0; i < out.countFrames(); ++i)
@@ -71,4 +74,22 @@ TEST_CASE("WaveReading")
 			REQUIRE(numFramesFilled == res.generated);
 		}
 	}
+	SECTION("Test fill, compact storage")
+	{
+		/* Integers up to 2048 are exact in half precision: the compact Wave must
+		read back the very same values. */
+
+		wave.setCompact(std::make_shared<m::CompactBuffer>(wave.getBuffer(), SampleStorage::HALF));
+
+		mcl::AudioBuffer out(BUFFER_SIZE, NUM_CHANNELS);
+
+		m::rendering::ReadResult res = rendering::readWave(sample, out,
+		    /*start=*/0, /*offset=*/0, resampler, &stretcher, compactWindow);
+
+		REQUIRE(wave.isCompact());
+		REQUIRE(res.used == BUFFER_SIZE);
+		REQUIRE(res.generated == BUFFER_SIZE);
+		for (int i = 0; i < out.countFrames(); ++i)
+			REQUIRE(out.at(i, 1) == static_cast<float>(i + 1));
+	}
 }
@@ -0,0 +1,58 @@
+#include "../src/core/worker.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace giada;
+
+TEST_CASE("Worker")
+{
+	using Clock = std::chrono::steady_clock;
+
+	/* A sleep time way longer than the test itself: the worker must only run
+	once on start, then whenever it's notified. */
+
+	Worker           worker(/*sleep=*/60000, /*rtPoll=*/1);
+	std::atomic<int> runs = 0;
+
+	worker.start([&runs]()
+	{
+		runs.fetch_add(1);
+	});
+
+	auto waitForRuns = [&runs](int count)
+	{
+		const Clock::time_point timeout = Clock::now() + std::chrono::seconds(5);
+		while (runs.load() < count && Clock::now() < timeout)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return runs.load() >= count;
+	};
+
+	REQUIRE(waitForRuns(1));
+
+	SECTION("Test notify")
+	{
+		worker.notify();
+		REQUIRE(waitForRuns(2));
+
+		worker.notify();
+		REQUIRE(waitForRuns(3));
+	}
+
+	SECTION("Test notify from the realtime thread")
+	{
+		worker.notify_RT();
+		REQUIRE(waitForRuns(2));
+
+		worker.notify_RT();
+		REQUIRE(waitForRuns(3));
+	}
+
+	SECTION("Test stop doesn't wait for the sleep time")
+	{
+		const Clock::time_point start = Clock::now();
+		worker.stop();
+		REQUIRE(Clock::now() - start < std::chrono::seconds(5));
+	}
+}
@@ -0,0 +1,86 @@
+#include "../src/core/rendering/workerPool.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace giada::m::rendering;
+
+TEST_CASE("WorkerPool")
+{
+	static const std::size_t NUM_JOBS = 64;
+
+	WorkerPool       pool;
+	std::vector<int> results(NUM_JOBS, 0);
+
+	auto job = [&results](std::size_t jobIndex, std::size_t /*worker*/)
+	{
+		results[jobIndex] += static_cast<int>(jobIndex);
+	};
+
+	SECTION("Test serial run")
+	{
+		REQUIRE(pool.countWorkers() == 1);
+
+		pool.run(NUM_JOBS, job);
+
+		for (std::size_t i = 0; i < NUM_JOBS; i++)
+			REQUIRE(results[i] == static_cast<int>(i));
+	}
+
+	SECTION("Test parallel runs")
+	{
+		pool.start(4);
+
+		REQUIRE(pool.countWorkers() == 4);
+
+		/* Each job must run exactly once per run, and all jobs must be completed
+		when run() returns. */
+
+		for (int run = 0; run < 100; run++)
+			pool.run(NUM_JOBS, job);
+
+		for (std::size_t i = 0; i < NUM_JOBS; i++)
+			REQUIRE(results[i] == static_cast<int>(i) * 100);
+
+		pool.stop();
+
+		REQUIRE(pool.countWorkers() == 1);
+	}
+
+	SECTION("Test worker indexes")
+	{
+		pool.start(3);
+
+		std::atomic<bool> validIndexes = true;
+		auto              check        = [&validIndexes, &pool](std::size_t, std::size_t worker)
+		{
+			if (worker >= pool.countWorkers())
+				validIndexes.store(false);
+		};
+		pool.run(NUM_JOBS, check);
+
+		REQUIRE(validIndexes.load());
+	}
+
+	SECTION("Test join on slow jobs")
+	{
+		/* Jobs last way longer than the spinning phase of the join barrier: the
+		calling thread must keep yielding until the last worker is done. */
+
+		pool.start(4);
+
+		auto slowJob = [&results](std::size_t jobIndex, std::size_t /*worker*/)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			results[jobIndex] += 1;
+		};
+
+		for (int run = 0; run < 10; run++)
+			pool.run(NUM_JOBS, slowJob);
+
+		for (std::size_t i = 0; i < NUM_JOBS; i++)
+			REQUIRE(results[i] == 10);
+	}
+}